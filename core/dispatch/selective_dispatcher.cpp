@@ -12,7 +12,9 @@
 #include <chrono>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <string_view>
 
 namespace AXIOM {
 
@@ -71,6 +73,71 @@ EngineResult SelectiveDispatcher::DispatchOperation(const std::string& expressio
     return result;
 }
 
+std::vector<EngineResult> SelectiveDispatcher::DispatchBatch(std::span<const std::string> expressions) {
+    auto batch_start = std::chrono::high_resolution_clock::now();
+    BatchDispatchMetrics metrics;
+    metrics.operation_count = expressions.size();
+    std::vector<EngineResult> results(expressions.size());
+
+    // 1. Classify once per shape and bucket indices per engine
+    std::vector<OperationComplexity> complexities(expressions.size());
+    std::map<ComputeEngine, std::vector<size_t>> groups;
+    for (size_t i = 0; i < expressions.size(); ++i) {
+        bool cache_hit = false;
+        complexities[i] = ClassifyCached(expressions[i], &cache_hit);
+        (cache_hit ? metrics.classification_cache_hits : metrics.classifications)++;
+        groups[SelectOptimalEngine(expressions[i], complexities[i])].push_back(i);
+    }
+    auto classify_end = std::chrono::high_resolution_clock::now();
+    metrics.classify_time_us = std::chrono::duration<double, std::micro>(classify_end - batch_start).count();
+
+    // 2. Every engine evaluates its whole group
+    for (const auto& [engine, indices] : groups) {
+        auto group_start = std::chrono::high_resolution_clock::now();
+        ExecuteGroup(engine, expressions, indices, results, metrics.distinct_expressions);
+        double group_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - group_start).count();
+        metrics.engine_group_sizes[engine] = indices.size();
+        metrics.engine_execution_ms[engine] = group_ms;
+
+        // The learning history gets one amortized entry per operation
+        double per_operation_ms = group_ms / static_cast<double>(indices.size());
+        for (size_t index : indices) {
+            RecordMetrics(engine, expressions[index], complexities[index], per_operation_ms);
+        }
+    }
+
+    metrics.total_time_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - batch_start).count();
+    last_batch_metrics_ = std::move(metrics);
+    return results;
+}
+
+void SelectiveDispatcher::ExecuteGroup(ComputeEngine engine, std::span<const std::string> expressions,
+                                       const std::vector<size_t>& indices, std::vector<EngineResult>& results,
+                                       size_t& evaluated) {
+    // Only the native engine is wired up; see ExecuteWithFallback
+    (void)engine;
+    DynamicCalc& calc = NativeEngine();
+    calc.SetMode(CalculationMode::ALGEBRAIC);
+
+    // Repeated expressions in the group are evaluated once
+    std::unordered_map<std::string_view, size_t> first_seen;
+    for (size_t index : indices) {
+        auto [it, inserted] = first_seen.emplace(expressions[index], index);
+        if (!inserted) {
+            results[index] = results[it->second];
+            continue;
+        }
+        ++evaluated;
+        try {
+            results[index] = calc.Evaluate(expressions[index]);
+        } catch (const std::exception&) {
+            results[index] = {{}, {EngineErrorResult(CalcErr::OperationNotFound)}};
+        }
+    }
+}
+
 ComputeEngine SelectiveDispatcher::SelectOptimalEngine(const std::string& expression, 
                                                       OperationComplexity complexity) {
     // For initial implementation, use Native engine only
@@ -161,10 +228,15 @@ EngineResult SelectiveDispatcher::ExecuteWithFallback(const std::string& express
     */
 }
 
+DynamicCalc& SelectiveDispatcher::NativeEngine() {
+    // One engine for every dispatch, so its parsers and caches are built once
+    if (!native_engine_) native_engine_ = std::make_unique<DynamicCalc>();
+    return *native_engine_;
+}
+
 EngineResult SelectiveDispatcher::ExecuteNative(const std::string& expression) {
     // Use the existing AXIOM native engine
-    DynamicCalc calc;
-    return calc.calculate(expression, CalculationMode::ALGEBRAIC);
+    return NativeEngine().calculate(expression, CalculationMode::ALGEBRAIC);
 }
 
 bool SelectiveDispatcher::IsEngineAvailable(ComputeEngine engine) const {
@@ -198,6 +270,56 @@ bool SelectiveDispatcher::HasSymbolicOperations(const std::string& expression) c
            (expression.find("factor") != std::string::npos);
 }
 
+OperationComplexity SelectiveDispatcher::ClassifyOperation(const std::string& expression) {
+    return ClassifyCached(expression, nullptr);
+}
+
+OperationComplexity SelectiveDispatcher::ClassifyCached(const std::string& expression, bool* cache_hit) {
+    std::string shape = OperationShape(expression);
+    auto it = classification_cache_.find(shape);
+    if (cache_hit) *cache_hit = it != classification_cache_.end();
+    if (it != classification_cache_.end()) return it->second;
+
+    if (classification_cache_.size() >= kMaxClassificationCache) classification_cache_.clear();
+    OperationComplexity complexity = ClassifyUncached(expression);
+    classification_cache_.emplace(std::move(shape), complexity);
+    return complexity;
+}
+
+OperationComplexity SelectiveDispatcher::ClassifyUncached(const std::string& expression) const {
+    if (HasSymbolicOperations(expression)) return OperationComplexity::Extreme;
+    if (HasMatrixOperations(expression)) return OperationComplexity::Complex;
+    for (size_t i = 1; i < expression.size(); ++i) {
+        // A function call: a name followed by '('
+        if (expression[i] == '(' && std::isalpha(static_cast<unsigned char>(expression[i - 1]))) {
+            return OperationComplexity::Medium;
+        }
+    }
+    return OperationComplexity::Simple;
+}
+
+std::string SelectiveDispatcher::OperationShape(const std::string& expression) {
+    // Numeric literals become '#' and whitespace goes, so "2 + 3" and "40+1.5"
+    // share a shape; digits that continue a name (log2, x1) are kept
+    std::string shape;
+    shape.reserve(expression.size());
+    for (size_t i = 0; i < expression.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(expression[i]);
+        if (std::isspace(c)) continue;
+        bool in_name = !shape.empty() && (std::isalnum(static_cast<unsigned char>(shape.back())) || shape.back() == '_');
+        if ((std::isdigit(c) || c == '.') && !in_name) {
+            while (i + 1 < expression.size() &&
+                   (std::isdigit(static_cast<unsigned char>(expression[i + 1])) || expression[i + 1] == '.')) {
+                ++i;
+            }
+            shape += '#';
+        } else {
+            shape += static_cast<char>(c);
+        }
+    }
+    return shape;
+}
+
 void SelectiveDispatcher::RecordMetrics(ComputeEngine engine, 
                                        const std::string& expression,
                                        OperationComplexity complexity,
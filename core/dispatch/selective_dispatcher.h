@@ -9,10 +9,13 @@
 #pragma once
 
 #include "../../include/dynamic_calc_types.h"
+#include <map>
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <string>
 #include <chrono>
+#include <vector>
 
 namespace AXIOM {
 
@@ -62,6 +65,22 @@ struct DispatchMetrics {
     bool fallback_used = false;
 };
 
+/**
+ * @brief Aggregate metrics for one DispatchBatch call
+ */
+struct BatchDispatchMetrics {
+    size_t operation_count = 0;
+    size_t distinct_expressions = 0;       ///< Evaluations actually performed
+    size_t classifications = 0;            ///< Shapes classified (cache misses)
+    size_t classification_cache_hits = 0;
+    double classify_time_us = 0.0;         ///< Classification and grouping
+    double total_time_ms = 0.0;
+    std::map<ComputeEngine, size_t> engine_group_sizes;
+    std::map<ComputeEngine, double> engine_execution_ms;
+};
+
+class DynamicCalc;
+
 // Forward declarations for optional engine types
 #ifdef ENABLE_EIGEN
 class EigenEngine;
@@ -88,6 +107,18 @@ public:
     // Core dispatch operations
     EngineResult DispatchOperation(const std::string& expression, 
                                  OperationComplexity complexity = OperationComplexity::Simple);
+    /**
+     * @brief Dispatches many expressions at once
+     *
+     * Each expression is classified once per shape (numeric literals erased),
+     * the batch is grouped by engine and every engine evaluates its group in
+     * one pass; repeated expressions are evaluated once. Results come back in
+     * input order.
+     */
+    std::vector<EngineResult> DispatchBatch(std::span<const std::string> expressions);
+
+    // Expression analysis (memoized per shape)
+    OperationComplexity ClassifyOperation(const std::string& expression);
 
     // Configuration
     void SetPreferredEngine(ComputeEngine engine);
@@ -96,6 +127,7 @@ public:
 
     // Monitoring and diagnostics
     DispatchMetrics GetLastMetrics() const;
+    BatchDispatchMetrics GetLastBatchMetrics() const { return last_batch_metrics_; }
     std::string GetPerformanceReport() const;
     bool IsEngineAvailable(ComputeEngine engine) const;
 
@@ -108,11 +140,18 @@ private:
     
     // Native execution
     EngineResult ExecuteNative(const std::string& expression);
+    DynamicCalc& NativeEngine();
+    void ExecuteGroup(ComputeEngine engine, std::span<const std::string> expressions,
+                      const std::vector<size_t>& indices, std::vector<EngineResult>& results,
+                      size_t& evaluated);
     
     // Expression analysis
     size_t EstimateDataSize(const std::string& expression) const;
     bool HasMatrixOperations(const std::string& expression) const;
     bool HasSymbolicOperations(const std::string& expression) const;
+    OperationComplexity ClassifyCached(const std::string& expression, bool* cache_hit);
+    OperationComplexity ClassifyUncached(const std::string& expression) const;
+    static std::string OperationShape(const std::string& expression);
     
     // Performance tracking
     void RecordMetrics(ComputeEngine engine, 
@@ -131,6 +170,14 @@ private:
     
     // Performance tracking
     DispatchMetrics last_metrics_;
+    BatchDispatchMetrics last_batch_metrics_;
+
+    // Classification memo keyed by operation shape; cleared when full
+    std::unordered_map<std::string, OperationComplexity> classification_cache_;
+    static constexpr size_t kMaxClassificationCache = 4096;
+
+    // Shared by single and batched dispatch, created on first use
+    std::unique_ptr<DynamicCalc> native_engine_;
     std::unordered_map<ComputeEngine, bool> engine_availability_;
     std::unordered_map<ComputeEngine, 
                       std::unordered_map<std::string, EnginePerformance>> engine_performance_;
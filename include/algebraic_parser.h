@@ -14,6 +14,8 @@
 #include <optional>
 #include <unordered_map>
 
+class UnitManager;
+
 // ========================================================
 // 1. MEMORY ARENA (High Performance Allocation)
 // ========================================================
@@ -147,9 +149,13 @@ public:
         return ParseAndExecuteWithContext(input, number_context);
     }
 
+    // Enables unit literals ("9.81 m/s^2 * 3 s"); results with a dimension come back as "29.43 m/s"
+    void SetUnitManager(UnitManager* units) { unit_manager_ = units; }
+
 private:
     Arena arena_;
     mutable std::shared_mutex mutex_s;
+    UnitManager* unit_manager_ = nullptr;
 
     // Performance: Expression memoization cache
     mutable std::unordered_map<std::string, EvalResult> eval_cache_;
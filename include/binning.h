@@ -0,0 +1,64 @@
+/**
+ * @file binning.h
+ * @brief Shared 1-D / 2-D histogram counting for statistics and plotting
+ *
+ * Bin indices come from the SIMD kernels (multiply-and-floor for uniform
+ * bins, vector compares or a branch-free binary search for edges); each
+ * worker counts into its own array and the arrays are summed at the end,
+ * so there are no shared counters or atomics. Bins are half-open
+ * [e_i, e_i+1) except the last, which also holds the upper limit (as in
+ * numpy.histogram). Values outside the range and NaNs are tallied
+ * separately instead of being dropped silently.
+ */
+#pragma once
+
+#include "dynamic_calc_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+struct Histogram {
+    Vector edges;                   // bins + 1 ascending edges
+    std::vector<uint64_t> counts;   // One per bin
+    uint64_t below = 0;             // x < edges.front()
+    uint64_t above = 0;             // x > edges.back()
+    uint64_t missing = 0;           // NaN
+
+    size_t Bins() const { return counts.size(); }
+};
+
+struct Histogram2D {
+    Vector x_edges;
+    Vector y_edges;
+    std::vector<uint64_t> counts;   // x bins x y bins, row-major by x bin
+    uint64_t outside = 0;           // Either coordinate outside its range
+    uint64_t missing = 0;           // Either coordinate NaN
+
+    size_t XBins() const { return x_edges.size() - 1; }
+    size_t YBins() const { return y_edges.size() - 1; }
+    uint64_t At(size_t ix, size_t iy) const { return counts[ix * YBins() + iy]; }
+};
+
+namespace Binning {
+
+// Upper bound on the bins (cells, in 2-D) of one histogram
+constexpr size_t kMaxBins = size_t{1} << 26;
+
+// bins equal bins over [lo, hi]; nullopt unless bins >= 1 and lo < hi are finite
+std::optional<Histogram> Uniform(const double* x, size_t n, size_t bins, double lo, double hi);
+// Range from the finite minimum / maximum of x (a unit range around a constant)
+std::optional<Histogram> Uniform(const double* x, size_t n, size_t bins);
+// Arbitrary finite, non-decreasing edges (at least two)
+std::optional<Histogram> Edges(const double* x, size_t n, const Vector& edges);
+
+std::optional<Histogram2D> Uniform2D(const double* x, const double* y, size_t n,
+                                     size_t x_bins, double x_lo, double x_hi,
+                                     size_t y_bins, double y_lo, double y_hi);
+std::optional<Histogram2D> Edges2D(const double* x, const double* y, size_t n,
+                                   const Vector& x_edges, const Vector& y_edges);
+
+// Finite minimum and maximum of x; nullopt if there are none
+std::optional<std::pair<double, double>> FiniteRange(const double* x, size_t n);
+
+} // namespace Binning
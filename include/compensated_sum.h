@@ -0,0 +1,49 @@
+/**
+ * @file compensated_sum.h
+ * @brief Compensated, parallel, deterministic reductions
+ *
+ * Each chunk is summed by a SIMD Kahan-Babuska (Neumaier) kernel and the
+ * chunk results are combined, again compensated, in index order. Error is
+ * O(eps) independent of n, and results are bit-reproducible for a given
+ * thread count (chunking follows Parallel::DefaultGrain).
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;   // Low-order bits lost from sum so far
+
+    void Add(double x) {
+        double t = sum + x;
+        compensation += std::fabs(sum) >= std::fabs(x) ? (sum - t) + x : (x - t) + sum;
+        sum = t;
+    }
+
+    void Merge(const CompensatedSum& other) {
+        Add(other.sum);
+        Add(other.compensation);
+    }
+
+    double Value() const { return sum + compensation; }
+};
+
+namespace Reduction {
+
+// sum x[i]
+double Sum(const double* data, size_t n);
+
+// sum (x[i] - center)^2
+double SumSquaredDeviations(const double* data, size_t n, double center);
+
+// Sums of (x - cx)^2, (y - cy)^2 and (x - cx)(y - cy)
+struct CrossDeviations {
+    double xx = 0.0;
+    double yy = 0.0;
+    double xy = 0.0;
+};
+CrossDeviations SumCrossDeviations(const double* x, const double* y, size_t n, double cx, double cy);
+
+} // namespace Reduction
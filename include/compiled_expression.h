@@ -0,0 +1,113 @@
+/**
+ * @file compiled_expression.h
+ * @brief Compile-once, evaluate-many real expressions for sampling and plotting
+ *
+ * Compile() parses an expression once into a flat postfix program with
+ * constants folded and small integer powers turned into multiplications.
+ * Evaluate() then runs the program over whole arrays: each instruction
+ * sweeps a block of 256 values, so a point costs a few vectorizable loop
+ * iterations instead of a parse, a std::map context and a virtual call per
+ * node. exp and ln go through the SIMD kernels, a sum of monomials in
+ * one variable runs as one Horner pass of the poly_eval kernel, and large
+ * batches are split over the shared pool.
+ *
+ * The syntax and conventions follow AlgebraicParser: trigonometry in
+ * degrees, pi / e / phi, implicit multiplication (2x, 3(x + 1),
+ * (x + 1)(x - 1)), "sin x" without parentheses, and max / min / gcd / lcm
+ * / mod. Points where the parser would report an error (division by zero,
+ * a root or logarithm outside its domain) evaluate to NaN.
+ *
+ * Given a UnitManager, a literal may carry a unit: "9.81 m/s^2 * 3 s".
+ * Dimensions are checked while compiling (m + s is a compile error) and
+ * each literal is folded to its SI value, so Evaluate() runs on plain
+ * doubles and returns results in the SI base units of ResultDimension().
+ * Angles are the exception: a lone "90 deg" or "1 rad" folds to degrees,
+ * which is what the trigonometric functions take, so sin(90 deg) is 1;
+ * an angle inside a compound unit or under a power is rejected.
+ */
+#pragma once
+
+#include "dimension.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class UnitManager;
+
+class CompiledExpression {
+public:
+    /**
+     * @param variables Names bound to Evaluate()'s inputs, in order
+     * @param error Receives a short reason when compilation fails
+     */
+    static std::optional<CompiledExpression> Compile(std::string_view expression,
+                                                     const std::vector<std::string>& variables,
+                                                     std::string* error = nullptr);
+    /**
+     * Compile with unit literals; variables are dimensionless
+     * @param dimension_error Set when compilation failed on a dimension check
+     */
+    static std::optional<CompiledExpression> Compile(std::string_view expression,
+                                                     const std::vector<std::string>& variables,
+                                                     const UnitManager& units, std::string* error = nullptr,
+                                                     bool* dimension_error = nullptr);
+
+    // Length of the number literal opening text ("2", ".5", "6.02e-23"); an exponent
+    // counts only when it has digits, so "2e" is 2 * e. 0 when text opens with no digit or '.'
+    static size_t NumberLength(std::string_view text);
+
+    size_t VariableCount() const { return variable_count_; }
+    size_t InstructionCount() const { return program_.size(); }
+    // True when the program is a sum of monomials in one variable, evaluated by Horner's rule
+    bool IsPolynomial() const { return !polynomial_.empty(); }
+    // True when no variable survived folding (one value for every point)
+    bool IsConstant() const;
+    // 64-bit hash of the folded program: "2*3*x" and "6x" compile alike and share it
+    uint64_t Fingerprint() const;
+    // Dimension of the result (dimensionless unless compiled with units)
+    const Dimension& ResultDimension() const { return result_dimension_; }
+    // True when some literal carried a unit
+    bool HasUnits() const { return has_units_; }
+
+    // inputs[v] holds n values of variable v; writes n results
+    void Evaluate(const double* const* inputs, double* out, size_t n) const;
+    // One-variable form
+    void Evaluate(const double* x, double* out, size_t n) const { Evaluate(&x, out, n); }
+    // One point; values holds one value per variable
+    double EvaluateAt(const double* values) const;
+
+    enum class OpCode : uint8_t {
+        Constant, Variable, Add, Sub, Mul, Div, Pow, PowInt, Neg, Max, Min, Mod, Gcd, Lcm, Function
+    };
+    enum class Function : uint8_t {
+        Sin, Cos, Tan, Cot, Sec, Csc, Asin, Acos, Atan, Acot, Asec, Acsc,
+        Sinh, Cosh, Tanh, Coth, Sech, Csch, Asinh, Acosh, Atanh, Acoth, Asech, Acsch,
+        Sqrt, Cbrt, Abs, Ln, Log10, Log2, Exp, Factorial
+    };
+    struct Instruction {
+        OpCode op = OpCode::Constant;
+        Function function = Function::Sin;
+        uint32_t index = 0;          // Variable
+        double value = 0.0;          // Constant, or the integer exponent of PowInt
+    };
+
+private:
+    CompiledExpression() = default;
+    static std::optional<CompiledExpression> Compile(std::string_view expression,
+                                                     const std::vector<std::string>& variables,
+                                                     const UnitManager* units, std::string* error,
+                                                     bool* dimension_error);
+    // stack holds max_depth_ slots of `stride` values each
+    void EvaluateBlock(const double* const* inputs, size_t offset, double* out, size_t m,
+                       double* stack, size_t stride) const;
+
+    std::vector<Instruction> program_;
+    size_t variable_count_ = 0;
+    size_t max_depth_ = 0;
+    Dimension result_dimension_;
+    bool has_units_ = false;
+    std::vector<double> polynomial_;   // Coefficients, lowest degree first, when IsPolynomial()
+};
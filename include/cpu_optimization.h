@@ -1,6 +1,10 @@
 /**
  * @file cpu_optimization.h
  * @brief CPU-specific optimizations and performance tuning
+ *
+ * Runtime CPUID feature detection. The selected ISA level drives the
+ * function-pointer dispatch in simd_kernels.h, so a single portable
+ * binary picks the widest vector path the host supports.
  */
 
 #ifndef CPU_OPTIMIZATION_H
@@ -12,6 +16,31 @@
 
 namespace AXIOM {
 
+/**
+ * @brief Instruction-set levels that kernels are built for
+ */
+enum class ISALevel {
+    Scalar,   // Portable C++ (baseline x86-64 / non-x86)
+    AVX2,     // AVX2 + FMA (Haswell / Zen and later)
+    AVX512    // AVX-512F (Skylake-SP / Zen 4 and later)
+};
+
+/**
+ * @brief Host CPU features detected via CPUID/XGETBV
+ */
+struct CPUFeatures {
+    bool sse2 = false;
+    bool sse41 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool avx512f = false;
+    bool os_avx = false;      // OS saves YMM state (XCR0)
+    bool os_avx512 = false;   // OS saves ZMM/opmask state (XCR0)
+    std::string vendor;
+    std::string brand;
+};
+
 /**
  * @brief CPU optimization utilities
  */
@@ -20,13 +49,24 @@ public:
     static void Initialize();
     static std::string GetCPUInfo();
     static void OptimizeForCurrentCPU();
-    
+
+    // Feature detection (cached after first call)
+    static const CPUFeatures& GetFeatures();
+
+    // Widest ISA level supported by both CPU and OS. The AXIOM_ISA
+    // environment variable (scalar|avx2|avx512) can lower it for testing.
+    static ISALevel GetISALevel();
+    static std::string ISALevelToString(ISALevel level);
+
 private:
     static bool DetectSSE();
     static bool DetectAVX();
     static bool DetectAVX2();
+    static bool DetectFMA();
+    static bool DetectAVX512();
+    static CPUFeatures QueryCPUID();
 };
 
 } // namespace AXIOM
 
-#endif // CPU_OPTIMIZATION_H
\ No newline at end of file
+#endif // CPU_OPTIMIZATION_H
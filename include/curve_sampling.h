@@ -0,0 +1,63 @@
+/**
+ * @file curve_sampling.h
+ * @brief Adaptive sampling of y = f(x) for plotting
+ *
+ * Sample() starts from a coarse grid and bisects only where the curve is
+ * not yet straight at the output resolution: an interval is split when
+ * its midpoint lies more than tolerance_pixels off the chord (a discrete
+ * curvature test), or when the function is defined at only some of the
+ * three points. Every refinement level is one batched Evaluate() call.
+ * Splitting stops once intervals are min_step_pixels wide, so a plot
+ * costs a few hundred evaluations where its curve is smooth and
+ * concentrates points around spikes, kinks and asymptotes.
+ *
+ * A jump of more than jump_pixels left between neighbouring samples is
+ * then bisected past pixel resolution, following the larger half each
+ * time. A continuous curve's jump shrinks with the interval; a
+ * discontinuity's does not, and is reported as a break so it is not drawn
+ * as a vertical line.
+ * Values far above or below the y range are clamped before any test, so
+ * off-screen detail costs nothing.
+ */
+#pragma once
+
+#include "compiled_expression.h"
+#include "dynamic_calc_types.h"
+#include <cstddef>
+#include <vector>
+
+namespace CurveSampling {
+
+struct Options {
+    size_t x_pixels = 800;           // Output resolution over [x_min, x_max]
+    size_t y_pixels = 600;           // Output resolution over [y_min, y_max]
+    double y_min = -5;
+    double y_max = 5;
+    double initial_step_pixels = 4;  // Coarse grid spacing
+    double min_step_pixels = 0.5;    // No bisection below this spacing
+    double tolerance_pixels = 0.5;   // Allowed midpoint distance from the chord
+    double jump_pixels = 8;          // Neighbours further apart are checked for a discontinuity
+    size_t jump_probe_levels = 12;   // Extra bisections used to classify a jump
+};
+
+struct Curve {
+    Vector x;                        // Ascending; only points where f is finite
+    Vector y;
+    std::vector<size_t> breaks;      // i: do not join point i to point i + 1
+    size_t evaluations = 0;          // Points evaluated, including discarded ones
+    double x_scale = 0.0;            // Pixels per unit the samples were checked at
+    double y_scale = 0.0;
+
+    size_t Size() const { return x.size(); }
+};
+
+/**
+ * expression must have exactly one variable; nothing is sampled unless x_min < x_max.
+ * seed: an earlier curve of the same expression (a view before a pan or zoom) whose
+ * points inside [x_min, x_max] are reused instead of being evaluated again. Raw
+ * samples work too: non-finite values are allowed, and x_scale 0 re-tests every interval
+ */
+Curve Sample(const CompiledExpression& expression, double x_min, double x_max, const Options& options = {},
+             const Curve* seed = nullptr);
+
+} // namespace CurveSampling
@@ -20,6 +20,10 @@
 #include <queue>
 #include <condition_variable>
 #include <chrono>
+#include <vector>
+
+#include "thread_pool.h"
+#include "streaming_statistics.h"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -31,6 +35,38 @@
 
 namespace AXIOM {
 
+class DynamicCalc;
+
+/**
+ * @brief Thread count, placement and idle policy for one daemon role
+ */
+struct DaemonThreadRole {
+    size_t threads = 1;
+    ThreadPlacement placement;
+    int spin_us = 0;                 // Busy-poll window before parking (0 = park immediately)
+};
+
+/**
+ * @brief Daemon thread layout
+ *
+ * Roles: "io" (pipe reader, always one thread), "compute" (request
+ * processors) and "pool" (shared work-stealing workers, threads 0 = auto).
+ * Keys are "<role>.<field>" in a config file or "--<role>-<field>=" on the
+ * command line, with fields threads, cpus (e.g. 2-3,6), pin (true/false),
+ * sched (other | fifo:PRIO), nice and spin_us.
+ */
+struct DaemonConfig {
+    DaemonThreadRole io;
+    DaemonThreadRole compute;
+    DaemonThreadRole pool{0, {}, 50};
+
+    bool Set(const std::string& key, const std::string& value, std::string& error);
+    bool LoadFile(const std::string& path, std::string& error);
+    // Consumes --daemon-config=FILE and --<role>-<field>=VALUE; other args are ignored
+    bool ApplyArgs(const std::vector<std::string>& args, std::string& error);
+    std::string Describe() const;
+};
+
 /**
  * @brief Enterprise Daemon Communication Protocol
  * 
@@ -64,6 +100,13 @@ public:
         SHUTDOWN
     };
 
+    struct LatencySummary {
+        size_t samples = 0;
+        double p50_us = 0.0;
+        double p99_us = 0.0;
+        double max_us = 0.0;
+    };
+
 private:
     // Core daemon state
     std::atomic<DaemonStatus> status_{DaemonStatus::STARTING};
@@ -72,22 +115,38 @@ private:
     
     // Communication infrastructure
     std::string pipe_name_;
+    DaemonConfig config_;
     std::thread daemon_thread_;
-    std::thread request_processor_;
+    std::vector<std::thread> request_processors_;
     
     // Request queue management
     std::queue<Request> request_queue_;
     std::mutex queue_mutex_;
     std::condition_variable queue_cv_;
+    std::atomic<size_t> pending_requests_{0};   // Lets spinning workers poll without the lock
+    std::atomic<int> busy_workers_{0};
+    
+    // Applied thread layout, one line per thread
+    std::vector<std::string> thread_layout_;
+    mutable std::mutex layout_mutex_;
     
     // Session management
     std::unordered_map<std::string, std::unique_ptr<class SessionContext>> sessions_;
     std::mutex sessions_mutex_;
     
+    // Daemon-wide sketch streams ("stream" mode), shared by all sessions
+    StreamingStatistics streams_;
+    
     // Performance metrics
     std::atomic<uint64_t> total_requests_{0};
     std::atomic<double> avg_response_time_{0.0};
     std::chrono::steady_clock::time_point startup_time_;
+    
+    // Enqueue-to-completion latency samples (ring buffer)
+    static constexpr size_t LATENCY_SAMPLES = 8192;
+    std::vector<double> latency_us_;
+    size_t latency_next_ = 0;
+    mutable std::mutex latency_mutex_;
 
 #ifdef _WIN32
     HANDLE pipe_handle_;
@@ -96,7 +155,7 @@ private:
 #endif
 
 public:
-    DaemonEngine(const std::string& pipe_name = "axiom_daemon");
+    DaemonEngine(const std::string& pipe_name = "axiom_daemon", const DaemonConfig& config = {});
     ~DaemonEngine();
 
     // Lifecycle management
@@ -104,6 +163,8 @@ public:
     void stop();
     bool is_running() const { return running_.load(); }
     DaemonStatus get_status() const { return status_.load(); }
+    std::string get_status_report() const;   // State, metrics and the applied thread layout
+    const DaemonConfig& get_config() const { return config_; }
 
     // Communication interface
     Response process_request(const Request& request);
@@ -115,17 +176,26 @@ public:
     bool destroy_session(const std::string& session_id);
     std::vector<std::string> get_active_sessions();
 
+    // Streaming statistics (also reachable through mode "stream")
+    StreamingStatistics& get_streams() { return streams_; }
+
     // Performance monitoring
     uint64_t get_total_requests() const { return total_requests_.load(); }
     double get_avg_response_time() const { return avg_response_time_.load(); }
     std::chrono::milliseconds get_uptime() const;
+    LatencySummary get_latency_summary() const;
+    void reset_latency_samples();
 
 private:
     void daemon_loop();
-    void request_processor_loop();
+    void request_processor_loop(size_t index);
+    void enqueue_request(Request request);
+    void record_layout(const std::string& role, size_t index, const DaemonThreadRole& config);
+    void record_latency(double latency_us);
     bool setup_pipe();
     void cleanup_pipe();
     Response execute_command(const Request& request);
+    std::string execute_stream_command(const std::string& command);
     void update_metrics(double execution_time);
 };
 
@@ -142,11 +212,10 @@ public:
     std::vector<std::string> history;
     std::chrono::steady_clock::time_point created_at;
     std::chrono::steady_clock::time_point last_access;
+    std::mutex mutex;   // Serializes requests when several compute workers share a session
     
-    // Python/computation state
-    std::unique_ptr<class PythonEngine> python_engine;
-    std::unique_ptr<class AlgebraicParser> algebraic_parser;
-    std::unique_ptr<class LinearSystemParser> linear_parser;
+    // Computation state: one engine per session, switched per request mode
+    std::unique_ptr<DynamicCalc> calc;
     
     SessionContext(const std::string& id);
     ~SessionContext();
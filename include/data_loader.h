@@ -0,0 +1,66 @@
+/**
+ * @file data_loader.h
+ * @brief Memory-mapped CSV/TSV ingestion into contiguous numeric columns
+ *
+ * The file is mapped read-only, split into newline-aligned chunks, and the
+ * chunks are parsed in parallel with std::from_chars straight into
+ * preallocated columns (row offsets come from a parallel line-count pass).
+ * Cells that are empty or not numeric become NaN. Quoted fields may contain
+ * the delimiter (and "" for a quote) but not newlines. A first line made only
+ * of numbers, empty cells and "nan" is read as data rather than a header.
+ *
+ * A parsed table can be stored as a binary columnar cache next to the source
+ * ("<file>.axcol"), keyed on the source size and modification time, so
+ * repeated loads skip parsing entirely.
+ */
+#pragma once
+
+#include "dynamic_calc_types.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct DataTable {
+    std::vector<std::string> names;
+    std::vector<Vector> columns;   // columns[c][row]; NaN marks a missing value
+    size_t rows = 0;
+    bool from_cache = false;
+
+    const Vector* Column(const std::string& name) const;
+};
+
+struct CsvOptions {
+    char delimiter = 0;        // 0: detect from the header (tab, ';' or ',')
+    bool has_header = true;    // Otherwise columns are named c0, c1, ...
+    bool use_cache = true;     // Read / refresh "<file>.axcol"
+};
+
+// Identifies the source a columnar cache was built from
+struct CacheStamp {
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    uint32_t options = 0;      // Delimiter / header options that shape the parse
+
+    bool operator==(const CacheStamp& o) const {
+        return source_size == o.source_size && source_mtime == o.source_mtime && options == o.options;
+    }
+};
+
+class DataLoader {
+public:
+    // Parses a CSV/TSV file (through the columnar cache when enabled)
+    static std::optional<DataTable> Load(const std::string& path, std::string& error,
+                                         const CsvOptions& options = {});
+
+    // Parses delimited text already in memory
+    static std::optional<DataTable> ParseText(const char* data, size_t size, std::string& error,
+                                              const CsvOptions& options = {});
+
+    // Binary columnar cache; Load reuses it only when the stamp matches
+    static bool WriteColumnar(const DataTable& table, const std::string& path,
+                              const CacheStamp& stamp = {});
+    static std::optional<DataTable> ReadColumnar(const std::string& path, CacheStamp* stamp = nullptr);
+
+    static std::string CachePath(const std::string& path) { return path + ".axcol"; }
+};
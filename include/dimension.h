@@ -0,0 +1,127 @@
+/**
+ * @file dimension.h
+ * @brief SI dimension exponent vectors
+ *
+ * A physical dimension is the product of the seven SI base dimensions,
+ * each raised to a small integer power: m/s is length^1 time^-1, N is
+ * mass^1 length^1 time^-2. Multiplying quantities adds exponents and
+ * dividing subtracts them, so dimensional analysis is a few byte adds.
+ *
+ * Dimension is a structural literal type. UnitManager uses it at run time
+ * for parsed units, and Quantity<D> (quantity.h) takes it as a template
+ * argument so C++ callers get the same checks at compile time.
+ *
+ * Exponents are int8_t. Run-time callers use CheckedProduct / CheckedPow and
+ * reject a result that leaves that range; the operators throw instead of
+ * wrapping, which in a constant expression makes the overflow a compile error.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+struct Dimension {
+    enum Base : size_t { kLength, kMass, kTime, kCurrent, kTemperature, kAmount, kLuminosity, kBaseCount };
+
+    std::array<int8_t, kBaseCount> exponents{};
+
+    static constexpr Dimension Of(Base base, int power = 1) {
+        Dimension d;
+        d.exponents[base] = static_cast<int8_t>(power);
+        return d;
+    }
+
+    constexpr bool IsDimensionless() const {
+        for (int8_t e : exponents) {
+            if (e != 0) return false;
+        }
+        return true;
+    }
+
+    // this^power, or nullopt if an exponent leaves int8_t
+    constexpr std::optional<Dimension> CheckedPow(int power) const {
+        Dimension d;
+        for (size_t i = 0; i < kBaseCount; ++i) {
+            const int64_t e = static_cast<int64_t>(exponents[i]) * power;
+            if (e < INT8_MIN || e > INT8_MAX) return std::nullopt;
+            d.exponents[i] = static_cast<int8_t>(e);
+        }
+        return d;
+    }
+
+    // a * b (or a / b with divide), or nullopt if an exponent leaves int8_t
+    static constexpr std::optional<Dimension> CheckedProduct(const Dimension& a, const Dimension& b, bool divide = false) {
+        Dimension d;
+        for (size_t i = 0; i < kBaseCount; ++i) {
+            const int e = divide ? a.exponents[i] - b.exponents[i] : a.exponents[i] + b.exponents[i];
+            if (e < INT8_MIN || e > INT8_MAX) return std::nullopt;
+            d.exponents[i] = static_cast<int8_t>(e);
+        }
+        return d;
+    }
+
+    constexpr Dimension Pow(int power) const { return OrThrow(CheckedPow(power)); }
+
+    friend constexpr Dimension operator*(const Dimension& a, const Dimension& b) {
+        return OrThrow(CheckedProduct(a, b));
+    }
+
+    friend constexpr Dimension operator/(const Dimension& a, const Dimension& b) {
+        return OrThrow(CheckedProduct(a, b, true));
+    }
+
+    friend constexpr bool operator==(const Dimension& a, const Dimension& b) = default;
+
+    // Base symbols with exponents, e.g. "kg*m/s^2"; "1" when dimensionless
+    std::string ToString() const {
+        static constexpr const char* kSymbols[kBaseCount] = {"m", "kg", "s", "A", "K", "mol", "cd"};
+        // Conventional order: mass, length, then the rest
+        static constexpr Base kOrder[kBaseCount] = {kMass, kLength, kTime, kCurrent, kTemperature, kAmount, kLuminosity};
+        std::string numerator, denominator;
+        for (Base base : kOrder) {
+            const int e = exponents[base];
+            if (e == 0) continue;
+            std::string& side = e > 0 ? numerator : denominator;
+            if (!side.empty()) side += '*';
+            side += kSymbols[base];
+            if (e != 1 && e != -1) side += "^" + std::to_string(e > 0 ? e : -e);
+        }
+        if (numerator.empty()) numerator = "1";
+        return denominator.empty() ? numerator : numerator + "/" + denominator;
+    }
+
+private:
+    static constexpr Dimension OrThrow(const std::optional<Dimension>& d) {
+        if (!d) throw std::overflow_error("dimension exponent out of range");
+        return *d;
+    }
+};
+
+namespace Dimensions {
+
+inline constexpr Dimension Dimensionless{};
+inline constexpr Dimension Length = Dimension::Of(Dimension::kLength);
+inline constexpr Dimension Mass = Dimension::Of(Dimension::kMass);
+inline constexpr Dimension Time = Dimension::Of(Dimension::kTime);
+inline constexpr Dimension Current = Dimension::Of(Dimension::kCurrent);
+inline constexpr Dimension Temperature = Dimension::Of(Dimension::kTemperature);
+inline constexpr Dimension Amount = Dimension::Of(Dimension::kAmount);
+inline constexpr Dimension Luminosity = Dimension::Of(Dimension::kLuminosity);
+
+inline constexpr Dimension Area = Length.Pow(2);
+inline constexpr Dimension Volume = Length.Pow(3);
+inline constexpr Dimension Frequency = Time.Pow(-1);
+inline constexpr Dimension Velocity = Length / Time;
+inline constexpr Dimension Acceleration = Velocity / Time;
+inline constexpr Dimension Force = Mass * Acceleration;
+inline constexpr Dimension Energy = Force * Length;
+inline constexpr Dimension Power = Energy / Time;
+inline constexpr Dimension Pressure = Force / Area;
+inline constexpr Dimension Charge = Current * Time;
+inline constexpr Dimension Voltage = Power / Current;
+
+} // namespace Dimensions
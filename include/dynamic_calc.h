@@ -65,6 +65,11 @@ public:
     SymbolicEngine* GetSymbolicEngine() { return symbolic_engine_.get(); }
     StatisticsEngine* GetStatisticsEngine() { return statistics_engine_.get(); }
     PlotEngine* GetPlotEngine() { return plot_engine_.get(); }
+
+    // Worker count of the shared thread pool used by every engine (0 = auto);
+    // false while parallel work is still running on the pool
+    static bool SetThreadCount(size_t num_threads);
+    static size_t GetThreadCount();
 #ifdef ENABLE_PYTHON_FFI
     PythonEngine* GetPythonEngine() { return nullptr; } // Disabled for pure C++ performance
 #endif
@@ -0,0 +1,60 @@
+/**
+ * @file frequency_table.h
+ * @brief Distinct-value counts, modes and contingency tables
+ *
+ * Count() picks its method from a sampled cardinality estimate:
+ * - Few distinct values: an open-addressing flat hash map (linear probing
+ *   over one key array and one count array, no per-node allocation), one
+ *   per chunk on the shared pool, merged in chunk order
+ * - Mostly distinct values: a parallel sort of a copy followed by one
+ *   run-length pass, which beats a table as large as the data
+ *
+ * Either way the result is ordered by value, so modes and ties come out
+ * the same for any input order, thread count or method. -0.0 is counted
+ * as 0.0 and NaN is tallied separately.
+ */
+#pragma once
+
+#include "dynamic_calc_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+struct FrequencyTable {
+    Vector values;                  // Distinct values, ascending
+    std::vector<uint64_t> counts;   // One per value
+    uint64_t missing = 0;           // NaN
+
+    size_t Size() const { return values.size(); }
+    // Every value with the highest count, ascending; empty for an empty table
+    Vector Modes() const;
+    // Indices by descending count, ties by ascending value
+    std::vector<size_t> ByCount() const;
+};
+
+struct ContingencyTable {
+    Vector row_values;              // Distinct x values, ascending
+    Vector column_values;           // Distinct y values, ascending
+    std::vector<uint64_t> counts;   // rows x columns, row-major
+    uint64_t missing = 0;           // Rows where x or y is NaN
+
+    size_t Rows() const { return row_values.size(); }
+    size_t Columns() const { return column_values.size(); }
+    uint64_t At(size_t r, size_t c) const { return counts[r * Columns() + c]; }
+};
+
+namespace Frequency {
+
+enum class Method { Hash, Sort };
+
+FrequencyTable Count(const double* x, size_t n);
+// Forces one method (both give the same table)
+FrequencyTable Count(const double* x, size_t n, Method method);
+// The method Count(x, n) would use
+Method ChooseMethod(const double* x, size_t n);
+
+// nullopt when the table would exceed 2^24 cells
+std::optional<ContingencyTable> CrossTabulate(const double* x, const double* y, size_t n);
+
+} // namespace Frequency
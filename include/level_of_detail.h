@@ -0,0 +1,80 @@
+/**
+ * @file level_of_detail.h
+ * @brief Min/max envelopes, LTTB and a zoomable pyramid for long x-sorted series
+ *
+ * A plot column can show at most a vertical span, so a series with
+ * millions of points reduces to the first, lowest, highest and last point
+ * of each column (M4) without changing any drawn pixel. Envelope() does
+ * that in one pass over the visible range.
+ *
+ * Pyramid keeps the minimum and maximum (with their positions) of every
+ * aligned block of 64, 128, 256, ... points. A column's extremes then come
+ * from O(log n) blocks plus at most 2 x 64 raw points at its ends, so an
+ * envelope for any zoom or pan costs O(columns log n) after one O(n)
+ * build. Downsample() runs Largest-Triangle-Three-Buckets over that
+ * envelope (MinMaxLTTB) for a fixed point budget that still follows peaks.
+ *
+ * NaN y values never become extremes; a NaN at the end of a column is kept
+ * so gaps stay visible.
+ */
+#pragma once
+
+#include "dynamic_calc_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace LevelOfDetail {
+
+struct Series {
+    Vector x;   // Ascending
+    Vector y;
+
+    size_t Size() const { return x.size(); }
+};
+
+/**
+ * M4 reduction of x-sorted data: first / min / max / last of each of
+ * `columns` equal x ranges over [x_lo, x_hi], in data order, plus the
+ * nearest point outside each end so lines leave the window correctly
+ */
+Series Envelope(const double* x, const double* y, size_t n, double x_lo, double x_hi, size_t columns);
+
+// Indices of `points` points picked by Largest-Triangle-Three-Buckets (always the first and last)
+std::vector<size_t> LargestTriangleThreeBuckets(const double* x, const double* y, size_t n, size_t points);
+
+class Pyramid {
+public:
+    // Sorts by x if needed; nullopt for mismatched sizes, no points or a NaN x
+    static std::optional<Pyramid> Build(Vector x, Vector y);
+
+    size_t Size() const { return x_.size(); }
+    size_t Levels() const { return levels_.size(); }
+    double XMin() const { return x_.front(); }
+    double XMax() const { return x_.back(); }
+    const Vector& X() const { return x_; }
+    const Vector& Y() const { return y_; }
+
+    // Same points as LevelOfDetail::Envelope over the stored data
+    Series Envelope(double x_lo, double x_hi, size_t columns) const;
+    // About `points` points: LTTB over the envelope of `points` columns
+    Series Downsample(double x_lo, double x_hi, size_t points) const;
+
+    struct Extremes {
+        static constexpr uint64_t kNone = ~uint64_t{0};
+        double min = 0.0, max = 0.0;
+        uint64_t argmin = kNone, argmax = kNone;   // kNone when every y is NaN
+    };
+    // Extremes of y[begin, end)
+    Extremes RangeExtremes(size_t begin, size_t end) const;
+
+private:
+    Pyramid() = default;
+
+    Vector x_;
+    Vector y_;
+    std::vector<std::vector<Extremes>> levels_;   // levels_[l][b]: points [b, b + 1) * (64 << l)
+};
+
+} // namespace LevelOfDetail
@@ -0,0 +1,71 @@
+/**
+ * @file linear_model.h
+ * @brief Multiple linear least squares: batch pivoted QR and online Givens QR
+ *
+ * Fit() copies the predictors into one contiguous column-major design and
+ * factors it with Householder QR and column pivoting; reflector dot products
+ * and updates run on the shared pool through the SIMD kernels. Columns whose
+ * pivot falls below max(n, p) * eps * |R00| are aliased: their coefficient
+ * and standard error are NaN, as in R's lm().
+ *
+ * OnlineRegression keeps only the p x p triangular factor R, Q^T y and the
+ * residual sum of squares, folding each row in with Givens rotations. A
+ * model over any number of rows therefore needs one pass and O(p^2) memory,
+ * and partial models (chunks, threads, streams) merge exactly.
+ */
+#pragma once
+
+#include "dynamic_calc_types.h"
+#include "moment_accumulator.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+struct RegressionFit {
+    Vector coefficients;              // Intercept first when fitted
+    Vector standard_errors;
+    double r_squared = 0.0;
+    double adjusted_r_squared = 0.0;
+    double residual_std_error = 0.0;  // sqrt(RSS / (n - rank))
+    double residual_sum_squares = 0.0;
+    uint64_t observations = 0;
+    size_t rank = 0;
+};
+
+namespace LinearModel {
+
+// y ~ columns (each of length n); nullopt if n < 1 or lengths differ
+std::optional<RegressionFit> Fit(const std::vector<const Vector*>& columns, const Vector& y,
+                                 bool intercept = true);
+
+} // namespace LinearModel
+
+/**
+ * @brief One-pass least squares over rows as they arrive
+ */
+class OnlineRegression {
+public:
+    explicit OnlineRegression(size_t predictors, bool intercept = true);
+
+    // x holds the predictors of one row (without the intercept term)
+    void Add(const double* x, double y);
+    void Merge(const OnlineRegression& other);
+
+    uint64_t Count() const { return y_moments_.count; }
+    size_t Terms() const { return terms_; }
+    std::optional<RegressionFit> Fit() const;
+
+private:
+    // Rotates the row (row[0 .. terms), y) into R and Q^T y; returns the
+    // part of y orthogonal to the current factor
+    double Rotate(double* row, double y);
+
+    size_t terms_;
+    bool intercept_;
+    Vector r_;         // terms x terms, row-major upper triangle
+    Vector qty_;       // Q^T y
+    double rss_ = 0.0;
+    MomentAccumulator y_moments_;
+    Vector row_;       // Scratch for the row being rotated in
+};
@@ -0,0 +1,232 @@
+/**
+ * @file moment_accumulator.h
+ * @brief Single-pass, mergeable moment accumulators
+ *
+ * MomentAccumulator tracks count, mean, central moment sums M2..M4, min and
+ * max using the pairwise update formulas of Pébay (2008), so partial results
+ * from chunks, threads or streams can be merged exactly. CoMomentAccumulator
+ * does the same for (x, y) pairs (means, M2x, M2y, Cxy) for correlation and
+ * simple regression.
+ *
+ * The bulk PushRange paths read memory once: each cache-resident block gets
+ * a compensated (Kahan-Babuska) mean and compensated second moments from the
+ * SIMD kernels, then is merged into the running state.
+ */
+#pragma once
+
+#include "compensated_sum.h"
+#include "simd_kernels.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Values per block in the PushRange paths (fits L1 alongside the kernels' state)
+inline constexpr size_t kMomentBlock = 2048;
+
+/**
+ * @brief Descriptive statistics derived from one MomentAccumulator
+ */
+struct DescriptiveStats {
+    uint64_t count = 0;
+    double sum = 0.0;
+    double mean = 0.0;
+    double variance = 0.0;       // Sample variance (n - 1)
+    double std_dev = 0.0;
+    double skewness = 0.0;       // Adjusted Fisher-Pearson G1 (n >= 3)
+    double kurtosis = 0.0;       // Sample excess kurtosis G2 (n >= 4)
+    double min = 0.0;
+    double max = 0.0;
+};
+
+struct MomentAccumulator {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;             // sum (x - mean)^2
+    double m3 = 0.0;             // sum (x - mean)^3
+    double m4 = 0.0;             // sum (x - mean)^4
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    CompensatedSum total;        // sum x; merged means are re-derived from it
+
+    // Welford/Terriberry update for a single observation
+    void Push(double x) {
+        uint64_t n1 = count++;
+        double n = static_cast<double>(count);
+        double delta = x - mean;
+        double delta_n = delta / n;
+        double delta_n2 = delta_n * delta_n;
+        double term1 = delta * delta_n * static_cast<double>(n1);
+        mean += delta_n;
+        m4 += term1 * delta_n2 * (n * n - 3 * n + 3) + 6 * delta_n2 * m2 - 4 * delta_n * m3;
+        m3 += term1 * delta_n * (n - 2) - 3 * delta_n * m2;
+        m2 += term1;
+        total.Add(x);
+        if (x < min) min = x;
+        if (x > max) max = x;
+    }
+
+    // Bulk update: compensated two-pass moments per cache-resident block,
+    // merged into the running state
+    void PushRange(const double* data, size_t n) {
+        const auto& kernels = AXIOM::SIMD::Kernels();
+        for (size_t start = 0; start < n; start += kMomentBlock) {
+            size_t len = (n - start < kMomentBlock) ? n - start : kMomentBlock;
+            const double* block = data + start;
+
+            double pair[2], moments[4];
+            MomentAccumulator part;
+            part.count = len;
+            kernels.sum_kb(block, len, pair);
+            part.total = CompensatedSum{pair[0], pair[1]};
+            part.mean = part.total.Value() / static_cast<double>(len);
+            kernels.central_moments_kb(block, len, part.mean, moments);
+            part.m2 = moments[0] + moments[1];
+            part.m3 = moments[2];
+            part.m4 = moments[3];
+            kernels.minmax(block, len, &part.min, &part.max);
+            Merge(part);
+        }
+    }
+
+    // Pébay's pairwise combination; exact for any split of the data
+    void Merge(const MomentAccumulator& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+
+        double na = static_cast<double>(count);
+        double nb = static_cast<double>(other.count);
+        double n = na + nb;
+        double delta = other.mean - mean;
+        double delta2 = delta * delta;
+        double delta3 = delta2 * delta;
+        double delta4 = delta2 * delta2;
+
+        double combined_m2 = m2 + other.m2 + delta2 * na * nb / n;
+        double combined_m3 = m3 + other.m3
+            + delta3 * na * nb * (na - nb) / (n * n)
+            + 3.0 * delta * (na * other.m2 - nb * m2) / n;
+        double combined_m4 = m4 + other.m4
+            + delta4 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+            + 6.0 * delta2 * (na * na * other.m2 + nb * nb * m2) / (n * n)
+            + 4.0 * delta * (na * other.m3 - nb * m3) / n;
+
+        // Blocks of large cancelling values have large means; weighting them
+        // together would drop the small remainder the compensated sum keeps
+        total.Merge(other.total);
+        mean = total.Value() / n;
+        m2 = combined_m2;
+        m3 = combined_m3;
+        m4 = combined_m4;
+        count += other.count;
+        if (other.min < min) min = other.min;
+        if (other.max > max) max = other.max;
+    }
+
+    double Sum() const { return total.Value(); }
+    double Variance() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0; }
+    double PopulationVariance() const { return count > 0 ? m2 / static_cast<double>(count) : 0.0; }
+    double StandardDeviation() const { return std::sqrt(Variance()); }
+
+    double Skewness() const {
+        if (count < 3 || m2 == 0.0) return 0.0;
+        double n = static_cast<double>(count);
+        double g1 = std::sqrt(n) * m3 / std::pow(m2, 1.5);
+        return g1 * std::sqrt(n * (n - 1)) / (n - 2);
+    }
+
+    double Kurtosis() const {
+        if (count < 4 || m2 == 0.0) return 0.0;
+        double n = static_cast<double>(count);
+        double g2 = n * m4 / (m2 * m2) - 3.0;
+        return ((n + 1) * g2 + 6) * (n - 1) / ((n - 2) * (n - 3));
+    }
+
+    bool IsFinite() const { return std::isfinite(mean) && std::isfinite(m2); }
+
+    DescriptiveStats Describe() const {
+        DescriptiveStats d;
+        d.count = count;
+        d.sum = Sum();
+        d.mean = mean;
+        d.variance = Variance();
+        d.std_dev = std::sqrt(d.variance);
+        d.skewness = Skewness();
+        d.kurtosis = Kurtosis();
+        d.min = count ? min : 0.0;
+        d.max = count ? max : 0.0;
+        return d;
+    }
+};
+
+struct CoMomentAccumulator {
+    uint64_t count = 0;
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    double m2x = 0.0;            // sum (x - mean_x)^2
+    double m2y = 0.0;            // sum (y - mean_y)^2
+    double cxy = 0.0;            // sum (x - mean_x)(y - mean_y)
+
+    void Push(double x, double y) {
+        ++count;
+        double n = static_cast<double>(count);
+        double dx = x - mean_x;
+        double dy = y - mean_y;
+        mean_x += dx / n;
+        mean_y += dy / n;
+        // Mixed old/new deltas give the exact Welford co-moment update
+        m2x += dx * (x - mean_x);
+        m2y += dy * (y - mean_y);
+        cxy += dx * (y - mean_y);
+    }
+
+    // Bulk update, blocked like MomentAccumulator::PushRange
+    void PushRange(const double* x, const double* y, size_t n) {
+        const auto& kernels = AXIOM::SIMD::Kernels();
+        for (size_t start = 0; start < n; start += kMomentBlock) {
+            size_t len = (n - start < kMomentBlock) ? n - start : kMomentBlock;
+            double len_d = static_cast<double>(len);
+
+            double pair[2], pairs[6];
+            CoMomentAccumulator part;
+            part.count = len;
+            kernels.sum_kb(x + start, len, pair);
+            part.mean_x = (pair[0] + pair[1]) / len_d;
+            kernels.sum_kb(y + start, len, pair);
+            part.mean_y = (pair[0] + pair[1]) / len_d;
+            kernels.co_dev_kb(x + start, y + start, len, part.mean_x, part.mean_y, pairs);
+            part.m2x = pairs[0] + pairs[1];
+            part.m2y = pairs[2] + pairs[3];
+            part.cxy = pairs[4] + pairs[5];
+            Merge(part);
+        }
+    }
+
+    void Merge(const CoMomentAccumulator& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        double na = static_cast<double>(count);
+        double nb = static_cast<double>(other.count);
+        double n = na + nb;
+        double dx = other.mean_x - mean_x;
+        double dy = other.mean_y - mean_y;
+        double w = na * nb / n;
+        m2x += other.m2x + dx * dx * w;
+        m2y += other.m2y + dy * dy * w;
+        cxy += other.cxy + dx * dy * w;
+        mean_x += dx * nb / n;
+        mean_y += dy * nb / n;
+        count += other.count;
+    }
+
+    double Covariance() const { return count > 1 ? cxy / static_cast<double>(count - 1) : 0.0; }
+    double Slope() const { return cxy / m2x; }
+    double Intercept() const { return mean_y - Slope() * mean_x; }
+    double Correlation() const { return cxy / std::sqrt(m2x * m2y); }
+};
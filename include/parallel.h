@@ -0,0 +1,199 @@
+/**
+ * @file parallel.h
+ * @brief Parallel algorithms on the shared work-stealing pool
+ *
+ * ParallelFor / ParallelReduce / ParallelSort split a range into chunks
+ * sized by DefaultGrain() and run them through a TaskGroup, so they nest
+ * freely inside each other. Reductions combine chunk partials strictly
+ * left-to-right, so results are deterministic for a given thread count
+ * and grain.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace AXIOM {
+namespace Parallel {
+
+// Ranges smaller than this run inline: task overhead would dominate
+inline constexpr size_t kSerialThreshold = 4096;
+
+// Target chunks per worker; >1 leaves slack for stealing to balance load
+inline constexpr size_t kChunksPerWorker = 4;
+
+/**
+ * @brief Chunk size heuristic: ~kChunksPerWorker chunks per worker,
+ *        never below min_grain elements
+ */
+inline size_t DefaultGrain(size_t n, size_t min_grain = 1024) {
+    size_t workers = ThreadPool::Global().Size();
+    size_t target_chunks = std::max<size_t>(1, workers * kChunksPerWorker);
+    return std::max(min_grain, (n + target_chunks - 1) / target_chunks);
+}
+
+/**
+ * @brief body(chunk_begin, chunk_end) over [begin, end) in chunks of grain
+ * @param grain 0 selects DefaultGrain()
+ */
+template <typename Body>
+void ParallelFor(size_t begin, size_t end, size_t grain, Body&& body) {
+    if (end <= begin) return;
+    size_t n = end - begin;
+    if (grain == 0) grain = DefaultGrain(n);
+    if (n <= std::max(grain, kSerialThreshold) || ThreadPool::Global().Size() <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group;
+    for (size_t lo = begin; lo < end; lo += grain) {
+        size_t hi = std::min(end, lo + grain);
+        group.Run([&body, lo, hi] { body(lo, hi); });
+    }
+    group.Wait();
+}
+
+template <typename Body>
+void ParallelFor(size_t begin, size_t end, Body&& body) {
+    ParallelFor(begin, end, 0, std::forward<Body>(body));
+}
+
+// Total work (items x cost per item) below which weighted loops run inline
+inline constexpr size_t kMinParallelWork = size_t{1} << 15;
+
+/**
+ * @brief body(lo, hi) over [0, count) for items that each cost about
+ *        work_per_item units (resamples, tiles, grid rows)
+ *
+ * Unlike ParallelFor, the serial cutoff is on total work rather than item
+ * count, so a few hundred heavy items still spread over the pool. Ranges
+ * are contiguous and cover [0, count) once; with disjoint outputs the split
+ * never changes results.
+ */
+template <typename Body>
+void ParallelForWork(size_t count, size_t work_per_item, Body&& body) {
+    size_t workers = ThreadPool::Global().Size();
+    size_t chunks = std::min(count, workers * kChunksPerWorker);
+    if (workers <= 1 || count * std::max<size_t>(work_per_item, 1) < kMinParallelWork) chunks = 1;
+    if (chunks <= 1) {
+        if (count > 0) body(size_t{0}, count);
+        return;
+    }
+    TaskGroup group;
+    for (size_t k = 0; k < chunks; ++k) {
+        size_t lo = count * k / chunks, hi = count * (k + 1) / chunks;
+        group.Run([&body, lo, hi] { body(lo, hi); });
+    }
+    group.Wait();
+}
+
+/**
+ * @brief Chunked reduction with a fixed combination order
+ *
+ * chunk(lo, hi) produces a partial for [lo, hi); partials are folded as
+ * combine(combine(identity, p0), p1)... in index order regardless of
+ * which worker finished first.
+ */
+template <typename T, typename ChunkFn, typename CombineFn>
+T ParallelReduce(size_t begin, size_t end, size_t grain, T identity,
+                 ChunkFn&& chunk, CombineFn&& combine) {
+    if (end <= begin) return identity;
+    size_t n = end - begin;
+    if (grain == 0) grain = DefaultGrain(n);
+    if (n <= std::max(grain, kSerialThreshold) || ThreadPool::Global().Size() <= 1) {
+        return combine(identity, chunk(begin, end));
+    }
+
+    size_t chunks = (n + grain - 1) / grain;
+    // optional<T> keeps slots distinct objects (vector<bool> would pack bits and race)
+    std::vector<std::optional<T>> partials(chunks);
+    {
+        TaskGroup group;
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t lo = begin + c * grain;
+            size_t hi = std::min(end, lo + grain);
+            group.Run([&partials, &chunk, c, lo, hi] { partials[c] = chunk(lo, hi); });
+        }
+        group.Wait();
+    }
+
+    T result = identity;
+    for (auto& partial : partials) result = combine(std::move(result), *partial);
+    return result;
+}
+
+/**
+ * @brief ParallelReduce over [0, count) with ParallelForWork's weighted
+ *        serial cutoff and chunking; partials combine in index order
+ */
+template <typename T, typename ChunkFn, typename CombineFn>
+T ParallelReduceWork(size_t count, size_t work_per_item, T identity, ChunkFn&& chunk, CombineFn&& combine) {
+    size_t workers = ThreadPool::Global().Size();
+    size_t chunks = std::min(count, workers * kChunksPerWorker);
+    if (workers <= 1 || count * std::max<size_t>(work_per_item, 1) < kMinParallelWork) chunks = 1;
+    if (chunks <= 1) return count > 0 ? combine(identity, chunk(size_t{0}, count)) : identity;
+
+    std::vector<std::optional<T>> partials(chunks);
+    {
+        TaskGroup group;
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t lo = count * c / chunks, hi = count * (c + 1) / chunks;
+            group.Run([&partials, &chunk, c, lo, hi] { partials[c] = chunk(lo, hi); });
+        }
+        group.Wait();
+    }
+
+    T result = identity;
+    for (auto& partial : partials) result = combine(std::move(result), *partial);
+    return result;
+}
+
+/**
+ * @brief Parallel sort: sort chunks independently, then merge pairs of
+ *        runs in parallel rounds (log2(chunks) rounds)
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp = {}) {
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    size_t workers = ThreadPool::Global().Size();
+    if (n <= kSerialThreshold * 4 || workers <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    size_t chunks = std::min(workers * 2, n / kSerialThreshold);
+    size_t run = (n + chunks - 1) / chunks;
+
+    {
+        TaskGroup group;
+        for (size_t lo = 0; lo < n; lo += run) {
+            size_t hi = std::min(n, lo + run);
+            group.Run([=, &comp] { std::sort(first + lo, first + hi, comp); });
+        }
+        group.Wait();
+    }
+
+    for (; run < n; run *= 2) {
+        TaskGroup group;
+        for (size_t lo = 0; lo + run < n; lo += 2 * run) {
+            size_t mid = lo + run;
+            size_t hi = std::min(n, lo + 2 * run);
+            group.Run([=, &comp] { std::inplace_merge(first + lo, first + mid, first + hi, comp); });
+        }
+        group.Wait();
+    }
+}
+
+} // namespace Parallel
+} // namespace AXIOM
+
+#endif // PARALLEL_H
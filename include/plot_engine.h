@@ -6,6 +6,8 @@
 #pragma once
 
 #include "dynamic_calc_types.h"
+#include "level_of_detail.h"
+#include "plot_tile_cache.h"
 #include <functional>
 
 struct PlotConfig {
@@ -29,6 +31,8 @@ public:
     
     // Data plotting
     std::string PlotData(const Vector& x_data, const Vector& y_data, const PlotConfig& config = {});
+    // Zoom / pan over a long series: config's x range is answered from the pyramid
+    std::string PlotSeries(const LevelOfDetail::Pyramid& series, const PlotConfig& config = {});
     std::string Histogram(const Vector& data, int bins = 10, const PlotConfig& config = {});
     std::string BoxPlot(const Vector& data, const PlotConfig& config = {});
     
@@ -38,8 +42,18 @@ public:
     // Specialized plots  
     std::string PlotComplex(const Vector& real_parts, const Vector& imag_parts, const PlotConfig& config = {});
     std::string PolarPlot(const std::string& r_expression, const PlotConfig& config = {});
+
+    // PlotFunction and PlotSurface sample through a tile cache kept across calls
+    PlotCacheMetrics GetCacheMetrics() const { return tile_cache_.Metrics(); }
+    void ResetCacheMetrics() { tile_cache_.ResetMetrics(); }
+    PlotTileCache& TileCache() { return tile_cache_; }
     
 private:
     char GetCharForValue(double value, double min_val, double max_val);
     std::pair<int, int> MapToScreen(double x, double y, const PlotConfig& config);
+    // Joins consecutive samples (except across breaks[k] -> breaks[k] + 1), clipped to the window, and adds the axes
+    std::string Rasterize(const Vector& xs, const Vector& ys, const PlotConfig& config,
+                          const std::vector<size_t>& breaks = {});
+
+    PlotTileCache tile_cache_;
 };
\ No newline at end of file
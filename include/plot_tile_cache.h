@@ -0,0 +1,80 @@
+/**
+ * @file plot_tile_cache.h
+ * @brief Sampled-value tiles shared across pans and zooms of the same expression
+ *
+ * Zoom level z samples x (and, with its own level, y) at multiples of
+ * 2^-z, so every level is a fixed grid anchored at the origin and a view
+ * only decides which levels and which tiles it needs. A curve tile holds
+ * 256 consecutive samples and a surface tile 32 x 32. Tiles are keyed by
+ * (expression fingerprint, levels, tile x, tile y), so a pan evaluates only
+ * the tiles it newly exposes, and a return to an earlier view evaluates
+ * nothing.
+ *
+ * After serving a view the cache queues, on the shared pool, the tiles
+ * next to it and the tiles covering it one level coarser (a zoom out).
+ * Those prefetches never block a plot: a tile still in flight is simply
+ * evaluated again in the foreground. Tiles are evicted least recently
+ * used first.
+ */
+#pragma once
+
+#include "compiled_expression.h"
+#include "dynamic_calc_types.h"
+#include "surface_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+struct PlotCacheMetrics {
+    size_t hits = 0;            // Tiles a plot found in the cache
+    size_t misses = 0;          // Tiles a plot had to evaluate
+    size_t prefetched = 0;      // Tiles evaluated in the background
+    size_t prefetch_hits = 0;   // Hits on tiles a prefetch filled
+    size_t evictions = 0;
+    size_t resident = 0;        // Tiles held now
+
+    double HitRate() const {
+        size_t lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+class PlotTileCache {
+public:
+    static constexpr size_t kCurveTile = 256;    // Samples per curve tile
+    static constexpr size_t kSurfaceTile = 32;   // Samples per side of a surface tile
+
+    explicit PlotTileCache(size_t max_tiles = 2048);
+    ~PlotTileCache();   // Waits for queued prefetches
+
+    PlotTileCache(const PlotTileCache&) = delete;
+    PlotTileCache& operator=(const PlotTileCache&) = delete;
+
+    // Finest level whose spacing 2^-level is at most `spacing`
+    static int LevelFor(double spacing);
+
+    /**
+     * f(x) at every grid point of the level for `spacing` from just below
+     * x_min to just above x_max (non-finite values kept). False, with
+     * nothing sampled, for a range the tile grid cannot index.
+     */
+    bool SampleCurve(const CompiledExpression& f, double x_min, double x_max, double spacing, Vector& xs, Vector& ys);
+    /**
+     * Fills grid (spec as given) with f at the nearest dyadic point: x and y
+     * each use the level whose spacing is at most that axis's grid step, so
+     * a cell's value is f at a point within half a step of the cell on each
+     * axis (callers needing f exactly at the cells use Surface::Evaluate).
+     * Per-axis levels keep the tiles evaluated to under about four times the
+     * cells plus one tile border. False as above.
+     */
+    bool SampleSurface(const CompiledExpression& f, const GridSpec& spec, SurfaceGrid& grid);
+
+    void WaitForPrefetch();
+    void Clear();
+    PlotCacheMetrics Metrics() const;
+    void ResetMetrics();
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;   // Shared with queued prefetch tasks
+};
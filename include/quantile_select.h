@@ -0,0 +1,56 @@
+/**
+ * @file quantile_select.h
+ * @brief Selection-based order statistics and quantiles
+ *
+ * Quantiles are found by selection instead of sorting:
+ * - FloydRivestSelect: expected n + min(k, n-k) + o(n) comparisons
+ * - MultiSelect: k order statistics in one recursive partition pass,
+ *   O(n log k), in place on the caller's buffer
+ * - ParallelQuantiles: sample-bracketed parallel counting and gathering for
+ *   very large inputs; leaves the input untouched
+ *
+ * Quantile interpolation matches StatisticsEngine::Percentile (linear
+ * between order statistics floor(h) and floor(h)+1, h = p * (n - 1)).
+ * Inputs must not contain NaN.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Selection {
+
+/**
+ * @brief Reorder data[left..right] (inclusive) so data[k] is the k-th
+ *        smallest, with smaller-or-equal values before it and
+ *        greater-or-equal values after it
+ */
+void FloydRivestSelect(double* data, size_t left, size_t right, size_t k);
+
+/**
+ * @brief Place every rank in `ranks` (sorted ascending, unique) at its
+ *        sorted position; data[ranks[i]] then holds that order statistic
+ */
+void MultiSelect(double* data, size_t n, const size_t* ranks, size_t rank_count);
+
+/**
+ * @brief Quantiles for probabilities in [0, 1], computed in place
+ * @param out Receives one value per probability (same order as probs)
+ */
+void QuantilesInPlace(double* data, size_t n, const double* probs, size_t count, double* out);
+
+/**
+ * @brief Parallel quantiles for very large inputs (input is not modified)
+ *
+ * Order statistics are bracketed from a random sample, the elements inside
+ * each bracket are counted and gathered in one parallel pass, and the
+ * target is selected within the small gathered set. Falls back to a copy
+ * plus QuantilesInPlace when a bracket misses (rare) or many quantiles are
+ * requested.
+ */
+void ParallelQuantiles(const double* data, size_t n, const double* probs, size_t count, double* out);
+
+// Inputs at least this large use ParallelQuantiles from the engine entry points
+inline constexpr size_t kParallelSelectThreshold = size_t{1} << 20;
+
+} // namespace Selection
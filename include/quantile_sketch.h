@@ -0,0 +1,93 @@
+/**
+ * @file quantile_sketch.h
+ * @brief Mergeable streaming quantile sketches (t-digest and KLL)
+ *
+ * Both sketches summarize unbounded streams in bounded memory, merge
+ * exactly-associatively enough to combine partial sketches from workers
+ * or hosts, and serialize to a compact little-endian binary form:
+ * - TDigest: merging t-digest (log-odds k2 scale). Accuracy is set by the
+ *   compression (~centroid budget) and is best near the tails.
+ * - KLLSketch: Karnin-Lang-Liberty compactor hierarchy. Rank error is
+ *   about 1.65 / k, uniform over the distribution, with provable bounds.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class TDigest {
+public:
+    static constexpr double kMaxCompression = 5000.0;
+
+    // compression is clamped to [10, kMaxCompression]
+    explicit TDigest(double compression = 100.0);
+
+    void Add(double x, double weight = 1.0);
+    void AddRange(const double* data, size_t n);
+    void Merge(const TDigest& other);
+
+    double Quantile(double q) const;   // q in [0, 1]; NaN when empty
+    double CDF(double x) const;        // Fraction of weight <= x
+
+    double Count() const { return total_weight_; }
+    double Min() const { return min_; }
+    double Max() const { return max_; }
+    double Compression() const { return compression_; }
+    size_t CentroidCount() const;
+
+    std::vector<uint8_t> Serialize() const;
+    static std::optional<TDigest> Deserialize(const uint8_t* data, size_t size);
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void Flush() const;   // Fold the insertion buffer into the centroid list
+
+    double compression_;
+    mutable std::vector<Centroid> centroids_;
+    mutable std::vector<Centroid> buffer_;
+    double total_weight_ = 0.0;
+    double min_;
+    double max_;
+};
+
+class KLLSketch {
+public:
+    static constexpr uint32_t kMaxK = 1u << 16;
+
+    // k is clamped to [8, kMaxK]
+    explicit KLLSketch(uint32_t k = 200);
+
+    void Update(double x);
+    void UpdateRange(const double* data, size_t n);
+    void Merge(const KLLSketch& other);
+
+    double Quantile(double q) const;   // q in [0, 1]; NaN when empty
+    double Rank(double x) const;       // Normalized rank of x in [0, 1]
+
+    uint64_t Count() const { return n_; }
+    double Min() const { return min_; }
+    double Max() const { return max_; }
+    uint32_t K() const { return k_; }
+    size_t RetainedItems() const;
+
+    std::vector<uint8_t> Serialize() const;
+    static std::optional<KLLSketch> Deserialize(const uint8_t* data, size_t size);
+
+private:
+    size_t Capacity(size_t level) const;
+    void Compress();
+    std::vector<std::pair<double, uint64_t>> WeightedItems() const;   // Sorted by value
+
+    uint32_t k_;
+    uint64_t n_ = 0;
+    std::vector<std::vector<double>> levels_;   // Items at level h carry weight 2^h
+    double min_;
+    double max_;
+    uint64_t rng_state_ = 0x9E3779B97F4A7C15ULL;
+};
@@ -0,0 +1,122 @@
+/**
+ * @file quantity.h
+ * @brief Compile-time dimensioned quantities for C++ callers
+ *
+ * Quantity<D> is a double in SI base units whose dimension D is part of
+ * the type. Adding a length to a time, or passing a velocity where a force
+ * is expected, fails to compile. Multiplication and division derive the
+ * result dimension at compile time. A Quantity is exactly one double and
+ * every operation is constexpr, so the checks cost nothing at run time.
+ *
+ * Units are scale factors with a dimension:
+ *   auto v = 100.0 * Units::km / (2.0 * Units::h);   // Quantity<Velocity>
+ *   double mph = v.In(Units::mi / Units::h);          // 31.07...
+ * Temperatures here are absolute (kelvin scale); the offset scales C and
+ * F are converted by UnitManager.
+ */
+#pragma once
+
+#include "dimension.h"
+
+template <Dimension D>
+class Quantity;
+
+// A unit: SI base units per unit, e.g. 0.3048 for ft; units combine with * and /
+template <Dimension D>
+struct ScaledUnit {
+    double scale = 1.0;
+
+    template <Dimension E>
+    constexpr ScaledUnit<D * E> operator*(ScaledUnit<E> other) const { return {scale * other.scale}; }
+    template <Dimension E>
+    constexpr ScaledUnit<D / E> operator/(ScaledUnit<E> other) const { return {scale / other.scale}; }
+};
+
+template <Dimension D>
+class Quantity {
+public:
+    static constexpr Dimension kDimension = D;
+
+    constexpr Quantity() = default;
+    // value in SI base units
+    explicit constexpr Quantity(double si_value) : value_(si_value) {}
+
+    constexpr double Value() const { return value_; }
+    constexpr double In(ScaledUnit<D> unit) const { return value_ / unit.scale; }
+
+    // Only a dimensionless quantity is a plain number
+    constexpr operator double() const requires(D.IsDimensionless()) { return value_; }
+
+    constexpr Quantity operator-() const { return Quantity(-value_); }
+    constexpr Quantity& operator+=(Quantity other) { value_ += other.value_; return *this; }
+    constexpr Quantity& operator-=(Quantity other) { value_ -= other.value_; return *this; }
+    constexpr Quantity& operator*=(double k) { value_ *= k; return *this; }
+    constexpr Quantity& operator/=(double k) { value_ /= k; return *this; }
+
+    friend constexpr Quantity operator+(Quantity a, Quantity b) { return Quantity(a.value_ + b.value_); }
+    friend constexpr Quantity operator-(Quantity a, Quantity b) { return Quantity(a.value_ - b.value_); }
+    friend constexpr Quantity operator*(Quantity a, double k) { return Quantity(a.value_ * k); }
+    friend constexpr Quantity operator*(double k, Quantity a) { return Quantity(k * a.value_); }
+    friend constexpr Quantity operator/(Quantity a, double k) { return Quantity(a.value_ / k); }
+    friend constexpr auto operator<=>(Quantity a, Quantity b) = default;
+
+    template <Dimension E>
+    constexpr Quantity<D * E> operator*(Quantity<E> other) const { return Quantity<D * E>(value_ * other.Value()); }
+    template <Dimension E>
+    constexpr Quantity<D / E> operator/(Quantity<E> other) const { return Quantity<D / E>(value_ / other.Value()); }
+
+private:
+    double value_ = 0.0;
+};
+
+template <Dimension D>
+constexpr Quantity<D> operator*(double value, ScaledUnit<D> unit) { return Quantity<D>(value * unit.scale); }
+
+template <Dimension D>
+constexpr Quantity<Dimensions::Dimensionless / D> operator/(double value, Quantity<D> q) {
+    return Quantity<Dimensions::Dimensionless / D>(value / q.Value());
+}
+
+// Quantity of dimension D for a runtime value: UnitManager conversions meet typed code here
+template <Dimension D>
+constexpr Quantity<D> FromSI(double si_value) { return Quantity<D>(si_value); }
+
+namespace Quantities {
+
+using Dimensionless = Quantity<Dimensions::Dimensionless>;
+using Length = Quantity<Dimensions::Length>;
+using Mass = Quantity<Dimensions::Mass>;
+using Time = Quantity<Dimensions::Time>;
+using Current = Quantity<Dimensions::Current>;
+using Temperature = Quantity<Dimensions::Temperature>;
+using Area = Quantity<Dimensions::Area>;
+using Volume = Quantity<Dimensions::Volume>;
+using Frequency = Quantity<Dimensions::Frequency>;
+using Velocity = Quantity<Dimensions::Velocity>;
+using Acceleration = Quantity<Dimensions::Acceleration>;
+using Force = Quantity<Dimensions::Force>;
+using Energy = Quantity<Dimensions::Energy>;
+using Power = Quantity<Dimensions::Power>;
+using Pressure = Quantity<Dimensions::Pressure>;
+
+} // namespace Quantities
+
+// Scale factors match UnitManager's table
+namespace Units {
+
+inline constexpr ScaledUnit<Dimensions::Length> m{1.0}, km{1000.0}, cm{0.01}, mm{0.001};
+inline constexpr ScaledUnit<Dimensions::Length> ft{0.3048}, in{0.0254}, yd{0.9144}, mi{1609.344};
+inline constexpr ScaledUnit<Dimensions::Mass> kg{1.0}, g{0.001}, t{1000.0}, lb{0.453592}, oz{0.0283495};
+inline constexpr ScaledUnit<Dimensions::Time> s{1.0}, min{60.0}, h{3600.0}, day{86400.0};
+inline constexpr ScaledUnit<Dimensions::Current> A{1.0};
+inline constexpr ScaledUnit<Dimensions::Temperature> K{1.0};
+inline constexpr ScaledUnit<Dimensions::Volume> L{0.001};
+inline constexpr ScaledUnit<Dimensions::Frequency> Hz{1.0};
+inline constexpr ScaledUnit<Dimensions::Force> N{1.0};
+inline constexpr ScaledUnit<Dimensions::Energy> J{1.0};
+inline constexpr ScaledUnit<Dimensions::Power> W{1.0};
+inline constexpr ScaledUnit<Dimensions::Pressure> Pa{1.0};
+
+} // namespace Units
+
+static_assert(sizeof(Quantities::Velocity) == sizeof(double), "Quantity must stay a bare double");
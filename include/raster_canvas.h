@@ -0,0 +1,85 @@
+/**
+ * @file raster_canvas.h
+ * @brief Reusable RGB pixel buffer with anti-aliased drawing and PGM/PPM/PNG encoding
+ *
+ * Coordinates are in pixels with pixel (i, j) centred on (i, j), row 0 at
+ * the top. Lines use Wu's algorithm (two coverage-weighted pixels per step
+ * along the major axis) after being clipped to the drawable area, so even
+ * a segment running to 1e16 costs only the pixels it crosses.
+ *
+ * All drawing, including Clear(), is limited to the clip columns. A plot
+ * that pans by whole pixels scrolls the buffer, clips to the exposed strip
+ * and redraws only that.
+ *
+ * The encoders need no external libraries: PNG output uses zlib "stored"
+ * deflate blocks (no compression) with the CRC-32 and Adler-32 checksums
+ * the format requires.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Rgb {
+    uint8_t r = 0, g = 0, b = 0;
+
+    bool operator==(const Rgb& other) const { return r == other.r && g == other.g && b == other.b; }
+};
+
+class RasterCanvas {
+public:
+    RasterCanvas() = default;
+    RasterCanvas(size_t width, size_t height) { Resize(width, height); }
+
+    // Keeps the allocation when the size shrinks; resets the clip
+    void Resize(size_t width, size_t height);
+    size_t Width() const { return width_; }
+    size_t Height() const { return height_; }
+    // RGB, row-major, top row first
+    const std::vector<uint8_t>& Pixels() const { return pixels_; }
+    Rgb At(size_t x, size_t y) const;
+
+    // Drawing touches columns [x0, x1) only
+    void SetClip(size_t x0, size_t x1);
+    void ResetClip() { SetClip(0, width_); }
+
+    void Clear(Rgb color);
+    // Mixes color into the pixel with weight coverage (0..1); ignored outside the clip
+    void Blend(long x, long y, Rgb color, double coverage);
+    void FillRect(long x0, long y0, long x1, long y1, Rgb color);   // [x0, x1) x [y0, y1)
+    void DrawLine(double x0, double y0, double x1, double y1, Rgb color, double opacity = 1.0);
+    // Consecutive points joined except across breaks[k] -> breaks[k] + 1 (ascending)
+    void DrawPolyline(const double* xs, const double* ys, size_t n, Rgb color,
+                      const std::vector<size_t>& breaks = {});
+    // Area between the polyline (x ascending) and the row `baseline`, edges anti-aliased
+    void FillToBaseline(const double* xs, const double* ys, size_t n, double baseline, Rgb color, double opacity,
+                        const std::vector<size_t>& breaks = {});
+    // rgb (width x height, as from Surface::Colorize) stretched over the canvas, nearest neighbour
+    void DrawImage(const uint8_t* rgb, size_t width, size_t height);
+
+    // Moves the content dx columns right (left if negative); uncovered columns keep stale pixels
+    void ScrollColumns(long dx);
+
+private:
+    size_t width_ = 0;
+    size_t height_ = 0;
+    size_t clip_x0_ = 0;
+    size_t clip_x1_ = 0;
+    std::vector<uint8_t> pixels_;
+};
+
+namespace RasterImage {
+
+enum class Format { PGM, PPM, PNG };
+
+// PGM stores luma (Rec. 601 weights); PPM and PNG store RGB
+std::vector<uint8_t> Encode(const RasterCanvas& canvas, Format format);
+bool Write(const RasterCanvas& canvas, Format format, const std::string& path);
+
+// Checksums used by the PNG encoder (exposed for tests)
+uint32_t Crc32(const uint8_t* data, size_t n, uint32_t crc = 0);
+uint32_t Adler32(const uint8_t* data, size_t n, uint32_t adler = 1);
+
+} // namespace RasterImage
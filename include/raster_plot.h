@@ -0,0 +1,86 @@
+/**
+ * @file raster_plot.h
+ * @brief Interactive raster plot of y = f(x) that re-renders only what a pan or zoom changed
+ *
+ * RasterFunctionPlot keeps its canvas and its adaptive samples between
+ * renders:
+ * - A pan by a whole number of pixels at the same scale scrolls the canvas,
+ *   samples only the newly exposed x strip and redraws only those columns
+ *   (plus two at the seam, where the new segments meet the old ones).
+ * - Any other change (zoom, new y range, new size) redraws everything, but
+ *   seeds the sampler with the cached points, so a zoom out evaluates only
+ *   the new margins and a zoom in only refines between known points.
+ *
+ * RenderHeatmap() evaluates f(x, y) once per pixel and draws it through a
+ * Surface colormap.
+ *
+ * Samples map to pixels as in PlotEngine: x_min / x_max fall on the centres
+ * of the first / last column and y_max / y_min on the top / bottom row.
+ */
+#pragma once
+
+#include "compiled_expression.h"
+#include "curve_sampling.h"
+#include "raster_canvas.h"
+#include "surface_grid.h"
+#include <optional>
+#include <string>
+
+struct RasterView {
+    double x_min = -10;
+    double x_max = 10;
+    double y_min = -5;
+    double y_max = 5;
+    size_t width = 800;
+    size_t height = 600;
+};
+
+struct RasterStyle {
+    Rgb background{255, 255, 255};
+    Rgb axes{160, 160, 160};
+    Rgb line{31, 119, 180};
+    Rgb fill{31, 119, 180};
+    double fill_opacity = 0.0;   // Area between the curve and y = 0; 0 draws none
+};
+
+class RasterFunctionPlot {
+public:
+    // expression in x; nullopt (and *error set) if it does not compile
+    static std::optional<RasterFunctionPlot> Create(const std::string& expression, const RasterStyle& style = {},
+                                                    std::string* error = nullptr);
+
+    // Brings the canvas to `view`; returns the number of columns redrawn (0 for an unchanged or empty view)
+    size_t Render(const RasterView& view);
+    // Redraws the current view from the cached samples without evaluating anything
+    void Redraw();
+
+    const RasterCanvas& Canvas() const { return canvas_; }
+    const RasterView& View() const { return view_; }
+    const CurveSampling::Curve& Samples() const { return samples_; }
+    // Points evaluated over all renders so far
+    size_t Evaluations() const { return evaluations_; }
+
+private:
+    RasterFunctionPlot(CompiledExpression expression, const RasterStyle& style)
+        : expression_(std::move(expression)), style_(style) {}
+
+    CurveSampling::Options SamplingOptions(size_t x_pixels) const;
+    size_t RenderAll(const RasterView& view);
+    size_t Pan(const RasterView& view, long shift);
+    void DrawColumns(size_t c0, size_t c1);
+    double PixelX(double x) const;
+    double PixelY(double y) const;
+
+    CompiledExpression expression_;
+    RasterStyle style_;
+    RasterCanvas canvas_;
+    RasterView view_;
+    bool rendered_ = false;
+    CurveSampling::Curve samples_;
+    size_t evaluations_ = 0;
+};
+
+// f(x, y) over the view, one grid point per pixel; nullopt if it does not compile or the view is empty
+std::optional<RasterCanvas> RenderHeatmap(const std::string& expression, const RasterView& view,
+                                          Surface::Colormap colormap = Surface::Colormap::Viridis,
+                                          std::string* error = nullptr);
@@ -0,0 +1,136 @@
+/**
+ * @file resampling.h
+ * @brief Parallel bootstrap confidence intervals and permutation tests
+ *
+ * Every resample b draws from its own Philox4x32-10 stream keyed by the
+ * seed with b in the counter (Salmon et al., SC'11), so the replicates, and
+ * therefore every interval and p-value, are identical for a given seed at
+ * any thread count or chunking. Resamples are split over the shared pool in
+ * contiguous ranges.
+ *
+ * Moment statistics are folded straight into a MomentAccumulator (paired
+ * ones into a CoMomentAccumulator) one small stack block at a time, so no
+ * resample is ever materialized. Only a caller-supplied statistic needs
+ * the full resample, in a buffer reused per worker.
+ */
+#pragma once
+
+#include "dynamic_calc_types.h"
+#include "moment_accumulator.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace Resampling {
+
+inline constexpr uint64_t kDefaultSeed = 0x5EED0F0A7C0FFEEULL;
+// Upper bound on resamples / permutations per call (replicates are kept)
+inline constexpr size_t kMaxResamples = 10'000'000;
+
+/**
+ * @brief Counter-based generator: block b of stream s is Philox(key, {b, s})
+ */
+class PhiloxStream {
+public:
+    PhiloxStream(uint64_t seed, uint64_t stream);
+
+    uint32_t Next32() {
+        if (used_ == 4) Refill();
+        return block_[used_++];
+    }
+    uint64_t Next64() {
+        uint64_t hi = Next32();
+        return (hi << 32) | Next32();
+    }
+    // Uniform in [0, bound) without modulo bias (Lemire's multiply-shift); bound > 0
+    uint64_t Below(uint64_t bound) {
+        if (bound > 0xFFFFFFFFull) return BelowWide(bound);
+        uint32_t b = static_cast<uint32_t>(bound);
+        uint64_t m = uint64_t{Next32()} * b;
+        if (static_cast<uint32_t>(m) < b) {
+            uint32_t threshold = (0u - b) % b;
+            while (static_cast<uint32_t>(m) < threshold) m = uint64_t{Next32()} * b;
+        }
+        return m >> 32;
+    }
+    // Uniform in [0, 1) with 53 random bits
+    double Uniform() { return static_cast<double>(Next64() >> 11) * 0x1.0p-53; }
+
+    // One Philox4x32-10 block
+    static std::array<uint32_t, 4> Block(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key);
+
+private:
+    void Refill();
+    uint64_t BelowWide(uint64_t bound);
+
+    std::array<uint32_t, 2> key_;
+    std::array<uint32_t, 4> counter_;   // {block lo, block hi, stream lo, stream hi}
+    std::array<uint32_t, 4> block_{};
+    unsigned used_ = 4;
+};
+
+// Computed from one MomentAccumulator per resample
+enum class Statistic { Mean, Variance, StdDev, Skewness, Kurtosis };
+// Computed from one CoMomentAccumulator per resample of (x, y) rows
+enum class PairStatistic { Correlation, Covariance, Slope };
+// Permutation test statistics: two-sided for two groups, upper tail for F
+enum class TestStatistic { MeanDifference, WelchT, FStatistic };
+
+// Caller-supplied statistic over one resample (a scratch buffer it may
+// reorder); must be safe to call concurrently
+using StatisticFn = std::function<double(double* data, size_t n)>;
+
+struct BootstrapOptions {
+    size_t resamples = 2000;
+    double confidence = 0.95;
+    uint64_t seed = kDefaultSeed;
+};
+
+struct BootstrapResult {
+    double estimate = 0.0;         // Statistic of the original sample
+    double standard_error = 0.0;   // Standard deviation of the replicates
+    double bias = 0.0;             // Replicate mean minus the estimate
+    double lower = 0.0;            // Percentile interval at options.confidence
+    double upper = 0.0;
+    Vector replicates;             // One per resample, in resample order
+};
+
+struct PermutationOptions {
+    size_t permutations = 9999;
+    uint64_t seed = kDefaultSeed;
+};
+
+struct PermutationResult {
+    double observed = 0.0;
+    double p_value = 1.0;          // (extreme + 1) / (permutations + 1)
+    uint64_t extreme = 0;          // Permutations at least as extreme as observed
+    uint64_t permutations = 0;
+};
+
+// nullopt for n < 2, resamples outside [1, kMaxResamples], or confidence
+// outside (0, 1). NaN replicates are kept in `replicates` but left out of
+// the summary.
+std::optional<BootstrapResult> Bootstrap(const double* x, size_t n, Statistic stat,
+                                         const BootstrapOptions& options = {});
+std::optional<BootstrapResult> Bootstrap(const double* x, size_t n, const StatisticFn& stat,
+                                         const BootstrapOptions& options = {});
+// Rows (x[i], y[i]) are resampled together
+std::optional<BootstrapResult> BootstrapPaired(const double* x, const double* y, size_t n, PairStatistic stat,
+                                               const BootstrapOptions& options = {});
+
+// Group labels are shuffled across the pooled values. MeanDifference and
+// WelchT need exactly two groups of at least two values; FStatistic needs
+// two or more non-empty groups with more values than groups, and
+// permutations must lie in [1, kMaxResamples].
+std::optional<PermutationResult> PermutationTest(const std::vector<const Vector*>& groups, TestStatistic stat,
+                                                 const PermutationOptions& options = {});
+
+// Test statistics from per-group moments (also behind StatisticsEngine::TTest / ANOVAOneWay)
+double WelchT(const MomentAccumulator& a, const MomentAccumulator& b);
+double WelchDegreesOfFreedom(const MomentAccumulator& a, const MomentAccumulator& b);
+double FStatistic(const MomentAccumulator* groups, size_t k);
+
+} // namespace Resampling
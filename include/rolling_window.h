@@ -0,0 +1,153 @@
+/**
+ * @file rolling_window.h
+ * @brief O(n) sliding-window statistics, batch and streaming
+ *
+ * Batch functions take n inputs and a window w and write n - w + 1 outputs
+ * (output i covers x[i .. i + w - 1]). They split the output into segments
+ * that are processed independently on the shared pool; each segment starts
+ * from an exactly computed window, which also bounds drift from the
+ * incremental updates:
+ * - Mean: SIMD prefix sums of values shifted by the segment's first value
+ * - Variance / StdDev: Welford add/remove (sample variance, w >= 2)
+ * - Min / Max: monotonic deques, amortized O(1) per step
+ * - Median: two balanced halves (multisets), O(log w) per step
+ *
+ * An inf in the input makes only the windows containing it non-finite
+ * (Mean gives +-inf or NaN, Variance NaN); the following windows are exact
+ * again.
+ *
+ * The streaming classes accept one value at a time and answer for the most
+ * recent w values (or fewer, until the window fills).
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace Rolling {
+
+// Batch entry points; out must hold n - w + 1 values (requires 1 <= w <= n)
+void Mean(const double* x, size_t n, size_t w, double* out);
+void Variance(const double* x, size_t n, size_t w, double* out);
+void StdDev(const double* x, size_t n, size_t w, double* out);
+void Min(const double* x, size_t n, size_t w, double* out);
+void Max(const double* x, size_t n, size_t w, double* out);
+void Median(const double* x, size_t n, size_t w, double* out);
+
+// Exponentially weighted mean / variance; out holds n values
+void EWMAMean(const double* x, size_t n, double alpha, double* out);
+void EWMAVariance(const double* x, size_t n, double alpha, double* out);
+
+// alpha for a given half-life (in samples) or pandas-style span
+inline double AlphaFromHalfLife(double half_life) { return 1.0 - std::exp2(-1.0 / half_life); }
+inline double AlphaFromSpan(double span) { return 2.0 / (span + 1.0); }
+
+/**
+ * @brief Counts of inf / NaN values in a window; a window's mean is decided
+ *        by these alone once it holds any of them
+ */
+struct NonFiniteCounts {
+    size_t nan = 0;
+    size_t pos_inf = 0;
+    size_t neg_inf = 0;
+
+    void Add(double v, int step) {
+        size_t& count = std::isnan(v) ? nan : (v > 0 ? pos_inf : neg_inf);
+        count += static_cast<size_t>(step);
+    }
+    bool Any() const { return nan + pos_inf + neg_inf > 0; }
+};
+
+/**
+ * @brief Streaming mean / variance over the last w values
+ */
+class MomentWindow {
+public:
+    explicit MomentWindow(size_t w);
+
+    void Push(double x);
+    size_t Count() const { return count_; }
+    bool Full() const { return count_ == ring_.size(); }
+    double Mean() const;
+    double Variance() const;   // Sample variance of the current window
+    double StdDev() const;
+
+private:
+    void Resync();
+
+    std::vector<double> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    size_t since_resync_ = 0;
+    NonFiniteCounts non_finite_;   // Inf / NaN values currently in the window
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+};
+
+/**
+ * @brief Streaming min / max over the last w values
+ */
+class ExtremaWindow {
+public:
+    explicit ExtremaWindow(size_t w) : window_(w) {}
+
+    void Push(double x);
+    double Min() const { return min_.front().second; }   // Requires at least one value
+    double Max() const { return max_.front().second; }
+
+private:
+    size_t window_;
+    uint64_t index_ = 0;
+    std::deque<std::pair<uint64_t, double>> min_;   // Increasing values
+    std::deque<std::pair<uint64_t, double>> max_;   // Decreasing values
+};
+
+/**
+ * @brief Streaming median over the last w values
+ */
+class MedianWindow {
+public:
+    explicit MedianWindow(size_t w);
+
+    void Push(double x);
+    size_t Count() const { return low_.size() + high_.size(); }
+    double Median() const;   // Requires at least one value
+
+private:
+    void Insert(double x);
+    void Erase(double x);
+    void Rebalance();
+
+    std::vector<double> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    std::multiset<double> low_;    // Lower half; holds the extra element when odd
+    std::multiset<double> high_;
+};
+
+/**
+ * @brief Streaming exponentially weighted mean and variance
+ */
+class EWMA {
+public:
+    explicit EWMA(double alpha) : alpha_(alpha) {}
+
+    void Push(double x);
+    bool Empty() const { return !seeded_; }
+    double Mean() const { return mean_; }
+    double Variance() const { return variance_; }
+    double StdDev() const;
+
+private:
+    double alpha_;
+    bool seeded_ = false;
+    double mean_ = 0.0;
+    double variance_ = 0.0;
+};
+
+} // namespace Rolling
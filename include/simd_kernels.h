@@ -0,0 +1,95 @@
+/**
+ * @file simd_kernels.h
+ * @brief Runtime-dispatched SIMD kernels for the numeric hot paths
+ *
+ * Each kernel is compiled for several ISA levels (scalar, AVX2+FMA,
+ * AVX-512F) in one translation unit via target attributes. The table
+ * returned by Kernels() is resolved once from CPUOptimization::GetISALevel(),
+ * so callers pay one indirect call and the build needs no -march flag.
+ */
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include "cpu_optimization.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace AXIOM {
+namespace SIMD {
+
+/**
+ * @brief Function-pointer table for the selected ISA level
+ */
+struct KernelTable {
+    // Reductions
+    double (*sum)(const double* data, size_t n);
+    double (*dot)(const double* x, const double* y, size_t n);
+    double (*sum_sq_dev)(const double* data, size_t n, double center);   // sum (x - c)^2
+    void (*minmax)(const double* data, size_t n, double* min_out, double* max_out);
+
+    // Compensated (Kahan-Babuska / Neumaier, per lane) variants of the above.
+    // Each result is an unfolded (sum, compensation) pair so callers can keep
+    // combining partials without rounding: sum_kb / sum_sq_dev_kb write
+    // out[0..1]; central_moments_kb writes the (x-c)^2 pair to out[0..1] and
+    // plain sums of (x-c)^3 and (x-c)^4 to out[2..3]; co_dev_kb writes pairs
+    // for (x-cx)^2, (y-cy)^2 and (x-cx)(y-cy) to out[0..5].
+    void (*sum_kb)(const double* data, size_t n, double* out);
+    void (*sum_sq_dev_kb)(const double* data, size_t n, double center, double* out);
+    void (*central_moments_kb)(const double* data, size_t n, double center, double* out);
+    void (*co_dev_kb)(const double* x, const double* y, size_t n, double cx, double cy, double* out);
+
+    // C[M x N] = A[M x K] * B[K x N], row-major, C is overwritten
+    void (*gemm)(const double* A, const double* B, double* C, size_t M, size_t K, size_t N);
+
+    // y[i] = coeffs[0] + coeffs[1]*x[i] + ... + coeffs[degree]*x[i]^degree
+    void (*poly_eval)(const double* coeffs, size_t degree, const double* x, double* y, size_t n);
+
+    // y[i] = a * x[i] + b (also the affine unit-conversion kernel)
+    void (*affine)(const double* x, double* y, size_t n, double a, double b);
+
+    // Inclusive scan: out[i] = sum_{j <= i} (x[j] - shift); shifting by a
+    // representative value keeps window differences well conditioned
+    void (*prefix_sum)(const double* x, double* out, size_t n, double shift);
+
+    // Elementwise y[i] = exp(x[i]) / log(x[i]); within a few ulp of libm,
+    // including inf / NaN / zero / subnormal handling
+    void (*exp)(const double* x, double* y, size_t n);
+    void (*log)(const double* x, double* y, size_t n);
+
+    // Normal density and distribution function (vectorized erfc)
+    void (*normal_pdf)(const double* x, double* y, size_t n, double mean, double sd);
+    void (*normal_cdf)(const double* x, double* y, size_t n, double mean, double sd);
+
+    // Histogram bin of each x: 0 below the range, 1..bins inside, bins + 1
+    // above, bins + 2 NaN; the upper limit belongs to the last bin.
+    // bin_uniform splits [lo, hi] at fma(i, (hi - lo) / bins, lo) (multiply and
+    // floor, then a one-step fix-up against those edges); bin_edges takes
+    // ascending edges[0..bins], counting them with vector compares when
+    // there are few and binary-searching branch-free otherwise
+    void (*bin_uniform)(const double* x, uint32_t* index, size_t n, double lo, double hi, uint32_t bins);
+    void (*bin_edges)(const double* x, uint32_t* index, size_t n, const double* edges, uint32_t bins);
+
+    // Reported by CPUOptimization::GetCPUInfo()
+    const char* reduction_path;
+    const char* gemm_path;
+    const char* batch_eval_path;
+    const char* special_path;
+    const char* binning_path;
+};
+
+/**
+ * @brief Kernel table for this host (resolved on first call, thread-safe)
+ */
+const KernelTable& Kernels();
+
+/**
+ * @brief Kernel table for one ISA level, ignoring AXIOM_ISA (for tests and
+ *        benchmarks); nullptr when this host cannot run that level
+ */
+const KernelTable* KernelsFor(ISALevel level);
+
+} // namespace SIMD
+} // namespace AXIOM
+
+#endif // SIMD_KERNELS_H
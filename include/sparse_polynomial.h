@@ -0,0 +1,101 @@
+/**
+ * @file sparse_polynomial.h
+ * @brief Sparse multivariate polynomials over packed exponent monomials
+ *
+ * A polynomial is a vector of (monomial, coefficient) terms sorted in
+ * descending lexicographic order. A monomial packs up to eight exponents
+ * (0..255) into one 64-bit word, first variable in the top byte, so
+ * comparing two monomials is one integer compare and multiplying them is
+ * one integer add. Products use Johnson's heap merge: result terms come
+ * out already sorted and equal monomials are summed as they meet, with no
+ * hash table and no final sort. Large products whose exponent box is small
+ * relative to the number of term pairs use Kronecker substitution instead:
+ * each monomial becomes an index into a dense accumulator.
+ *
+ * Parse() reads the polynomial subset of CompiledExpression's syntax (+,
+ * -, *, division by constants, non-negative integer powers, implicit
+ * multiplication, pi / e / phi) and expands as it goes: "(x + y + z)^20"
+ * becomes its 231 terms in a few hundred microseconds. Constant
+ * subexpressions take any real power ("2^-1" is 0.5).
+ *
+ * Coefficients are doubles. Integer coefficients are exact up to 2^53;
+ * past that they round (C(60, 30) in (1 + x)^60 is about 1.18e17), and
+ * IsExact() reports it. ToString() prints such coefficients with 15
+ * significant digits, so they never read as exact integers.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class SparsePolynomial {
+public:
+    static constexpr size_t kMaxVariables = 8;
+    static constexpr unsigned kMaxExponent = 255;
+    // Products and powers stop once the result passes this many terms (16 MB)
+    static constexpr size_t kMaxTerms = size_t{1} << 20;
+
+    struct Term {
+        uint64_t monomial;
+        double coefficient;
+    };
+
+    // The zero polynomial
+    SparsePolynomial() = default;
+
+    static SparsePolynomial Constant(double value);
+    static SparsePolynomial Variable(const std::string& name);
+
+    /**
+     * @param error Receives a short reason when the text is not a polynomial
+     *              (functions, division by a variable, more than kMaxVariables)
+     */
+    static std::optional<SparsePolynomial> Parse(std::string_view text, std::string* error = nullptr);
+
+    // Operands over different variables are first rewritten over the union of both;
+    // nullopt when that exceeds kMaxVariables or an exponent would exceed kMaxExponent;
+    // Multiply and Pow also give up past kMaxTerms result terms
+    static std::optional<SparsePolynomial> Add(const SparsePolynomial& a, const SparsePolynomial& b);
+    static std::optional<SparsePolynomial> Subtract(const SparsePolynomial& a, const SparsePolynomial& b);
+    static std::optional<SparsePolynomial> Multiply(const SparsePolynomial& a, const SparsePolynomial& b);
+    // Repeated multiplication by the base: the heap stays the size of the base, and for
+    // dense results this touches far fewer term pairs than squaring
+    static std::optional<SparsePolynomial> Pow(const SparsePolynomial& base, unsigned exponent);
+    SparsePolynomial Scaled(double factor) const;
+
+    // Sorted variable names; monomial byte k (from the top) is the exponent of Variables()[k]
+    const std::vector<std::string>& Variables() const { return variables_; }
+    // Descending lexicographic order, no zero coefficients
+    const std::vector<Term>& Terms() const { return terms_; }
+    size_t TermCount() const { return terms_.size(); }
+    bool IsZero() const { return terms_.empty(); }
+    // Constant polynomial (including zero); value in *value
+    bool IsConstant(double* value = nullptr) const;
+    unsigned TotalDegree() const;
+    // False when a coefficient exceeds 2^53, where integer coefficients may have rounded
+    bool IsExact() const;
+
+    static unsigned Exponent(uint64_t monomial, size_t variable) {
+        return static_cast<unsigned>(monomial >> (8 * (kMaxVariables - 1 - variable))) & 0xFF;
+    }
+
+    // values holds one value per entry of Variables()
+    double Evaluate(const double* values) const;
+    // "x^2 + 2*x*y + y^2"; "0" for zero
+    std::string ToString() const;
+
+private:
+    // Same polynomial over `variables`, a sorted superset of variables_
+    SparsePolynomial Over(const std::vector<std::string>& variables) const;
+    // Largest exponent of each variable over all terms, one per byte
+    uint64_t ExponentBounds() const;
+    // Sorted union of both variable lists; nullopt beyond kMaxVariables
+    static std::optional<std::vector<std::string>> MergedVariables(const SparsePolynomial& a, const SparsePolynomial& b);
+
+    std::vector<std::string> variables_;
+    std::vector<Term> terms_;
+};
@@ -5,26 +5,56 @@
  */
 #pragma once
 
+#include "distributions.h"
 #include "dynamic_calc_types.h"
+#include "moment_accumulator.h"
+#include "resampling.h"
 #include <algorithm>
 #include <numeric>
+#include <span>
 #include <vector>
 
 class StatisticsEngine {
 public:
+    // Single-pass compensated moments (parallel over chunks, merged in order)
+    static MomentAccumulator Accumulate(const double* data, size_t n);
+    static MomentAccumulator Accumulate(const Vector& data) { return Accumulate(data.data(), data.size()); }
+    
+    // Single-pass compensated co-moments (count, means, m2x, m2y, cxy)
+    static CoMomentAccumulator AccumulatePairs(const Vector& x, const Vector& y);
+
+    // [count, mean, variance, std_dev, skewness, kurtosis, min, max] in one pass
+    EngineResult Describe(const Vector& data);
+
     // Descriptive Statistics
     EngineResult Mean(const Vector& data);
-    EngineResult Median(Vector data);  // Note: modifies input for sorting
+    EngineResult Median(const Vector& data);
+    // The most frequent value; all of them, ascending, as a Vector on a tie
     EngineResult Mode(const Vector& data);
     EngineResult Variance(const Vector& data);
     EngineResult StandardDeviation(const Vector& data);
     EngineResult Skewness(const Vector& data);
     EngineResult Kurtosis(const Vector& data);
     
-    // Percentiles and Quantiles  
-    EngineResult Percentile(Vector data, double p);
-    EngineResult Quartiles(Vector data);
-    EngineResult InterquartileRange(Vector data);
+    // Percentiles and Quantiles (selection-based, no full sort)
+    EngineResult Percentile(const Vector& data, double p);
+    EngineResult Quartiles(const Vector& data);
+    EngineResult InterquartileRange(const Vector& data);
+    // Quantiles for probabilities in [0, 1]; large inputs are selected in parallel without a copy
+    EngineResult Quantiles(const Vector& data, const Vector& probabilities);
+    // Same, but reorders the caller's buffer instead of copying it
+    static EngineResult QuantilesInPlace(std::span<double> buffer, const Vector& probabilities);
+    
+    // Bin counts (shared SIMD binning, see binning.h): uniform bins over the
+    // finite data range, or explicit ascending edges; NaN / outside values are not counted
+    EngineResult HistogramCounts(const Vector& data, int bins);
+    EngineResult HistogramCounts(const Vector& data, const Vector& edges);
+    
+    // Frequency tables (frequency_table.h); NaN is not counted
+    // [[value, count], ...] by descending count, ties by ascending value
+    EngineResult ValueCounts(const Vector& data);
+    // Counts of (x, y) pairs; rows follow ascending distinct x, columns distinct y
+    EngineResult CrossTabulate(const Vector& x, const Vector& y);
     
     // Correlation and Regression
     EngineResult Correlation(const Vector& x, const Vector& y);
@@ -36,13 +66,43 @@ public:
     EngineResult NormalCDF(double x, double mean = 0, double stddev = 1);
     EngineResult TDistributionPDF(double x, double degrees_freedom);
     EngineResult ChiSquaredPDF(double x, double degrees_freedom);
+    // Array in, array out for one distribution; invalid parameters give DomainError
+    EngineResult DistributionPDF(const Distributions::Distribution& dist, const Vector& x);
+    EngineResult DistributionCDF(const Distributions::Distribution& dist, const Vector& x);
+    EngineResult DistributionQuantile(const Distributions::Distribution& dist, const Vector& p);
     
     // Hypothesis Testing
+    // Welch two-sample t: [t, degrees of freedom, two-sided p]
     EngineResult TTest(const Vector& sample1, const Vector& sample2);
+    // Pearson chi-squared [statistic, df, p]: goodness of fit against expected,
+    // or independence (expected from the margins) when expected is empty
     EngineResult ChiSquaredTest(const Matrix& observed, const Matrix& expected);
+    // Independence of two categorical columns through their contingency table
+    EngineResult ChiSquaredTest(const Vector& x, const Vector& y);
+    // [F, between-group df, within-group df, p]
     EngineResult ANOVAOneWay(const std::vector<Vector>& groups);
     
-    // Time Series
+    // Resampling (resampling.h); reproducible for a seed at any thread count
+    // Bootstrap percentile interval: [estimate, lower, upper, standard_error]
+    EngineResult BootstrapCI(const Vector& data, Resampling::Statistic stat,
+                             const Resampling::BootstrapOptions& options = {});
+    EngineResult BootstrapCI(const Vector& data, const Resampling::StatisticFn& stat,
+                             const Resampling::BootstrapOptions& options = {});
+    EngineResult BootstrapCI(const Vector& x, const Vector& y, Resampling::PairStatistic stat,
+                             const Resampling::BootstrapOptions& options = {});
+    // [observed statistic, p]
+    EngineResult PermutationTest(const std::vector<Vector>& groups, Resampling::TestStatistic stat,
+                                 const Resampling::PermutationOptions& options = {});
+    
+    // Time Series (O(n) sliding windows; element i covers data[i .. i + window_size))
     EngineResult MovingAverage(const Vector& data, int window_size);
+    EngineResult RollingVariance(const Vector& data, int window_size);
+    EngineResult RollingStdDev(const Vector& data, int window_size);
+    EngineResult RollingMin(const Vector& data, int window_size);
+    EngineResult RollingMax(const Vector& data, int window_size);
+    EngineResult RollingMedian(const Vector& data, int window_size);
+    
+    // Exponentially weighted mean / variance, alpha in (0, 1]; one value per input
     EngineResult ExponentialSmoothing(const Vector& data, double alpha);
+    EngineResult EWMAVariance(const Vector& data, double alpha);
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file statistics_parser.h
+ * @brief Statistics mode commands over loaded data columns
+ *
+ *   load PATH [as NAME]        mmap + parse a CSV/TSV (or reuse its cache)
+ *   tables / columns [NAME]    list loaded tables / a table's columns
+ *   OP ARG...                  run an operation on columns or [1,2,3] lists
+ *   regress(y ~ x1 + x2)       multiple regression (add "- 1" to drop the intercept)
+ *   hist X [BINS | [EDGES]]    bin counts (uniform over the data range by default)
+ *   hist2 X Y [XBINS [YBINS]]  2-D counts as a matrix (rows follow X bins)
+ *   pdf|cdf|invcdf DIST P... X distribution functions at a number, list or column;
+ *                              DIST is normal m s | t df | chi2 df | gamma k theta |
+ *                              beta a b | binomial n p
+ *   ttest X Y / anova X Y...   Welch t [t, df, p] / one-way ANOVA [F, df1, df2, p]
+ *   bootstrap STAT X [Y] [B [LEVEL]]
+ *                              percentile interval [estimate, lower, upper, se];
+ *                              STAT is mean | var | std | skew | kurt | median,
+ *                              or corr | cov | slope over X, Y rows
+ *   permtest X Y... [B]        permutation test [statistic, p]: Welch t for two
+ *                              groups, F for more
+ *   value_counts X             [[value, count], ...], most frequent first
+ *   crosstab X Y / chi2test X Y  contingency counts / independence [chi2, df, p]
+ *
+ * A column is referenced as "col" (searched in the most recently loaded
+ * table first) or "table.col". Missing values (NaN) are skipped; two-column
+ * operations keep only rows where both values are present.
+ */
+#pragma once
+#include "iParser.h"
+#include "data_loader.h"
+#include "statistics_engine.h"
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+class StatisticsParser : public IParser {
+private:
+    StatisticsEngine* engine_;
+    std::map<std::string, DataTable> tables_;
+    std::string current_table_;
+
+public:
+    explicit StatisticsParser(StatisticsEngine* engine) : engine_(engine) {}
+
+    EngineResult ParseAndExecute(const std::string& input) override;
+
+    const DataTable* GetTable(const std::string& name) const;
+
+private:
+    EngineResult Load(const std::vector<std::string>& args);
+    EngineResult ListColumns(const std::vector<std::string>& args) const;
+    EngineResult Execute(const std::string& op, const std::vector<std::string>& args);
+    EngineResult Regress(const std::string& formula) const;
+    EngineResult BuildHistogram(const std::vector<std::string>& args) const;
+    EngineResult BuildHistogram2D(const std::vector<std::string>& args) const;
+    EngineResult EvaluateDistribution(const std::string& op, const std::vector<std::string>& args) const;
+    EngineResult Bootstrap(const std::vector<std::string>& args) const;
+    EngineResult CompareGroups(const std::string& op, const std::vector<std::string>& args) const;
+
+    // Column reference or [..] literal, NaN-free
+    std::optional<Vector> ResolveVector(const std::string& ref) const;
+    // Two references with rows dropped where either value is missing
+    bool ResolvePair(const std::string& a, const std::string& b, Vector& x, Vector& y) const;
+    const Vector* FindColumn(const std::string& ref) const;
+};
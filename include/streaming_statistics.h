@@ -0,0 +1,69 @@
+/**
+ * @file streaming_statistics.h
+ * @brief Named unbounded data streams summarized by mergeable sketches
+ *
+ * Each stream keeps exact moments (MomentAccumulator) plus a t-digest and a
+ * KLL sketch for approximate quantiles, all in bounded memory. A stream's
+ * state serializes to one compact blob that another process can merge into
+ * its own stream of the same name, so per-worker or per-host partials can
+ * be combined later. All methods are thread-safe.
+ */
+#pragma once
+
+#include "moment_accumulator.h"
+#include "quantile_sketch.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+enum class SketchKind {
+    TDigest,
+    KLL
+};
+
+struct StreamingConfig {
+    double tdigest_compression = 100.0;   // Higher: more centroids, tighter tails
+    uint32_t kll_k = 200;                 // Rank error ~1.65 / k
+};
+
+class StreamingStatistics {
+public:
+    explicit StreamingStatistics(StreamingConfig config = {});
+
+    void Push(const std::string& stream, double value);
+    void Push(const std::string& stream, const double* values, size_t n);
+
+    std::optional<double> Quantile(const std::string& stream, double q,
+                                   SketchKind kind = SketchKind::TDigest) const;
+    std::optional<double> CDF(const std::string& stream, double x,
+                              SketchKind kind = SketchKind::TDigest) const;
+    std::optional<DescriptiveStats> Describe(const std::string& stream) const;
+
+    // Empty when the stream does not exist
+    std::vector<uint8_t> Serialize(const std::string& stream) const;
+    // Merges a Serialize() blob into `stream` (created if absent); false if malformed
+    bool MergeSerialized(const std::string& stream, const uint8_t* data, size_t size);
+
+    bool Reset(const std::string& stream);
+    std::vector<std::string> Streams() const;
+    const StreamingConfig& Config() const { return config_; }
+
+private:
+    struct Stream {
+        MomentAccumulator moments;
+        TDigest tdigest;
+        KLLSketch kll;
+
+        explicit Stream(const StreamingConfig& config)
+            : tdigest(config.tdigest_compression), kll(config.kll_k) {}
+    };
+
+    Stream& GetOrCreate(const std::string& stream);
+
+    StreamingConfig config_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Stream> streams_;
+};
@@ -8,6 +8,7 @@
 #include <charconv>
 #include <optional>
 #include <string_view>
+#include <cstdint>
 
 namespace Utils {
     
@@ -65,4 +66,11 @@ namespace Utils {
 
     // String utilities
     std::string ReplaceAll(const std::string& str, const std::string& from, const std::string& to);
+
+    // Calculator display: integers exactly, otherwise 15 significant digits (scientific outside 1e-6..1e6)
+    std::string FormatNumber(double val);
+
+    // Base64 (RFC 4648, padded) for shipping binary blobs over text channels
+    std::string Base64Encode(const uint8_t* data, size_t size);
+    std::optional<std::vector<uint8_t>> Base64Decode(std::string_view text);
 }
\ No newline at end of file
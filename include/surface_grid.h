@@ -0,0 +1,78 @@
+/**
+ * @file surface_grid.h
+ * @brief Dense z = f(x, y) grids for surface plots and heatmaps
+ *
+ * Evaluate() runs a CompiledExpression over the grid in tiles of 128 x 32
+ * points: each tile fills its x / y inputs, evaluates them as one batch
+ * (a few hundred KB of working set) and narrows the results into a
+ * contiguous float buffer. Tiles are spread over the shared pool and write
+ * disjoint parts of the buffer, so a 2000 x 2000 grid needs no locking and
+ * no per-point parsing.
+ *
+ * Colorize() and Contour() are parallel post-passes over the finished
+ * grid: a 256-entry colormap lookup per point, and marching squares per
+ * band of cell rows (saddles resolved by the cell's centre value), with
+ * the bands' segments concatenated in row order.
+ */
+#pragma once
+
+#include "compiled_expression.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+struct GridSpec {
+    size_t columns = 200;   // Points along x, at least 2
+    size_t rows = 200;      // Points along y, at least 2
+    double x_min = -10;
+    double x_max = 10;
+    double y_min = -10;
+    double y_max = 10;
+};
+
+/**
+ * Row-major values, top row first: point (c, r) sits at x = X(c), y = Y(r),
+ * with row 0 at y_max as in an image. Points where f is undefined hold NaN.
+ */
+struct SurfaceGrid {
+    GridSpec spec;
+    std::vector<float> values;
+
+    size_t Columns() const { return spec.columns; }
+    size_t Rows() const { return spec.rows; }
+    float At(size_t c, size_t r) const { return values[r * spec.columns + c]; }
+    double X(size_t c) const {
+        return spec.x_min + (spec.x_max - spec.x_min) * static_cast<double>(c) / static_cast<double>(spec.columns - 1);
+    }
+    double Y(size_t r) const {
+        return spec.y_max - (spec.y_max - spec.y_min) * static_cast<double>(r) / static_cast<double>(spec.rows - 1);
+    }
+};
+
+struct ContourSegment {
+    double x0, y0;
+    double x1, y1;
+};
+
+namespace Surface {
+
+enum class Colormap { Viridis, Grayscale, Coolwarm };
+
+// f must have two variables, bound to x and y in that order; nullopt for an invalid spec
+// or more than 2^28 points
+std::optional<SurfaceGrid> Evaluate(const CompiledExpression& f, const GridSpec& spec);
+
+// Finite minimum and maximum; nullopt if there are none
+std::optional<std::pair<float, float>> FiniteRange(const SurfaceGrid& grid);
+
+// 3 bytes (RGB) per point, row-major; lo / hi map to the ends of the colormap, NaN is black
+std::vector<uint8_t> Colorize(const SurfaceGrid& grid, Colormap colormap, double lo, double hi);
+// Over FiniteRange(grid)
+std::vector<uint8_t> Colorize(const SurfaceGrid& grid, Colormap colormap);
+
+// Iso-line pieces at level in x / y coordinates; cells with a NaN corner are skipped
+std::vector<ContourSegment> Contour(const SurfaceGrid& grid, double level);
+
+} // namespace Surface
@@ -0,0 +1,211 @@
+/**
+ * @file thread_pool.h
+ * @brief Shared work-stealing scheduler for all AXIOM engines
+ *
+ * One process-wide pool replaces per-engine threading:
+ * - Chase-Lev deques per worker (owner pushes/pops LIFO, thieves steal FIFO)
+ * - Spin-then-park idle policy with lost-wakeup-free notification
+ * - TaskGroup::Wait() executes pending tasks, so nested parallelism is safe
+ * - Workers are placed across physical cores before SMT siblings
+ *
+ * The worker count comes from a single setting (SetGlobalThreadCount,
+ * --threads=N, or AXIOM_THREADS) shared by DynamicCalc, the daemon and
+ * every engine. Parallel algorithms live in parallel.h.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AXIOM {
+
+/**
+ * @brief Unit of work scheduled on the pool
+ */
+struct PoolTask {
+    std::function<void()> fn;
+};
+
+/**
+ * @brief Chase-Lev work-stealing deque (Le et al., PPoPP'13 memory orders)
+ *
+ * Push/Pop are owner-only; Steal may be called from any thread. Grown
+ * buffers are retired, not freed, until the deque is destroyed, so a
+ * concurrent thief never reads freed memory.
+ */
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(int64_t initial_capacity = 256);
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    void Push(PoolTask* task);
+    PoolTask* Pop();
+    PoolTask* Steal();
+    bool Empty() const;
+
+private:
+    struct Buffer {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<PoolTask*>[]> slots;
+
+        explicit Buffer(int64_t cap) : capacity(cap), slots(new std::atomic<PoolTask*>[cap]) {}
+        PoolTask* Get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_acquire); }
+        void Put(int64_t i, PoolTask* t) { slots[i & (capacity - 1)].store(t, std::memory_order_release); }
+    };
+
+    Buffer* Grow(Buffer* old, int64_t bottom, int64_t top);
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;   // Owns current + retired
+};
+
+/**
+ * @brief CPU placement and scheduling policy for one group of threads
+ */
+struct ThreadPlacement {
+    std::vector<int> cpus;           // Empty = inherit process affinity
+    bool pin_each = false;           // Thread i -> cpus[i % n] instead of floating over the set
+    int fifo_priority = 0;           // > 0 requests SCHED_FIFO at this priority
+    int nice = 0;                    // Per-thread nice level (ignored under SCHED_FIFO)
+};
+
+/**
+ * @brief Apply a placement to the calling thread
+ * @param index Position of the thread within its group (selects the CPU when pin_each)
+ * @return Human-readable summary of what was applied, including refusals
+ *         (e.g. SCHED_FIFO without CAP_SYS_NICE)
+ */
+std::string ApplyThreadPlacement(const ThreadPlacement& placement, size_t index);
+
+/**
+ * @brief Parse a CPU list such as "0-3,8,10-11"
+ * @return false on malformed input
+ */
+bool ParseCPUList(const std::string& spec, std::vector<int>& cpus);
+
+/**
+ * @brief Scheduler configuration
+ */
+struct ThreadPoolConfig {
+    size_t num_threads = 0;          // 0 = one per allowed CPU
+    ThreadPlacement placement;       // cpus empty + pin_each = pin in topology order
+    int spin_us = 50;                // Busy-steal window before yielding
+    int yield_iterations = 16;       // Yields before parking
+};
+
+/**
+ * @brief Process-wide work-stealing thread pool
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(const ThreadPoolConfig& config = {});
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Schedule fire-and-forget work. From a worker the task goes to that
+    // worker's deque; from other threads it goes to the injection queue.
+    void Submit(std::function<void()> fn);
+
+    // Run one pending task on the calling thread if any is available.
+    // Used by TaskGroup::Wait so waiting threads keep the pool busy.
+    bool TryRunOneTask();
+
+    size_t Size() const { return workers_.size(); }
+    // Tasks submitted and not yet finished
+    size_t Outstanding() const { return outstanding_.load(std::memory_order_acquire); }
+    int CurrentWorkerIndex() const;   // -1 when called off-pool
+    const std::vector<int>& WorkerCPUs() const { return worker_cpus_; }
+    const ThreadPoolConfig& Config() const { return config_; }
+    std::string Describe() const;
+
+    // Global pool shared by every engine. Reconfiguring replaces it: the old
+    // pool's workers are joined but the object stays alive, so references
+    // taken earlier stay valid and run submitted work inline. Returns false
+    // (and changes nothing) while the current pool has outstanding tasks or
+    // when called from one of its workers.
+    static ThreadPool& Global();
+    static bool SetGlobalThreadCount(size_t num_threads);   // 0 = auto
+    static size_t GlobalThreadCount();
+    static bool ConfigureGlobal(const ThreadPoolConfig& config);
+
+    // CPUs in placement order: one per physical core first, then SMT siblings
+    static std::vector<int> TopologyOrderedCPUs();
+
+private:
+    struct Worker {
+        WorkStealingDeque deque;
+        std::thread thread;
+        uint64_t rng_state = 0;
+    };
+
+    void WorkerLoop(size_t index);
+    void Stop();   // Joins the workers, then runs anything still queued on the caller
+    PoolTask* FindTask(size_t self_index, uint64_t& rng_state);
+    PoolTask* PopInjected();
+    void NotifyOne();
+    void Execute(PoolTask* task);
+
+    ThreadPoolConfig config_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<int> worker_cpus_;
+    std::vector<std::string> worker_layout_;   // Filled by each worker at startup
+    mutable std::mutex layout_mutex_;
+
+    std::mutex injection_mutex_;
+    std::deque<PoolTask*> injection_queue_;
+    std::atomic<size_t> injected_count_{0};
+
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+    std::atomic<int> sleepers_{0};
+    uint64_t wake_epoch_ = 0;          // Guarded by park_mutex_
+    std::atomic<bool> stopping_{false};
+    std::atomic<size_t> outstanding_{0};
+};
+
+/**
+ * @brief Structured fork/join scope for nested parallelism
+ *
+ * Wait() helps run queued tasks instead of blocking, so a task may itself
+ * create and wait on a TaskGroup without starving the pool. The first
+ * exception thrown by a child is rethrown from Wait().
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::Global()) : pool_(pool) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(std::function<void()> fn);
+    void Wait();
+
+private:
+    ThreadPool& pool_;
+    std::atomic<size_t> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace AXIOM
+
+#endif // THREAD_POOL_H
@@ -2,16 +2,28 @@
  * @file unit_manager.h
  * @brief Unit conversion and dimensional analysis system
  * Adds support for physical units: meters, seconds, kilograms, etc.
+ *
+ * Every unit carries an SI dimension vector, so compound units such as
+ * "m/s", "kg*m/s^2" or "km/h" parse into a dimension and one scale factor.
+ * A conversion is an affine map (value * factor + offset; the offset is
+ * only non-zero between C, F and K) computed once per unit pair and cached.
+ * Symbols are looked up through a perfect hash table rebuilt on registration,
+ * and lists convert in one pass of the SIMD affine kernel.
  */
 #pragma once
 
+#include "dimension.h"
 #include "dynamic_calc_types.h"
+#include <mutex>
+#include <cstdint>
+#include <optional>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 enum class UnitType {
-    Length, Time, Mass, Temperature, Current, 
+    Length, Time, Mass, Temperature, Current,
     Angle, Area, Volume, Velocity, Acceleration,
     Force, Energy, Power, Pressure, Dimensionless
 };
@@ -21,22 +33,74 @@ struct Unit {
     double scale_factor; // Relative to SI base unit
     std::string symbol;
     std::string name;
+    Dimension dimension;
+    double offset = 0.0; // SI value of zero in this unit (C and F only)
+};
+
+// A parsed unit expression: one SI scale, its dimension, and an offset for a lone C or F
+struct CompoundUnit {
+    Dimension dimension;
+    double scale = 1.0;
+    double offset = 0.0;
+};
+
+// to_value = from_value * factor + offset
+struct UnitConversion {
+    double factor = 1.0;
+    double offset = 0.0;
+
+    double Apply(double value) const { return value * factor + offset; }
+};
+
+/**
+ * Symbol -> Unit by hash-and-displace perfect hashing: each bucket of keys gets
+ * a displacement that sends all its keys to free slots, so a lookup is one hash,
+ * two loads and one string compare, with no probing and no allocation.
+ */
+class UnitSymbolTable {
+public:
+    // Pointers into units must stay valid until the next Build (unordered_map nodes do)
+    void Build(const std::unordered_map<std::string, Unit>& units);
+    const Unit* Find(std::string_view symbol) const;
+
+private:
+    std::vector<uint16_t> displacements_;   // One per bucket
+    std::vector<const Unit*> slots_;
+    uint64_t bucket_mask_ = 0;
+    uint64_t slot_mask_ = 0;
 };
 
 class UnitManager {
 private:
     std::unordered_map<std::string, Unit> units_;
-    
+    UnitSymbolTable symbols_;
+    bool symbols_ready_ = false;   // The constructor builds the table once, after the defaults
+    std::unordered_map<std::string, UnitConversion> conversions_;   // Key: from '\0' to
+    std::mutex conversions_mutex_;
+
 public:
     UnitManager();
-    
+
     // Core functionality
     EngineResult ConvertUnit(double value, const std::string& from_unit, const std::string& to_unit);
+    // Every element through the pair's cached factor and offset in one SIMD pass
+    EngineResult ConvertUnit(const Vector& values, const std::string& from_unit, const std::string& to_unit);
     EngineResult ConvertTemperature(double value, const std::string& from_unit, const std::string& to_unit);
     bool AreCompatible(const std::string& unit1, const std::string& unit2);
     std::string GetCanonicalUnit(UnitType type);
-    
+
+    // Compound units: symbols joined by '*' or '/', each with an optional integer power ("kg*m/s^2")
+    std::optional<CompoundUnit> ParseUnit(std::string_view text) const;
+    const Unit* FindUnit(std::string_view symbol) const { return symbols_.Find(symbol); }
+    // Cached; nullopt with *error OperationNotFound (unknown unit) or ArgumentMismatch (dimensions differ)
+    std::optional<UnitConversion> GetConversion(const std::string& from_unit, const std::string& to_unit,
+                                                CalcErr* error = nullptr);
+
     // Registration
     void RegisterUnit(const std::string& symbol, UnitType type, double scale, const std::string& name);
+    void RegisterUnit(const std::string& symbol, const Dimension& dimension, double scale, const std::string& name,
+                      double offset = 0.0);
     std::vector<std::string> GetUnitsOfType(UnitType type);
-};
\ No newline at end of file
+
+    static Dimension DimensionOf(UnitType type);
+};
@@ -1,8 +1,29 @@
+/**
+ * @file unit_parser.h
+ * @brief UNITS mode: "[convert] VALUE UNIT to UNIT"
+ *
+ * VALUE is a number, with an optional sign and exponent (-4.5e3), or a
+ * [..] list. A list is converted in one pass of the SIMD affine kernel.
+ * UNIT is any expression that UnitManager::ParseUnit accepts, such as
+ * "km/h" or "kg*m/s^2". The input is read by a single hand-written scan.
+ *
+ * EvaluateQuantity serves ALGEBRAIC input with unit literals
+ * ("9.81 m/s^2 * 3 s") on AlgebraicParser's behalf.
+ */
 #pragma once
 #include "IParser.h"
 #include "unit_manager.h"
+#include <map>
+#include <optional>
 #include <string>
-#include <regex>
+#include <string_view>
+
+struct UnitConversionRequest {
+    Vector values;
+    bool is_list = false;
+    std::string from_unit;
+    std::string to_unit;
+};
 
 class UnitParser : public IParser {
 private:
@@ -12,8 +33,22 @@ public:
     UnitParser(UnitManager* manager) : unit_manager_(manager) {}
     
     EngineResult ParseAndExecute(const std::string& input) override;
-    
-private:
-    bool IsUnitConversion(const std::string& input);
-    EngineResult ParseConversion(const std::string& input);
-};
\ No newline at end of file
+
+    // Syntax only (units are not looked up); DynamicCalc routes "... to ..." input from other modes with it
+    bool IsUnitConversion(const std::string& input) const { return Scan(input).has_value(); }
+    static std::optional<UnitConversionRequest> Scan(const std::string& input);
+
+    /**
+     * An expression whose literals may carry units, checked and folded by
+     * CompiledExpression: a number, or "value dimension" text for a
+     * dimensioned result. nullopt when no literal carries a unit, so the
+     * caller's own parser takes the input; HasUnitLiteral rules most such
+     * input out before anything is compiled.
+     */
+    static std::optional<EngineResult> EvaluateQuantity(const std::string& input,
+                                                        const std::map<std::string, double>& context,
+                                                        const UnitManager& units);
+    // Some number literal is followed by a unit symbol that is not a context variable or a call
+    static bool HasUnitLiteral(std::string_view input, const UnitManager& units,
+                               const std::map<std::string, double>& context = {});
+};
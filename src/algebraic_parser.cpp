@@ -6,6 +6,8 @@
 
 #include "algebraic_parser.h"
 #include "string_helpers.h"
+#include "unit_manager.h"
+#include "unit_parser.h"
 #include <exception>
 #include <iostream>
 #include <cmath>
@@ -34,30 +36,7 @@ CalcErr NormalizeError(const EvalResult& res, CalcErr fallback = CalcErr::Argume
     return res.error == CalcErr::None ? fallback : res.error;
 }
 
-std::string FormatNumber(double val) {
-    // Handle special cases
-    if (std::isinf(val)) return std::signbit(val) ? "-inf" : "inf";
-    if (std::isnan(val)) return "nan";
-    
-    // For integers or numbers that can be represented exactly
-    if (val == std::floor(val) && std::abs(val) < 1e15) {
-        return std::to_string(static_cast<long long>(val));
-    }
-    
-    // For normal floating point numbers
-    char buffer[64];
-    double abs_val = std::abs(val);
-    
-    if (abs_val >= 1e6 || (abs_val > 0 && abs_val < 1e-6)) {
-        // Use scientific notation for very large or very small numbers
-        sprintf(buffer, "%.6e", val);
-    } else {
-        // Use high precision for normal numbers - let's try 15 digits
-        sprintf(buffer, "%.15g", val);
-    }
-    
-    return std::string(buffer);
-}
+using Utils::FormatNumber;
 
 // ========================================================
 // AST NODE IMPLEMENTATIONS
@@ -1035,6 +1014,10 @@ EngineResult AlgebraicParser::ParseAndExecuteWithContext(const std::string& inpu
         }
         pos++;
     }
+
+    if (unit_manager_) {
+        if (auto with_units = UnitParser::EvaluateQuantity(trimmed, context, *unit_manager_)) return *with_units;
+    }
     
     // Check cache first for performance
     std::string cache_key = input;
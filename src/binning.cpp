@@ -0,0 +1,188 @@
+/**
+ * @file binning.cpp
+ * @brief Histogram counting over SIMD bin indices with per-worker counts
+ */
+
+#include "binning.h"
+#include "parallel.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr size_t kBlock = 1024;          // Indices per kernel call (stack buffer)
+using Binning::kMaxBins;
+
+// One histogram axis; edges are always materialized for the result
+struct Axis {
+    Vector edges;
+    bool uniform = false;
+    uint32_t bins = 0;
+
+    void Index(const double* x, uint32_t* out, size_t n, const AXIOM::SIMD::KernelTable& kernels) const {
+        if (uniform) kernels.bin_uniform(x, out, n, edges.front(), edges.back(), bins);
+        else kernels.bin_edges(x, out, n, edges.data(), bins);
+    }
+};
+
+std::optional<Axis> UniformAxis(size_t bins, double lo, double hi) {
+    if (bins == 0 || bins > kMaxBins || !(lo < hi) || !std::isfinite(hi - lo)) return std::nullopt;
+    Axis axis;
+    axis.uniform = true;
+    axis.bins = static_cast<uint32_t>(bins);
+    axis.edges.resize(bins + 1);
+    // Fused, as in the kernels' edge check, so every ISA and build agrees on the edges
+    const double step = (hi - lo) / static_cast<double>(bins);
+    for (size_t i = 0; i < bins; ++i) axis.edges[i] = std::fma(static_cast<double>(i), step, lo);
+    axis.edges[bins] = hi;
+    return axis;
+}
+
+std::optional<Axis> EdgeAxis(const Vector& edges) {
+    if (edges.size() < 2 || edges.size() - 1 > kMaxBins) return std::nullopt;
+    if (!std::all_of(edges.begin(), edges.end(), [](double e) { return std::isfinite(e); })) return std::nullopt;
+    if (!std::is_sorted(edges.begin(), edges.end()) || !(edges.front() < edges.back())) return std::nullopt;
+    Axis axis;
+    axis.edges = edges;
+    axis.bins = static_cast<uint32_t>(edges.size() - 1);
+    return axis;
+}
+
+std::vector<uint64_t> AddCounts(std::vector<uint64_t> acc, const std::vector<uint64_t>& part) {
+    for (size_t i = 0; i < acc.size(); ++i) acc[i] += part[i];
+    return acc;
+}
+
+// Chunks hold at least a few elements per slot so zeroing and merging the
+// private count arrays stays small next to the counting itself
+size_t CountingGrain(size_t n, size_t slots) {
+    return std::max(AXIOM::Parallel::DefaultGrain(n), 4 * slots);
+}
+
+// Slot layout: 0 below, 1..bins, bins + 1 above, bins + 2 missing
+Histogram Count(const Axis& axis, const double* x, size_t n) {
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    const size_t slots = size_t{axis.bins} + 3;
+    auto counts = AXIOM::Parallel::ParallelReduce(size_t{0}, n, CountingGrain(n, slots),
+        std::vector<uint64_t>(slots, 0),
+        [&](size_t lo, size_t hi) {
+            std::vector<uint64_t> local(slots, 0);
+            uint32_t index[kBlock];
+            for (size_t start = lo; start < hi; start += kBlock) {
+                size_t m = std::min(kBlock, hi - start);
+                axis.Index(x + start, index, m, kernels);
+                for (size_t i = 0; i < m; ++i) ++local[index[i]];
+            }
+            return local;
+        },
+        AddCounts);
+
+    Histogram hist;
+    hist.edges = axis.edges;
+    hist.counts.assign(counts.begin() + 1, counts.begin() + 1 + axis.bins);
+    hist.below = counts[0];
+    hist.above = counts[axis.bins + 1];
+    hist.missing = counts[axis.bins + 2];
+    return hist;
+}
+
+// Slot layout: x bins * y bins cells, then outside, then missing
+std::optional<Histogram2D> Count2D(const Axis& ax, const Axis& ay, const double* x, const double* y, size_t n) {
+    const size_t cells = size_t{ax.bins} * ay.bins;
+    if (cells > kMaxBins) return std::nullopt;
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    const uint32_t x_missing = ax.bins + 2, y_missing = ay.bins + 2;
+    auto counts = AXIOM::Parallel::ParallelReduce(size_t{0}, n, CountingGrain(n, cells + 2),
+        std::vector<uint64_t>(cells + 2, 0),
+        [&](size_t lo, size_t hi) {
+            std::vector<uint64_t> local(cells + 2, 0);
+            uint32_t xi[kBlock], yi[kBlock];
+            for (size_t start = lo; start < hi; start += kBlock) {
+                size_t m = std::min(kBlock, hi - start);
+                ax.Index(x + start, xi, m, kernels);
+                ay.Index(y + start, yi, m, kernels);
+                for (size_t i = 0; i < m; ++i) {
+                    // Unsigned wrap sends index 0 (below) out of range along with above / missing
+                    uint32_t cx = xi[i] - 1, cy = yi[i] - 1;
+                    bool inside = cx < ax.bins && cy < ay.bins;
+                    bool nan = xi[i] == x_missing || yi[i] == y_missing;
+                    size_t slot = inside ? size_t{cx} * ay.bins + cy : cells + (nan ? 1 : 0);
+                    ++local[slot];
+                }
+            }
+            return local;
+        },
+        AddCounts);
+
+    Histogram2D hist;
+    hist.x_edges = ax.edges;
+    hist.y_edges = ay.edges;
+    hist.counts.assign(counts.begin(), counts.begin() + static_cast<std::ptrdiff_t>(cells));
+    hist.outside = counts[cells];
+    hist.missing = counts[cells + 1];
+    return hist;
+}
+
+} // namespace
+
+namespace Binning {
+
+std::optional<std::pair<double, double>> FiniteRange(const double* x, size_t n) {
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+    using Range = std::pair<double, double>;
+    Range range = AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, Range{kInf, -kInf},
+        [&](size_t lo, size_t hi) {
+            Range r{kInf, -kInf};
+            for (size_t i = lo; i < hi; ++i) {
+                if (!std::isfinite(x[i])) continue;
+                r.first = std::min(r.first, x[i]);
+                r.second = std::max(r.second, x[i]);
+            }
+            return r;
+        },
+        [](Range a, const Range& b) { return Range{std::min(a.first, b.first), std::max(a.second, b.second)}; });
+    if (range.first > range.second) return std::nullopt;
+    return range;
+}
+
+std::optional<Histogram> Uniform(const double* x, size_t n, size_t bins, double lo, double hi) {
+    auto axis = UniformAxis(bins, lo, hi);
+    if (!axis) return std::nullopt;
+    return Count(*axis, x, n);
+}
+
+std::optional<Histogram> Uniform(const double* x, size_t n, size_t bins) {
+    auto range = FiniteRange(x, n).value_or(std::pair<double, double>{0.0, 1.0});
+    if (range.first == range.second) {
+        range.first -= 0.5;
+        range.second += 0.5;
+    }
+    return Uniform(x, n, bins, range.first, range.second);
+}
+
+std::optional<Histogram> Edges(const double* x, size_t n, const Vector& edges) {
+    auto axis = EdgeAxis(edges);
+    if (!axis) return std::nullopt;
+    return Count(*axis, x, n);
+}
+
+std::optional<Histogram2D> Uniform2D(const double* x, const double* y, size_t n,
+                                     size_t x_bins, double x_lo, double x_hi,
+                                     size_t y_bins, double y_lo, double y_hi) {
+    auto ax = UniformAxis(x_bins, x_lo, x_hi);
+    auto ay = UniformAxis(y_bins, y_lo, y_hi);
+    if (!ax || !ay) return std::nullopt;
+    return Count2D(*ax, *ay, x, y, n);
+}
+
+std::optional<Histogram2D> Edges2D(const double* x, const double* y, size_t n,
+                                   const Vector& x_edges, const Vector& y_edges) {
+    auto ax = EdgeAxis(x_edges);
+    auto ay = EdgeAxis(y_edges);
+    if (!ax || !ay) return std::nullopt;
+    return Count2D(*ax, *ay, x, y, n);
+}
+
+} // namespace Binning
@@ -0,0 +1,65 @@
+/**
+ * @file compensated_sum.cpp
+ * @brief Chunked parallel drivers for the compensated SIMD kernels
+ */
+
+#include "compensated_sum.h"
+#include "parallel.h"
+#include "simd_kernels.h"
+
+namespace Reduction {
+
+namespace {
+
+struct CrossSums {
+    CompensatedSum xx, yy, xy;
+};
+
+CompensatedSum FromPair(const double* pair) {
+    return CompensatedSum{pair[0], pair[1]};
+}
+
+CompensatedSum Combine(CompensatedSum acc, const CompensatedSum& part) {
+    acc.Merge(part);
+    return acc;
+}
+
+} // namespace
+
+double Sum(const double* data, size_t n) {
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    return AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, CompensatedSum{},
+        [&](size_t lo, size_t hi) {
+            double pair[2];
+            kernels.sum_kb(data + lo, hi - lo, pair);
+            return FromPair(pair);
+        },
+        Combine).Value();
+}
+
+double SumSquaredDeviations(const double* data, size_t n, double center) {
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    return AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, CompensatedSum{},
+        [&](size_t lo, size_t hi) {
+            double pair[2];
+            kernels.sum_sq_dev_kb(data + lo, hi - lo, center, pair);
+            return FromPair(pair);
+        },
+        Combine).Value();
+}
+
+CrossDeviations SumCrossDeviations(const double* x, const double* y, size_t n, double cx, double cy) {
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    CrossSums total = AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, CrossSums{},
+        [&](size_t lo, size_t hi) {
+            double pairs[6];
+            kernels.co_dev_kb(x + lo, y + lo, hi - lo, cx, cy, pairs);
+            return CrossSums{FromPair(pairs), FromPair(pairs + 2), FromPair(pairs + 4)};
+        },
+        [](CrossSums acc, const CrossSums& part) {
+            return CrossSums{Combine(acc.xx, part.xx), Combine(acc.yy, part.yy), Combine(acc.xy, part.xy)};
+        });
+    return {total.xx.Value(), total.yy.Value(), total.xy.Value()};
+}
+
+} // namespace Reduction
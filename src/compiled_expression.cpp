@@ -0,0 +1,772 @@
+/**
+ * @file compiled_expression.cpp
+ * @brief Expression compiler (recursive descent to folded postfix) and block evaluator
+ */
+
+#include "compiled_expression.h"
+#include "dynamic_calc_types.h"
+#include "parallel.h"
+#include "simd_kernels.h"
+#include "unit_manager.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+
+namespace {
+
+using OpCode = CompiledExpression::OpCode;
+using Function = CompiledExpression::Function;
+using Instruction = CompiledExpression::Instruction;
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr size_t kBlock = 256;               // Values per instruction sweep
+constexpr double kMaxUnrolledPower = 64.0;   // Larger integer exponents use std::pow
+
+const std::map<std::string_view, Function>& FunctionNames() {
+    static const std::map<std::string_view, Function> names = {
+        {"sin", Function::Sin}, {"cos", Function::Cos}, {"tan", Function::Tan},
+        {"cot", Function::Cot}, {"sec", Function::Sec}, {"csc", Function::Csc},
+        {"asin", Function::Asin}, {"acos", Function::Acos}, {"atan", Function::Atan},
+        {"acot", Function::Acot}, {"asec", Function::Asec}, {"acsc", Function::Acsc},
+        {"sinh", Function::Sinh}, {"cosh", Function::Cosh}, {"tanh", Function::Tanh},
+        {"coth", Function::Coth}, {"sech", Function::Sech}, {"csch", Function::Csch},
+        {"asinh", Function::Asinh}, {"acosh", Function::Acosh}, {"atanh", Function::Atanh},
+        {"acoth", Function::Acoth}, {"asech", Function::Asech}, {"acsch", Function::Acsch},
+        {"sqrt", Function::Sqrt}, {"cbrt", Function::Cbrt}, {"abs", Function::Abs},
+        {"ln", Function::Ln}, {"log", Function::Log10}, {"log2", Function::Log2}, {"lg", Function::Log2},
+        {"exp", Function::Exp}, {"factorial", Function::Factorial},
+    };
+    return names;
+}
+
+const std::map<std::string_view, OpCode>& MultiArgumentNames() {
+    static const std::map<std::string_view, OpCode> names = {
+        {"max", OpCode::Max}, {"min", OpCode::Min}, {"gcd", OpCode::Gcd},
+        {"lcm", OpCode::Lcm}, {"mod", OpCode::Mod}, {"modulo", OpCode::Mod},
+    };
+    return names;
+}
+
+double Factorial(double v) {
+    static const std::array<double, 171> table = [] {
+        std::array<double, 171> t{};
+        t[0] = 1.0;
+        for (size_t i = 1; i < t.size(); ++i) t[i] = t[i - 1] * static_cast<double>(i);
+        return t;
+    }();
+    if (!(v >= 0.0 && v <= 170.0) || v != std::floor(v)) return kNaN;
+    return table[static_cast<size_t>(v)];
+}
+
+long long GcdOf(double a, double b) {
+    long long x = std::llabs(static_cast<long long>(a)), y = std::llabs(static_cast<long long>(b));
+    while (y != 0) {
+        long long t = y;
+        y = x % y;
+        x = t;
+    }
+    return x;
+}
+
+// Outside [-2^63, 2^63) the integer conversion behind gcd / lcm is undefined
+bool IntegerRange(double v) { return std::abs(v) < 9.2e18; }
+
+double ApplyFunction(Function f, double v) {
+    switch (f) {
+        case Function::Sin: return std::sin(v * D2R);
+        case Function::Cos: return std::cos(v * D2R);
+        case Function::Tan: return std::tan(v * D2R);
+        case Function::Cot: return 1.0 / std::tan(v * D2R);
+        case Function::Sec: return 1.0 / std::cos(v * D2R);
+        case Function::Csc: return 1.0 / std::sin(v * D2R);
+        case Function::Asin: return std::asin(v) * R2D;
+        case Function::Acos: return std::acos(v) * R2D;
+        case Function::Atan: return std::atan(v) * R2D;
+        case Function::Acot: return std::atan(1.0 / v) * R2D;
+        case Function::Asec: return std::acos(1.0 / v) * R2D;
+        case Function::Acsc: return std::asin(1.0 / v) * R2D;
+        case Function::Sinh: return std::sinh(v);
+        case Function::Cosh: return std::cosh(v);
+        case Function::Tanh: return std::tanh(v);
+        case Function::Coth: return 1.0 / std::tanh(v);
+        case Function::Sech: return 1.0 / std::cosh(v);
+        case Function::Csch: return 1.0 / std::sinh(v);
+        case Function::Asinh: return std::asinh(v);
+        case Function::Acosh: return std::acosh(v);
+        case Function::Atanh: return std::atanh(v);
+        case Function::Acoth: return std::atanh(1.0 / v);
+        case Function::Asech: return std::acosh(1.0 / v);
+        case Function::Acsch: return std::asinh(1.0 / v);
+        case Function::Sqrt: return v < 0.0 ? kNaN : std::sqrt(v);
+        case Function::Cbrt: return std::cbrt(v);
+        case Function::Abs: return std::abs(v);
+        case Function::Ln: return v > 0.0 ? std::log(v) : kNaN;
+        case Function::Log10: return v > 0.0 ? std::log10(v) : kNaN;
+        case Function::Log2: return v > 0.0 ? std::log2(v) : kNaN;
+        case Function::Exp: return std::exp(v);
+        case Function::Factorial: return Factorial(v);
+    }
+    return kNaN;
+}
+
+double PowInt(double x, long long n) {
+    unsigned long long e = static_cast<unsigned long long>(n < 0 ? -n : n);
+    double result = 1.0;
+    for (double base = x; e; e >>= 1, base *= base) {
+        if (e & 1) result *= base;
+    }
+    return n < 0 ? 1.0 / result : result;
+}
+
+double ApplyBinary(OpCode op, double a, double b) {
+    switch (op) {
+        case OpCode::Add: return a + b;
+        case OpCode::Sub: return a - b;
+        case OpCode::Mul: return a * b;
+        case OpCode::Div: return b == 0.0 ? kNaN : a / b;
+        case OpCode::Pow: return std::pow(a, b);
+        case OpCode::Max: return std::max(a, b);
+        case OpCode::Min: return std::min(a, b);
+        case OpCode::Mod: return b == 0.0 ? kNaN : std::fmod(a, b);
+        case OpCode::Gcd:
+            if (!IntegerRange(a) || !IntegerRange(b)) return kNaN;
+            return static_cast<double>(GcdOf(a, b));
+        case OpCode::Lcm: {
+            if (!IntegerRange(a) || !IntegerRange(b)) return kNaN;
+            long long x = std::llabs(static_cast<long long>(a)), y = std::llabs(static_cast<long long>(b));
+            if (x == 0 || y == 0) return 0.0;
+            return static_cast<double>(x / GcdOf(a, b)) * static_cast<double>(y);
+        }
+        default: return kNaN;
+    }
+}
+
+/**
+ * Coefficients (lowest degree first) when the folded program is a sum of
+ * monomials in variable 0, such as 3x^3 - x^2/2 + 5; empty otherwise.
+ * Products of two non-monomials ((x + 1)(x - 1)) are left to the stack
+ * program: expanding them could cancel badly, whereas rewriting a sum of
+ * monomials in Horner form is as accurate as evaluating it term by term.
+ */
+std::vector<double> MonomialSum(const std::vector<Instruction>& program) {
+    std::vector<std::vector<double>> stack;
+    auto monomial = [](const std::vector<double>& p) {
+        return std::count_if(p.begin(), p.end(), [](double c) { return c != 0.0; }) <= 1;
+    };
+    // Cancellation ((x - x + 3), 0*x + 2) leaves zero leading coefficients; drop them
+    auto trim = [](std::vector<double>& p) {
+        while (p.size() > 1 && p.back() == 0.0) p.pop_back();
+    };
+    for (const auto& in : program) {
+        switch (in.op) {
+            case OpCode::Constant:
+                stack.push_back({in.value});
+                break;
+            case OpCode::Variable:
+                if (in.index != 0) return {};
+                stack.push_back({0.0, 1.0});
+                break;
+            case OpCode::Neg:
+                for (double& c : stack.back()) c = -c;
+                break;
+            case OpCode::PowInt: {
+                std::vector<double>& base = stack.back();
+                trim(base);
+                const size_t degree = base.size() - 1;
+                if (in.value < 0.0 || !monomial(base) || degree * static_cast<size_t>(in.value) > kMaxUnrolledPower) return {};
+                const double coefficient = PowInt(base[degree], static_cast<long long>(in.value));
+                base.assign(degree * static_cast<size_t>(in.value) + 1, 0.0);
+                base.back() = coefficient;
+                break;
+            }
+            case OpCode::Add:
+            case OpCode::Sub:
+            case OpCode::Mul:
+            case OpCode::Div: {
+                std::vector<double> b = std::move(stack.back());
+                stack.pop_back();
+                std::vector<double>& a = stack.back();
+                if (in.op == OpCode::Add || in.op == OpCode::Sub) {
+                    const double sign = in.op == OpCode::Add ? 1.0 : -1.0;
+                    if (a.size() < b.size()) a.resize(b.size(), 0.0);
+                    for (size_t d = 0; d < b.size(); ++d) a[d] += sign * b[d];
+                } else if (in.op == OpCode::Div) {
+                    if (b.size() != 1 || b[0] == 0.0) return {};
+                    for (double& c : a) c /= b[0];
+                } else {
+                    if (!monomial(a) && !monomial(b)) return {};
+                    std::vector<double> product(a.size() + b.size() - 1, 0.0);
+                    for (size_t i = 0; i < a.size(); ++i) {
+                        for (size_t j = 0; j < b.size(); ++j) product[i + j] += a[i] * b[j];
+                    }
+                    if (product.size() - 1 > kMaxUnrolledPower) return {};
+                    a = std::move(product);
+                }
+                break;
+            }
+            default:
+                return {};
+        }
+    }
+    if (stack.size() != 1) return {};
+    trim(stack[0]);
+    if (stack[0].size() < 2) return {};
+    return std::move(stack[0]);
+}
+
+/**
+ * Recursive descent with the same precedence as AlgebraicParser:
+ *   sum     := product (('+' | '-') product)*
+ *   product := signed (('*' | '/' | implicit) signed)*
+ *   signed  := ('-' | '+') signed | power
+ *   power   := primary ('^' signed)?          (right associative)
+ *   primary := number unit? | name | name '(' args ')' | name primary | '(' sum ')'
+ *   unit    := symbol ('^' integer)? (('*' | '/') symbol ('^' integer)?)*
+ * Each rule emits postfix code, folding operations on constants as it goes.
+ * A dimension is tracked for every stack entry. Without a UnitManager all
+ * of them are dimensionless and no check can fail.
+ */
+class Compiler {
+public:
+    Compiler(std::string_view text, const std::vector<std::string>& variables, const UnitManager* units = nullptr)
+        : text_(text), variables_(variables), units_(units) {}
+
+    bool Run(std::vector<Instruction>& program, std::string& error) {
+        bool ok = Sum() && (SkipSpace(), pos_ == text_.size() || Fail("unexpected '" + std::string(1, text_[pos_]) + "'"));
+        if (!ok) {
+            error = error_;
+            return false;
+        }
+        program = std::move(program_);
+        return true;
+    }
+
+    const Dimension& ResultDimension() const { return dimensions_.back(); }
+    bool HasUnits() const { return has_units_; }
+    bool DimensionError() const { return dimension_error_; }
+
+private:
+    bool Fail(std::string message) {
+        if (error_.empty()) error_ = std::move(message);
+        return false;
+    }
+
+    bool FailDimension(std::string message) {
+        if (error_.empty()) dimension_error_ = true;
+        return Fail(std::move(message));
+    }
+
+    bool RequireDimensionless(const Dimension& d, std::string_view what) {
+        return d.IsDimensionless() || FailDimension(std::string(what) + " of a quantity in " + d.ToString());
+    }
+
+    // Stores a checked product or power, failing when an exponent leaves int8_t
+    bool SetDimension(const std::optional<Dimension>& d, Dimension& out) {
+        if (!d) return FailDimension("unit exponent out of range (-128..127)");
+        out = *d;
+        return true;
+    }
+
+    void SkipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    }
+
+    char Peek() {
+        SkipSpace();
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    bool Accept(char c) {
+        if (Peek() != c) return false;
+        ++pos_;
+        return true;
+    }
+
+    static bool NameStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+    static bool NameChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+    static bool NumberStart(char c) { return std::isdigit(static_cast<unsigned char>(c)) || c == '.'; }
+
+    void EmitConstant(double v) {
+        Instruction in;
+        in.op = OpCode::Constant;
+        in.value = v;
+        program_.push_back(in);
+        dimensions_.push_back(Dimensions::Dimensionless);
+    }
+
+    bool TopIsConstant(size_t depth = 1) const {
+        if (program_.size() < depth) return false;
+        for (size_t i = program_.size() - depth; i < program_.size(); ++i) {
+            if (program_[i].op != OpCode::Constant) return false;
+        }
+        return true;
+    }
+
+    // Dimension of `a op b`, or a failure; b is on top of the stack
+    bool BinaryDimension(OpCode op, const Dimension& a, const Dimension& b, Dimension& out) {
+        switch (op) {
+            case OpCode::Mul: return SetDimension(Dimension::CheckedProduct(a, b), out);
+            case OpCode::Div: return SetDimension(Dimension::CheckedProduct(a, b, true), out);
+            case OpCode::Pow: {
+                if (!RequireDimensionless(b, "exponent")) return false;
+                out = a;
+                if (a.IsDimensionless()) return true;
+                const bool integer = TopIsConstant() && program_.back().value == std::floor(program_.back().value) &&
+                                     std::abs(program_.back().value) <= 127;
+                if (!integer) return FailDimension("a quantity in " + a.ToString() + " needs a constant integer exponent");
+                return SetDimension(a.CheckedPow(static_cast<int>(program_.back().value)), out);
+            }
+            case OpCode::Gcd:
+            case OpCode::Lcm:
+                out = a;
+                return RequireDimensionless(a, "gcd/lcm") && RequireDimensionless(b, "gcd/lcm");
+            default:   // Add, Sub, Max, Min, Mod
+                out = a;
+                return a == b || FailDimension("cannot combine " + a.ToString() + " with " + b.ToString());
+        }
+    }
+
+    bool EmitBinary(OpCode op) {
+        Dimension result;
+        if (!BinaryDimension(op, dimensions_[dimensions_.size() - 2], dimensions_.back(), result)) return false;
+        dimensions_.pop_back();
+        dimensions_.back() = result;
+        if (TopIsConstant(2)) {
+            double b = program_.back().value;
+            program_.pop_back();
+            program_.back().value = ApplyBinary(op, program_.back().value, b);
+            return true;
+        }
+        // x^n for small integer n: repeated squaring instead of pow
+        if (op == OpCode::Pow && TopIsConstant()) {
+            double n = program_.back().value;
+            if (n == std::floor(n) && std::abs(n) <= kMaxUnrolledPower) {
+                program_.back().op = OpCode::PowInt;
+                return true;
+            }
+        }
+        Instruction in;
+        in.op = op;
+        program_.push_back(in);
+        return true;
+    }
+
+    // abs keeps the dimension, roots divide it, everything else takes a plain number
+    bool FunctionDimension(Function f, Dimension& d) {
+        if (f == Function::Abs || d.IsDimensionless()) return true;
+        const int root = f == Function::Sqrt ? 2 : f == Function::Cbrt ? 3 : 0;
+        if (root == 0) return RequireDimensionless(d, "function");
+        for (int8_t& e : d.exponents) {
+            if (e % root != 0) return FailDimension("root of a quantity in " + d.ToString());
+            e = static_cast<int8_t>(e / root);
+        }
+        return true;
+    }
+
+    bool EmitFunction(Function f) {
+        if (!FunctionDimension(f, dimensions_.back())) return false;
+        if (TopIsConstant()) {
+            program_.back().value = ApplyFunction(f, program_.back().value);
+            return true;
+        }
+        Instruction in;
+        in.op = OpCode::Function;
+        in.function = f;
+        program_.push_back(in);
+        return true;
+    }
+
+    void EmitNegate() {
+        if (TopIsConstant()) {
+            program_.back().value = -program_.back().value;
+            return;
+        }
+        Instruction in;
+        in.op = OpCode::Neg;
+        program_.push_back(in);
+    }
+
+    bool Sum() {
+        if (!Product()) return false;
+        for (;;) {
+            if (Accept('+')) {
+                if (!Product() || !EmitBinary(OpCode::Add)) return false;
+            } else if (Accept('-')) {
+                if (!Product() || !EmitBinary(OpCode::Sub)) return false;
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool Product() {
+        if (!Signed()) return false;
+        for (;;) {
+            char c = Peek();
+            if (c == '*' || c == '/') {
+                ++pos_;
+                if (!Signed() || !EmitBinary(c == '*' ? OpCode::Mul : OpCode::Div)) return false;
+            } else if (NumberStart(c) || NameStart(c) || c == '(') {
+                // Implicit multiplication: 2x, 3(x + 1), (x + 1)(x - 1)
+                if (!Signed() || !EmitBinary(OpCode::Mul)) return false;
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool Signed() {
+        if (Accept('-')) {
+            if (!Signed()) return false;
+            EmitNegate();
+            return true;
+        }
+        if (Accept('+')) return Signed();
+        return Power();
+    }
+
+    bool Power() {
+        if (!Primary()) return false;
+        if (Accept('^')) {
+            if (!Signed() || !EmitBinary(OpCode::Pow)) return false;
+        }
+        return true;
+    }
+
+    bool Number() {
+        const char* begin = text_.data() + pos_;
+        const char* stop = begin + CompiledExpression::NumberLength(text_.substr(pos_));
+        double value;
+        auto [ptr, ec] = std::from_chars(begin, stop, value);
+        if (ec != std::errc() || ptr != stop) return Fail("bad number '" + std::string(begin, stop) + "'");
+        pos_ += static_cast<size_t>(stop - begin);
+        EmitConstant(value);
+        return !units_ || UnitSuffix();
+    }
+
+    // A unit symbol at pos_ that is not a variable, constant or function call
+    const Unit* ScanSymbol(size_t& end) {
+        size_t at = pos_;
+        while (at < text_.size() && std::isspace(static_cast<unsigned char>(text_[at]))) ++at;
+        end = at;
+        while (end < text_.size() && NameChar(text_[end])) ++end;
+        if (end == at || !NameStart(text_[at])) return nullptr;
+        std::string_view name = text_.substr(at, end - at);
+        size_t next = end;
+        while (next < text_.size() && std::isspace(static_cast<unsigned char>(text_[next]))) ++next;
+        if (next < text_.size() && text_[next] == '(') return nullptr;
+        if (std::find(variables_.begin(), variables_.end(), name) != variables_.end()) return nullptr;
+        return units_->FindUnit(name);
+    }
+
+    // "9.81 m/s^2": scales the literal just emitted to SI and gives it the unit's dimension.
+    // The unit ends before a '*' or '/' that is not followed by another unit symbol.
+    // A lone angle ("90 deg", "1 rad") becomes degrees, the unit trigonometry takes here;
+    // inside a compound unit or under a power an angle has no consistent meaning and fails.
+    bool UnitSuffix() {
+        double scale = 1.0;
+        Dimension dimension;
+        bool divide = false;
+        const Unit* angle = nullptr;
+        size_t terms = 0;
+        bool powered_angle = false;
+        for (bool first = true;; first = false) {
+            const size_t before = pos_;
+            if (!first) {
+                const char op = Peek();
+                if (op != '*' && op != '/') break;
+                ++pos_;
+                divide = op == '/';
+            }
+            size_t end;
+            const Unit* unit = ScanSymbol(end);
+            if (!unit) {
+                pos_ = before;
+                break;
+            }
+            if (unit->offset != 0.0) return FailDimension("offset scale " + unit->symbol + " in an expression (use K)");
+            pos_ = end;
+            int power = 1;
+            if (Peek() == '^') {
+                size_t at = pos_ + 1;
+                const bool negative = at < text_.size() && text_[at] == '-';
+                if (negative) ++at;
+                int digits = 0;
+                for (power = 0; at < text_.size() && std::isdigit(static_cast<unsigned char>(text_[at])) && digits < 3; ++at, ++digits) {
+                    power = power * 10 + (text_[at] - '0');
+                }
+                if (digits == 0) return Fail("expected an integer power after " + unit->symbol + "^");
+                if (negative) power = -power;
+                pos_ = at;
+            }
+            if (divide) power = -power;
+            ++terms;
+            if (unit->type == UnitType::Angle) {
+                angle = unit;
+                powered_angle = powered_angle || power != 1;
+            }
+            scale *= std::pow(unit->scale_factor, power);
+            auto powered = unit->dimension.CheckedPow(power);
+            if (!SetDimension(powered ? Dimension::CheckedProduct(dimension, *powered) : std::nullopt, dimension)) {
+                return false;
+            }
+            has_units_ = true;
+        }
+        if (angle) {
+            if (terms > 1 || powered_angle) {
+                return FailDimension("angle " + angle->symbol + " only as a lone literal such as 90 " + angle->symbol);
+            }
+            scale *= R2D;
+        }
+        program_.back().value *= scale;
+        dimensions_.back() = dimension;
+        return true;
+    }
+
+    bool Arguments(std::string_view name, OpCode op) {
+        size_t count = 0;
+        if (Peek() != ')') {
+            do {
+                if (!Sum()) return false;
+                if (++count > 1 && !EmitBinary(op)) return false;
+            } while (Accept(','));
+        }
+        if (!Accept(')')) return Fail("expected ')' after arguments of " + std::string(name));
+        bool binary = op == OpCode::Gcd || op == OpCode::Lcm || op == OpCode::Mod;
+        if (count == 0 || (binary && count != 2)) return Fail(std::string(name) + " has the wrong number of arguments");
+        return true;
+    }
+
+    bool Primary() {
+        char c = Peek();
+        if (c == '(') {
+            ++pos_;
+            if (!Sum()) return false;
+            return Accept(')') || Fail("expected ')'");
+        }
+        if (NumberStart(c)) return Number();
+        if (!NameStart(c)) return Fail(c ? "unexpected '" + std::string(1, c) + "'" : "unexpected end of expression");
+
+        size_t start = pos_;
+        while (pos_ < text_.size() && NameChar(text_[pos_])) ++pos_;
+        std::string_view name = text_.substr(start, pos_ - start);
+
+        auto variable = std::find(variables_.begin(), variables_.end(), name);
+        if (variable != variables_.end()) {
+            Instruction in;
+            in.op = OpCode::Variable;
+            in.index = static_cast<uint32_t>(variable - variables_.begin());
+            program_.push_back(in);
+            dimensions_.push_back(Dimensions::Dimensionless);
+            return true;
+        }
+        if (name == "pi" || name == "PI") {
+            EmitConstant(PI_CONST);
+            return true;
+        }
+        if (name == "e" || name == "E") {
+            EmitConstant(2.718281828459045);
+            return true;
+        }
+        if (name == "phi") {
+            EmitConstant(1.618033988749895);
+            return true;
+        }
+
+        if (auto multi = MultiArgumentNames().find(name); multi != MultiArgumentNames().end()) {
+            if (!Accept('(')) return Fail("expected '(' after " + std::string(name));
+            return Arguments(name, multi->second);
+        }
+        auto function = FunctionNames().find(name);
+        if (function == FunctionNames().end()) return Fail("unknown name '" + std::string(name) + "'");
+        // "sin(x)" or "sin x"; the latter binds to the next primary, as in AlgebraicParser
+        return Primary() && EmitFunction(function->second);
+    }
+
+    std::string_view text_;
+    const std::vector<std::string>& variables_;
+    const UnitManager* units_;
+    size_t pos_ = 0;
+    std::vector<Instruction> program_;
+    std::vector<Dimension> dimensions_;   // Parallel to the evaluation stack
+    std::string error_;
+    bool has_units_ = false;
+    bool dimension_error_ = false;
+};
+
+} // namespace
+
+size_t CompiledExpression::NumberLength(std::string_view text) {
+    // "2e" alone is 2 * e: only take an exponent that has digits
+    size_t stop = 0;
+    while (stop < text.size() && (std::isdigit(static_cast<unsigned char>(text[stop])) || text[stop] == '.')) ++stop;
+    if (stop > 0 && stop < text.size() && (text[stop] == 'e' || text[stop] == 'E')) {
+        size_t q = stop + 1;
+        if (q < text.size() && (text[q] == '+' || text[q] == '-')) ++q;
+        if (q < text.size() && std::isdigit(static_cast<unsigned char>(text[q]))) {
+            stop = q;
+            while (stop < text.size() && std::isdigit(static_cast<unsigned char>(text[stop]))) ++stop;
+        }
+    }
+    return stop;
+}
+
+std::optional<CompiledExpression> CompiledExpression::Compile(std::string_view expression,
+                                                              const std::vector<std::string>& variables,
+                                                              std::string* error) {
+    return Compile(expression, variables, nullptr, error, nullptr);
+}
+
+std::optional<CompiledExpression> CompiledExpression::Compile(std::string_view expression,
+                                                              const std::vector<std::string>& variables,
+                                                              const UnitManager& units, std::string* error,
+                                                              bool* dimension_error) {
+    return Compile(expression, variables, &units, error, dimension_error);
+}
+
+std::optional<CompiledExpression> CompiledExpression::Compile(std::string_view expression,
+                                                              const std::vector<std::string>& variables,
+                                                              const UnitManager* units, std::string* error,
+                                                              bool* dimension_error) {
+    std::string reason;
+    CompiledExpression compiled;
+    Compiler compiler(expression, variables, units);
+    const bool ok = compiler.Run(compiled.program_, reason);
+    if (dimension_error) *dimension_error = !ok && compiler.DimensionError();
+    if (!ok) {
+        if (error) *error = reason;
+        return std::nullopt;
+    }
+    compiled.result_dimension_ = compiler.ResultDimension();
+    compiled.has_units_ = compiler.HasUnits();
+
+    size_t depth = 0;
+    for (const auto& in : compiled.program_) {
+        if (in.op == OpCode::Constant || in.op == OpCode::Variable) {
+            compiled.max_depth_ = std::max(compiled.max_depth_, ++depth);
+        } else if (in.op != OpCode::Neg && in.op != OpCode::Function && in.op != OpCode::PowInt) {
+            --depth;
+        }
+    }
+    compiled.variable_count_ = variables.size();
+    if (compiled.variable_count_ == 1) compiled.polynomial_ = MonomialSum(compiled.program_);
+    return compiled;
+}
+
+bool CompiledExpression::IsConstant() const {
+    return program_.size() == 1 && program_[0].op == OpCode::Constant;
+}
+
+uint64_t CompiledExpression::Fingerprint() const {
+    // FNV-1a over every field of every instruction
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](uint64_t v) {
+        for (int k = 0; k < 8; ++k, v >>= 8) hash = (hash ^ (v & 0xFF)) * 0x100000001b3ull;
+    };
+    mix(variable_count_);
+    if (has_units_) {
+        for (int8_t e : result_dimension_.exponents) mix(static_cast<uint8_t>(e));
+    }
+    for (const auto& in : program_) {
+        uint64_t bits;
+        std::memcpy(&bits, &in.value, sizeof(bits));
+        mix((static_cast<uint64_t>(in.op) << 40) | (static_cast<uint64_t>(in.function) << 32) | in.index);
+        mix(bits);
+    }
+    return hash;
+}
+
+void CompiledExpression::EvaluateBlock(const double* const* inputs, size_t offset, double* out, size_t m,
+                                       double* stack, size_t stride) const {
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    size_t sp = 0;
+    for (const auto& in : program_) {
+        double* top = stack + (sp - 1) * stride;   // Only read once sp >= 1
+        switch (in.op) {
+            case OpCode::Constant:
+                std::fill_n(stack + sp++ * stride, m, in.value);
+                break;
+            case OpCode::Variable:
+                std::copy_n(inputs[in.index] + offset, m, stack + sp++ * stride);
+                break;
+            case OpCode::Neg:
+                for (size_t i = 0; i < m; ++i) top[i] = -top[i];
+                break;
+            case OpCode::PowInt: {
+                const long long n = static_cast<long long>(in.value);
+                if (n == 2) {
+                    for (size_t i = 0; i < m; ++i) top[i] *= top[i];
+                } else {
+                    for (size_t i = 0; i < m; ++i) top[i] = PowInt(top[i], n);
+                }
+                break;
+            }
+            case OpCode::Function:
+                if (in.function == Function::Exp) {
+                    kernels.exp(top, top, m);
+                } else if (in.function == Function::Ln) {
+                    for (size_t i = 0; i < m; ++i) top[i] = top[i] > 0.0 ? top[i] : kNaN;
+                    kernels.log(top, top, m);
+                } else {
+                    for (size_t i = 0; i < m; ++i) top[i] = ApplyFunction(in.function, top[i]);
+                }
+                break;
+            default: {
+                double* a = top - stride;
+                const double* b = top;
+                --sp;
+                switch (in.op) {
+                    case OpCode::Add: for (size_t i = 0; i < m; ++i) a[i] += b[i]; break;
+                    case OpCode::Sub: for (size_t i = 0; i < m; ++i) a[i] -= b[i]; break;
+                    case OpCode::Mul: for (size_t i = 0; i < m; ++i) a[i] *= b[i]; break;
+                    case OpCode::Div:
+                        for (size_t i = 0; i < m; ++i) a[i] = b[i] == 0.0 ? kNaN : a[i] / b[i];
+                        break;
+                    default:
+                        for (size_t i = 0; i < m; ++i) a[i] = ApplyBinary(in.op, a[i], b[i]);
+                        break;
+                }
+                break;
+            }
+        }
+    }
+    std::copy_n(stack, m, out);
+}
+
+void CompiledExpression::Evaluate(const double* const* inputs, double* out, size_t n) const {
+    if (!polynomial_.empty()) {
+        // Horner's rule through the SIMD kernel, no stack program
+        const auto& kernels = AXIOM::SIMD::Kernels();
+        AXIOM::Parallel::ParallelFor(0, n, AXIOM::Parallel::DefaultGrain(n, kBlock), [&](size_t lo, size_t hi) {
+            kernels.poly_eval(polynomial_.data(), polynomial_.size() - 1, inputs[0] + lo, out + lo, hi - lo);
+        });
+        return;
+    }
+    AXIOM::Parallel::ParallelFor(0, n, AXIOM::Parallel::DefaultGrain(n, kBlock), [&](size_t lo, size_t hi) {
+        std::vector<double> stack(std::max<size_t>(max_depth_, 1) * kBlock);
+        for (size_t start = lo; start < hi; start += kBlock) {
+            size_t m = std::min(kBlock, hi - start);
+            EvaluateBlock(inputs, start, out + start, m, stack.data(), kBlock);
+        }
+    });
+}
+
+double CompiledExpression::EvaluateAt(const double* values) const {
+    if (!polynomial_.empty()) {
+        double out;
+        AXIOM::SIMD::Kernels().poly_eval(polynomial_.data(), polynomial_.size() - 1, values, &out, 1);
+        return out;
+    }
+    std::vector<const double*> inputs(variable_count_);
+    for (size_t v = 0; v < variable_count_; ++v) inputs[v] = values + v;
+    std::vector<double> stack(std::max<size_t>(max_depth_, 1));
+    double out;
+    EvaluateBlock(inputs.data(), 0, &out, 1, stack.data(), 1);
+    return out;
+}
@@ -4,32 +4,193 @@
  */
 
 #include "cpu_optimization.h"
+#include "simd_kernels.h"
 #include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define AXIOM_X86 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
 
 namespace AXIOM {
 
+namespace {
+
+#ifdef AXIOM_X86
+void Cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(out[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+uint64_t ReadXCR0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+} // namespace
+
+CPUFeatures CPUOptimization::QueryCPUID() {
+    CPUFeatures f;
+#ifdef AXIOM_X86
+    uint32_t r[4] = {0, 0, 0, 0};
+    Cpuid(0, 0, r);
+    uint32_t max_leaf = r[0];
+    char vendor[13] = {0};
+    std::memcpy(vendor + 0, &r[1], 4);
+    std::memcpy(vendor + 4, &r[3], 4);
+    std::memcpy(vendor + 8, &r[2], 4);
+    f.vendor = vendor;
+
+    if (max_leaf >= 1) {
+        Cpuid(1, 0, r);
+        f.sse2 = (r[3] >> 26) & 1;
+        f.sse41 = (r[2] >> 19) & 1;
+        f.fma = (r[2] >> 12) & 1;
+        bool osxsave = (r[2] >> 27) & 1;
+        f.avx = (r[2] >> 28) & 1;
+
+        if (osxsave) {
+            uint64_t xcr0 = ReadXCR0();
+            f.os_avx = (xcr0 & 0x6) == 0x6;          // XMM | YMM
+            f.os_avx512 = (xcr0 & 0xE6) == 0xE6;     // + opmask | ZMM_Hi256 | Hi16_ZMM
+        }
+    }
+
+    if (max_leaf >= 7) {
+        Cpuid(7, 0, r);
+        f.avx2 = (r[1] >> 5) & 1;
+        f.avx512f = (r[1] >> 16) & 1;
+    }
+
+    Cpuid(0x80000000u, 0, r);
+    if (r[0] >= 0x80000004u) {
+        char brand[49] = {0};
+        for (uint32_t leaf = 0; leaf < 3; ++leaf) {
+            Cpuid(0x80000002u + leaf, 0, r);
+            std::memcpy(brand + leaf * 16, r, 16);
+        }
+        f.brand = brand;
+        size_t start = f.brand.find_first_not_of(' ');
+        f.brand = (start == std::string::npos) ? "" : f.brand.substr(start);
+    }
+#else
+    f.vendor = "non-x86";
+#endif
+    return f;
+}
+
+const CPUFeatures& CPUOptimization::GetFeatures() {
+    static const CPUFeatures features = QueryCPUID();
+    return features;
+}
+
+ISALevel CPUOptimization::GetISALevel() {
+    static const ISALevel level = [] {
+        ISALevel detected = ISALevel::Scalar;
+        if (DetectAVX512()) detected = ISALevel::AVX512;
+        else if (DetectAVX2() && DetectFMA()) detected = ISALevel::AVX2;
+
+        // Allow forcing a lower level (never a higher one) for testing
+        if (const char* env = std::getenv("AXIOM_ISA")) {
+            std::string requested(env);
+            ISALevel forced = detected;
+            if (requested == "scalar") forced = ISALevel::Scalar;
+            else if (requested == "avx2") forced = ISALevel::AVX2;
+            else if (requested == "avx512") forced = ISALevel::AVX512;
+            if (static_cast<int>(forced) < static_cast<int>(detected)) detected = forced;
+        }
+        return detected;
+    }();
+    return level;
+}
+
+std::string CPUOptimization::ISALevelToString(ISALevel level) {
+    switch (level) {
+        case ISALevel::Scalar: return "scalar";
+        case ISALevel::AVX2: return "avx2+fma";
+        case ISALevel::AVX512: return "avx512f";
+        default: return "unknown";
+    }
+}
+
 void CPUOptimization::Initialize() {
-    std::cout << "🚀 CPU optimizations initialized" << std::endl;
+    // Resolve kernel pointers up front so the first hot call pays nothing
+    SIMD::Kernels();
+    std::cout << "🚀 CPU optimizations initialized (" << ISALevelToString(GetISALevel()) << ")" << std::endl;
 }
 
 std::string CPUOptimization::GetCPUInfo() {
-    return "CPU optimization module loaded";
+    const auto& f = GetFeatures();
+    const auto& k = SIMD::Kernels();
+
+    std::ostringstream info;
+    info << "CPU: " << (f.brand.empty() ? f.vendor : f.brand) << "\n";
+    info << "Features:";
+    if (f.sse2) info << " sse2";
+    if (f.sse41) info << " sse4.1";
+    if (f.avx) info << " avx";
+    if (f.avx2) info << " avx2";
+    if (f.fma) info << " fma";
+    if (f.avx512f) info << " avx512f";
+    info << "\n";
+    info << "OS vector state: ymm=" << (f.os_avx ? "yes" : "no")
+         << " zmm=" << (f.os_avx512 ? "yes" : "no") << "\n";
+    info << "Selected ISA: " << ISALevelToString(GetISALevel()) << "\n";
+    info << "Kernel paths:\n";
+    info << "  sum/dot/moments: " << k.reduction_path << "\n";
+    info << "  gemm:            " << k.gemm_path << "\n";
+    info << "  batch eval:      " << k.batch_eval_path << "\n";
+    info << "  exp/log/normal:  " << k.special_path << "\n";
+    info << "  histogram bins:  " << k.binning_path << "\n";
+    return info.str();
 }
 
 void CPUOptimization::OptimizeForCurrentCPU() {
+    Initialize();
     std::cout << "🏎️ CPU optimizations applied for Senna speed!" << std::endl;
 }
 
 bool CPUOptimization::DetectSSE() {
-    return true;  // Simplified detection
+    return GetFeatures().sse2;
 }
 
 bool CPUOptimization::DetectAVX() {
-    return true;  // Simplified detection  
+    const auto& f = GetFeatures();
+    return f.avx && f.os_avx;
 }
 
 bool CPUOptimization::DetectAVX2() {
-    return true;  // Simplified detection
+    const auto& f = GetFeatures();
+    return f.avx2 && f.os_avx;
+}
+
+bool CPUOptimization::DetectFMA() {
+    const auto& f = GetFeatures();
+    return f.fma && f.os_avx;
+}
+
+bool CPUOptimization::DetectAVX512() {
+    const auto& f = GetFeatures();
+    return f.avx512f && f.os_avx512;
 }
 
-} // namespace AXIOM
\ No newline at end of file
+} // namespace AXIOM
@@ -0,0 +1,258 @@
+/**
+ * @file curve_sampling.cpp
+ * @brief Level-batched bisection on pixel-space deviation, plus jump classification
+ */
+
+#include "curve_sampling.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct Point {
+    double x;
+    double y;
+    bool verified = false;   // Seed point whose intervals already passed at this scale
+};
+
+struct Interval {
+    Point a;
+    Point b;
+};
+
+class Sampler {
+public:
+    Sampler(const CompiledExpression& expression, double x_min, double x_max, const CurveSampling::Options& options)
+        : expression_(expression), options_(options) {
+        const double y_span = options.y_max - options.y_min;
+        y_scale_ = static_cast<double>(std::max<size_t>(options.y_pixels, 1)) / y_span;
+        // One plot height of margin keeps the slope at the edges right
+        y_low_ = options.y_min - y_span;
+        y_high_ = options.y_max + y_span;
+        x_scale_ = static_cast<double>(std::max<size_t>(options.x_pixels, 1)) / (x_max - x_min);
+        min_step_ = options.min_step_pixels / x_scale_;
+    }
+
+    CurveSampling::Curve Run(double x_min, double x_max, const CurveSampling::Curve* seed) {
+        Refine(seed && seed->Size() > 0 ? Seeded(x_min, x_max, *seed) : Grid(x_min, x_max));
+        std::sort(points_.begin(), points_.end(), [](const Point& p, const Point& q) { return p.x < q.x; });
+        ProbeJumps();
+        std::sort(points_.begin(), points_.end(), [](const Point& p, const Point& q) { return p.x < q.x; });
+        CurveSampling::Curve curve = Collect();
+        curve.x_scale = x_scale_;
+        curve.y_scale = y_scale_;
+        return curve;
+    }
+
+private:
+    Vector Evaluate(const Vector& xs) {
+        Vector ys(xs.size());
+        expression_.Evaluate(xs.data(), ys.data(), xs.size());
+        evaluations_ += xs.size();
+        return ys;
+    }
+
+    std::vector<Interval> Grid(double x_min, double x_max) {
+        const double pixels = static_cast<double>(std::max<size_t>(options_.x_pixels, 1));
+        const size_t steps = static_cast<size_t>(std::ceil(pixels / std::max(options_.initial_step_pixels, 1e-3)));
+        Vector grid(steps + 1);
+        for (size_t i = 0; i <= steps; ++i) {
+            grid[i] = x_min + (x_max - x_min) * static_cast<double>(i) / static_cast<double>(steps);
+        }
+        grid[steps] = x_max;
+        Vector values = Evaluate(grid);
+        std::vector<Interval> candidates;
+        for (size_t i = 0; i <= steps; ++i) {
+            points_.push_back({grid[i], values[i]});
+            if (i > 0) candidates.push_back({points_[i - 1], points_[i]});
+        }
+        return candidates;
+    }
+
+    /**
+     * Starts from the seed's points inside [x_min, x_max] and evaluates only
+     * the ends and the grid points of gaps wider than the coarse step. Seed
+     * intervals are tested again only when the scale grew: at the same or a
+     * smaller scale their midpoint deviation can only have shrunk.
+     */
+    std::vector<Interval> Seeded(double x_min, double x_max, const CurveSampling::Curve& seed) {
+        const bool verified = seed.x_scale >= x_scale_ * (1.0 - 1e-12) && seed.y_scale >= y_scale_ * (1.0 - 1e-12);
+        const size_t first = static_cast<size_t>(std::lower_bound(seed.x.begin(), seed.x.end(), x_min) - seed.x.begin());
+        const size_t last = static_cast<size_t>(std::upper_bound(seed.x.begin(), seed.x.end(), x_max) - seed.x.begin());
+
+        const bool need_lo = first == last || seed.x[first] > x_min;
+        const bool need_hi = first == last || seed.x[last - 1] < x_max;
+        Vector anchors;
+        if (need_lo) anchors.push_back(x_min);
+        anchors.insert(anchors.end(), seed.x.begin() + first, seed.x.begin() + last);
+        if (need_hi) anchors.push_back(x_max);
+
+        Vector fresh;
+        if (need_lo) fresh.push_back(x_min);
+        const double step = std::max(options_.initial_step_pixels, 1e-3) / x_scale_;
+        for (size_t i = 0; i + 1 < anchors.size(); ++i) {
+            const double a = anchors[i], b = anchors[i + 1];
+            const size_t parts = static_cast<size_t>(std::ceil((b - a) / step));
+            for (size_t k = 1; k < parts; ++k) fresh.push_back(a + (b - a) * static_cast<double>(k) / static_cast<double>(parts));
+        }
+        if (need_hi) fresh.push_back(x_max);
+
+        Vector values = Evaluate(fresh);
+        // Both ends of a seed break are tested again so the break is found anew
+        auto broken = [&](size_t i) {
+            return std::binary_search(seed.breaks.begin(), seed.breaks.end(), i) ||
+                   (i > 0 && std::binary_search(seed.breaks.begin(), seed.breaks.end(), i - 1));
+        };
+        for (size_t i = first; i < last; ++i) points_.push_back({seed.x[i], seed.y[i], verified && !broken(i)});
+        for (size_t i = 0; i < fresh.size(); ++i) points_.push_back({fresh[i], values[i]});
+        std::sort(points_.begin(), points_.end(), [](const Point& p, const Point& q) { return p.x < q.x; });
+
+        std::vector<Interval> candidates;
+        for (size_t i = 0; i + 1 < points_.size(); ++i) {
+            if (!(points_[i].verified && points_[i + 1].verified)) candidates.push_back({points_[i], points_[i + 1]});
+        }
+        return candidates;
+    }
+
+    double PixelY(double y) const { return (std::clamp(y, y_low_, y_high_) - options_.y_min) * y_scale_; }
+
+    // Pixel distance between two finite values
+    double Jump(const Point& p, const Point& q) const { return std::abs(PixelY(q.y) - PixelY(p.y)); }
+
+    bool NeedsSplit(const Point& a, const Point& m, const Point& b) const {
+        int finite = std::isfinite(a.y) + std::isfinite(m.y) + std::isfinite(b.y);
+        if (finite == 0) return false;
+        if (finite < 3) return true;   // Locate the edge of the domain
+        double chord = 0.5 * (PixelY(a.y) + PixelY(b.y));
+        return std::abs(PixelY(m.y) - chord) > options_.tolerance_pixels;
+    }
+
+    // One batched evaluation per level; only intervals that failed the test are split again
+    void Refine(std::vector<Interval> candidates) {
+        while (!candidates.empty()) {
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                            [&](const Interval& s) { return s.b.x - s.a.x <= min_step_; }),
+                             candidates.end());
+            Vector mids(candidates.size());
+            for (size_t i = 0; i < candidates.size(); ++i) mids[i] = 0.5 * (candidates[i].a.x + candidates[i].b.x);
+            Vector values = Evaluate(mids);
+
+            std::vector<Interval> next;
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                Point m{mids[i], values[i]};
+                points_.push_back(m);
+                if (NeedsSplit(candidates[i].a, m, candidates[i].b)) {
+                    next.push_back({candidates[i].a, m});
+                    next.push_back({m, candidates[i].b});
+                }
+            }
+            candidates = std::move(next);
+        }
+    }
+
+    /**
+     * Follows each large jump down jump_probe_levels bisections, always into
+     * the half holding most of it. A jump that has not at least halved by
+     * then (or an edge of the domain) is a break.
+     */
+    void ProbeJumps() {
+        struct Probe {
+            Interval span;
+            double initial = 0.0;
+            bool open = true;
+        };
+        std::vector<Probe> probes;
+        for (size_t i = 0; i + 1 < points_.size(); ++i) {
+            const Point& a = points_[i];
+            const Point& b = points_[i + 1];
+            bool fa = std::isfinite(a.y), fb = std::isfinite(b.y);
+            // A jump Refine() could still split is only a steep straight stretch
+            bool bottomed_out = b.x - a.x <= min_step_;
+            if (fa != fb) probes.push_back({{a, b}, 0.0});
+            else if (fa && bottomed_out && Jump(a, b) > options_.jump_pixels) probes.push_back({{a, b}, Jump(a, b)});
+        }
+
+        for (size_t level = 0; level < options_.jump_probe_levels; ++level) {
+            Vector mids;
+            std::vector<Probe*> open;
+            for (auto& probe : probes) {
+                if (!probe.open) continue;
+                mids.push_back(0.5 * (probe.span.a.x + probe.span.b.x));
+                open.push_back(&probe);
+            }
+            if (open.empty()) break;
+            Vector values = Evaluate(mids);
+
+            for (size_t i = 0; i < open.size(); ++i) {
+                Probe& probe = *open[i];
+                Point m{mids[i], values[i]};
+                points_.push_back(m);
+                const Point& a = probe.span.a;
+                const Point& b = probe.span.b;
+                if (std::isfinite(a.y) != std::isfinite(b.y)) {
+                    probe.span = std::isfinite(a.y) == std::isfinite(m.y) ? Interval{m, b} : Interval{a, m};
+                    continue;
+                }
+                if (!std::isfinite(m.y)) {
+                    probe.open = false;   // A hole; Collect() breaks the line there
+                    continue;
+                }
+                probe.span = Jump(a, m) >= Jump(m, b) ? Interval{a, m} : Interval{m, b};
+                if (Jump(probe.span.a, probe.span.b) <= options_.tolerance_pixels) probe.open = false;
+            }
+        }
+
+        for (const auto& probe : probes) {
+            if (!probe.open) continue;
+            bool edge = std::isfinite(probe.span.a.y) != std::isfinite(probe.span.b.y);
+            if (!edge && Jump(probe.span.a, probe.span.b) > 0.5 * probe.initial) breaks_.push_back(probe.span.a.x);
+        }
+        std::sort(breaks_.begin(), breaks_.end());
+    }
+
+    // Drops non-finite points; a dropped point or a classified jump breaks the line
+    CurveSampling::Curve Collect() {
+        CurveSampling::Curve curve;
+        curve.x.reserve(points_.size());
+        curve.y.reserve(points_.size());
+        bool pending = false;
+        for (const auto& p : points_) {
+            if (!std::isfinite(p.y)) {
+                pending = !curve.x.empty();
+                continue;
+            }
+            if (pending) curve.breaks.push_back(curve.x.size() - 1);
+            curve.x.push_back(p.x);
+            curve.y.push_back(p.y);
+            pending = std::binary_search(breaks_.begin(), breaks_.end(), p.x);
+        }
+        curve.evaluations = evaluations_;
+        return curve;
+    }
+
+    const CompiledExpression& expression_;
+    const CurveSampling::Options& options_;
+    double x_scale_ = 1.0;
+    double y_scale_ = 1.0;
+    double y_low_ = 0.0;
+    double y_high_ = 0.0;
+    double min_step_ = 0.0;
+    std::vector<Point> points_;
+    Vector breaks_;   // x of the left point of each classified jump
+    size_t evaluations_ = 0;
+};
+
+} // namespace
+
+namespace CurveSampling {
+
+Curve Sample(const CompiledExpression& expression, double x_min, double x_max, const Options& options,
+             const Curve* seed) {
+    if (!(x_min < x_max) || !std::isfinite(x_max - x_min) || !(options.y_min < options.y_max) ||
+        expression.VariableCount() != 1) {
+        return {};
+    }
+    return Sampler(expression, x_min, x_max, options).Run(x_min, x_max, seed);
+}
+
+} // namespace CurveSampling
@@ -7,13 +7,15 @@
 
 #include "daemon_engine.h"
 #include "dynamic_calc.h"
-#include "algebraic_parser.h"
-#include "linear_system_parser.h"
+#include "string_helpers.h"
 
+#include <iostream>
 #include <sstream>
+#include <fstream>
 #include <random>
 #include <iomanip>
 #include <algorithm>
+#include <optional>
 
 #ifdef _WIN32
     #include <io.h>
@@ -21,10 +23,224 @@
 #else
     #include <signal.h>
     #include <sys/wait.h>
+    #include <poll.h>
 #endif
 
 namespace AXIOM {
 
+// ============================================================================
+// DaemonConfig Implementation
+// ============================================================================
+
+namespace {
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+std::string Trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r\n");
+    return s.substr(start, end - start + 1);
+}
+
+std::string DescribeRole(const DaemonThreadRole& role) {
+    std::ostringstream ss;
+    ss << role.threads << " thread(s), cpus ";
+    if (role.placement.cpus.empty()) {
+        ss << "any";
+    } else {
+        for (size_t i = 0; i < role.placement.cpus.size(); ++i) {
+            ss << (i ? "," : "") << role.placement.cpus[i];
+        }
+        ss << (role.placement.pin_each ? " (pinned)" : " (shared)");
+    }
+    if (role.placement.fifo_priority > 0) ss << ", fifo:" << role.placement.fifo_priority;
+    else if (role.placement.nice != 0) ss << ", nice " << role.placement.nice;
+    ss << ", spin " << role.spin_us << "us";
+    return ss.str();
+}
+
+// Request mode names as typed at the REPL prompt; empty means algebraic
+std::optional<CalculationMode> ModeFromName(const std::string& name) {
+    if (name.empty() || name == "algebraic") return CalculationMode::ALGEBRAIC;
+    if (name == "linear") return CalculationMode::LINEAR_SYSTEM;
+    if (name == "statistics") return CalculationMode::STATISTICS;
+    if (name == "symbolic") return CalculationMode::SYMBOLIC;
+    if (name == "units") return CalculationMode::UNITS;
+    if (name == "plot") return CalculationMode::PLOT;
+    return std::nullopt;
+}
+
+std::string FormatResult(const EngineResult& result) {
+    if (!result.HasResult()) throw std::runtime_error("calculation error");
+
+    std::ostringstream oss;
+    oss << std::setprecision(15);
+    std::visit([&oss, &result](const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, Vector>) {
+            for (size_t i = 0; i < value.size(); ++i) {
+                oss << (i ? ", " : "") << "x" << i << " = " << value[i];
+            }
+        } else if constexpr (std::is_same_v<T, Matrix>) {
+            for (size_t r = 0; r < value.size(); ++r) {
+                oss << (r ? "; " : "");
+                for (size_t c = 0; c < value[r].size(); ++c) oss << (c ? " " : "") << value[r][c];
+            }
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            oss << value;
+        } else {
+            std::complex<double> z = result.GetComplex().value_or(0.0);
+            oss << z.real();
+            if (z.imag() != 0.0) oss << (z.imag() < 0 ? " - " : " + ") << std::abs(z.imag()) << "i";
+        }
+    }, *result.result);
+    return oss.str();
+}
+
+} // namespace
+
+bool DaemonConfig::Set(const std::string& key, const std::string& value, std::string& error) {
+    size_t dot = key.find('.');
+    if (dot == std::string::npos) {
+        error = "Expected <role>.<field>: " + key;
+        return false;
+    }
+    std::string role_name = key.substr(0, dot);
+    std::string field = key.substr(dot + 1);
+
+    DaemonThreadRole* role = nullptr;
+    if (role_name == "io") role = &io;
+    else if (role_name == "compute") role = &compute;
+    else if (role_name == "pool") role = &pool;
+    else {
+        error = "Unknown thread role: " + role_name;
+        return false;
+    }
+
+    try {
+        if (field == "threads") {
+            size_t threads = std::stoul(value);
+            if (role == &io && threads != 1) {
+                error = "io.threads must be 1 (single pipe reader)";
+                return false;
+            }
+            if (role == &compute && threads == 0) {
+                error = "compute.threads must be at least 1";
+                return false;
+            }
+            role->threads = threads;
+        } else if (field == "cpus") {
+            if (!ParseCPUList(value, role->placement.cpus)) {
+                error = "Invalid CPU list: " + value;
+                return false;
+            }
+        } else if (field == "pin") {
+            role->placement.pin_each = (value == "true" || value == "1" || value == "yes");
+        } else if (field == "sched") {
+            if (value == "other") {
+                role->placement.fifo_priority = 0;
+            } else if (value.rfind("fifo:", 0) == 0) {
+                int priority = std::stoi(value.substr(5));
+                if (priority < 1 || priority > 99) {
+                    error = "SCHED_FIFO priority must be in 1..99";
+                    return false;
+                }
+                role->placement.fifo_priority = priority;
+            } else {
+                error = "Expected sched = other | fifo:PRIO, got " + value;
+                return false;
+            }
+        } else if (field == "nice") {
+            int nice = std::stoi(value);
+            if (nice < -20 || nice > 19) {
+                error = "nice must be in -20..19";
+                return false;
+            }
+            role->placement.nice = nice;
+        } else if (field == "spin_us") {
+            role->spin_us = std::stoi(value);
+        } else {
+            error = "Unknown field: " + field;
+            return false;
+        }
+    } catch (const std::exception&) {
+        error = "Invalid value for " + key + ": " + value;
+        return false;
+    }
+    return true;
+}
+
+bool DaemonConfig::LoadFile(const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "Cannot open daemon config: " + path;
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = Trim(line);
+        if (line.empty()) continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            error = path + ":" + std::to_string(line_number) + ": expected key = value";
+            return false;
+        }
+        if (!Set(Trim(line.substr(0, eq)), Trim(line.substr(eq + 1)), error)) {
+            error = path + ":" + std::to_string(line_number) + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DaemonConfig::ApplyArgs(const std::vector<std::string>& args, std::string& error) {
+    // Config file first so explicit flags override it regardless of order
+    for (const auto& arg : args) {
+        if (arg.starts_with("--daemon-config=") && !LoadFile(arg.substr(16), error)) {
+            return false;
+        }
+    }
+
+    for (const auto& arg : args) {
+        for (const char* role : {"io", "compute", "pool"}) {
+            std::string prefix = std::string("--") + role + "-";
+            if (!arg.starts_with(prefix)) continue;
+            size_t eq = arg.find('=');
+            if (eq == std::string::npos) {
+                error = "Expected " + arg + "=VALUE";
+                return false;
+            }
+            std::string field = arg.substr(prefix.size(), eq - prefix.size());
+            std::replace(field.begin(), field.end(), '-', '_');
+            if (!Set(std::string(role) + "." + field, arg.substr(eq + 1), error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string DaemonConfig::Describe() const {
+    std::ostringstream ss;
+    ss << "io:      " << DescribeRole(io) << "\n";
+    ss << "compute: " << DescribeRole(compute) << "\n";
+    ss << "pool:    " << DescribeRole(pool);
+    return ss.str();
+}
+
 // ============================================================================
 // SessionContext Implementation
 // ============================================================================
@@ -37,8 +253,7 @@ SessionContext::SessionContext(const std::string& id)
 {
     // Initialize computation engines
     try {
-        algebraic_parser = std::make_unique<AlgebraicParser>();
-        linear_parser = std::make_unique<LinearSystemParser>();
+        calc = std::make_unique<DynamicCalc>();
         
         history.push_back("Session " + session_id + " initialized at " + 
                          std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -55,8 +270,9 @@ SessionContext::~SessionContext() = default;
 // DaemonEngine Implementation  
 // ============================================================================
 
-DaemonEngine::DaemonEngine(const std::string& pipe_name)
+DaemonEngine::DaemonEngine(const std::string& pipe_name, const DaemonConfig& config)
     : pipe_name_(pipe_name)
+    , config_(config)
     , startup_time_(std::chrono::steady_clock::now())
 #ifdef _WIN32
     , pipe_handle_(INVALID_HANDLE_VALUE)
@@ -77,6 +293,23 @@ bool DaemonEngine::start() {
     
     status_.store(DaemonStatus::STARTING);
     
+    // Size and place the shared compute pool before any engine touches it. A pool
+    // with work in flight cannot be replaced; running on it would make the
+    // reported layout a lie, so the daemon refuses to start instead.
+    const DaemonThreadRole& pool = config_.pool;
+    if (pool.threads > 0 || !pool.placement.cpus.empty() || pool.placement.fifo_priority > 0 ||
+        pool.placement.nice != 0 || pool.spin_us != ThreadPoolConfig{}.spin_us) {
+        ThreadPoolConfig pool_config;
+        pool_config.num_threads = pool.threads;
+        pool_config.placement = pool.placement;
+        pool_config.spin_us = pool.spin_us;
+        if (!ThreadPool::ConfigureGlobal(pool_config)) {
+            std::cerr << "Daemon: compute pool is busy; requested pool layout not applied\n";
+            status_.store(DaemonStatus::ERROR);
+            return false;
+        }
+    }
+    
     if (!setup_pipe()) {
         status_.store(DaemonStatus::ERROR);
         return false;
@@ -84,16 +317,33 @@ bool DaemonEngine::start() {
     
     running_.store(true);
     
+    {
+        std::lock_guard<std::mutex> lock(layout_mutex_);
+        thread_layout_.assign(1 + config_.compute.threads, "starting");
+    }
+    
     // Start daemon communication thread
     daemon_thread_ = std::thread(&DaemonEngine::daemon_loop, this);
     
-    // Start request processor thread
-    request_processor_ = std::thread(&DaemonEngine::request_processor_loop, this);
+    // Start request processor threads
+    for (size_t i = 0; i < config_.compute.threads; ++i) {
+        request_processors_.emplace_back(&DaemonEngine::request_processor_loop, this, i);
+    }
     
     status_.store(DaemonStatus::READY);
     return true;
 }
 
+void DaemonEngine::record_layout(const std::string& role, size_t index, const DaemonThreadRole& config) {
+    std::string applied = ApplyThreadPlacement(config.placement, index);
+    size_t slot = (role == "io") ? 0 : 1 + index;
+    std::lock_guard<std::mutex> lock(layout_mutex_);
+    if (slot < thread_layout_.size()) {
+        thread_layout_[slot] = role + "[" + std::to_string(index) + "] " + applied +
+                               ", spin " + std::to_string(config.spin_us) + "us";
+    }
+}
+
 void DaemonEngine::stop() {
     running_.store(false);
     status_.store(DaemonStatus::SHUTDOWN);
@@ -105,9 +355,12 @@ void DaemonEngine::stop() {
         daemon_thread_.join();
     }
     
-    if (request_processor_.joinable()) {
-        request_processor_.join();
+    for (auto& processor : request_processors_) {
+        if (processor.joinable()) {
+            processor.join();
+        }
     }
+    request_processors_.clear();
     
     cleanup_pipe();
     
@@ -162,6 +415,12 @@ void DaemonEngine::cleanup_pipe() {
 }
 
 void DaemonEngine::daemon_loop() {
+    record_layout("io", 0, config_.io);
+#ifndef _WIN32
+    const auto spin = std::chrono::microseconds(config_.io.spin_us);
+    auto last_activity = std::chrono::steady_clock::now();
+#endif
+    
     while (running_.load()) {
         try {
 #ifdef _WIN32
@@ -171,7 +430,7 @@ void DaemonEngine::daemon_loop() {
                 DWORD bytes_read = 0;
                 
                 if (ReadFile(pipe_handle_, buffer, sizeof(buffer) - 1, &bytes_read, nullptr)) {
-                    buffer[bytes_read] = '\\0';
+                    buffer[bytes_read] = '\0';
                     
                     // Parse request (simplified JSON-like format)
                     std::string request_str(buffer);
@@ -199,38 +458,86 @@ void DaemonEngine::daemon_loop() {
                 
                 DisconnectNamedPipe(pipe_handle_);
             }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
 #else
             // Linux FIFO handling
             char buffer[4096];
             ssize_t bytes_read = read(pipe_fd_, buffer, sizeof(buffer) - 1);
             
             if (bytes_read > 0) {
-                buffer[bytes_read] = '\\0';
+                buffer[bytes_read] = '\0';
                 
                 std::string request_str(buffer);
                 Request request;
                 request.command = request_str; // Simplified
-                request.request_id = next_request_id_.fetch_add(1);
-                request.timestamp = std::chrono::steady_clock::now();
-                
-                {
-                    std::lock_guard<std::mutex> lock(queue_mutex_);
-                    request_queue_.push(request);
-                }
-                queue_cv_.notify_one();
+                enqueue_request(std::move(request));
+                last_activity = std::chrono::steady_clock::now();
+                continue;
             }
+            
+            // Busy-poll for the spin window after the last message, then
+            // block in poll() instead of sleeping a fixed interval
+            if (spin > std::chrono::microseconds(0) &&
+                std::chrono::steady_clock::now() - last_activity < spin) {
+                CpuRelax();
+                continue;
+            }
+            pollfd pfd{pipe_fd_, POLLIN, 0};
+            poll(&pfd, 1, 10);
 #endif
         } catch (const std::exception& e) {
             // Log error and continue
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 }
 
-void DaemonEngine::request_processor_loop() {
+void DaemonEngine::enqueue_request(Request request) {
+    request.request_id = next_request_id_.fetch_add(1);
+    request.timestamp = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        request_queue_.push(std::move(request));
+        pending_requests_.fetch_add(1, std::memory_order_release);
+    }
+    queue_cv_.notify_one();
+}
+
+bool DaemonEngine::send_command(const std::string& session_id, const std::string& command,
+                                const std::string& mode) {
+    if (!running_.load()) {
+        return false;
+    }
+    Request request;
+    request.session_id = session_id;
+    request.command = command;
+    request.mode = mode;
+    enqueue_request(std::move(request));
+    return true;
+}
+
+DaemonEngine::Response DaemonEngine::process_request(const Request& request) {
+    // Synchronous path for in-process callers that need the result back
+    Response response = execute_command(request);
+    update_metrics(response.execution_time_ms);
+    total_requests_.fetch_add(1);
+    return response;
+}
+
+void DaemonEngine::request_processor_loop(size_t index) {
+    record_layout("compute", index, config_.compute);
+    const auto spin = std::chrono::microseconds(config_.compute.spin_us);
+    
     while (running_.load()) {
+        // Spin-before-park: poll the queue depth without taking the lock
+        if (spin > std::chrono::microseconds(0)) {
+            auto deadline = std::chrono::steady_clock::now() + spin;
+            while (pending_requests_.load(std::memory_order_acquire) == 0 && running_.load() &&
+                   std::chrono::steady_clock::now() < deadline) {
+                CpuRelax();
+            }
+        }
+        
         std::unique_lock<std::mutex> lock(queue_mutex_);
         
         // Wait for requests
@@ -242,17 +549,20 @@ void DaemonEngine::request_processor_loop() {
             break;
         }
         
-        Request request = request_queue_.front();
+        Request request = std::move(request_queue_.front());
         request_queue_.pop();
+        pending_requests_.fetch_sub(1, std::memory_order_relaxed);
         lock.unlock();
         
         // Process request
-        status_.store(DaemonStatus::BUSY);
+        if (busy_workers_.fetch_add(1) == 0) status_.store(DaemonStatus::BUSY);
         Response response = execute_command(request);
-        status_.store(DaemonStatus::READY);
+        if (busy_workers_.fetch_sub(1) == 1) status_.store(DaemonStatus::READY);
         
         // Update metrics
         update_metrics(response.execution_time_ms);
+        record_latency(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - request.timestamp).count());
         total_requests_.fetch_add(1);
         
         // Send response (simplified - in production would queue responses)
@@ -282,34 +592,22 @@ DaemonEngine::Response DaemonEngine::execute_command(const Request& request) {
         }
         
         SessionContext& session = **session_ptr;
+        std::lock_guard<std::mutex> session_lock(session.mutex);
         session.update_access_time();
         
         // Execute command based on mode
         std::string result;
         
-        if (request.mode == "algebraic" || request.mode.empty()) {
-            if (session.algebraic_parser) {
-                auto calc_result = session.algebraic_parser->parse(request.command);
-                if (calc_result.success) {
-                    result = std::to_string(calc_result.value);
-                } else {
-                    throw std::runtime_error(calc_result.error_message);
-                }
-            }
-        } else if (request.mode == "linear") {
-            if (session.linear_parser) {
-                auto calc_result = session.linear_parser->parse(request.command);
-                if (calc_result.success) {
-                    std::ostringstream oss;
-                    for (size_t i = 0; i < calc_result.linear_result.solution.size(); ++i) {
-                        if (i > 0) oss << ", ";
-                        oss << "x" << i << " = " << calc_result.linear_result.solution[i];
-                    }
-                    result = oss.str();
-                } else {
-                    throw std::runtime_error(calc_result.error_message);
-                }
-            }
+        // Raw pipe text carries no mode, so "stream ..." selects stream mode there
+        bool stream_prefixed = request.mode.empty() && request.command.rfind("stream ", 0) == 0;
+        
+        if (request.mode == "stream" || stream_prefixed) {
+            result = execute_stream_command(stream_prefixed ? request.command.substr(7) : request.command);
+        } else {
+            auto mode = ModeFromName(request.mode);
+            if (!mode) throw std::runtime_error("unknown mode: " + request.mode);
+            if (!session.calc) throw std::runtime_error("session engine unavailable");
+            result = FormatResult(session.calc->calculate(request.command, *mode));
         }
         
         // Add to session history
@@ -329,6 +627,81 @@ DaemonEngine::Response DaemonEngine::execute_command(const Request& request) {
     return response;
 }
 
+/**
+ * Stream commands (mode "stream"):
+ *   add NAME v1 v2 ...            append values
+ *   quantile NAME q [tdigest|kll] approximate quantile, q in [0, 1]
+ *   cdf NAME x [tdigest|kll]      approximate fraction <= x
+ *   describe NAME                 exact moments
+ *   export NAME                   base64 sketch blob for merging elsewhere
+ *   merge NAME BLOB               fold an exported blob into NAME
+ *   reset NAME | list
+ */
+std::string DaemonEngine::execute_stream_command(const std::string& command) {
+    std::vector<std::string> args = Utils::Split(command, ' ');
+    if (args.empty()) throw std::runtime_error("empty stream command");
+    const std::string& op = args[0];
+
+    if (op == "list") {
+        std::ostringstream oss;
+        for (const auto& name : streams_.Streams()) oss << name << "\n";
+        return oss.str();
+    }
+    if (args.size() < 2) throw std::runtime_error("usage: " + op + " NAME ...");
+    const std::string& name = args[1];
+
+    auto parse_number = [](const std::string& text) {
+        auto value = Utils::FastParseDouble(text);
+        if (!value) throw std::runtime_error("not a number: " + text);
+        return *value;
+    };
+    auto parse_kind = [&args](size_t at) {
+        if (args.size() <= at || args[at] == "tdigest") return SketchKind::TDigest;
+        if (args[at] == "kll") return SketchKind::KLL;
+        throw std::runtime_error("unknown sketch: " + args[at]);
+    };
+
+    std::ostringstream oss;
+    oss << std::setprecision(15);
+    if (op == "add") {
+        std::vector<double> values;
+        values.reserve(args.size() - 2);
+        for (size_t i = 2; i < args.size(); ++i) values.push_back(parse_number(args[i]));
+        streams_.Push(name, values.data(), values.size());
+        oss << values.size();
+    } else if (op == "quantile" || op == "cdf") {
+        if (args.size() < 3) throw std::runtime_error("usage: " + op + " NAME VALUE [tdigest|kll]");
+        double x = parse_number(args[2]);
+        auto value = op == "quantile" ? streams_.Quantile(name, x, parse_kind(3))
+                                      : streams_.CDF(name, x, parse_kind(3));
+        if (!value) throw std::runtime_error("no data for stream: " + name);
+        oss << *value;
+    } else if (op == "describe") {
+        auto stats = streams_.Describe(name);
+        if (!stats) throw std::runtime_error("unknown stream: " + name);
+        oss << "count=" << stats->count << " mean=" << stats->mean << " std_dev=" << stats->std_dev
+            << " min=" << stats->min << " max=" << stats->max
+            << " p50=" << streams_.Quantile(name, 0.5).value_or(0.0)
+            << " p99=" << streams_.Quantile(name, 0.99).value_or(0.0);
+    } else if (op == "export") {
+        auto blob = streams_.Serialize(name);
+        if (blob.empty()) throw std::runtime_error("unknown stream: " + name);
+        return Utils::Base64Encode(blob.data(), blob.size());
+    } else if (op == "merge") {
+        if (args.size() < 3) throw std::runtime_error("usage: merge NAME BLOB");
+        auto blob = Utils::Base64Decode(args[2]);
+        if (!blob || !streams_.MergeSerialized(name, blob->data(), blob->size())) {
+            throw std::runtime_error("malformed sketch blob");
+        }
+        oss << "merged";
+    } else if (op == "reset") {
+        oss << (streams_.Reset(name) ? "reset" : "unknown stream");
+    } else {
+        throw std::runtime_error("unknown stream command: " + op);
+    }
+    return oss.str();
+}
+
 void DaemonEngine::update_metrics(double execution_time) {
     // Update running average (simplified exponential moving average)
     double current_avg = avg_response_time_.load();
@@ -379,6 +752,66 @@ std::chrono::milliseconds DaemonEngine::get_uptime() const {
     return std::chrono::duration_cast<std::chrono::milliseconds>(now - startup_time_);
 }
 
+void DaemonEngine::record_latency(double latency_us) {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    if (latency_us_.size() < LATENCY_SAMPLES) {
+        latency_us_.push_back(latency_us);
+    } else {
+        latency_us_[latency_next_] = latency_us;
+    }
+    latency_next_ = (latency_next_ + 1) % LATENCY_SAMPLES;
+}
+
+void DaemonEngine::reset_latency_samples() {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    latency_us_.clear();
+    latency_next_ = 0;
+}
+
+DaemonEngine::LatencySummary DaemonEngine::get_latency_summary() const {
+    std::vector<double> samples;
+    {
+        std::lock_guard<std::mutex> lock(latency_mutex_);
+        samples = latency_us_;
+    }
+    
+    LatencySummary summary;
+    summary.samples = samples.size();
+    if (samples.empty()) {
+        return summary;
+    }
+    
+    auto at = [&](double q) {
+        size_t k = std::min(samples.size() - 1, static_cast<size_t>(q * samples.size()));
+        std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+        return samples[k];
+    };
+    summary.p50_us = at(0.50);
+    summary.p99_us = at(0.99);
+    summary.max_us = *std::max_element(samples.begin(), samples.end());
+    return summary;
+}
+
+std::string DaemonEngine::get_status_report() const {
+    static const char* names[] = {"STARTING", "READY", "BUSY", "ERROR", "SHUTDOWN"};
+    auto latency = get_latency_summary();
+    
+    std::ostringstream ss;
+    ss << "Status: " << names[static_cast<int>(get_status())] << "\n";
+    ss << "Requests: " << get_total_requests() << ", avg " << get_avg_response_time() << "ms"
+       << ", p50 " << latency.p50_us << "us, p99 " << latency.p99_us << "us\n";
+    ss << "Uptime: " << get_uptime().count() << "ms\n";
+    ss << "Thread layout:\n";
+    {
+        std::lock_guard<std::mutex> lock(layout_mutex_);
+        for (const auto& line : thread_layout_) {
+            ss << "  " << line << "\n";
+        }
+    }
+    ss << "Compute pool: " << ThreadPool::Global().Describe() << "\n";
+    return ss.str();
+}
+
 // ============================================================================
 // DaemonClient Implementation
 // ============================================================================
@@ -470,7 +903,7 @@ DaemonEngine::Response DaemonClient::execute(const std::string& command, const s
         char buffer[4096];
         DWORD bytes_read = 0;
         if (ReadFile(pipe_handle_, buffer, sizeof(buffer) - 1, &bytes_read, nullptr)) {
-            buffer[bytes_read] = '\\0';
+            buffer[bytes_read] = '\0';
             response.result = std::string(buffer);
             response.success = true;
         }
@@ -481,7 +914,7 @@ DaemonEngine::Response DaemonClient::execute(const std::string& command, const s
         char buffer[4096];
         ssize_t bytes_read = read(pipe_fd_, buffer, sizeof(buffer) - 1);
         if (bytes_read > 0) {
-            buffer[bytes_read] = '\\0';
+            buffer[bytes_read] = '\0';
             response.result = std::string(buffer);
             response.success = true;
         }
@@ -0,0 +1,462 @@
+/**
+ * @file data_loader.cpp
+ * @brief Memory-mapped parallel CSV parsing and the binary columnar cache
+ */
+
+#include "data_loader.h"
+#include "thread_pool.h"
+#include "parallel.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const Vector* DataTable::Column(const std::string& name) const {
+    for (size_t c = 0; c < names.size(); ++c) {
+        if (names[c] == name) return &columns[c];
+    }
+    return nullptr;
+}
+
+namespace {
+
+// Below this many bytes per chunk, task overhead outweighs parsing
+constexpr size_t kMinChunkBytes = 1 << 20;
+
+constexpr char kCacheMagic[4] = {'A', 'X', 'C', 'L'};
+constexpr uint32_t kCacheVersion = 1;
+
+/**
+ * @brief Read-only view of a whole file: mapped when possible, otherwise
+ *        read into memory
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ != INVALID_HANDLE_VALUE) {
+            LARGE_INTEGER size;
+            if (GetFileSizeEx(file_, &size) && size.QuadPart > 0) {
+                mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping_) {
+                    data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+                    if (data_) size_ = static_cast<size_t>(size.QuadPart);
+                }
+            }
+            ok_ = true;
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                    data_ = static_cast<const char*>(p);
+                    size_ = static_cast<size_t>(st.st_size);
+                    mapped_ = true;
+                }
+            }
+            ::close(fd);
+            ok_ = true;
+        }
+#endif
+        if (ok_ && !data_) ReadFallback(path);
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_ && mapping_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Ok() const { return ok_; }
+    const char* Data() const { return data_ ? data_ : buffer_.data(); }
+    size_t Size() const { return data_ ? size_ : buffer_.size(); }
+
+private:
+    // Pipes, special files and failed mappings are read the ordinary way
+    void ReadFallback(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            ok_ = false;
+            return;
+        }
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    bool ok_ = false;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::string buffer_;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    bool mapped_ = false;
+#endif
+};
+
+// End of the line starting at p (the '\n' or end)
+const char* LineEnd(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+bool IsBlank(const char* p, const char* end) {
+    for (; p < end; ++p) {
+        if (*p != ' ' && *p != '\t' && *p != '\r') return false;
+    }
+    return true;
+}
+
+std::string_view Trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\r')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+/**
+ * Splits off the field at p and advances p past its delimiter. Quoted fields
+ * are returned without the quotes and may contain the delimiter; their
+ * doubled quotes are left for Unquote, since cells that parse as numbers
+ * never contain one.
+ */
+std::string_view NextField(const char*& p, const char* end, char delimiter, bool* quoted = nullptr) {
+    const char* start = p;
+    while (start < end && *start == ' ') ++start;
+    if (quoted) *quoted = start < end && *start == '"';
+    if (start < end && *start == '"') {
+        const char* q = start + 1;
+        while (q < end) {
+            if (*q == '"') {
+                if (q + 1 < end && q[1] == '"') {
+                    q += 2;
+                    continue;
+                }
+                break;
+            }
+            ++q;
+        }
+        std::string_view field(start + 1, static_cast<size_t>(q - start - 1));
+        const char* d = static_cast<const char*>(std::memchr(q, delimiter, static_cast<size_t>(end - std::min(q, end))));
+        p = d ? d + 1 : end;
+        return field;
+    }
+    const char* d = static_cast<const char*>(std::memchr(p, delimiter, static_cast<size_t>(end - p)));
+    std::string_view field(p, static_cast<size_t>((d ? d : end) - p));
+    p = d ? d + 1 : end;
+    return Trim(field);
+}
+
+// Collapses the doubled quotes of a quoted field ("" -> ")
+std::string Unquote(std::string_view field) {
+    std::string out;
+    out.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        out += field[i];
+        if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') ++i;
+    }
+    return out;
+}
+
+double ParseCell(std::string_view cell) {
+    cell = Trim(cell);
+    if (!cell.empty() && cell.front() == '+') cell.remove_prefix(1);
+    double value;
+    auto [ptr, ec] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+    if (cell.empty() || ec != std::errc() || ptr != cell.data() + cell.size()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return value;
+}
+
+// Empty cells and NaN spellings are missing data, not header text
+bool IsDataCell(std::string_view cell) {
+    cell = Trim(cell);
+    return cell.empty() || !std::isnan(ParseCell(cell)) ||
+           std::equal(cell.begin(), cell.end(), "nan", "nan" + 3,
+                      [](char a, char b) { return (a | 0x20) == b; });
+}
+
+char DetectDelimiter(const char* p, const char* end) {
+    size_t tabs = std::count(p, end, '\t');
+    size_t semicolons = std::count(p, end, ';');
+    size_t commas = std::count(p, end, ',');
+    if (tabs > 0) return '\t';
+    return semicolons > commas ? ';' : ',';
+}
+
+bool StatSource(const std::string& path, const CsvOptions& options, CacheStamp& stamp) {
+    std::error_code ec;
+    stamp.source_size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    stamp.source_mtime = static_cast<int64_t>(time.time_since_epoch().count());
+    stamp.options = static_cast<unsigned char>(options.delimiter) | (options.has_header ? 0x100u : 0u);
+    return true;
+}
+
+template <typename T>
+void Put(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool Get(const char*& p, const char* end, T& value) {
+    if (static_cast<size_t>(end - p) < sizeof(T)) return false;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+std::optional<DataTable> DataLoader::ParseText(const char* data, size_t size, std::string& error,
+                                               const CsvOptions& options) {
+    const char* begin = data;
+    const char* end = data + size;
+    if (size >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) begin += 3;
+
+    // First non-blank line fixes the column count and delimiter
+    while (begin < end && IsBlank(begin, LineEnd(begin, end))) {
+        begin = LineEnd(begin, end);
+        if (begin < end) ++begin;
+    }
+    if (begin >= end) {
+        error = "no data";
+        return std::nullopt;
+    }
+    const char* first_end = LineEnd(begin, end);
+    const char* fields_end = first_end > begin && first_end[-1] == '\r' ? first_end - 1 : first_end;
+    char delimiter = options.delimiter ? options.delimiter : DetectDelimiter(begin, fields_end);
+
+    std::vector<std::string_view> first;
+    std::vector<bool> first_quoted;
+    for (const char* p = begin; p < fields_end;) {
+        bool quoted = false;
+        first.push_back(NextField(p, fields_end, delimiter, &quoted));
+        first_quoted.push_back(quoted);
+    }
+    if (fields_end[-1] == delimiter) {
+        first.emplace_back();
+        first_quoted.push_back(false);
+    }
+
+    // A first line of numbers and missing cells is data, not a header
+    bool header = options.has_header && !std::all_of(first.begin(), first.end(), IsDataCell);
+
+    DataTable table;
+    for (size_t c = 0; c < first.size(); ++c) {
+        std::string name = !header ? std::string() : first_quoted[c] ? Unquote(first[c]) : std::string(first[c]);
+        if (name.empty()) name = "c" + std::to_string(c);
+        table.names.push_back(std::move(name));
+    }
+    const char* body = header ? std::min(end, first_end + 1) : begin;
+    const size_t ncols = table.names.size();
+
+    // Newline-aligned chunks
+    size_t workers = AXIOM::ThreadPool::Global().Size();
+    size_t body_size = static_cast<size_t>(end - body);
+    size_t chunk_count = std::max<size_t>(1, std::min(workers * AXIOM::Parallel::kChunksPerWorker,
+                                                      body_size / kMinChunkBytes));
+    std::vector<const char*> bounds{body};
+    for (size_t k = 1; k < chunk_count; ++k) {
+        const char* cut = std::max(bounds.back(), body + body_size * k / chunk_count);
+        if (cut > body && cut < end && cut[-1] != '\n') {
+            const char* e = LineEnd(cut, end);
+            cut = e < end ? e + 1 : end;
+        }
+        bounds.push_back(cut);
+    }
+    bounds.push_back(end);
+    chunk_count = bounds.size() - 1;
+
+    auto run_chunks = [&](auto&& body_fn) {
+        if (chunk_count == 1) {
+            body_fn(0);
+            return;
+        }
+        AXIOM::TaskGroup group;
+        for (size_t k = 0; k < chunk_count; ++k) group.Run([&body_fn, k] { body_fn(k); });
+        group.Wait();
+    };
+
+    // Pass 1: rows per chunk, so pass 2 can write straight into the columns
+    std::vector<size_t> row_offset(chunk_count + 1, 0);
+    run_chunks([&](size_t k) {
+        size_t rows = 0;
+        for (const char* p = bounds[k]; p < bounds[k + 1];) {
+            const char* e = LineEnd(p, bounds[k + 1]);
+            if (!IsBlank(p, e)) ++rows;
+            p = e + 1;
+        }
+        row_offset[k + 1] = rows;
+    });
+    for (size_t k = 0; k < chunk_count; ++k) row_offset[k + 1] += row_offset[k];
+
+    table.rows = row_offset[chunk_count];
+    table.columns.assign(ncols, Vector(table.rows, std::numeric_limits<double>::quiet_NaN()));
+
+    // Pass 2: parse; short rows leave NaN, extra fields are ignored
+    run_chunks([&](size_t k) {
+        size_t row = row_offset[k];
+        for (const char* p = bounds[k]; p < bounds[k + 1];) {
+            const char* e = LineEnd(p, bounds[k + 1]);
+            if (!IsBlank(p, e)) {
+                const char* q = p;
+                for (size_t c = 0; c < ncols && q < e; ++c) {
+                    table.columns[c][row] = ParseCell(NextField(q, e, delimiter));
+                }
+                ++row;
+            }
+            p = e + 1;
+        }
+    });
+
+    return table;
+}
+
+std::optional<DataTable> DataLoader::Load(const std::string& path, std::string& error,
+                                          const CsvOptions& options) {
+    CacheStamp stamp;
+    if (!StatSource(path, options, stamp)) {
+        error = "cannot open " + path;
+        return std::nullopt;
+    }
+
+    if (options.use_cache) {
+        CacheStamp cached_stamp;
+        auto cached = ReadColumnar(CachePath(path), &cached_stamp);
+        if (cached && cached_stamp == stamp) {
+            cached->from_cache = true;
+            return cached;
+        }
+    }
+
+    MappedFile file(path);
+    if (!file.Ok()) {
+        error = "cannot open " + path;
+        return std::nullopt;
+    }
+    auto table = ParseText(file.Data(), file.Size(), error, options);
+    if (table && options.use_cache) {
+        // A read-only directory just means no cache
+        WriteColumnar(*table, CachePath(path), stamp);
+    }
+    return table;
+}
+
+bool DataLoader::WriteColumnar(const DataTable& table, const std::string& path,
+                               const CacheStamp& stamp) {
+    std::string header;
+    header.append(kCacheMagic, sizeof(kCacheMagic));
+    Put(header, kCacheVersion);
+    Put(header, stamp.source_size);
+    Put(header, stamp.source_mtime);
+    Put(header, stamp.options);
+    Put(header, static_cast<uint64_t>(table.rows));
+    Put(header, static_cast<uint32_t>(table.names.size()));
+    for (const auto& name : table.names) {
+        Put(header, static_cast<uint32_t>(name.size()));
+        header += name;
+    }
+    // Column data starts 8-byte aligned
+    header.resize((header.size() + 7) & ~size_t{7}, '\0');
+
+    // Written beside the target and renamed, so readers never see a partial file
+    std::string temp = path + ".tmp";
+    bool written;
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+        for (const auto& column : table.columns) {
+            out.write(reinterpret_cast<const char*>(column.data()),
+                      static_cast<std::streamsize>(column.size() * sizeof(double)));
+        }
+        out.close();
+        written = !out.fail();
+    }
+    std::error_code ec;
+    if (written) std::filesystem::rename(temp, path, ec);
+    if (!written || ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<DataTable> DataLoader::ReadColumnar(const std::string& path, CacheStamp* stamp) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) return std::nullopt;
+    MappedFile file(path);
+    if (!file.Ok()) return std::nullopt;
+
+    const char* start = file.Data();
+    const char* p = start;
+    const char* end = start + file.Size();
+    if (file.Size() < sizeof(kCacheMagic) || std::memcmp(p, kCacheMagic, sizeof(kCacheMagic)) != 0) {
+        return std::nullopt;
+    }
+    p += sizeof(kCacheMagic);
+
+    uint32_t version = 0, ncols = 0;
+    uint64_t rows = 0;
+    CacheStamp source;
+    if (!Get(p, end, version) || version != kCacheVersion || !Get(p, end, source.source_size) ||
+        !Get(p, end, source.source_mtime) || !Get(p, end, source.options) ||
+        !Get(p, end, rows) || !Get(p, end, ncols)) {
+        return std::nullopt;
+    }
+
+    DataTable table;
+    table.rows = static_cast<size_t>(rows);
+    for (uint32_t c = 0; c < ncols; ++c) {
+        uint32_t length = 0;
+        if (!Get(p, end, length) || static_cast<size_t>(end - p) < length) return std::nullopt;
+        table.names.emplace_back(p, length);
+        p += length;
+    }
+    p = start + ((static_cast<size_t>(p - start) + 7) & ~size_t{7});
+    if (p > end || static_cast<size_t>(end - p) / sizeof(double) / std::max<uint32_t>(1, ncols) < rows) {
+        return std::nullopt;
+    }
+
+    table.columns.resize(ncols);
+    for (auto& column : table.columns) {
+        column.resize(table.rows);
+        std::memcpy(column.data(), p, table.rows * sizeof(double));
+        p += table.rows * sizeof(double);
+    }
+
+    if (stamp) *stamp = source;
+    return table;
+}
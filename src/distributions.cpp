@@ -0,0 +1,504 @@
+/**
+ * @file distributions.cpp
+ * @brief Special functions and batch PDF / CDF / quantile evaluation
+ */
+
+#include "distributions.h"
+#include "parallel.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Distributions {
+
+namespace {
+
+using Kind = Distribution::Kind;
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr double kEps = std::numeric_limits<double>::epsilon();
+constexpr double kTiny = 1e-300;                 // Lentz guard against zero denominators
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kLnSqrt2Pi = 0.91893853320467274178;
+constexpr double kSqrt2Pi = 2.50662827463100050242;
+constexpr int kMaxIterations = 100000;          // Series / fractions need O(sqrt(a)) terms
+constexpr int kMaxRefinements = 64;
+
+// Elements per block: scratch for the log-density pass stays on the stack
+constexpr size_t kBlock = 256;
+// Per-element CDFs and quantiles cost microseconds; split them finely
+constexpr size_t kHeavyGrain = 256;
+
+// log1p(u) from w = fl(1 + u) and log(w): Goldberg's correction restores
+// the bits of u lost when w was rounded
+inline double Log1pFromLog(double u, double w, double log_w) {
+    return w == 1.0 ? u : log_w * u / (w - 1.0);
+}
+
+// Lower incomplete gamma P(a, x) by its power series; x < a + 1
+double GammaSeries(double a, double x, double log_gamma_a) {
+    double term = 1.0 / a;
+    double sum = term;
+    double ap = a;
+    for (int i = 0; i < kMaxIterations; ++i) {
+        ap += 1.0;
+        term *= x / ap;
+        sum += term;
+        if (std::fabs(term) < std::fabs(sum) * kEps) break;
+    }
+    return sum * std::exp(-x + a * std::log(x) - log_gamma_a);
+}
+
+// Upper incomplete gamma Q(a, x) by its continued fraction (modified Lentz); x >= a + 1
+double GammaFraction(double a, double x, double log_gamma_a) {
+    double b = x + 1.0 - a;
+    double c = 1.0 / kTiny;
+    double d = 1.0 / b;
+    double h = d;
+    for (int i = 1; i < kMaxIterations; ++i) {
+        double an = -i * (i - a);
+        b += 2.0;
+        d = an * d + b;
+        if (std::fabs(d) < kTiny) d = kTiny;
+        c = b + an / c;
+        if (std::fabs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) <= kEps) break;
+    }
+    return std::exp(-x + a * std::log(x) - log_gamma_a) * h;
+}
+
+// Continued fraction for I_x(a, b); converges fast for x < (a + 1) / (a + b + 2)
+double BetaFraction(double a, double b, double x) {
+    const double qab = a + b, qap = a + 1.0, qam = a - 1.0;
+    double c = 1.0;
+    double d = 1.0 - qab * x / qap;
+    if (std::fabs(d) < kTiny) d = kTiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m < kMaxIterations; ++m) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < kTiny) d = kTiny;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        h *= d * c;
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < kTiny) d = kTiny;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) <= kEps) break;
+    }
+    return h;
+}
+
+// I_x(a, b) with y = 1 - x supplied by the caller, so x near 1 keeps its precision
+double IncompleteBeta(double a, double b, double x, double y) {
+    if (!(x > 0.0)) return std::isnan(x) ? kNaN : 0.0;
+    if (!(y > 0.0)) return std::isnan(y) ? kNaN : 1.0;
+    double front = std::exp(LogGamma(a + b) - LogGamma(a) - LogGamma(b) + a * std::log(x) + b * std::log(y));
+    if (x < (a + 1.0) / (a + b + 2.0)) return front * BetaFraction(a, b, x) / a;
+    return 1.0 - front * BetaFraction(b, a, y) / b;
+}
+
+// Standard normal quantile for p <= 0.5: Acklam's rational approximation
+// (relative error 1.2e-9) polished by one Halley step against erfc
+double NormalQuantileLower(double p) {
+    static constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                   1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                   6.680131188771972e+01, -1.328068155288572e+01};
+    static constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                   -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                   3.754408661907416e+00};
+
+    double x;
+    if (p < 0.02425) {
+        double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else {
+        double q = p - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+    // u = (Phi(x) - p) / phi(x), with p / phi(x) formed in logs so tiny p cannot overflow
+    double relative = 0.5 * std::erfc(-x / std::sqrt(2.0)) / p - 1.0;
+    double u = relative * kSqrt2Pi * std::exp(std::log(p) + 0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+// x with P(a, x) = p; Wilson-Hilferty / small-a start, Halley steps (after Numerical Recipes)
+double InverseGammaP(double a, double p) {
+    if (p <= 0.0) return 0.0;
+    if (p >= 1.0) return kInf;
+    const double a1 = a - 1.0;
+    const double gln = LogGamma(a);
+    double lna1 = 0.0, afac = 0.0, x;
+    if (a > 1.0) {
+        lna1 = std::log(a1);
+        afac = std::exp(a1 * (lna1 - 1.0) - gln);
+        double pp = p < 0.5 ? p : 1.0 - p;
+        double t = std::sqrt(-2.0 * std::log(pp));
+        x = (2.30753 + t * 0.27061) / (1.0 + t * (0.99229 + t * 0.04481)) - t;
+        if (p < 0.5) x = -x;
+        x = std::max(1e-3, a * std::pow(1.0 - 1.0 / (9.0 * a) - x / (3.0 * std::sqrt(a)), 3.0));
+    } else {
+        double t = 1.0 - a * (0.253 + a * 0.12);
+        x = p < t ? std::pow(p / t, 1.0 / a) : 1.0 - std::log(1.0 - (p - t) / (1.0 - t));
+    }
+
+    for (int j = 0; j < kMaxRefinements; ++j) {
+        if (x <= 0.0) return 0.0;
+        double err = GammaP(a, x) - p;
+        // Density relative to its mode (a > 1) keeps the exponent in range
+        double density = a > 1.0 ? afac * std::exp(-(x - a1) + a1 * (std::log(x) - lna1))
+                                 : std::exp(-x + a1 * std::log(x) - gln);
+        if (!(density > 0.0)) break;
+        double u = err / density;
+        double step = u / (1.0 - 0.5 * std::min(1.0, u * (a1 / x - 1.0)));
+        x -= step;
+        if (x <= 0.0) x = 0.5 * (x + step);
+        if (std::fabs(step) < 1e-13 * x) break;
+    }
+    return x;
+}
+
+// x with I_x(a, b) = p (after Numerical Recipes' invbetai)
+double InverseBetaI(double a, double b, double p) {
+    if (p <= 0.0) return 0.0;
+    if (p >= 1.0) return 1.0;
+    const double a1 = a - 1.0, b1 = b - 1.0;
+    double x;
+    if (a >= 1.0 && b >= 1.0) {
+        double pp = p < 0.5 ? p : 1.0 - p;
+        double t = std::sqrt(-2.0 * std::log(pp));
+        x = (2.30753 + t * 0.27061) / (1.0 + t * (0.99229 + t * 0.04481)) - t;
+        if (p < 0.5) x = -x;
+        double al = (x * x - 3.0) / 6.0;
+        double h = 2.0 / (1.0 / (2.0 * a - 1.0) + 1.0 / (2.0 * b - 1.0));
+        double w = x * std::sqrt(al + h) / h - (1.0 / (2.0 * b - 1.0) - 1.0 / (2.0 * a - 1.0)) * (al + 5.0 / 6.0 - 2.0 / (3.0 * h));
+        x = a / (a + b * std::exp(2.0 * w));
+    } else {
+        double lna = std::log(a / (a + b)), lnb = std::log(b / (a + b));
+        double t = std::exp(a * lna) / a;
+        double u = std::exp(b * lnb) / b;
+        double w = t + u;
+        x = p < t / w ? std::pow(a * w * p, 1.0 / a) : 1.0 - std::pow(b * w * (1.0 - p), 1.0 / b);
+    }
+
+    const double afac = LogGamma(a + b) - LogGamma(a) - LogGamma(b);
+    for (int j = 0; j < kMaxRefinements; ++j) {
+        if (x <= 0.0 || x >= 1.0) return x;
+        double err = IncompleteBeta(a, b, x, 1.0 - x) - p;
+        double density = std::exp(a1 * std::log(x) + b1 * std::log1p(-x) + afac);
+        if (!(density > 0.0)) break;
+        double u = err / density;
+        double step = u / (1.0 - 0.5 * std::min(1.0, u * (a1 / x - b1 / (1.0 - x))));
+        x -= step;
+        if (x <= 0.0) x = 0.5 * (x + step);
+        if (x >= 1.0) x = 0.5 * (x + step + 1.0);
+        if (std::fabs(step) < 1e-13 * x && j > 0) break;
+    }
+    return x;
+}
+
+double BinomialCDF(double trials, double prob, double k) {
+    if (k < 0.0) return 0.0;
+    k = std::floor(k);
+    if (k >= trials) return 1.0;
+    return IncompleteBeta(trials - k, k + 1.0, 1.0 - prob, prob);
+}
+
+// Smallest integer k with CDF(k) >= p, fuzzed so that Quantile(CDF(k)) == k
+double BinomialQuantile(double trials, double prob, double p) {
+    double target = p * (1.0 - 64.0 * kEps);
+    double lo = -1.0, hi = trials;   // CDF(lo) < target <= CDF(hi)
+    while (hi - lo > 1.0) {
+        double mid = std::floor(0.5 * (lo + hi));
+        if (BinomialCDF(trials, prob, mid) >= target) hi = mid;
+        else lo = mid;
+    }
+    return hi;
+}
+
+/**
+ * Densities for a block of at most kBlock points: the log-density is
+ * assembled around one SIMD log pass, then one SIMD exp pass produces out.
+ * Boundary and out-of-support points are patched afterwards.
+ */
+void DensityBlock(const Distribution& d, const double* x, double* out, size_t n,
+                  const AXIOM::SIMD::KernelTable& kernels) {
+    double logs[kBlock];
+    double scratch[kBlock] = {};
+
+    switch (d.kind) {
+    case Kind::StudentT: {
+        const double v = d.a;
+        const double half = 0.5 * (v + 1.0);
+        const double norm = LogGamma(half) - LogGamma(0.5 * v) - 0.5 * std::log(v * kPi);
+        for (size_t i = 0; i < n; ++i) scratch[i] = 1.0 + x[i] * x[i] / v;
+        kernels.log(scratch, logs, n);
+        for (size_t i = 0; i < n; ++i) {
+            double u = x[i] * x[i] / v;
+            scratch[i] = norm - half * Log1pFromLog(u, scratch[i], logs[i]);
+        }
+        kernels.exp(scratch, out, n);
+        for (size_t i = 0; i < n; ++i) {
+            if (std::isinf(x[i])) out[i] = 0.0;
+        }
+        return;
+    }
+    case Kind::ChiSquared:
+    case Kind::Gamma: {
+        const double shape = d.kind == Kind::Gamma ? d.a : 0.5 * d.a;
+        const double scale = d.kind == Kind::Gamma ? d.b : 2.0;
+        const double norm = LogGamma(shape) + shape * std::log(scale);
+        kernels.log(x, logs, n);
+        for (size_t i = 0; i < n; ++i) scratch[i] = (shape - 1.0) * logs[i] - x[i] / scale - norm;
+        kernels.exp(scratch, out, n);
+        for (size_t i = 0; i < n; ++i) {
+            if (x[i] > 0.0 && !std::isinf(x[i])) continue;
+            if (std::isnan(x[i])) continue;
+            if (x[i] == 0.0) out[i] = shape < 1.0 ? kInf : (shape == 1.0 ? 1.0 / scale : 0.0);
+            else out[i] = 0.0;
+        }
+        return;
+    }
+    case Kind::Beta: {
+        const double alpha = d.a, beta = d.b;
+        const double norm = LogGamma(alpha) + LogGamma(beta) - LogGamma(alpha + beta);
+        double complement_logs[kBlock];
+        for (size_t i = 0; i < n; ++i) scratch[i] = 1.0 - x[i];
+        kernels.log(x, logs, n);
+        kernels.log(scratch, complement_logs, n);
+        for (size_t i = 0; i < n; ++i) {
+            double log1m = Log1pFromLog(-x[i], scratch[i], complement_logs[i]);
+            scratch[i] = (alpha - 1.0) * logs[i] + (beta - 1.0) * log1m - norm;
+        }
+        kernels.exp(scratch, out, n);
+        for (size_t i = 0; i < n; ++i) {
+            if ((x[i] > 0.0 && x[i] < 1.0) || std::isnan(x[i])) continue;
+            if (x[i] == 0.0) out[i] = alpha < 1.0 ? kInf : (alpha == 1.0 ? beta : 0.0);
+            else if (x[i] == 1.0) out[i] = beta < 1.0 ? kInf : (beta == 1.0 ? alpha : 0.0);
+            else out[i] = 0.0;
+        }
+        return;
+    }
+    case Kind::Binomial: {
+        const double trials = d.a, prob = d.b;
+        if (prob == 0.0 || prob == 1.0) {
+            const double certain = prob == 0.0 ? 0.0 : trials;
+            for (size_t i = 0; i < n; ++i) out[i] = std::isnan(x[i]) ? kNaN : (x[i] == certain ? 1.0 : 0.0);
+            return;
+        }
+        const double log_p = std::log(prob), log_q = std::log1p(-prob);
+        const double log_n_factorial = LogGamma(trials + 1.0);
+        for (size_t i = 0; i < n; ++i) {
+            double k = x[i];
+            if (!(k >= 0.0 && k <= trials && k == std::floor(k))) {
+                scratch[i] = std::isnan(k) ? kNaN : -kInf;
+                continue;
+            }
+            scratch[i] = log_n_factorial - LogGamma(k + 1.0) - LogGamma(trials - k + 1.0) +
+                         k * log_p + (trials - k) * log_q;
+        }
+        kernels.exp(scratch, out, n);
+        return;
+    }
+    case Kind::Normal:
+        kernels.normal_pdf(x, out, n, d.a, d.b);
+        return;
+    }
+}
+
+} // namespace
+
+bool Distribution::Valid() const {
+    auto positive = [](double v) { return v > 0.0 && std::isfinite(v); };
+    switch (kind) {
+    case Kind::Normal: return std::isfinite(a) && positive(b);
+    case Kind::StudentT:
+    case Kind::ChiSquared: return positive(a);
+    case Kind::Gamma:
+    case Kind::Beta: return positive(a) && positive(b);
+    case Kind::Binomial: return a >= 0.0 && a <= 9007199254740992.0 && a == std::floor(a) && b >= 0.0 && b <= 1.0;
+    }
+    return false;
+}
+
+// ============================================================================
+// Special functions
+// ============================================================================
+
+double LogGamma(double x) {
+    // Lanczos, g = 7, n = 9: about 1e-15 relative on Gamma(x)
+    static constexpr double kLanczos[] = {
+        0.99999999999980993, 676.5203681218851, -1259.1392167224028,
+        771.32342877765313, -176.61502916214059, 12.507343278686905,
+        -0.13857109526572012, 9.9843695780195716e-6, 1.5056327351493116e-7};
+    if (x < 0.5) {
+        // Reflection keeps accuracy near the pole at 0
+        return std::log(kPi / std::fabs(std::sin(kPi * x))) - LogGamma(1.0 - x);
+    }
+    x -= 1.0;
+    double sum = kLanczos[0];
+    for (int i = 1; i < 9; ++i) sum += kLanczos[i] / (x + i);
+    double t = x + 7.5;
+    return kLnSqrt2Pi + (x + 0.5) * std::log(t) - t + std::log(sum);
+}
+
+double GammaP(double a, double x) {
+    if (std::isnan(a) || std::isnan(x)) return kNaN;
+    if (x <= 0.0) return 0.0;
+    if (std::isinf(x)) return 1.0;
+    double lg = LogGamma(a);
+    return x < a + 1.0 ? GammaSeries(a, x, lg) : 1.0 - GammaFraction(a, x, lg);
+}
+
+double GammaQ(double a, double x) {
+    if (std::isnan(a) || std::isnan(x)) return kNaN;
+    if (x <= 0.0) return 1.0;
+    if (std::isinf(x)) return 0.0;
+    double lg = LogGamma(a);
+    return x < a + 1.0 ? 1.0 - GammaSeries(a, x, lg) : GammaFraction(a, x, lg);
+}
+
+double BetaI(double a, double b, double x) {
+    if (x >= 1.0) return 1.0;
+    return IncompleteBeta(a, b, x, 1.0 - x);
+}
+
+double NormalQuantile(double p) {
+    if (std::isnan(p) || p < 0.0 || p > 1.0) return kNaN;
+    if (p == 0.0) return -kInf;
+    if (p == 1.0) return kInf;
+    // 1 - p is exact for p >= 0.5, so the upper half reuses the lower tail
+    return p > 0.5 ? -NormalQuantileLower(1.0 - p) : NormalQuantileLower(p);
+}
+
+// ============================================================================
+// Scalar evaluation
+// ============================================================================
+
+double PDF(const Distribution& d, double x) {
+    double out;
+    PDF(d, &x, &out, 1);
+    return out;
+}
+
+double CDF(const Distribution& d, double x) {
+    if (std::isnan(x)) return kNaN;
+    switch (d.kind) {
+    case Kind::Normal:
+        return 0.5 * std::erfc((d.a - x) / (d.b * std::sqrt(2.0)));
+    case Kind::StudentT: {
+        if (std::isinf(x)) return x > 0.0 ? 1.0 : 0.0;
+        // P(T > |x|) = I_{v / (v + x^2)}(v / 2, 1 / 2) / 2, both arguments formed directly
+        double v = d.a, t2 = x * x;
+        double tail = 0.5 * IncompleteBeta(0.5 * v, 0.5, v / (v + t2), t2 / (v + t2));
+        return x < 0.0 ? tail : 1.0 - tail;
+    }
+    case Kind::ChiSquared:
+        return GammaP(0.5 * d.a, 0.5 * x);
+    case Kind::Gamma:
+        return GammaP(d.a, x / d.b);
+    case Kind::Beta:
+        if (x <= 0.0) return 0.0;
+        if (x >= 1.0) return 1.0;
+        return IncompleteBeta(d.a, d.b, x, 1.0 - x);
+    case Kind::Binomial:
+        return BinomialCDF(d.a, d.b, x);
+    }
+    return kNaN;
+}
+
+double Quantile(const Distribution& d, double p) {
+    if (std::isnan(p) || p < 0.0 || p > 1.0) return kNaN;
+    switch (d.kind) {
+    case Kind::Normal:
+        return d.a + d.b * NormalQuantile(p);
+    case Kind::StudentT: {
+        if (p == 0.0) return -kInf;
+        if (p == 1.0) return kInf;
+        if (p == 0.5) return 0.0;
+        // Invert the two-sided tail q through whichever beta form keeps t^2 precise
+        double v = d.a;
+        double q = 2.0 * std::min(p, 1.0 - p);
+        double t2;
+        if (q < 0.5) {
+            double x = InverseBetaI(0.5 * v, 0.5, q);        // x = v / (v + t^2)
+            t2 = v * (1.0 - x) / x;
+        } else {
+            double y = InverseBetaI(0.5, 0.5 * v, 1.0 - q);  // y = t^2 / (v + t^2)
+            t2 = v * y / (1.0 - y);
+        }
+        return p < 0.5 ? -std::sqrt(t2) : std::sqrt(t2);
+    }
+    case Kind::ChiSquared:
+        return 2.0 * InverseGammaP(0.5 * d.a, p);
+    case Kind::Gamma:
+        return d.b * InverseGammaP(d.a, p);
+    case Kind::Beta:
+        return InverseBetaI(d.a, d.b, p);
+    case Kind::Binomial:
+        if (p == 0.0) return 0.0;
+        return BinomialQuantile(d.a, d.b, p);
+    }
+    return kNaN;
+}
+
+// ============================================================================
+// Batch evaluation
+// ============================================================================
+
+void PDF(const Distribution& d, const double* x, double* out, size_t n) {
+    PDF(d, x, out, n, AXIOM::SIMD::Kernels());
+}
+
+void PDF(const Distribution& d, const double* x, double* out, size_t n,
+         const AXIOM::SIMD::KernelTable& kernels) {
+    AXIOM::Parallel::ParallelFor(0, n, [&](size_t lo, size_t hi) {
+        for (size_t start = lo; start < hi; start += kBlock) {
+            DensityBlock(d, x + start, out + start, std::min(kBlock, hi - start), kernels);
+        }
+    });
+}
+
+void CDF(const Distribution& d, const double* x, double* out, size_t n) {
+    CDF(d, x, out, n, AXIOM::SIMD::Kernels());
+}
+
+void CDF(const Distribution& d, const double* x, double* out, size_t n,
+         const AXIOM::SIMD::KernelTable& kernels) {
+    if (d.kind == Kind::Normal) {
+        AXIOM::Parallel::ParallelFor(0, n, [&](size_t lo, size_t hi) {
+            kernels.normal_cdf(x + lo, out + lo, hi - lo, d.a, d.b);
+        });
+        return;
+    }
+    AXIOM::Parallel::ParallelFor(0, n, kHeavyGrain, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) out[i] = CDF(d, x[i]);
+    });
+}
+
+void Quantile(const Distribution& d, const double* p, double* out, size_t n) {
+    AXIOM::Parallel::ParallelFor(0, n, kHeavyGrain, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) out[i] = Quantile(d, p[i]);
+    });
+}
+
+} // namespace Distributions
@@ -6,6 +6,8 @@
 #include "algebraic_parser.h"
 #include "linear_system_parser.h"
 #include "unit_parser.h"
+#include "statistics_parser.h"
+#include "thread_pool.h"
 #ifdef ENABLE_PYTHON_FFI
 #include "python_parser.h"
 #endif
@@ -37,8 +39,10 @@ DynamicCalc::DynamicCalc() {
     statistics_engine_ = std::make_unique<StatisticsEngine>();
     plot_engine_ = std::make_unique<PlotEngine>();
     
-    // Initialize unit parser
+    // Initialize unit parser; algebraic expressions accept unit literals too
     parsers_[CalculationMode::UNITS] = std::make_unique<UnitParser>(unit_manager_.get());
+    static_cast<AlgebraicParser*>(parsers_[CalculationMode::ALGEBRAIC].get())->SetUnitManager(unit_manager_.get());
+    parsers_[CalculationMode::STATISTICS] = std::make_unique<StatisticsParser>(statistics_engine_.get());
     
 #ifdef ENABLE_PYTHON_FFI
     // Python engine disabled for pure C++ performance
@@ -54,6 +58,15 @@ DynamicCalc::DynamicCalc() {
 #endif
 }
 
+// Thread count is process-wide: it resizes the shared pool used by every engine.
+bool DynamicCalc::SetThreadCount(size_t num_threads) {
+    return ThreadPool::SetGlobalThreadCount(num_threads);
+}
+
+size_t DynamicCalc::GetThreadCount() {
+    return ThreadPool::GlobalThreadCount();
+}
+
 // Sets the current calculation mode.
 // @param mode: The calculation mode to set (e.g., ALGEBRAIC, LINEAR_SYSTEM).
 void DynamicCalc::SetMode(CalculationMode mode) {
@@ -151,14 +164,22 @@ EngineResult DynamicCalc::EvaluateWithContext(const std::string& input,const std
         }
     }
     
-    if (input.find("stats ") == 0 && current_mode_ != CalculationMode::STATISTICS) {
-        // Handle basic stats commands like "stats mean [1,2,3,4]"
-        return {{}, {CalcErr::OperationNotFound}}; // Placeholder
+    if (input.find("stats ") == 0) {
+        // "stats mean [1,2,3,4]" / "stats load data.csv" from any mode
+        return parsers_[CalculationMode::STATISTICS]->ParseAndExecute(input);
+    }
+    
+    if (input.find("expand(") == 0 && input.back() == ')') {
+        // "expand((x + y)^3)" from any mode
+        return symbolic_engine_->Expand(input.substr(7, input.size() - 8));
     }
     
     if (input.find("convert ") == 0 || input.find(" to ") != std::string::npos) {
-        auto unit_result = unit_manager_->ConvertUnit(1.0, "m", "ft"); // Parse properly
-        return unit_result;
+        // "convert 5 km to mi" / "[1, 2] m to ft" from any mode
+        UnitParser* unit_parser = static_cast<UnitParser*>(parsers_[CalculationMode::UNITS].get());
+        if (unit_parser->IsUnitConversion(input)) {
+            return unit_parser->ParseAndExecute(input);
+        }
     }
     
     auto it = parsers_.find(current_mode_);
@@ -6,6 +6,7 @@
 #ifdef ENABLE_EIGEN
 
 #include "eigen_engine.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -25,7 +26,7 @@ namespace AXIOM {
 EigenEngine::EigenEngine() 
     : optimization_level_(CPUOptimizationLevel::SIMD)
     , simd_enabled_(true)
-    , num_threads_(std::thread::hardware_concurrency()) {
+    , num_threads_(static_cast<int>(ThreadPool::GlobalThreadCount())) {
     
     // Initialize Eigen with optimal settings for Senna Speed! 🏎️
     Eigen::initParallel();
@@ -66,12 +67,12 @@ void EigenEngine::SetOptimizationLevel(CPUOptimizationLevel level) {
             break;
         case CPUOptimizationLevel::Parallel:
             simd_enabled_ = true;
-            num_threads_ = std::thread::hardware_concurrency();
+            num_threads_ = static_cast<int>(ThreadPool::GlobalThreadCount());
             break;
         case CPUOptimizationLevel::Vectorized:
         case CPUOptimizationLevel::Extreme:
             simd_enabled_ = true;
-            num_threads_ = std::thread::hardware_concurrency();
+            num_threads_ = static_cast<int>(ThreadPool::GlobalThreadCount());
 #ifdef _OPENMP
             Eigen::setNbThreads(num_threads_);
 #endif
@@ -81,7 +82,7 @@ void EigenEngine::SetOptimizationLevel(CPUOptimizationLevel level) {
 
 void EigenEngine::SetNumThreads(int num_threads) {
     if (num_threads <= 0) {
-        num_threads_ = std::thread::hardware_concurrency();
+        num_threads_ = static_cast<int>(ThreadPool::GlobalThreadCount());
     } else {
         num_threads_ = num_threads;
     }
@@ -0,0 +1,270 @@
+/**
+ * @file frequency_table.cpp
+ * @brief Flat hash / sort-and-run-length counting and cross tabulation
+ */
+
+#include "frequency_table.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+constexpr uint64_t kEmpty = ~uint64_t{0};   // A NaN bit pattern; NaNs never become keys
+constexpr size_t kSampleSize = 2048;        // Values looked at by the cardinality estimate
+constexpr size_t kMaxCells = size_t{1} << 24;
+
+uint64_t Key(double v) {
+    if (v == 0.0) v = 0.0;   // Fold -0.0
+    uint64_t key;
+    std::memcpy(&key, &v, sizeof(key));
+    return key;
+}
+
+double Value(uint64_t key) {
+    double v;
+    std::memcpy(&v, &key, sizeof(v));
+    return v;
+}
+
+// MurmurHash3 finalizer: neighbouring doubles differ only in low mantissa bits
+uint64_t Mix(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+/**
+ * Open addressing with linear probing over parallel key / value arrays,
+ * kept at most half full. Values are counts, or indices when used to
+ * factorize.
+ */
+class FlatCountMap {
+public:
+    explicit FlatCountMap(size_t expected = 8) {
+        size_t capacity = 16;
+        while (capacity < 2 * expected) capacity *= 2;
+        keys_.assign(capacity, kEmpty);
+        values_.assign(capacity, 0);
+    }
+
+    void Add(uint64_t key, uint64_t amount) {
+        size_t slot = Slot(key);
+        if (keys_[slot] == kEmpty) {
+            if (2 * (size_ + 1) > keys_.size()) {
+                Grow();
+                slot = Slot(key);
+            }
+            keys_[slot] = key;
+            ++size_;
+        }
+        values_[slot] += amount;
+    }
+
+    const uint64_t* Find(uint64_t key) const {
+        size_t slot = Slot(key);
+        return keys_[slot] == key ? &values_[slot] : nullptr;
+    }
+
+    size_t Size() const { return size_; }
+
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (keys_[i] != kEmpty) fn(keys_[i], values_[i]);
+        }
+    }
+
+private:
+    size_t Slot(uint64_t key) const {
+        const size_t mask = keys_.size() - 1;
+        size_t slot = Mix(key) & mask;
+        while (keys_[slot] != kEmpty && keys_[slot] != key) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void Grow() {
+        FlatCountMap bigger(keys_.size());
+        ForEach([&](uint64_t key, uint64_t value) { bigger.Add(key, value); });
+        *this = std::move(bigger);
+    }
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint64_t> values_;
+    size_t size_ = 0;
+};
+
+struct Sampled {
+    size_t distinct = 0;
+    size_t looked_at = 0;
+};
+
+// Distinct values among up to kSampleSize evenly spaced non-NaN elements
+Sampled SampleCardinality(const double* x, size_t n) {
+    Sampled s;
+    if (n == 0) return s;
+    size_t m = std::min(n, kSampleSize);
+    size_t stride = n / m;
+    FlatCountMap seen(m);
+    for (size_t j = 0; j < m; ++j) {
+        double v = x[j * stride];
+        if (std::isnan(v)) continue;
+        seen.Add(Key(v), 1);
+        ++s.looked_at;
+    }
+    s.distinct = seen.Size();
+    return s;
+}
+
+// Mostly distinct: a table would be as large as the data and miss cache on every probe
+Frequency::Method Choose(const Sampled& s) {
+    return 2 * s.distinct > s.looked_at ? Frequency::Method::Sort : Frequency::Method::Hash;
+}
+
+FrequencyTable HashCount(const double* x, size_t n, size_t expected) {
+    struct Partial {
+        FlatCountMap map;
+        uint64_t missing = 0;
+    };
+    Partial total = AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, Partial{FlatCountMap(expected)},
+        [&](size_t lo, size_t hi) {
+            Partial part{FlatCountMap(expected)};
+            for (size_t i = lo; i < hi; ++i) {
+                if (std::isnan(x[i])) ++part.missing;
+                else part.map.Add(Key(x[i]), 1);
+            }
+            return part;
+        },
+        [](Partial acc, const Partial& part) {
+            part.map.ForEach([&](uint64_t key, uint64_t count) { acc.map.Add(key, count); });
+            acc.missing += part.missing;
+            return acc;
+        });
+
+    std::vector<std::pair<double, uint64_t>> entries;
+    entries.reserve(total.map.Size());
+    total.map.ForEach([&](uint64_t key, uint64_t count) { entries.emplace_back(Value(key), count); });
+    std::sort(entries.begin(), entries.end());
+
+    FrequencyTable table;
+    table.missing = total.missing;
+    table.values.reserve(entries.size());
+    table.counts.reserve(entries.size());
+    for (const auto& [value, count] : entries) {
+        table.values.push_back(value);
+        table.counts.push_back(count);
+    }
+    return table;
+}
+
+FrequencyTable SortCount(const double* x, size_t n) {
+    FrequencyTable table;
+    Vector sorted;
+    sorted.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (std::isnan(x[i])) ++table.missing;
+        else sorted.push_back(x[i] == 0.0 ? 0.0 : x[i]);
+    }
+    AXIOM::Parallel::ParallelSort(sorted.begin(), sorted.end());
+
+    for (size_t i = 0; i < sorted.size();) {
+        size_t run = i + 1;
+        while (run < sorted.size() && sorted[run] == sorted[i]) ++run;
+        table.values.push_back(sorted[i]);
+        table.counts.push_back(run - i);
+        i = run;
+    }
+    return table;
+}
+
+// Value -> position in the ascending distinct values
+FlatCountMap IndexOf(const Vector& values) {
+    FlatCountMap index(values.size());
+    for (size_t i = 0; i < values.size(); ++i) index.Add(Key(values[i]), i);
+    return index;
+}
+
+} // namespace
+
+Vector FrequencyTable::Modes() const {
+    Vector modes;
+    if (counts.empty()) return modes;
+    uint64_t top = *std::max_element(counts.begin(), counts.end());
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i] == top) modes.push_back(values[i]);
+    }
+    return modes;
+}
+
+std::vector<size_t> FrequencyTable::ByCount() const {
+    std::vector<size_t> order(counts.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    // Stable: equal counts keep ascending value order
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return counts[a] > counts[b]; });
+    return order;
+}
+
+namespace Frequency {
+
+Method ChooseMethod(const double* x, size_t n) {
+    return Choose(SampleCardinality(x, n));
+}
+
+FrequencyTable Count(const double* x, size_t n, Method method) {
+    if (method == Method::Sort) return SortCount(x, n);
+    return HashCount(x, n, SampleCardinality(x, n).distinct);
+}
+
+FrequencyTable Count(const double* x, size_t n) {
+    Sampled s = SampleCardinality(x, n);
+    return Choose(s) == Method::Sort ? SortCount(x, n) : HashCount(x, n, s.distinct);
+}
+
+std::optional<ContingencyTable> CrossTabulate(const double* x, const double* y, size_t n) {
+    // Only complete rows contribute categories
+    Vector xs, ys;
+    xs.reserve(n);
+    ys.reserve(n);
+    ContingencyTable table;
+    for (size_t i = 0; i < n; ++i) {
+        if (std::isnan(x[i]) || std::isnan(y[i])) {
+            ++table.missing;
+            continue;
+        }
+        xs.push_back(x[i]);
+        ys.push_back(y[i]);
+    }
+    table.row_values = Count(xs.data(), xs.size()).values;
+    table.column_values = Count(ys.data(), ys.size()).values;
+    const size_t columns = table.Columns();
+    const size_t cells = table.Rows() * columns;
+    if (cells > kMaxCells) return std::nullopt;
+
+    const FlatCountMap row_index = IndexOf(table.row_values);
+    const FlatCountMap column_index = IndexOf(table.column_values);
+    const size_t rows = xs.size();
+    size_t grain = std::max(AXIOM::Parallel::DefaultGrain(rows), 4 * cells);
+    table.counts = AXIOM::Parallel::ParallelReduce(size_t{0}, rows, grain, std::vector<uint64_t>(cells, 0),
+        [&](size_t lo, size_t hi) {
+            std::vector<uint64_t> local(cells, 0);
+            for (size_t i = lo; i < hi; ++i) {
+                size_t r = *row_index.Find(Key(xs[i]));
+                size_t c = *column_index.Find(Key(ys[i]));
+                ++local[r * columns + c];
+            }
+            return local;
+        },
+        [](std::vector<uint64_t> acc, const std::vector<uint64_t>& part) {
+            for (size_t i = 0; i < acc.size(); ++i) acc[i] += part[i];
+            return acc;
+        });
+    return table;
+}
+
+} // namespace Frequency
@@ -0,0 +1,239 @@
+/**
+ * @file level_of_detail.cpp
+ * @brief M4 envelopes, LTTB and the block min/max pyramid
+ */
+
+#include "level_of_detail.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+using Extremes = LevelOfDetail::Pyramid::Extremes;
+
+constexpr size_t kBlock = 64;   // Points per level-0 pyramid block
+
+void Include(Extremes& acc, double v, uint64_t i) {
+    if (std::isnan(v)) return;
+    if (acc.argmin == Extremes::kNone || v < acc.min) {
+        acc.min = v;
+        acc.argmin = i;
+    }
+    if (acc.argmax == Extremes::kNone || v > acc.max) {
+        acc.max = v;
+        acc.argmax = i;
+    }
+}
+
+void Merge(Extremes& acc, const Extremes& part) {
+    if (part.argmin == Extremes::kNone) return;
+    // Ties go to the earlier point whatever the merge order
+    if (acc.argmin == Extremes::kNone || part.min < acc.min || (part.min == acc.min && part.argmin < acc.argmin)) {
+        acc.min = part.min;
+        acc.argmin = part.argmin;
+    }
+    if (acc.argmax == Extremes::kNone || part.max > acc.max || (part.max == acc.max && part.argmax < acc.argmax)) {
+        acc.max = part.max;
+        acc.argmax = part.argmax;
+    }
+}
+
+Extremes Scan(const double* y, size_t begin, size_t end) {
+    Extremes acc;
+    for (size_t i = begin; i < end; ++i) Include(acc, y[i], i);
+    return acc;
+}
+
+/**
+ * Shared column walk: each column's index range comes from a binary search
+ * on x, and extremes(begin, end) supplies its min / max
+ */
+template <typename ExtremesFn>
+LevelOfDetail::Series BuildEnvelope(const double* x, const double* y, size_t n, double x_lo, double x_hi,
+                                    size_t columns, ExtremesFn&& extremes) {
+    LevelOfDetail::Series out;
+    if (n == 0 || columns == 0 || !(x_lo < x_hi)) return out;
+    const double* first = std::lower_bound(x, x + n, x_lo);
+    const double* last = std::upper_bound(first, x + n, x_hi);
+    const size_t begin = static_cast<size_t>(first - x), end = static_cast<size_t>(last - x);
+
+    auto push = [&](size_t i) {
+        if (!out.x.empty() && out.x.back() == x[i] && out.y.back() == y[i]) return;
+        out.x.push_back(x[i]);
+        out.y.push_back(y[i]);
+    };
+    out.x.reserve(4 * columns + 2);
+    out.y.reserve(4 * columns + 2);
+    if (begin > 0) push(begin - 1);
+
+    const double width = (x_hi - x_lo) / static_cast<double>(columns);
+    size_t lo = begin;
+    for (size_t c = 0; c < columns && lo < end; ++c) {
+        size_t hi = end;
+        if (c + 1 < columns) {
+            const double edge = x_lo + width * static_cast<double>(c + 1);
+            hi = static_cast<size_t>(std::lower_bound(x + lo, x + end, edge) - x);
+        }
+        if (hi == lo) continue;
+        const Extremes e = extremes(lo, hi);
+        size_t picks[4] = {lo, lo, lo, hi - 1};
+        size_t count = 1;
+        if (e.argmin != Extremes::kNone) {
+            picks[count++] = std::min<size_t>(e.argmin, e.argmax);
+            picks[count++] = std::max<size_t>(e.argmin, e.argmax);
+        }
+        picks[count++] = hi - 1;
+        for (size_t k = 0; k < count; ++k) {
+            if (k == 0 || picks[k] != picks[k - 1]) push(picks[k]);
+        }
+        lo = hi;
+    }
+
+    if (end < n) push(end);
+    return out;
+}
+
+// Average of the finite points in [begin, end); y falls back to `fallback` if there are none
+void BucketAverage(const double* x, const double* y, size_t begin, size_t end, double fallback,
+                   double& avg_x, double& avg_y) {
+    double sx = 0.0, sy = 0.0;
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (std::isnan(y[i])) continue;
+        sx += x[i];
+        sy += y[i];
+        ++count;
+    }
+    if (count == 0) {
+        avg_x = 0.5 * (x[begin] + x[end - 1]);
+        avg_y = fallback;
+        return;
+    }
+    avg_x = sx / static_cast<double>(count);
+    avg_y = sy / static_cast<double>(count);
+}
+
+} // namespace
+
+namespace LevelOfDetail {
+
+Series Envelope(const double* x, const double* y, size_t n, double x_lo, double x_hi, size_t columns) {
+    return BuildEnvelope(x, y, n, x_lo, x_hi, columns, [y](size_t lo, size_t hi) { return Scan(y, lo, hi); });
+}
+
+std::vector<size_t> LargestTriangleThreeBuckets(const double* x, const double* y, size_t n, size_t points) {
+    std::vector<size_t> picked;
+    if (points >= n || points < 3) {
+        picked.resize(n);
+        std::iota(picked.begin(), picked.end(), size_t{0});
+        return picked;
+    }
+    picked.reserve(points);
+    picked.push_back(0);
+
+    // Interior points split into points - 2 buckets; bucket b is [Edge(b), Edge(b + 1))
+    const double every = static_cast<double>(n - 2) / static_cast<double>(points - 2);
+    auto edge = [&](size_t b) { return std::min(n - 1, static_cast<size_t>(std::floor(b * every)) + 1); };
+    size_t a = 0;
+    for (size_t b = 0; b + 2 < points; ++b) {
+        const size_t lo = edge(b), hi = edge(b + 1);
+        // The next bucket, or the last point after the final bucket
+        const size_t next_lo = hi, next_hi = b + 3 < points ? edge(b + 2) : n;
+        double cx, cy;
+        BucketAverage(x, y, next_lo, next_hi, y[a], cx, cy);
+
+        size_t best = lo;
+        double best_area = -1.0;
+        for (size_t i = lo; i < hi; ++i) {
+            double area = std::abs((x[a] - cx) * (y[i] - y[a]) - (x[a] - x[i]) * (cy - y[a]));
+            if (area > best_area) {   // False for NaN
+                best_area = area;
+                best = i;
+            }
+        }
+        picked.push_back(best);
+        if (!std::isnan(y[best])) a = best;
+    }
+    picked.push_back(n - 1);
+    return picked;
+}
+
+std::optional<Pyramid> Pyramid::Build(Vector x, Vector y) {
+    if (x.size() != y.size() || x.empty()) return std::nullopt;
+    if (std::any_of(x.begin(), x.end(), [](double v) { return std::isnan(v); })) return std::nullopt;
+    if (!std::is_sorted(x.begin(), x.end())) {
+        std::vector<size_t> order(x.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return x[a] < x[b]; });
+        Vector sx(x.size()), sy(y.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            sx[i] = x[order[i]];
+            sy[i] = y[order[i]];
+        }
+        x = std::move(sx);
+        y = std::move(sy);
+    }
+
+    Pyramid pyramid;
+    pyramid.x_ = std::move(x);
+    pyramid.y_ = std::move(y);
+    const double* data = pyramid.y_.data();
+    const size_t n = pyramid.y_.size();
+
+    // Level 0 from the data, each further level from pairs of the one below
+    std::vector<Extremes> level((n + kBlock - 1) / kBlock);
+    AXIOM::Parallel::ParallelFor(0, level.size(), 0, [&](size_t lo, size_t hi) {
+        for (size_t b = lo; b < hi; ++b) level[b] = Scan(data, b * kBlock, std::min(n, (b + 1) * kBlock));
+    });
+    while (level.size() > 1) {
+        std::vector<Extremes> up((level.size() + 1) / 2);
+        AXIOM::Parallel::ParallelFor(0, up.size(), 0, [&](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b) {
+                up[b] = level[2 * b];
+                if (2 * b + 1 < level.size()) Merge(up[b], level[2 * b + 1]);
+            }
+        });
+        pyramid.levels_.push_back(std::move(level));
+        level = std::move(up);
+    }
+    pyramid.levels_.push_back(std::move(level));
+    return pyramid;
+}
+
+Pyramid::Extremes Pyramid::RangeExtremes(size_t begin, size_t end) const {
+    end = std::min(end, y_.size());
+    if (begin >= end) return {};
+    if (end - begin <= 2 * kBlock) return Scan(y_.data(), begin, end);
+
+    // Ragged ends from the data, whole blocks bottom-up as in a segment tree
+    size_t first = (begin + kBlock - 1) / kBlock, last = end / kBlock;
+    Extremes acc = Scan(y_.data(), begin, first * kBlock);
+    Merge(acc, Scan(y_.data(), last * kBlock, end));
+    for (size_t l = 0; first < last; ++l, first /= 2, last /= 2) {
+        if (first & 1) Merge(acc, levels_[l][first++]);
+        if (last & 1) Merge(acc, levels_[l][--last]);
+    }
+    return acc;
+}
+
+Series Pyramid::Envelope(double x_lo, double x_hi, size_t columns) const {
+    return BuildEnvelope(x_.data(), y_.data(), x_.size(), x_lo, x_hi, columns,
+                         [this](size_t lo, size_t hi) { return RangeExtremes(lo, hi); });
+}
+
+Series Pyramid::Downsample(double x_lo, double x_hi, size_t points) const {
+    Series envelope = Envelope(x_lo, x_hi, points);
+    std::vector<size_t> keep = LargestTriangleThreeBuckets(envelope.x.data(), envelope.y.data(), envelope.Size(), points);
+    Series out;
+    out.x.reserve(keep.size());
+    out.y.reserve(keep.size());
+    for (size_t i : keep) {
+        out.x.push_back(envelope.x[i]);
+        out.y.push_back(envelope.y[i]);
+    }
+    return out;
+}
+
+} // namespace LevelOfDetail
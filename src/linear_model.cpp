@@ -0,0 +1,255 @@
+/**
+ * @file linear_model.cpp
+ * @brief Pivoted Householder QR least squares and the Givens online update
+ */
+
+#include "linear_model.h"
+#include "compensated_sum.h"
+#include "parallel.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+double Dot(const double* x, const double* y, size_t n) {
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    return AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, 0.0,
+        [&](size_t lo, size_t hi) { return kernels.dot(x + lo, y + lo, hi - lo); },
+        [](double acc, double part) { return acc + part; });
+}
+
+// y -= a * x
+void SubtractScaled(double a, const double* x, double* y, size_t n) {
+    AXIOM::Parallel::ParallelFor(0, n, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) y[i] -= a * x[i];
+    });
+}
+
+struct QRSolution {
+    Vector coefficients;      // Original column order; NaN where aliased
+    Vector scale;             // sqrt(diag((R^T R)^-1)), same order
+    double rss = 0.0;         // Residual sum of squares of this system
+    size_t rank = 0;
+};
+
+/**
+ * Least squares for the m x p column-major system a * coef = b by
+ * Householder QR with column pivoting (Businger-Golub). a and b are
+ * overwritten. Pivots below tolerance_dim * eps * |R00| end the
+ * factorization; the remaining columns are aliased.
+ */
+QRSolution SolvePivoted(Vector& a, size_t m, size_t p, Vector& b, size_t tolerance_dim) {
+    std::vector<size_t> perm(p);
+    std::iota(perm.begin(), perm.end(), size_t{0});
+    Vector norms(p), reference(p), diag(p, 0.0);
+    for (size_t j = 0; j < p; ++j) {
+        norms[j] = reference[j] = Dot(&a[j * m], &a[j * m], m);
+    }
+
+    const double tolerance = static_cast<double>(tolerance_dim) * std::numeric_limits<double>::epsilon();
+    size_t rank = 0;
+    for (size_t k = 0; k < std::min(m, p); ++k) {
+        size_t pivot = k + static_cast<size_t>(std::max_element(norms.begin() + k, norms.end()) - (norms.begin() + k));
+        if (pivot != k) {
+            std::swap_ranges(a.begin() + k * m, a.begin() + (k + 1) * m, a.begin() + pivot * m);
+            std::swap(norms[k], norms[pivot]);
+            std::swap(reference[k], reference[pivot]);
+            std::swap(perm[k], perm[pivot]);
+        }
+
+        double* v = &a[k * m + k];
+        size_t len = m - k;
+        double alpha = std::sqrt(Dot(v, v, len));
+        if (alpha == 0.0 || (k > 0 && alpha <= tolerance * std::fabs(diag[0]))) break;
+
+        // H = I - v v^T * 2 / (v^T v) with v = x - beta e1; beta opposes x0 to avoid cancellation
+        double beta = v[0] >= 0.0 ? -alpha : alpha;
+        double vtv = 2.0 * alpha * (alpha + std::fabs(v[0]));
+        v[0] -= beta;
+        diag[k] = beta;
+
+        for (size_t j = k + 1; j < p; ++j) {
+            double* col = &a[j * m + k];
+            SubtractScaled(2.0 * Dot(v, col, len) / vtv, v, col, len);
+
+            // Downdate the remaining norm; recompute once cancellation dominates
+            norms[j] -= col[0] * col[0];
+            if (norms[j] <= 1e-8 * reference[j]) {
+                norms[j] = reference[j] = len > 1 ? Dot(col + 1, col + 1, len - 1) : 0.0;
+            }
+        }
+        SubtractScaled(2.0 * Dot(v, &b[k], len) / vtv, v, &b[k], len);
+        rank = k + 1;
+    }
+
+    // R[i][j] (i < j) sits at a[j * m + i]; back-substitute R z = Q^T b
+    Vector z(rank);
+    for (size_t i = rank; i-- > 0;) {
+        double s = b[i];
+        for (size_t j = i + 1; j < rank; ++j) s -= a[j * m + i] * z[j];
+        z[i] = s / diag[i];
+    }
+
+    // Rows of R^-1 give diag((R^T R)^-1)
+    Vector inv(rank * rank, 0.0);   // Row-major upper triangle
+    for (size_t i = rank; i-- > 0;) {
+        inv[i * rank + i] = 1.0 / diag[i];
+        for (size_t j = i + 1; j < rank; ++j) {
+            double s = 0.0;
+            for (size_t l = i + 1; l <= j; ++l) s += a[l * m + i] * inv[l * rank + j];
+            inv[i * rank + j] = -s / diag[i];
+        }
+    }
+
+    QRSolution solution;
+    solution.rank = rank;
+    solution.coefficients.assign(p, kNaN);
+    solution.scale.assign(p, kNaN);
+    for (size_t i = 0; i < rank; ++i) {
+        double sq = 0.0;
+        for (size_t j = i; j < rank; ++j) sq += inv[i * rank + j] * inv[i * rank + j];
+        solution.coefficients[perm[i]] = z[i];
+        solution.scale[perm[i]] = std::sqrt(sq);
+    }
+    solution.rss = m > rank ? Reduction::SumSquaredDeviations(b.data() + rank, m - rank, 0.0) : 0.0;
+    return solution;
+}
+
+RegressionFit Summarize(const QRSolution& solution, double rss, double tss, uint64_t n, bool intercept) {
+    RegressionFit fit;
+    fit.coefficients = solution.coefficients;
+    fit.rank = solution.rank;
+    fit.observations = n;
+    fit.residual_sum_squares = rss;
+
+    double nd = static_cast<double>(n);
+    double dof = nd - static_cast<double>(solution.rank);
+    fit.residual_std_error = dof > 0.0 ? std::sqrt(rss / dof) : kNaN;
+    fit.r_squared = tss > 0.0 ? 1.0 - rss / tss : kNaN;
+    fit.adjusted_r_squared = dof > 0.0 ? 1.0 - (1.0 - fit.r_squared) * (nd - (intercept ? 1.0 : 0.0)) / dof : kNaN;
+
+    fit.standard_errors.resize(solution.scale.size());
+    for (size_t j = 0; j < solution.scale.size(); ++j) {
+        fit.standard_errors[j] = fit.residual_std_error * solution.scale[j];
+    }
+    return fit;
+}
+
+} // namespace
+
+namespace LinearModel {
+
+std::optional<RegressionFit> Fit(const std::vector<const Vector*>& columns, const Vector& y, bool intercept) {
+    const size_t n = y.size();
+    const size_t p = columns.size() + (intercept ? 1 : 0);
+    if (n == 0 || p == 0) return std::nullopt;
+    for (const Vector* column : columns) {
+        if (!column || column->size() != n) return std::nullopt;
+    }
+    auto finite = [](const Vector& v) { return std::all_of(v.begin(), v.end(), [](double x) { return std::isfinite(x); }); };
+    if (!finite(y)) return std::nullopt;
+
+    // Contiguous column-major design, intercept column first
+    Vector design(n * p);
+    size_t offset = 0;
+    if (intercept) {
+        std::fill_n(design.begin(), n, 1.0);
+        offset = n;
+    }
+    for (const Vector* column : columns) {
+        if (!finite(*column)) return std::nullopt;
+        std::memcpy(design.data() + offset, column->data(), n * sizeof(double));
+        offset += n;
+    }
+    Vector response = y;
+
+    QRSolution solution = SolvePivoted(design, n, p, response, std::max(n, p));
+    double center = intercept ? Reduction::Sum(y.data(), n) / static_cast<double>(n) : 0.0;
+    double tss = Reduction::SumSquaredDeviations(y.data(), n, center);
+    return Summarize(solution, solution.rss, tss, n, intercept);
+}
+
+} // namespace LinearModel
+
+// ============================================================================
+// OnlineRegression
+// ============================================================================
+
+OnlineRegression::OnlineRegression(size_t predictors, bool intercept)
+    : terms_(predictors + (intercept ? 1 : 0)),
+      intercept_(intercept),
+      r_(terms_ * terms_, 0.0),
+      qty_(terms_, 0.0),
+      row_(terms_, 0.0) {}
+
+double OnlineRegression::Rotate(double* row, double y) {
+    for (size_t i = 0; i < terms_; ++i) {
+        double xi = row[i];
+        if (xi == 0.0) continue;
+        double* ri = &r_[i * terms_];
+        double radius = std::sqrt(ri[i] * ri[i] + xi * xi);
+        double c = ri[i] / radius;
+        double s = xi / radius;
+        ri[i] = radius;
+        for (size_t j = i + 1; j < terms_; ++j) {
+            double rij = ri[j];
+            ri[j] = c * rij + s * row[j];
+            row[j] = c * row[j] - s * rij;
+        }
+        double q = qty_[i];
+        qty_[i] = c * q + s * y;
+        y = c * y - s * q;
+    }
+    return y;
+}
+
+void OnlineRegression::Add(const double* x, double y) {
+    size_t offset = 0;
+    if (intercept_) row_[offset++] = 1.0;
+    std::copy(x, x + (terms_ - offset), row_.begin() + static_cast<std::ptrdiff_t>(offset));
+    double residual = Rotate(row_.data(), y);
+    rss_ += residual * residual;
+    y_moments_.Push(y);
+}
+
+void OnlineRegression::Merge(const OnlineRegression& other) {
+    if (other.terms_ != terms_ || other.intercept_ != intercept_) return;
+    if (&other == this) {
+        OnlineRegression copy = other;
+        Merge(copy);
+        return;
+    }
+    // Stacking the other factor's rows reproduces its X^T X and X^T y
+    for (size_t i = 0; i < terms_; ++i) {
+        std::copy(other.r_.begin() + static_cast<std::ptrdiff_t>(i * terms_),
+                  other.r_.begin() + static_cast<std::ptrdiff_t>((i + 1) * terms_), row_.begin());
+        double residual = Rotate(row_.data(), other.qty_[i]);
+        rss_ += residual * residual;
+    }
+    rss_ += other.rss_;
+    y_moments_.Merge(other.y_moments_);
+}
+
+std::optional<RegressionFit> OnlineRegression::Fit() const {
+    uint64_t n = y_moments_.count;
+    if (n == 0 || terms_ == 0) return std::nullopt;
+
+    // min |X b - y|^2 = min |R b - Q^T y|^2 + rss_; the small system gets the
+    // same pivoted solver so aliased columns are handled identically
+    Vector a(terms_ * terms_);
+    for (size_t i = 0; i < terms_; ++i) {
+        for (size_t j = 0; j < terms_; ++j) a[j * terms_ + i] = r_[i * terms_ + j];
+    }
+    Vector b = qty_;
+    QRSolution solution = SolvePivoted(a, terms_, terms_, b, std::max<size_t>(n, terms_));
+
+    double nd = static_cast<double>(n);
+    double tss = intercept_ ? y_moments_.m2 : y_moments_.m2 + nd * y_moments_.mean * y_moments_.mean;
+    return Summarize(solution, rss_ + solution.rss, tss, n, intercept_);
+}
@@ -1,5 +1,6 @@
 #include "linear_system_parser.h"
 #include "string_helpers.h" // Ensure StringHelpers.h exists
+#include "simd_kernels.h"
 // EigenEngine integration for advanced linear algebra
 // #ifdef ENABLE_EIGEN
 // #include "../core/engine/eigen_engine.h"
@@ -189,7 +190,7 @@ EngineResult LinearSystemParser::HandleQR(const std::string &input)
     if (Q.empty())
         return {{}, {LinAlgErr::NoSolution}};
 
-    return {EngineSuccessResult(Q), {}};
+    return EngineSuccessResult(Q);
 }
 
 EngineResult LinearSystemParser::HandleEigen(const std::string &input)
@@ -212,7 +213,7 @@ EngineResult LinearSystemParser::HandleEigen(const std::string &input)
 
     auto [eigenValues, eigenVectors] = ComputeEigenvalues(A, 100);
 
-    return {EngineSuccessResult(Vector(eigenValues)), {}};
+    return EngineSuccessResult(Vector(eigenValues));
 }
 
 EngineResult LinearSystemParser::HandleCramer(const std::string &input)
@@ -258,35 +259,23 @@ Matrix LinearSystemParser::MultiplyMatrices(const Matrix &A, const Matrix &B)
     //     static AXIOM::EigenEngine eigen_engine;
     //     return eigen_engine.MatrixMultiply(A, B);
     // #else
-    // Optimized fallback: Cache-friendly matrix multiplication with blocking
+    // Rows are packed once and multiplied by the runtime-dispatched SIMD gemm
     if (A.empty() || B.empty() || A[0].size() != B.size()) return {};
     
-    const int n = A.size(), m = B[0].size(), p = B.size();
-    Matrix C(n, std::vector<double>(m, 0.0));
-    
-    // Cache-blocking optimization for better memory access patterns
-    const int BLOCK_SIZE = 64;  // Optimize for L1 cache
-    
-    for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
-        for (int jj = 0; jj < m; jj += BLOCK_SIZE) {
-            for (int kk = 0; kk < p; kk += BLOCK_SIZE) {
-                // Process block
-                int i_end = std::min(ii + BLOCK_SIZE, n);
-                int j_end = std::min(jj + BLOCK_SIZE, m);
-                int k_end = std::min(kk + BLOCK_SIZE, p);
-                
-                for (int i = ii; i < i_end; i++) {
-                    for (int j = jj; j < j_end; j++) {
-                        double sum = C[i][j];
-                        for (int k = kk; k < k_end; k++) {
-                            sum += A[i][k] * B[k][j];
-                        }
-                        C[i][j] = sum;
-                    }
-                }
-            }
-        }
+    const size_t n = A.size(), m = B[0].size(), p = B.size();
+    std::vector<double> a(n * p), b(p * m), c(n * m);
+    for (size_t i = 0; i < n; ++i) {
+        if (A[i].size() != p) return {};
+        std::copy(A[i].begin(), A[i].end(), a.begin() + i * p);
     }
+    for (size_t k = 0; k < p; ++k) {
+        if (B[k].size() != m) return {};
+        std::copy(B[k].begin(), B[k].end(), b.begin() + k * m);
+    }
+    AXIOM::SIMD::Kernels().gemm(a.data(), b.data(), c.data(), n, p, m);
+    
+    Matrix C(n);
+    for (size_t i = 0; i < n; ++i) C[i].assign(c.begin() + i * m, c.begin() + (i + 1) * m);
     
     return C;
     // #endif
@@ -11,6 +11,8 @@
 #include <memory>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <charconv>
 
 #include "dynamic_calc.h"
 #include "extended_types.h"
@@ -61,7 +63,12 @@ void print_help() {
     std::cout << "  axiom --daemon              Start as background daemon\n";
     std::cout << "  axiom --daemon --pipe=NAME  Start daemon with custom pipe name\n";
     std::cout << "  axiom --daemon-status       Check daemon status\n";
-    std::cout << "  axiom --daemon-stop         Stop running daemon\n\n";
+    std::cout << "  axiom --daemon-stop         Stop running daemon\n";
+    std::cout << "  axiom --daemon --daemon-config=FILE   Thread layout from file\n";
+    std::cout << "  axiom --daemon --compute-threads=2 --compute-cpus=2-3 --compute-pin=true\n";
+    std::cout << "               --io-cpus=1 --io-sched=fifo:50 --pool-cpus=4-7 --compute-spin-us=200\n";
+    std::cout << "                              Per-role (io|compute|pool) threads, cpus, pin,\n";
+    std::cout << "                              sched (other|fifo:PRIO), nice, spin-us\n\n";
     
     std::cout << "Command Line Execution:\n";
     std::cout << "  axiom \"expression\"          Execute single expression\n";
@@ -79,6 +86,7 @@ void print_help() {
     std::cout << "Enterprise Features:\n";
     std::cout << "  axiom --install-service     Install as Windows service\n";
     std::cout << "  axiom --benchmark           Run performance benchmarks\n";
+    std::cout << "  axiom --threads=N           Worker threads for all engines (0 = auto)\n";
     std::cout << "  axiom --memory-profile      Enable memory profiling\n";
     std::cout << "  axiom --numa-optimize       Enable NUMA optimizations\n\n";
     
@@ -171,10 +179,7 @@ int run_interactive_mode() {
                         std::cout << "🛑 Daemon stopped.\n";
                         break;
                     } else if (daemon_input == "status") {
-                        std::cout << "📊 Status: " << static_cast<int>(daemon->get_status()) << "\n";
-                        std::cout << "📈 Total requests: " << daemon->get_total_requests() << "\n";
-                        std::cout << "⏱️ Avg response time: " << daemon->get_avg_response_time() << "ms\n";
-                        std::cout << "🕐 Uptime: " << daemon->get_uptime().count() << "ms\n";
+                        std::cout << "📊 " << daemon->get_status_report();
                     }
                 }
                 continue;
@@ -254,16 +259,24 @@ int run_daemon_mode(const std::vector<std::string>& args) {
         }
     }
     
+    AXIOM::DaemonConfig config;
+    std::string config_error;
+    if (!config.ApplyArgs(args, config_error)) {
+        std::cerr << "❌ " << config_error << "\n";
+        return 1;
+    }
+    
     print_axiom_banner();
     std::cout << "🔥 Starting AXIOM Engine Daemon Mode...\n";
-    std::cout << "📡 Pipe name: " << pipe_name << "\n\n";
+    std::cout << "📡 Pipe name: " << pipe_name << "\n";
+    std::cout << "🧵 Thread layout:\n" << config.Describe() << "\n\n";
     
     // Initialize enterprise memory management
 #ifdef ENABLE_ARENA_ALLOCATOR
     AXIOM::MemoryProfiler::instance().enable_profiling(true);
 #endif
     
-    auto daemon = std::make_unique<AXIOM::DaemonEngine>(pipe_name);
+    auto daemon = std::make_unique<AXIOM::DaemonEngine>(pipe_name, config);
     
     if (!daemon->start()) {
         std::cerr << "❌ Failed to start daemon\n";
@@ -296,7 +309,44 @@ int run_daemon_mode(const std::vector<std::string>& args) {
 }
 #endif
 
-int run_benchmark_mode() {
+#ifdef ENABLE_DAEMON_MODE
+// Open-loop load against an in-process daemon; reports enqueue-to-completion percentiles
+AXIOM::DaemonEngine::LatencySummary measure_daemon_latency(const AXIOM::DaemonConfig& config,
+                                                           const std::string& pipe_name) {
+    AXIOM::DaemonEngine daemon(pipe_name, config);
+    if (!daemon.start()) {
+        return {};
+    }
+    
+    constexpr int kWarmup = 500;
+    constexpr int kRequests = 5000;
+    const auto interval = std::chrono::microseconds(200);
+    
+    for (int i = 0; i < kWarmup; ++i) {
+        daemon.send_command("bench", "2 + 3 * 4 - 1");
+    }
+    while (daemon.get_total_requests() < kWarmup) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    daemon.reset_latency_samples();
+    
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRequests; ++i) {
+        daemon.send_command("bench", "2 + 3 * 4 - 1");
+        next += interval;
+        std::this_thread::sleep_until(next);
+    }
+    while (daemon.get_total_requests() < kWarmup + kRequests) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    
+    auto summary = daemon.get_latency_summary();
+    daemon.stop();
+    return summary;
+}
+#endif
+
+int run_benchmark_mode(const std::vector<std::string>& args) {
     print_axiom_banner();
     std::cout << "🏁 Running AXIOM Engine Performance Benchmarks...\n\n";
     
@@ -314,6 +364,43 @@ int run_benchmark_mode() {
     std::cout << "  ⚡ 10,000 calculations in " << duration.count() << "μs\n";
     std::cout << "  🏎️ " << (10000.0 * 1000000.0 / duration.count()) << " calculations/second\n\n";
     
+#ifdef ENABLE_DAEMON_MODE
+    // Benchmark 2: Daemon request latency, default vs pinned/spinning layout
+    {
+        AXIOM::DaemonConfig tuned;
+        std::string config_error;
+        bool has_layout_flags = std::any_of(args.begin(), args.end(), [](const std::string& arg) {
+            return arg.starts_with("--io-") || arg.starts_with("--compute-") ||
+                   arg.starts_with("--pool-") || arg.starts_with("--daemon-config=");
+        });
+        if (has_layout_flags) {
+            if (!tuned.ApplyArgs(args, config_error)) {
+                std::cerr << "❌ " << config_error << "\n";
+                return 1;
+            }
+        } else {
+            // Default tuned layout: io and compute on separate physical cores, busy-polling
+            auto cpus = AXIOM::ThreadPool::TopologyOrderedCPUs();
+            if (cpus.size() >= 2) {
+                tuned.io.placement.cpus = {cpus[0]};
+                tuned.compute.placement.cpus = {cpus[1]};
+                tuned.compute.placement.pin_each = true;
+            }
+            tuned.io.spin_us = 200;
+            tuned.compute.spin_us = 200;
+        }
+        
+        std::cout << "⏱️ Daemon Latency Benchmark (5,000 requests @ 5k req/s):\n";
+        auto baseline = measure_daemon_latency(AXIOM::DaemonConfig{}, "axiom_bench_default");
+        auto pinned = measure_daemon_latency(tuned, "axiom_bench_tuned");
+        std::cout << "  default layout: p50 " << baseline.p50_us << "μs, p99 " << baseline.p99_us
+                  << "μs, max " << baseline.max_us << "μs\n";
+        std::cout << "  tuned layout:   p50 " << pinned.p50_us << "μs, p99 " << pinned.p99_us
+                  << "μs, max " << pinned.max_us << "μs\n";
+        std::cout << "  layout:\n" << tuned.Describe() << "\n\n";
+    }
+#endif
+    
 #ifdef ENABLE_ARENA_ALLOCATOR
     // Benchmark 3: Memory allocation
     std::cout << "🧠 Memory Arena Benchmark:\n";
@@ -341,6 +428,23 @@ int main(int argc, char* argv[]) {
         args.emplace_back(argv[i]);
     }
     
+    // Shared thread pool size applies to every mode, so consume it first
+    for (auto it = args.begin(); it != args.end(); ++it) {
+        if (it->rfind("--threads=", 0) == 0) {
+            const char* begin = it->data() + 10;
+            const char* end = it->data() + it->size();
+            size_t threads = 0;
+            auto [ptr, ec] = std::from_chars(begin, end, threads);
+            if (ec != std::errc() || ptr != end || begin == end) {
+                std::cerr << "❌ Invalid thread count: " << *it << " (expected --threads=N, N >= 0)\n";
+                return 1;
+            }
+            AXIOM::DynamicCalc::SetThreadCount(threads);
+            args.erase(it);
+            break;
+        }
+    }
+    
     // Check for help
     if (args.empty()) {
         return run_interactive_mode();
@@ -385,7 +489,7 @@ int main(int argc, char* argv[]) {
     
     // Check for benchmark mode
     if (std::find(args.begin(), args.end(), "--benchmark") != args.end()) {
-        return run_benchmark_mode();
+        return run_benchmark_mode(args);
     }
     
     // Command line execution
@@ -1,34 +1,184 @@
 #include "plot_engine.h"
-#include "algebraic_parser.h"
+#include "binning.h"
+#include "compiled_expression.h"
+#include "curve_sampling.h"
+#include "level_of_detail.h"
+#include "surface_grid.h"
 #include <sstream>
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
 
+namespace {
+
+// Samples per column for curves whose x is not monotone in the parameter
+constexpr int kCurveSamplesPerColumn = 4;
+
+Vector Linspace(double lo, double hi, size_t n) {
+    Vector v(n);
+    double step = n > 1 ? (hi - lo) / static_cast<double>(n - 1) : 0.0;
+    for (size_t i = 0; i < n; ++i) v[i] = lo + static_cast<double>(i) * step;
+    return v;
+}
+
+// Liang-Barsky: trims the segment to the plot window; false if none of it is visible
+bool ClipToWindow(double& x0, double& y0, double& x1, double& y1, const PlotConfig& config) {
+    const double dx = x1 - x0, dy = y1 - y0;
+    const double p[] = {-dx, dx, -dy, dy};
+    const double q[] = {x0 - config.x_min, config.x_max - x0, y0 - config.y_min, config.y_max - y0};
+    double t0 = 0.0, t1 = 1.0;
+    for (int k = 0; k < 4; ++k) {
+        if (p[k] == 0.0) {
+            if (q[k] < 0.0) return false;
+            continue;
+        }
+        double t = q[k] / p[k];
+        if (p[k] < 0.0) t0 = std::max(t0, t);
+        else t1 = std::min(t1, t);
+        if (t0 > t1) return false;
+    }
+    const double ox = x0, oy = y0;
+    x0 = ox + t0 * dx;
+    y0 = oy + t0 * dy;
+    x1 = ox + t1 * dx;
+    y1 = oy + t1 * dy;
+    return true;
+}
+
+// MapToScreen puts column boundaries every (x_max - x_min) / (width - 1)
+size_t EnvelopeColumns(const PlotConfig& config) {
+    return static_cast<size_t>(std::max(config.width - 1, 1));
+}
+
+} // namespace
+
 std::string PlotEngine::PlotFunction(const std::string& expression, const PlotConfig& config) {
-    AlgebraicParser parser;
+    // Compile once; samples are added only where a character cell needs them
+    auto compiled = CompiledExpression::Compile(expression, {"x"});
+    if (!compiled) return "Error: Invalid expression\n";
+
+    CurveSampling::Options options;
+    options.x_pixels = static_cast<size_t>(std::max(config.width, 1));
+    options.y_pixels = static_cast<size_t>(std::max(config.height, 1));
+    options.y_min = config.y_min;
+    options.y_max = config.y_max;
+    options.initial_step_pixels = 1;
+    options.jump_pixels = 2;
+    // Cached tiles supply samples at most min_step apart, so the sampler only probes jumps and domain edges
+    CurveSampling::Curve base;
+    const double spacing = options.min_step_pixels * (config.x_max - config.x_min) / static_cast<double>(options.x_pixels);
+    const bool tiled = tile_cache_.SampleCurve(*compiled, config.x_min, config.x_max, spacing, base.x, base.y);
+    auto curve = CurveSampling::Sample(*compiled, config.x_min, config.x_max, options, tiled ? &base : nullptr);
+    return Rasterize(curve.x, curve.y, config, curve.breaks);
+}
+
+std::string PlotEngine::PlotParametric(const std::string& x_expr, const std::string& y_expr,
+                                      double t_min, double t_max, const PlotConfig& config) {
+    auto x_of_t = CompiledExpression::Compile(x_expr, {"t"});
+    auto y_of_t = CompiledExpression::Compile(y_expr, {"t"});
+    if (!x_of_t || !y_of_t) return "Error: Invalid expression\n";
+
+    Vector ts = Linspace(t_min, t_max, static_cast<size_t>(std::max(config.width, 0)) * kCurveSamplesPerColumn);
+    Vector xs(ts.size()), ys(ts.size());
+    x_of_t->Evaluate(ts.data(), xs.data(), ts.size());
+    y_of_t->Evaluate(ts.data(), ys.data(), ts.size());
+    return Rasterize(xs, ys, config);
+}
+
+std::string PlotEngine::PolarPlot(const std::string& r_expression, const PlotConfig& config) {
+    // Angles are in degrees, like the parser's trigonometry; "theta" and "t" both name the angle
+    auto r_of_theta = CompiledExpression::Compile(r_expression, {"theta", "t"});
+    if (!r_of_theta) return "Error: Invalid expression\n";
+
+    Vector thetas = Linspace(0.0, 360.0, static_cast<size_t>(std::max(config.width, 0)) * kCurveSamplesPerColumn);
+    Vector rs(thetas.size());
+    const double* inputs[] = {thetas.data(), thetas.data()};
+    r_of_theta->Evaluate(inputs, rs.data(), thetas.size());
+
+    Vector xs(rs.size()), ys(rs.size());
+    for (size_t i = 0; i < rs.size(); ++i) {
+        xs[i] = rs[i] * std::cos(thetas[i] * D2R);
+        ys[i] = rs[i] * std::sin(thetas[i] * D2R);
+    }
+    return Rasterize(xs, ys, config);
+}
+
+std::string PlotEngine::PlotSurface(const std::string& expression, const PlotConfig& config) {
+    // Top-down heatmap: one grid point per character cell, darkest to brightest
+    auto compiled = CompiledExpression::Compile(expression, {"x", "y"});
+    if (!compiled) return "Error: Invalid expression\n";
+
+    GridSpec spec;
+    spec.columns = static_cast<size_t>(std::max(config.width, 2));
+    spec.rows = static_cast<size_t>(std::max(config.height, 2));
+    spec.x_min = config.x_min;
+    spec.x_max = config.x_max;
+    spec.y_min = config.y_min;
+    spec.y_max = config.y_max;
+    std::optional<SurfaceGrid> grid;
+    SurfaceGrid tiled;
+    if (tile_cache_.SampleSurface(*compiled, spec, tiled)) grid = std::move(tiled);
+    else grid = Surface::Evaluate(*compiled, spec);
+    if (!grid) return "Error: Invalid plot range\n";
+    auto range = Surface::FiniteRange(*grid);
+    if (!range) return "Error: Function is undefined over the plot range\n";
+
+    std::stringstream result;
+    for (size_t r = 0; r < grid->Rows(); ++r) {
+        for (size_t c = 0; c < grid->Columns(); ++c) {
+            float z = grid->At(c, r);
+            result << (std::isfinite(z) ? GetCharForValue(z, range->first, range->second) : ' ');
+        }
+        result << "\n";
+    }
+    result << "z: " << range->first << " (' ') to " << range->second << " ('@')\n";
+    return result.str();
+}
+
+char PlotEngine::GetCharForValue(double value, double min_val, double max_val) {
+    static constexpr char kRamp[] = " .:-=+*#%@";
+    constexpr int kLevels = sizeof(kRamp) - 1;
+    if (!(max_val > min_val)) return kRamp[kLevels / 2];
+    double t = std::clamp((value - min_val) / (max_val - min_val), 0.0, 1.0);
+    return kRamp[static_cast<int>(std::lround(t * (kLevels - 1)))];
+}
+
+std::string PlotEngine::Rasterize(const Vector& xs, const Vector& ys, const PlotConfig& config,
+                                  const std::vector<size_t>& breaks) {
+    if (config.width <= 0 || config.height <= 0) return "";
     std::vector<std::string> lines(config.height, std::string(config.width, ' '));
-    
-    // Calculate step size
-    double x_step = (config.x_max - config.x_min) / (config.width - 1);
-    
-    for (int col = 0; col < config.width; ++col) {
-        double x = config.x_min + col * x_step;
-        
-        std::map<std::string, double> context;
-        context["x"] = x;
-        
-        auto result = parser.ParseAndExecuteWithContext(expression, context);
-        if (result.result.has_value()) {
-            double y = std::get<double>(*result.result);
-            
-            if (std::isfinite(y) && y >= config.y_min && y <= config.y_max) {
-                auto [screen_x, screen_y] = MapToScreen(x, y, config);
-                if (screen_x >= 0 && screen_x < config.width && 
-                    screen_y >= 0 && screen_y < config.height) {
-                    lines[screen_y][screen_x] = config.plot_char;
-                }
-            }
+    auto set = [&](int col, int row) {
+        if (col >= 0 && col < config.width && row >= 0 && row < config.height) {
+            lines[row][col] = config.plot_char;
+        }
+    };
+
+    auto next_break = breaks.begin();
+    for (size_t i = 0; i + 1 < xs.size(); ++i) {
+        while (next_break != breaks.end() && *next_break < i) ++next_break;
+        if (next_break != breaks.end() && *next_break == i) continue;
+        double x0 = xs[i], y0 = ys[i], x1 = xs[i + 1], y1 = ys[i + 1];
+        if (!std::isfinite(x0) || !std::isfinite(y0) || !std::isfinite(x1) || !std::isfinite(y1)) continue;
+        if (!ClipToWindow(x0, y0, x1, y1, config)) continue;
+
+        // Join neighbouring samples cell by cell so steep stretches stay connected
+        auto [c0, r0] = MapToScreen(x0, y0, config);
+        auto [c1, r1] = MapToScreen(x1, y1, config);
+        int steps = std::max(std::abs(c1 - c0), std::abs(r1 - r0));
+        for (int s = 0; s <= steps; ++s) {
+            double t = steps > 0 ? static_cast<double>(s) / steps : 0.0;
+            set(static_cast<int>(std::lround(c0 + t * (c1 - c0))), static_cast<int>(std::lround(r0 + t * (r1 - r0))));
+        }
+    }
+    // Isolated samples (single points between breaks) are drawn too
+    for (size_t i = 0; i < xs.size(); ++i) {
+        double x = xs[i];
+        double y = ys[i];
+        if (std::isfinite(x) && std::isfinite(y) &&
+            x >= config.x_min && x <= config.x_max &&
+            y >= config.y_min && y <= config.y_max) {
+            auto [screen_x, screen_y] = MapToScreen(x, y, config);
+            set(screen_x, screen_y);
         }
     }
     
@@ -73,6 +223,14 @@ std::string PlotEngine::PlotData(const Vector& x_data, const Vector& y_data, con
         return "Error: Data vectors must be same size and non-empty\n";
     }
     
+    // A series sorted by x is drawn as a line through each screen column's first,
+    // lowest, highest and last point: the same cells as all points, at a cost set by the width
+    if (std::is_sorted(x_data.begin(), x_data.end())) {
+        auto view = LevelOfDetail::Envelope(x_data.data(), y_data.data(), x_data.size(),
+                                            config.x_min, config.x_max, EnvelopeColumns(config));
+        return Rasterize(view.x, view.y, config);
+    }
+    
     std::vector<std::string> lines(config.height, std::string(config.width, ' '));
     
     for (size_t i = 0; i < x_data.size(); ++i) {
@@ -93,58 +251,57 @@ std::string PlotEngine::PlotData(const Vector& x_data, const Vector& y_data, con
     
     std::stringstream result;
     for (const auto& line : lines) {
-        result << line << "\\n";
+        result << line << "\n";
     }
     
     return result.str();
 }
 
+std::string PlotEngine::PlotSeries(const LevelOfDetail::Pyramid& series, const PlotConfig& config) {
+    auto view = series.Envelope(config.x_min, config.x_max, EnvelopeColumns(config));
+    return Rasterize(view.x, view.y, config);
+}
+
 std::string PlotEngine::Histogram(const Vector& data, int bins, const PlotConfig& config) {
     if (data.empty() || bins <= 0) {
         return "Error: Data must be non-empty and bins > 0\n";
     }
     
-    // Find data range
-    auto [min_it, max_it] = std::minmax_element(data.begin(), data.end());
-    double data_min = *min_it;
-    double data_max = *max_it;
-    
-    if (data_min == data_max) {
+    // Find data range (NaN / inf are counted separately, not binned)
+    auto range = Binning::FiniteRange(data.data(), data.size());
+    if (!range) return "Error: No valid data\n";
+    if (range->first == range->second) {
         return "Error: All data points are identical\n";
     }
     
-    // Create histogram bins
-    std::vector<int> hist(bins, 0);
-    double bin_width = (data_max - data_min) / bins;
-    
-    for (double val : data) {
-        int bin = static_cast<int>((val - data_min) / bin_width);
-        if (bin >= bins) bin = bins - 1;  // Handle edge case
-        hist[bin]++;
-    }
+    // Shared SIMD binning (same counts as the statistics "hist" command)
+    auto hist = Binning::Uniform(data.data(), data.size(), static_cast<size_t>(bins), range->first, range->second);
+    if (!hist) return "Error: Invalid histogram range\n";
     
     // Find max frequency for scaling
-    int max_freq = *std::max_element(hist.begin(), hist.end());
-    if (max_freq == 0) return "Error: No valid data\n";
+    uint64_t max_freq = *std::max_element(hist->counts.begin(), hist->counts.end());
     
     std::stringstream result;
     result << "Histogram (" << data.size() << " points, " << bins << " bins):\n";
     
     for (int i = bins - 1; i >= 0; --i) {
-        double bin_start = data_min + i * bin_width;
-        double bin_end = bin_start + bin_width;
+        double bin_start = hist->edges[i];
+        double bin_end = hist->edges[i + 1];
         
-        int bar_length = static_cast<int>((hist[i] * config.width) / max_freq);
+        int bar_length = static_cast<int>(hist->counts[i] * static_cast<uint64_t>(config.width) / max_freq);
         
         result << std::fixed << std::setprecision(2) 
-               << "[" << bin_start << "-" << bin_end << ") ";
+               << "[" << bin_start << "-" << bin_end << (i == bins - 1 ? "] " : ") ");
         
         for (int j = 0; j < bar_length; ++j) {
             result << config.plot_char;
         }
-        result << " (" << hist[i] << ")\n";
+        result << " (" << hist->counts[i] << ")\n";
     }
     
+    uint64_t skipped = hist->below + hist->above + hist->missing;
+    if (skipped > 0) result << skipped << " non-finite values not shown\n";
+    
     return result.str();
 }
 
@@ -0,0 +1,319 @@
+/**
+ * @file plot_tile_cache.cpp
+ * @brief Dyadic sample tiles with LRU eviction and background prefetch
+ */
+
+#include "plot_tile_cache.h"
+#include "parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+constexpr double kMaxIndex = 4503599627370496.0;          // 2^52: sample indices stay exact as doubles
+constexpr int kMaxLevel = 1000;                           // 2^-1000 is still a normal double
+constexpr double kMaxCurveSamples = 1 << 22;
+constexpr double kMaxSurfaceSamples = 1 << 26;
+
+struct TileKey {
+    uint64_t expression = 0;
+    int32_t level = 0;     // Level along x
+    bool surface = false;
+    int64_t tx = 0;
+    int64_t ty = 0;        // Always 0 for curve tiles
+    int32_t level_y = 0;   // Level along y; always 0 for curve tiles
+
+    bool operator==(const TileKey& other) const {
+        return expression == other.expression && level == other.level && surface == other.surface &&
+               tx == other.tx && ty == other.ty && level_y == other.level_y;
+    }
+};
+
+struct TileKeyHash {
+    size_t operator()(const TileKey& key) const {
+        uint64_t h = key.expression;
+        for (uint64_t v : {static_cast<uint64_t>(key.level) * 2 + key.surface, static_cast<uint64_t>(key.tx),
+                           static_cast<uint64_t>(key.ty), static_cast<uint64_t>(key.level_y)}) {
+            h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+int64_t FloorDiv(int64_t a, int64_t b) { return a / b - (a % b != 0 && (a < 0) != (b < 0)); }
+
+using Tile = std::shared_ptr<const Vector>;
+
+Tile EvaluateTile(const CompiledExpression& f, const TileKey& key) {
+    if (!key.surface) {
+        Vector xs(PlotTileCache::kCurveTile);
+        auto values = std::make_shared<Vector>(xs.size());
+        for (size_t k = 0; k < xs.size(); ++k) {
+            xs[k] = std::ldexp(static_cast<double>(key.tx * static_cast<int64_t>(xs.size()) + static_cast<int64_t>(k)), -key.level);
+        }
+        f.Evaluate(xs.data(), values->data(), xs.size());
+        return values;
+    }
+    constexpr size_t side = PlotTileCache::kSurfaceTile;
+    Vector xs(side * side), ys(side * side);
+    auto values = std::make_shared<Vector>(side * side);
+    for (size_t r = 0; r < side; ++r) {
+        const double y = std::ldexp(static_cast<double>(key.ty * static_cast<int64_t>(side) + static_cast<int64_t>(r)), -key.level_y);
+        for (size_t c = 0; c < side; ++c) {
+            xs[r * side + c] = std::ldexp(static_cast<double>(key.tx * static_cast<int64_t>(side) + static_cast<int64_t>(c)), -key.level);
+            ys[r * side + c] = y;
+        }
+    }
+    const double* inputs[] = {xs.data(), ys.data()};
+    f.Evaluate(inputs, values->data(), xs.size());
+    return values;
+}
+
+// Grid indices [lo, hi] covering [a, b] at `step`; false if they would not stay exact
+bool IndexRange(double a, double b, double step, int64_t& lo, int64_t& hi) {
+    const double first = std::floor(a / step), last = std::ceil(b / step);
+    if (!(std::abs(first) < kMaxIndex && std::abs(last) < kMaxIndex)) return false;
+    lo = static_cast<int64_t>(first);
+    hi = static_cast<int64_t>(last);
+    return true;
+}
+
+} // namespace
+
+struct PlotTileCache::State : std::enable_shared_from_this<PlotTileCache::State> {
+    struct Entry {
+        Tile values;
+        bool prefetched = false;   // Filled in the background and not looked up since
+        std::list<TileKey>::iterator lru;
+    };
+
+    explicit State(size_t max) : max_tiles(std::max<size_t>(max, 1)) {}
+
+    // The caller holds mutex
+    Tile Find(const TileKey& key) {
+        auto it = tiles.find(key);
+        if (it == tiles.end()) return nullptr;
+        lru.splice(lru.begin(), lru, it->second.lru);
+        ++metrics.hits;
+        if (it->second.prefetched) {
+            ++metrics.prefetch_hits;
+            it->second.prefetched = false;
+        }
+        return it->second.values;
+    }
+
+    // The caller holds mutex; an entry already present is kept
+    void Insert(const TileKey& key, Tile values, bool prefetched) {
+        if (tiles.count(key)) return;
+        lru.push_front(key);
+        tiles.emplace(key, Entry{std::move(values), prefetched, lru.begin()});
+        while (tiles.size() > max_tiles) {
+            tiles.erase(lru.back());
+            lru.pop_back();
+            ++metrics.evictions;
+        }
+    }
+
+    /**
+     * The tiles for `keys`, in order: hits from the cache, misses evaluated
+     * here (in parallel when there are many) and then inserted
+     */
+    std::vector<Tile> Fetch(const CompiledExpression& f, const std::vector<TileKey>& keys) {
+        std::vector<Tile> found(keys.size());
+        std::vector<size_t> missing;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < keys.size(); ++i) {
+                found[i] = Find(keys[i]);
+                if (!found[i]) missing.push_back(i);
+            }
+            metrics.misses += missing.size();
+        }
+        const size_t work = keys.empty() || !keys[0].surface ? kCurveTile : kSurfaceTile * kSurfaceTile;
+        AXIOM::Parallel::ParallelForWork(missing.size(), work, [&](size_t lo, size_t hi) {
+            for (size_t m = lo; m < hi; ++m) found[missing[m]] = EvaluateTile(f, keys[missing[m]]);
+        });
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i : missing) Insert(keys[i], found[i], false);
+        return found;
+    }
+
+    // Queues the keys that are neither cached nor already queued
+    void Prefetch(const CompiledExpression& f, const std::vector<TileKey>& keys) {
+        std::vector<TileKey> queue;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& key : keys) {
+                if (tiles.count(key) || !in_flight.insert(key).second) continue;
+                queue.push_back(key);
+            }
+            pending += queue.size();
+        }
+        if (queue.empty()) return;
+        auto expression = std::make_shared<const CompiledExpression>(f);
+        for (const auto& key : queue) {
+            AXIOM::ThreadPool::Global().Submit([self = shared_from_this(), expression, key] {
+                Tile values = EvaluateTile(*expression, key);
+                std::lock_guard<std::mutex> lock(self->mutex);
+                self->in_flight.erase(key);
+                if (!self->tiles.count(key)) {
+                    self->Insert(key, std::move(values), true);
+                    ++self->metrics.prefetched;
+                }
+                --self->pending;
+                self->idle.notify_all();
+            });
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::condition_variable idle;
+    const size_t max_tiles;
+    std::unordered_map<TileKey, Entry, TileKeyHash> tiles;
+    std::list<TileKey> lru;   // Most recently used first
+    std::unordered_set<TileKey, TileKeyHash> in_flight;
+    size_t pending = 0;       // Queued prefetch tasks
+    PlotCacheMetrics metrics;
+};
+
+PlotTileCache::PlotTileCache(size_t max_tiles) : state_(std::make_shared<State>(max_tiles)) {}
+
+PlotTileCache::~PlotTileCache() { WaitForPrefetch(); }
+
+int PlotTileCache::LevelFor(double spacing) {
+    // spacing = m * 2^e with 1 <= m < 2, so 2^e is the largest power of two not above it
+    return -std::ilogb(spacing);
+}
+
+bool PlotTileCache::SampleCurve(const CompiledExpression& f, double x_min, double x_max, double spacing,
+                                Vector& xs, Vector& ys) {
+    if (f.VariableCount() != 1 || !(x_min < x_max) || !(spacing > 0.0) || !std::isfinite(spacing)) return false;
+    const int level = LevelFor(spacing);
+    if (std::abs(level) > kMaxLevel) return false;
+    const double step = std::ldexp(1.0, -level);
+    int64_t i0, i1;
+    if (!IndexRange(x_min, x_max, step, i0, i1) || static_cast<double>(i1 - i0) > kMaxCurveSamples) return false;
+
+    const int64_t per_tile = static_cast<int64_t>(kCurveTile);
+    const int64_t t0 = FloorDiv(i0, per_tile), t1 = FloorDiv(i1, per_tile);
+    const uint64_t id = f.Fingerprint();
+    std::vector<TileKey> keys;
+    for (int64_t t = t0; t <= t1; ++t) keys.push_back({id, level, false, t, 0});
+    std::vector<Tile> tiles = state_->Fetch(f, keys);
+
+    xs.resize(static_cast<size_t>(i1 - i0 + 1));
+    ys.resize(xs.size());
+    for (int64_t i = i0; i <= i1; ++i) {
+        const int64_t t = FloorDiv(i, per_tile);
+        xs[static_cast<size_t>(i - i0)] = std::ldexp(static_cast<double>(i), -level);
+        ys[static_cast<size_t>(i - i0)] = (*tiles[static_cast<size_t>(t - t0)])[static_cast<size_t>(i - t * per_tile)];
+    }
+
+    // The next tile each way, and the view one level coarser
+    std::vector<TileKey> ahead = {{id, level, false, t0 - 1, 0}, {id, level, false, t1 + 1, 0}};
+    if (level > -kMaxLevel) {
+        for (int64_t t = FloorDiv(t0, 2); t <= FloorDiv(t1, 2); ++t) ahead.push_back({id, level - 1, false, t, 0});
+    }
+    state_->Prefetch(f, ahead);
+    return true;
+}
+
+bool PlotTileCache::SampleSurface(const CompiledExpression& f, const GridSpec& spec, SurfaceGrid& grid) {
+    if (f.VariableCount() != 2 || spec.columns < 2 || spec.rows < 2) return false;
+    if (!(spec.x_min < spec.x_max) || !(spec.y_min < spec.y_max)) return false;
+    const double dx = (spec.x_max - spec.x_min) / static_cast<double>(spec.columns - 1);
+    const double dy = (spec.y_max - spec.y_min) / static_cast<double>(spec.rows - 1);
+    if (!(dx > 0.0) || !std::isfinite(dx) || !(dy > 0.0) || !std::isfinite(dy)) return false;
+    // One level per axis, so a wide, short view does not sample y at the x spacing
+    const int level_x = LevelFor(dx), level_y = LevelFor(dy);
+    if (std::abs(level_x) > kMaxLevel || std::abs(level_y) > kMaxLevel) return false;
+    const double step_x = std::ldexp(1.0, -level_x), step_y = std::ldexp(1.0, -level_y);
+    int64_t i0, i1, j0, j1;
+    if (!IndexRange(spec.x_min, spec.x_max, step_x, i0, i1) || !IndexRange(spec.y_min, spec.y_max, step_y, j0, j1) ||
+        static_cast<double>(i1 - i0 + 1) * static_cast<double>(j1 - j0 + 1) > kMaxSurfaceSamples) {
+        return false;
+    }
+
+    const int64_t side = static_cast<int64_t>(kSurfaceTile);
+    const int64_t tx0 = FloorDiv(i0, side), tx1 = FloorDiv(i1, side);
+    const int64_t ty0 = FloorDiv(j0, side), ty1 = FloorDiv(j1, side);
+    const size_t across = static_cast<size_t>(tx1 - tx0 + 1);
+    const uint64_t id = f.Fingerprint();
+    std::vector<TileKey> keys;
+    for (int64_t ty = ty0; ty <= ty1; ++ty) {
+        for (int64_t tx = tx0; tx <= tx1; ++tx) keys.push_back({id, level_x, true, tx, ty, level_y});
+    }
+    std::vector<Tile> tiles = state_->Fetch(f, keys);
+
+    grid.spec = spec;
+    grid.values.resize(spec.columns * spec.rows);
+    std::vector<int64_t> column_index(spec.columns);
+    for (size_t c = 0; c < spec.columns; ++c) {
+        column_index[c] = std::clamp(static_cast<int64_t>(std::llround(grid.X(c) / step_x)), i0, i1);
+    }
+    for (size_t r = 0; r < spec.rows; ++r) {
+        const int64_t j = std::clamp(static_cast<int64_t>(std::llround(grid.Y(r) / step_y)), j0, j1);
+        const int64_t ty = FloorDiv(j, side);
+        for (size_t c = 0; c < spec.columns; ++c) {
+            const int64_t i = column_index[c], tx = FloorDiv(i, side);
+            const Vector& tile = *tiles[static_cast<size_t>(ty - ty0) * across + static_cast<size_t>(tx - tx0)];
+            grid.values[r * spec.columns + c] =
+                static_cast<float>(tile[static_cast<size_t>((j - ty * side) * side + (i - tx * side))]);
+        }
+    }
+
+    // The ring of tiles around the view, and the view one level coarser
+    std::vector<TileKey> ahead;
+    for (int64_t ty = ty0 - 1; ty <= ty1 + 1; ++ty) {
+        for (int64_t tx = tx0 - 1; tx <= tx1 + 1; ++tx) {
+            if (ty < ty0 || ty > ty1 || tx < tx0 || tx > tx1) ahead.push_back({id, level_x, true, tx, ty, level_y});
+        }
+    }
+    if (level_x > -kMaxLevel && level_y > -kMaxLevel) {
+        for (int64_t ty = FloorDiv(ty0, 2); ty <= FloorDiv(ty1, 2); ++ty) {
+            for (int64_t tx = FloorDiv(tx0, 2); tx <= FloorDiv(tx1, 2); ++tx) {
+                ahead.push_back({id, level_x - 1, true, tx, ty, level_y - 1});
+            }
+        }
+    }
+    state_->Prefetch(f, ahead);
+    return true;
+}
+
+void PlotTileCache::WaitForPrefetch() {
+    // Helps run queued tasks, so waiting from a pool thread cannot deadlock
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    while (state_->pending > 0) {
+        lock.unlock();
+        if (!AXIOM::ThreadPool::Global().TryRunOneTask()) {
+            lock.lock();
+            state_->idle.wait_for(lock, std::chrono::milliseconds(1), [&] { return state_->pending == 0; });
+            continue;
+        }
+        lock.lock();
+    }
+}
+
+void PlotTileCache::Clear() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->tiles.clear();
+    state_->lru.clear();
+}
+
+PlotCacheMetrics PlotTileCache::Metrics() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    PlotCacheMetrics metrics = state_->metrics;
+    metrics.resident = state_->tiles.size();
+    return metrics;
+}
+
+void PlotTileCache::ResetMetrics() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->metrics = PlotCacheMetrics();
+}
@@ -0,0 +1,237 @@
+/**
+ * @file quantile_select.cpp
+ * @brief Floyd-Rivest selection, multi-select and parallel quantiles
+ */
+
+#include "quantile_select.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+namespace Selection {
+
+namespace {
+
+// Ranges at or below this size are partitioned without the sampling step
+constexpr ptrdiff_t kSampleCutoff = 600;
+
+// Above this many quantiles the per-bracket counting pass costs more than a copy
+constexpr size_t kMaxParallelRanks = 16;
+
+void SelectImpl(double* a, ptrdiff_t left, ptrdiff_t right, ptrdiff_t k) {
+    while (right > left) {
+        if (right - left > kSampleCutoff) {
+            // Recursively select within a sample-sized window around k so the
+            // pivot lands close to the k-th element
+            double n = static_cast<double>(right - left + 1);
+            double i = static_cast<double>(k - left + 1);
+            double z = std::log(n);
+            double s = 0.5 * std::exp(2.0 * z / 3.0);
+            double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i - n / 2 < 0 ? -1.0 : 1.0);
+            ptrdiff_t new_left = std::max(left, static_cast<ptrdiff_t>(std::floor(static_cast<double>(k) - i * s / n + sd)));
+            ptrdiff_t new_right = std::min(right, static_cast<ptrdiff_t>(std::floor(static_cast<double>(k) + (n - i) * s / n + sd)));
+            SelectImpl(a, new_left, new_right, k);
+        }
+
+        double t = a[k];
+        ptrdiff_t i = left;
+        ptrdiff_t j = right;
+        std::swap(a[left], a[k]);
+        if (a[right] > t) std::swap(a[right], a[left]);
+        while (i < j) {
+            std::swap(a[i], a[j]);
+            ++i;
+            --j;
+            while (a[i] < t) ++i;
+            while (a[j] > t) --j;
+        }
+        if (a[left] == t) {
+            std::swap(a[left], a[j]);
+        } else {
+            ++j;
+            std::swap(a[j], a[right]);
+        }
+        if (j <= k) left = j + 1;
+        if (k <= j) right = j - 1;
+    }
+}
+
+void MultiSelectImpl(double* a, size_t lo, size_t hi, const size_t* ranks, size_t count) {
+    // [lo, hi) holds exactly the values whose sorted positions are lo..hi-1
+    while (count > 0 && hi - lo > 1) {
+        size_t mid = count / 2;
+        size_t k = ranks[mid];
+        SelectImpl(a, static_cast<ptrdiff_t>(lo), static_cast<ptrdiff_t>(hi - 1), static_cast<ptrdiff_t>(k));
+
+        // Recurse on the smaller side, loop on the larger
+        if (mid < count - mid - 1) {
+            MultiSelectImpl(a, lo, k, ranks, mid);
+            lo = k + 1;
+            ranks += mid + 1;
+            count -= mid + 1;
+        } else {
+            MultiSelectImpl(a, k + 1, hi, ranks + mid + 1, count - mid - 1);
+            hi = k;
+            count = mid;
+        }
+    }
+}
+
+// Order statistics needed for linear interpolation at each probability
+std::vector<size_t> RanksFor(size_t n, const double* probs, size_t count) {
+    std::vector<size_t> ranks;
+    ranks.reserve(count * 2);
+    for (size_t q = 0; q < count; ++q) {
+        double h = std::clamp(probs[q], 0.0, 1.0) * static_cast<double>(n - 1);
+        size_t lower = static_cast<size_t>(h);
+        ranks.push_back(lower);
+        if (lower + 1 < n && h > static_cast<double>(lower)) ranks.push_back(lower + 1);
+    }
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    return ranks;
+}
+
+template <typename ValueAt>
+void Interpolate(size_t n, const double* probs, size_t count, double* out, ValueAt value_at) {
+    for (size_t q = 0; q < count; ++q) {
+        double h = std::clamp(probs[q], 0.0, 1.0) * static_cast<double>(n - 1);
+        size_t lower = static_cast<size_t>(h);
+        double weight = h - static_cast<double>(lower);
+        double v = value_at(lower);
+        if (weight > 0.0 && lower + 1 < n) {
+            v = v * (1.0 - weight) + value_at(lower + 1) * weight;
+        }
+        out[q] = v;
+    }
+}
+
+} // namespace
+
+void FloydRivestSelect(double* data, size_t left, size_t right, size_t k) {
+    if (k < left || k > right) return;
+    SelectImpl(data, static_cast<ptrdiff_t>(left), static_cast<ptrdiff_t>(right), static_cast<ptrdiff_t>(k));
+}
+
+void MultiSelect(double* data, size_t n, const size_t* ranks, size_t rank_count) {
+    if (n == 0) return;
+    MultiSelectImpl(data, 0, n, ranks, rank_count);
+}
+
+void QuantilesInPlace(double* data, size_t n, const double* probs, size_t count, double* out) {
+    if (n == 0 || count == 0) return;
+    std::vector<size_t> ranks = RanksFor(n, probs, count);
+    MultiSelect(data, n, ranks.data(), ranks.size());
+    Interpolate(n, probs, count, out, [data](size_t rank) { return data[rank]; });
+}
+
+void ParallelQuantiles(const double* data, size_t n, const double* probs, size_t count, double* out) {
+    if (n == 0 || count == 0) return;
+
+    std::vector<size_t> ranks = RanksFor(n, probs, count);
+    auto fallback = [&] {
+        std::vector<double> copy(data, data + n);
+        QuantilesInPlace(copy.data(), n, probs, count, out);
+    };
+    if (ranks.size() > kMaxParallelRanks || n < 4096) {
+        fallback();
+        return;
+    }
+
+    // 1. Bracket each rank from a sorted random sample (~4 sigma either side)
+    size_t sample_size = std::min<size_t>(n, 65536);
+    std::vector<double> sample(sample_size);
+    std::mt19937_64 rng(0x5DEECE66DULL ^ n);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    for (auto& v : sample) v = data[pick(rng)];
+    std::sort(sample.begin(), sample.end());
+
+    size_t margin = static_cast<size_t>(2.0 * std::sqrt(static_cast<double>(sample_size))) + 1;
+    size_t r = ranks.size();
+    std::vector<double> bracket_lo(r), bracket_hi(r);
+    for (size_t b = 0; b < r; ++b) {
+        size_t pos = static_cast<size_t>(static_cast<double>(ranks[b]) / static_cast<double>(n - 1) *
+                                         static_cast<double>(sample_size - 1));
+        bracket_lo[b] = sample[pos > margin ? pos - margin : 0];
+        bracket_hi[b] = sample[std::min(sample_size - 1, pos + margin)];
+    }
+
+    // 2. One parallel pass: count values below each bracket and equal to its
+    //    bounds, and gather only the values strictly inside it (chunk partials
+    //    concatenated in index order). Counting the bounds keeps heavy ties,
+    //    where a bracket collapses onto one repeated value, from copying the
+    //    input once per rank.
+    struct Partial {
+        std::vector<size_t> below;
+        std::vector<size_t> at_lo;
+        std::vector<size_t> at_hi;
+        std::vector<std::vector<double>> inside;
+    };
+    auto make_partial = [r] {
+        return Partial{std::vector<size_t>(r, 0), std::vector<size_t>(r, 0), std::vector<size_t>(r, 0),
+                       std::vector<std::vector<double>>(r)};
+    };
+
+    Partial total = AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, make_partial(),
+        [&](size_t lo, size_t hi) {
+            Partial part = make_partial();
+            for (size_t i = lo; i < hi; ++i) {
+                double v = data[i];
+                for (size_t b = 0; b < r; ++b) {
+                    if (v < bracket_lo[b]) part.below[b]++;
+                    else if (v == bracket_lo[b]) part.at_lo[b]++;
+                    else if (v < bracket_hi[b]) part.inside[b].push_back(v);
+                    else if (v == bracket_hi[b]) part.at_hi[b]++;
+                }
+            }
+            return part;
+        },
+        [r](Partial acc, const Partial& part) {
+            for (size_t b = 0; b < r; ++b) {
+                acc.below[b] += part.below[b];
+                acc.at_lo[b] += part.at_lo[b];
+                acc.at_hi[b] += part.at_hi[b];
+                acc.inside[b].insert(acc.inside[b].end(), part.inside[b].begin(), part.inside[b].end());
+            }
+            return acc;
+        });
+
+    // 3. Locate each rank among [below | == lo | inside | == hi] and select
+    //    inside the bracket; a miss means the sample was unlucky
+    std::vector<double> values(r);
+    for (size_t b = 0; b < r; ++b) {
+        auto& bucket = total.inside[b];
+        size_t k = ranks[b];
+        if (k < total.below[b]) {
+            fallback();
+            return;
+        }
+        k -= total.below[b];
+        if (k < total.at_lo[b]) {
+            values[b] = bracket_lo[b];
+            continue;
+        }
+        k -= total.at_lo[b];
+        if (k < bucket.size()) {
+            FloydRivestSelect(bucket.data(), 0, bucket.size() - 1, k);
+            values[b] = bucket[k];
+            continue;
+        }
+        k -= bucket.size();
+        if (k >= total.at_hi[b]) {
+            fallback();
+            return;
+        }
+        values[b] = bracket_hi[b];
+    }
+
+    Interpolate(n, probs, count, out, [&](size_t rank) {
+        size_t b = static_cast<size_t>(std::lower_bound(ranks.begin(), ranks.end(), rank) - ranks.begin());
+        return values[b];
+    });
+}
+
+} // namespace Selection
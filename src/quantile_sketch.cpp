@@ -0,0 +1,421 @@
+/**
+ * @file quantile_sketch.cpp
+ * @brief t-digest and KLL sketch implementations
+ */
+
+#include "quantile_sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr uint8_t kTDigestMagic = 'T';
+constexpr uint8_t kKLLMagic = 'K';
+constexpr uint8_t kFormatVersion = 1;
+
+// Fixed-width little-endian (host order on all supported targets) encoding
+class Writer {
+public:
+    template <typename T>
+    void Put(T value) {
+        size_t at = bytes_.size();
+        bytes_.resize(at + sizeof(T));
+        std::memcpy(bytes_.data() + at, &value, sizeof(T));
+    }
+    std::vector<uint8_t> Take() { return std::move(bytes_); }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    bool Get(T& value) {
+        if (size_ - pos_ < sizeof(T) || pos_ > size_) return false;
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+    bool AtEnd() const { return pos_ == size_; }
+    size_t Remaining() const { return pos_ <= size_ ? size_ - pos_ : 0; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+} // namespace
+
+// ============================================================================
+// TDigest
+// ============================================================================
+
+TDigest::TDigest(double compression)
+    : compression_(std::min(kMaxCompression, std::max(10.0, compression))), min_(kInf), max_(-kInf) {
+    buffer_.reserve(static_cast<size_t>(compression_ * 5));
+}
+
+void TDigest::Add(double x, double weight) {
+    if (std::isnan(x) || !(weight > 0.0)) return;
+    buffer_.push_back({x, weight});
+    total_weight_ += weight;
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+    if (buffer_.size() >= static_cast<size_t>(compression_ * 5)) Flush();
+}
+
+void TDigest::AddRange(const double* data, size_t n) {
+    for (size_t i = 0; i < n; ++i) Add(data[i]);
+}
+
+void TDigest::Merge(const TDigest& other) {
+    if (other.total_weight_ == 0.0) return;
+    other.Flush();
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    total_weight_ += other.total_weight_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    Flush();
+}
+
+void TDigest::Flush() const {
+    if (buffer_.empty()) return;
+
+    std::vector<Centroid> all;
+    all.reserve(centroids_.size() + buffer_.size());
+    all.insert(all.end(), centroids_.begin(), centroids_.end());
+    all.insert(all.end(), buffer_.begin(), buffer_.end());
+    buffer_.clear();
+    std::sort(all.begin(), all.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+    double total = 0.0;
+    for (const auto& c : all) total += c.weight;
+
+    // k2 scale: k(q) = delta / Z * log(q / (1 - q)), Z = 4 log(n / delta) + 24.
+    // A centroid may grow until it spans one unit of k, so centroids shrink
+    // toward the tails and the extreme points stay singletons.
+    const double z = 4.0 * std::log(std::max(total / compression_, 1.0)) + 24.0;
+    const double norm = 2.0 * compression_ / z;
+    auto k_of = [norm](double q) { return norm * std::log(q / (1.0 - q)); };
+    auto q_of = [norm](double k) { return 1.0 / (1.0 + std::exp(-k / norm)); };
+
+    std::vector<Centroid> merged;
+    merged.reserve(static_cast<size_t>(compression_) + 8);
+    Centroid current = all[0];
+    double weight_so_far = 0.0;
+    double limit = total * q_of(k_of(0.0) + 1.0);
+
+    for (size_t i = 1; i < all.size(); ++i) {
+        const Centroid& next = all[i];
+        if (weight_so_far + current.weight + next.weight <= limit) {
+            double w = current.weight + next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / w;
+            current.weight = w;
+        } else {
+            weight_so_far += current.weight;
+            merged.push_back(current);
+            limit = total * q_of(k_of(weight_so_far / total) + 1.0);
+            current = next;
+        }
+    }
+    merged.push_back(current);
+    centroids_ = std::move(merged);
+}
+
+size_t TDigest::CentroidCount() const {
+    Flush();
+    return centroids_.size();
+}
+
+double TDigest::Quantile(double q) const {
+    Flush();
+    if (centroids_.empty()) return kNaN;
+    q = std::clamp(q, 0.0, 1.0);
+    if (centroids_.size() == 1) return centroids_[0].mean;
+
+    const auto& c = centroids_;
+    double total = total_weight_;
+    double index = q * total;
+
+    if (index < 1.0) return min_;
+    if (index > total - 1.0) return max_;
+
+    // Between min and the first centroid's center
+    if (c.front().weight > 2.0 && index < c.front().weight / 2.0) {
+        return min_ + (index - 1.0) / (c.front().weight / 2.0 - 1.0) * (c.front().mean - min_);
+    }
+    // Between the last centroid's center and max
+    if (c.back().weight > 2.0 && total - index <= c.back().weight / 2.0) {
+        return max_ - (total - index - 1.0) / (c.back().weight / 2.0 - 1.0) * (max_ - c.back().mean);
+    }
+
+    // Interpolate between adjacent centroid centers
+    double weight_so_far = c.front().weight / 2.0;
+    for (size_t i = 0; i + 1 < c.size(); ++i) {
+        double dw = (c[i].weight + c[i + 1].weight) / 2.0;
+        if (weight_so_far + dw > index) {
+            double z1 = index - weight_so_far;
+            double z2 = weight_so_far + dw - index;
+            return (c[i].mean * z2 + c[i + 1].mean * z1) / (z1 + z2);
+        }
+        weight_so_far += dw;
+    }
+    return c.back().mean;
+}
+
+double TDigest::CDF(double x) const {
+    Flush();
+    if (centroids_.empty()) return kNaN;
+    if (x < min_) return 0.0;
+    if (x >= max_) return 1.0;
+
+    const auto& c = centroids_;
+    double total = total_weight_;
+    if (x < c.front().mean) {
+        double span = c.front().mean - min_;
+        double frac = span > 0.0 ? (x - min_) / span : 1.0;
+        return frac * c.front().weight / 2.0 / total;
+    }
+
+    double cumulative = 0.0;
+    for (size_t i = 0; i + 1 < c.size(); ++i) {
+        if (x < c[i + 1].mean) {
+            double span = c[i + 1].mean - c[i].mean;
+            double frac = span > 0.0 ? (x - c[i].mean) / span : 0.0;
+            double left = cumulative + c[i].weight / 2.0;
+            return (left + frac * (c[i].weight + c[i + 1].weight) / 2.0) / total;
+        }
+        cumulative += c[i].weight;
+    }
+
+    double span = max_ - c.back().mean;
+    double frac = span > 0.0 ? (x - c.back().mean) / span : 1.0;
+    return (total - c.back().weight / 2.0 + frac * c.back().weight / 2.0) / total;
+}
+
+std::vector<uint8_t> TDigest::Serialize() const {
+    Flush();
+    Writer out;
+    out.Put(kTDigestMagic);
+    out.Put(kFormatVersion);
+    out.Put(compression_);
+    out.Put(min_);
+    out.Put(max_);
+    out.Put(static_cast<uint32_t>(centroids_.size()));
+    for (const auto& c : centroids_) {
+        out.Put(c.mean);
+        out.Put(c.weight);
+    }
+    return out.Take();
+}
+
+std::optional<TDigest> TDigest::Deserialize(const uint8_t* data, size_t size) {
+    Reader in(data, size);
+    uint8_t magic = 0, version = 0;
+    double compression = 0.0, min = 0.0, max = 0.0;
+    uint32_t count = 0;
+    if (!in.Get(magic) || magic != kTDigestMagic || !in.Get(version) || version != kFormatVersion ||
+        !in.Get(compression) || !in.Get(min) || !in.Get(max) || !in.Get(count)) {
+        return std::nullopt;
+    }
+    // Blobs arrive from other processes: bound everything that sizes an allocation
+    if (!(compression >= 10.0 && compression <= kMaxCompression) ||
+        count > in.Remaining() / (2 * sizeof(double))) {
+        return std::nullopt;
+    }
+
+    TDigest digest(compression);
+    digest.min_ = min;
+    digest.max_ = max;
+    digest.centroids_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Centroid c{};
+        if (!in.Get(c.mean) || !in.Get(c.weight) || !(c.weight > 0.0)) return std::nullopt;
+        digest.centroids_.push_back(c);
+        digest.total_weight_ += c.weight;
+    }
+    if (!in.AtEnd()) return std::nullopt;
+    return digest;
+}
+
+// ============================================================================
+// KLLSketch
+// ============================================================================
+
+KLLSketch::KLLSketch(uint32_t k)
+    : k_(std::clamp<uint32_t>(k, 8, kMaxK)), min_(kInf), max_(-kInf) {
+    levels_.emplace_back();
+}
+
+size_t KLLSketch::Capacity(size_t level) const {
+    // Geometric decay (c = 2/3) from the top level down, never below 8;
+    // narrower bottom compactors push the rank error past 1.65 / k
+    size_t depth = levels_.size() - level - 1;
+    double cap = std::ceil(static_cast<double>(k_) * std::pow(2.0 / 3.0, static_cast<double>(depth)));
+    return std::max<size_t>(8, static_cast<size_t>(cap));
+}
+
+size_t KLLSketch::RetainedItems() const {
+    size_t total = 0;
+    for (const auto& level : levels_) total += level.size();
+    return total;
+}
+
+void KLLSketch::Update(double x) {
+    if (std::isnan(x)) return;
+    levels_[0].push_back(x);
+    ++n_;
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+    if (levels_[0].size() >= Capacity(0)) Compress();
+}
+
+void KLLSketch::UpdateRange(const double* data, size_t n) {
+    for (size_t i = 0; i < n; ++i) Update(data[i]);
+}
+
+void KLLSketch::Compress() {
+    // Compact the lowest over-full level until every level fits. Compaction
+    // pushes items up and may add a level, which shrinks every capacity
+    // below it, so levels already visited are rechecked.
+    for (;;) {
+        size_t h = 0;
+        while (h < levels_.size() && levels_[h].size() < Capacity(h)) ++h;
+        if (h == levels_.size()) return;
+
+        if (h + 1 == levels_.size()) levels_.emplace_back();
+        auto& level = levels_[h];
+        std::sort(level.begin(), level.end());
+
+        // An odd item stays behind so total weight is preserved exactly
+        double carry = 0.0;
+        bool has_carry = (level.size() % 2) == 1;
+        if (has_carry) {
+            carry = level.back();
+            level.pop_back();
+        }
+
+        // Random offset keeps the compaction error unbiased
+        rng_state_ ^= rng_state_ << 13;
+        rng_state_ ^= rng_state_ >> 7;
+        rng_state_ ^= rng_state_ << 17;
+        size_t offset = rng_state_ & 1;
+
+        auto& up = levels_[h + 1];
+        for (size_t i = offset; i < level.size(); i += 2) up.push_back(level[i]);
+        level.clear();
+        if (has_carry) level.push_back(carry);
+    }
+}
+
+void KLLSketch::Merge(const KLLSketch& other) {
+    if (other.n_ == 0) return;
+    while (levels_.size() < other.levels_.size()) levels_.emplace_back();
+    for (size_t h = 0; h < other.levels_.size(); ++h) {
+        levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+    }
+    n_ += other.n_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    Compress();
+}
+
+std::vector<std::pair<double, uint64_t>> KLLSketch::WeightedItems() const {
+    std::vector<std::pair<double, uint64_t>> items;
+    items.reserve(RetainedItems());
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        for (double v : levels_[h]) items.emplace_back(v, uint64_t{1} << h);
+    }
+    std::sort(items.begin(), items.end());
+    return items;
+}
+
+double KLLSketch::Quantile(double q) const {
+    if (n_ == 0) return kNaN;
+    q = std::clamp(q, 0.0, 1.0);
+    if (q == 0.0) return min_;
+    if (q == 1.0) return max_;
+
+    auto items = WeightedItems();
+    uint64_t total = 0;
+    for (const auto& item : items) total += item.second;
+
+    double target = q * static_cast<double>(total);
+    uint64_t cumulative = 0;
+    for (const auto& [value, weight] : items) {
+        cumulative += weight;
+        if (static_cast<double>(cumulative) >= target) return value;
+    }
+    return max_;
+}
+
+double KLLSketch::Rank(double x) const {
+    if (n_ == 0) return kNaN;
+    uint64_t below = 0, total = 0;
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        uint64_t weight = uint64_t{1} << h;
+        for (double v : levels_[h]) {
+            total += weight;
+            if (v <= x) below += weight;
+        }
+    }
+    return static_cast<double>(below) / static_cast<double>(total);
+}
+
+std::vector<uint8_t> KLLSketch::Serialize() const {
+    Writer out;
+    out.Put(kKLLMagic);
+    out.Put(kFormatVersion);
+    out.Put(k_);
+    out.Put(n_);
+    out.Put(min_);
+    out.Put(max_);
+    out.Put(static_cast<uint32_t>(levels_.size()));
+    for (const auto& level : levels_) {
+        out.Put(static_cast<uint32_t>(level.size()));
+        for (double v : level) out.Put(v);
+    }
+    return out.Take();
+}
+
+std::optional<KLLSketch> KLLSketch::Deserialize(const uint8_t* data, size_t size) {
+    Reader in(data, size);
+    uint8_t magic = 0, version = 0;
+    uint32_t k = 0, level_count = 0;
+    uint64_t n = 0;
+    double min = 0.0, max = 0.0;
+    if (!in.Get(magic) || magic != kKLLMagic || !in.Get(version) || version != kFormatVersion ||
+        !in.Get(k) || !in.Get(n) || !in.Get(min) || !in.Get(max) || !in.Get(level_count) ||
+        level_count == 0 || level_count > 64 || k < 8 || k > kMaxK) {
+        return std::nullopt;
+    }
+
+    KLLSketch sketch(k);
+    sketch.n_ = n;
+    sketch.min_ = min;
+    sketch.max_ = max;
+    sketch.levels_.assign(level_count, {});
+    // Level h items weigh 2^h and compaction preserves weight, so they must sum to n exactly
+    uint64_t weight = 0;
+    for (size_t h = 0; h < sketch.levels_.size(); ++h) {
+        auto& level = sketch.levels_[h];
+        uint32_t items = 0;
+        if (!in.Get(items) || items > in.Remaining() / sizeof(double)) return std::nullopt;
+        if (items > 0 && (h >= 63 || items > (n - weight) >> h)) return std::nullopt;
+        weight += uint64_t{items} << h;
+        level.resize(items);
+        for (double& v : level) {
+            if (!in.Get(v)) return std::nullopt;
+        }
+    }
+    if (!in.AtEnd() || weight != n) return std::nullopt;
+    return sketch;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file raster_canvas.cpp
+ * @brief Wu lines, coverage fills, column scrolling and the image encoders
+ */
+
+#include "raster_canvas.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+constexpr size_t kMaxStoredBlock = 65535;   // Largest deflate stored block
+
+double Fraction(double v) { return v - std::floor(v); }
+
+// Liang-Barsky against [x_lo, x_hi] x [y_lo, y_hi]; false if nothing is left
+bool Clip(double& x0, double& y0, double& x1, double& y1, double x_lo, double x_hi, double y_lo, double y_hi) {
+    const double dx = x1 - x0, dy = y1 - y0;
+    const double p[] = {-dx, dx, -dy, dy};
+    const double q[] = {x0 - x_lo, x_hi - x0, y0 - y_lo, y_hi - y0};
+    double t0 = 0.0, t1 = 1.0;
+    for (int k = 0; k < 4; ++k) {
+        if (p[k] == 0.0) {
+            if (q[k] < 0.0) return false;
+            continue;
+        }
+        const double t = q[k] / p[k];
+        if (p[k] < 0.0) t0 = std::max(t0, t);
+        else t1 = std::min(t1, t);
+        if (t0 > t1) return false;
+    }
+    const double ox = x0, oy = y0;
+    x0 = ox + t0 * dx;
+    y0 = oy + t0 * dy;
+    x1 = ox + t1 * dx;
+    y1 = oy + t1 * dy;
+    return true;
+}
+
+bool Finite(double a, double b, double c, double d) {
+    return std::isfinite(a) && std::isfinite(b) && std::isfinite(c) && std::isfinite(d);
+}
+
+/**
+ * Calls fn(i) for each segment i -> i + 1 of the polyline that is not a
+ * break; breaks are ascending
+ */
+template <typename Fn>
+void ForEachSegment(size_t n, const std::vector<size_t>& breaks, Fn&& fn) {
+    auto next_break = breaks.begin();
+    for (size_t i = 0; i + 1 < n; ++i) {
+        while (next_break != breaks.end() && *next_break < i) ++next_break;
+        if (next_break != breaks.end() && *next_break == i) continue;
+        fn(i);
+    }
+}
+
+void Append32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void AppendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    Append32(out, static_cast<uint32_t>(data.size()));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    Append32(out, RasterImage::Crc32(out.data() + start, out.size() - start));
+}
+
+std::vector<uint8_t> Netpbm(const RasterCanvas& canvas, bool gray) {
+    std::string header = (gray ? "P5\n" : "P6\n") + std::to_string(canvas.Width()) + " " +
+                         std::to_string(canvas.Height()) + "\n255\n";
+    std::vector<uint8_t> out(header.begin(), header.end());
+    const auto& px = canvas.Pixels();
+    if (!gray) {
+        out.insert(out.end(), px.begin(), px.end());
+        return out;
+    }
+    out.reserve(out.size() + px.size() / 3);
+    for (size_t i = 0; i < px.size(); i += 3) {
+        out.push_back(static_cast<uint8_t>((299u * px[i] + 587u * px[i + 1] + 114u * px[i + 2] + 500u) / 1000u));
+    }
+    return out;
+}
+
+std::vector<uint8_t> Png(const RasterCanvas& canvas) {
+    static const uint8_t kSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> out(kSignature, kSignature + sizeof(kSignature));
+
+    std::vector<uint8_t> header;
+    Append32(header, static_cast<uint32_t>(canvas.Width()));
+    Append32(header, static_cast<uint32_t>(canvas.Height()));
+    header.insert(header.end(), {8, 2, 0, 0, 0});   // 8-bit RGB, deflate, adaptive filters, no interlace
+    AppendChunk(out, "IHDR", header);
+
+    // Scanlines with filter type 0 (None)
+    const size_t row_bytes = 3 * canvas.Width();
+    std::vector<uint8_t> raw;
+    raw.reserve((row_bytes + 1) * canvas.Height());
+    for (size_t y = 0; y < canvas.Height(); ++y) {
+        raw.push_back(0);
+        const uint8_t* row = canvas.Pixels().data() + y * row_bytes;
+        raw.insert(raw.end(), row, row + row_bytes);
+    }
+
+    // zlib stream of stored blocks: CMF/FLG, then per block BFINAL/BTYPE, LEN, NLEN, data; Adler-32
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    zlib.reserve(raw.size() + 5 * (raw.size() / kMaxStoredBlock + 1) + 6);
+    size_t offset = 0;
+    do {
+        const size_t len = std::min(kMaxStoredBlock, raw.size() - offset);
+        const bool final = offset + len == raw.size();
+        zlib.push_back(final ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(len));
+        zlib.push_back(static_cast<uint8_t>(len >> 8));
+        zlib.push_back(static_cast<uint8_t>(~len));
+        zlib.push_back(static_cast<uint8_t>(~len >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + len);
+        offset += len;
+    } while (offset < raw.size());
+    Append32(zlib, RasterImage::Adler32(raw.data(), raw.size()));
+    AppendChunk(out, "IDAT", zlib);
+    AppendChunk(out, "IEND", {});
+    return out;
+}
+
+} // namespace
+
+void RasterCanvas::Resize(size_t width, size_t height) {
+    width_ = width;
+    height_ = height;
+    pixels_.resize(3 * width * height);
+    ResetClip();
+}
+
+Rgb RasterCanvas::At(size_t x, size_t y) const {
+    const uint8_t* p = pixels_.data() + 3 * (y * width_ + x);
+    return {p[0], p[1], p[2]};
+}
+
+void RasterCanvas::SetClip(size_t x0, size_t x1) {
+    clip_x1_ = std::min(x1, width_);
+    clip_x0_ = std::min(x0, clip_x1_);
+}
+
+void RasterCanvas::Clear(Rgb color) {
+    FillRect(static_cast<long>(clip_x0_), 0, static_cast<long>(clip_x1_), static_cast<long>(height_), color);
+}
+
+void RasterCanvas::Blend(long x, long y, Rgb color, double coverage) {
+    if (x < static_cast<long>(clip_x0_) || x >= static_cast<long>(clip_x1_) || y < 0 ||
+        y >= static_cast<long>(height_) || !(coverage > 0.0)) {
+        return;
+    }
+    const double a = std::min(coverage, 1.0);
+    uint8_t* p = pixels_.data() + 3 * (static_cast<size_t>(y) * width_ + static_cast<size_t>(x));
+    const uint8_t c[] = {color.r, color.g, color.b};
+    for (int k = 0; k < 3; ++k) p[k] = static_cast<uint8_t>(std::lround(p[k] + a * (c[k] - p[k])));
+}
+
+void RasterCanvas::FillRect(long x0, long y0, long x1, long y1, Rgb color) {
+    x0 = std::max(x0, static_cast<long>(clip_x0_));
+    x1 = std::min(x1, static_cast<long>(clip_x1_));
+    y0 = std::max(y0, 0L);
+    y1 = std::min(y1, static_cast<long>(height_));
+    for (long y = y0; y < y1; ++y) {
+        uint8_t* p = pixels_.data() + 3 * (static_cast<size_t>(y) * width_);
+        for (long x = x0; x < x1; ++x) {
+            p[3 * x] = color.r;
+            p[3 * x + 1] = color.g;
+            p[3 * x + 2] = color.b;
+        }
+    }
+}
+
+void RasterCanvas::DrawLine(double x0, double y0, double x1, double y1, Rgb color, double opacity) {
+    if (!Finite(x0, y0, x1, y1)) return;
+    // Two pixels of margin: the end cap the cut creates then lands outside the area, so a
+    // clipped line covers the same pixels as the whole line
+    if (!Clip(x0, y0, x1, y1, static_cast<double>(clip_x0_) - 2.0, static_cast<double>(clip_x1_) + 1.0,
+              -2.0, static_cast<double>(height_) + 1.0)) {
+        return;
+    }
+
+    const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    const double dx = x1 - x0, dy = y1 - y0;
+    const double gradient = dx == 0.0 ? 1.0 : dy / dx;
+    auto plot = [&](long major, long minor, double coverage) {
+        if (steep) Blend(minor, major, color, coverage * opacity);
+        else Blend(major, minor, color, coverage * opacity);
+    };
+
+    // First end cap
+    double x_end = std::round(x0);
+    double y_end = y0 + gradient * (x_end - x0);
+    double x_gap = 1.0 - Fraction(x0 + 0.5);
+    const long first = static_cast<long>(x_end);
+    plot(first, static_cast<long>(std::floor(y_end)), (1.0 - Fraction(y_end)) * x_gap);
+    plot(first, static_cast<long>(std::floor(y_end)) + 1, Fraction(y_end) * x_gap);
+    double y_at = y_end + gradient;
+
+    // Second end cap
+    x_end = std::round(x1);
+    y_end = y1 + gradient * (x_end - x1);
+    x_gap = Fraction(x1 + 0.5);
+    const long last = static_cast<long>(x_end);
+    if (last == first) return;   // Shorter than a pixel: the first cap covers it
+    plot(last, static_cast<long>(std::floor(y_end)), (1.0 - Fraction(y_end)) * x_gap);
+    plot(last, static_cast<long>(std::floor(y_end)) + 1, Fraction(y_end) * x_gap);
+
+    for (long x = first + 1; x < last; ++x, y_at += gradient) {
+        const long y = static_cast<long>(std::floor(y_at));
+        plot(x, y, 1.0 - Fraction(y_at));
+        plot(x, y + 1, Fraction(y_at));
+    }
+}
+
+void RasterCanvas::DrawPolyline(const double* xs, const double* ys, size_t n, Rgb color,
+                                const std::vector<size_t>& breaks) {
+    ForEachSegment(n, breaks, [&](size_t i) { DrawLine(xs[i], ys[i], xs[i + 1], ys[i + 1], color); });
+}
+
+void RasterCanvas::FillToBaseline(const double* xs, const double* ys, size_t n, double baseline, Rgb color,
+                                  double opacity, const std::vector<size_t>& breaks) {
+    ForEachSegment(n, breaks, [&](size_t i) {
+        const double x0 = xs[i], x1 = xs[i + 1];
+        if (!Finite(x0, ys[i], x1, ys[i + 1]) || !(x0 < x1)) return;
+        // Columns whose centre lies in [x0, x1), so neighbouring segments never fill one twice
+        const long c_lo = std::max(static_cast<long>(std::ceil(x0)), static_cast<long>(clip_x0_));
+        const long c_hi = std::min(static_cast<long>(std::ceil(x1)), static_cast<long>(clip_x1_));
+        for (long c = c_lo; c < c_hi; ++c) {
+            const double t = (c - x0) / (x1 - x0);
+            const double y = ys[i] + t * (ys[i + 1] - ys[i]);
+            // Pixel row j spans [j - 0.5, j + 0.5); coverage is its overlap with the span
+            const double top = std::clamp(std::min(y, baseline), -0.5, height_ - 0.5);
+            const double bottom = std::clamp(std::max(y, baseline), -0.5, height_ - 0.5);
+            for (long j = static_cast<long>(std::floor(top + 0.5)); j <= static_cast<long>(std::floor(bottom + 0.5)); ++j) {
+                const double overlap = std::min(bottom, j + 0.5) - std::max(top, j - 0.5);
+                Blend(c, j, color, overlap * opacity);
+            }
+        }
+    });
+}
+
+void RasterCanvas::DrawImage(const uint8_t* rgb, size_t width, size_t height) {
+    if (width == 0 || height == 0) return;
+    for (size_t y = 0; y < height_; ++y) {
+        const size_t sy = y * height / height_;
+        uint8_t* row = pixels_.data() + 3 * y * width_;
+        for (size_t x = clip_x0_; x < clip_x1_; ++x) {
+            const uint8_t* src = rgb + 3 * (sy * width + x * width / width_);
+            std::memcpy(row + 3 * x, src, 3);
+        }
+    }
+}
+
+void RasterCanvas::ScrollColumns(long dx) {
+    const size_t shift = static_cast<size_t>(std::labs(dx));
+    if (dx == 0 || shift >= width_) return;
+    const size_t keep = 3 * (width_ - shift);
+    for (size_t y = 0; y < height_; ++y) {
+        uint8_t* row = pixels_.data() + 3 * y * width_;
+        if (dx > 0) std::memmove(row + 3 * shift, row, keep);
+        else std::memmove(row, row + 3 * shift, keep);
+    }
+}
+
+namespace RasterImage {
+
+uint32_t Crc32(const uint8_t* data, size_t n, uint32_t crc) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t Adler32(const uint8_t* data, size_t n, uint32_t adler) {
+    constexpr uint32_t kMod = 65521;
+    constexpr size_t kRun = 5552;   // Longest run before the 32-bit sums could overflow
+    uint32_t a = adler & 0xFFFF, b = adler >> 16;
+    while (n > 0) {
+        const size_t run = std::min(n, kRun);
+        for (size_t i = 0; i < run; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= kMod;
+        b %= kMod;
+        data += run;
+        n -= run;
+    }
+    return (b << 16) | a;
+}
+
+std::vector<uint8_t> Encode(const RasterCanvas& canvas, Format format) {
+    switch (format) {
+        case Format::PGM: return Netpbm(canvas, true);
+        case Format::PPM: return Netpbm(canvas, false);
+        case Format::PNG: return Png(canvas);
+    }
+    return {};
+}
+
+bool Write(const RasterCanvas& canvas, Format format, const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    const std::vector<uint8_t> bytes = Encode(canvas, format);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace RasterImage
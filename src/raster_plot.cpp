@@ -0,0 +1,217 @@
+/**
+ * @file raster_plot.cpp
+ * @brief Scroll-and-patch panning, seeded re-sampling and heatmap rendering
+ */
+
+#include "raster_plot.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr size_t kSeamColumns = 2;   // Old columns redrawn next to an exposed strip
+
+bool Valid(const RasterView& view) {
+    return view.width > 0 && view.height > 0 && view.x_min < view.x_max && view.y_min < view.y_max &&
+           std::isfinite(view.x_max - view.x_min) && std::isfinite(view.y_max - view.y_min);
+}
+
+// Pixels per unit of x: x_min and x_max sit on the first and last column centres
+double XScale(const RasterView& view) {
+    return static_cast<double>(std::max<size_t>(view.width - 1, 1)) / (view.x_max - view.x_min);
+}
+
+/**
+ * Union of the cached curve and a freshly sampled strip, both ascending.
+ * Points at the same x are kept once. A segment between a point only in
+ * `cached` and one only in `strip` would bridge the seam across whatever
+ * neither sampled there, so it becomes a break.
+ */
+CurveSampling::Curve Merge(const CurveSampling::Curve& cached, const CurveSampling::Curve& strip,
+                           double keep_lo, double keep_hi) {
+    // Source of each merged point: 1 cached, 2 strip, 3 both
+    CurveSampling::Curve out;
+    std::vector<uint8_t> source;
+    Vector break_x;   // Left x of every break, from either curve
+    for (size_t b : cached.breaks) break_x.push_back(cached.x[b]);
+    for (size_t b : strip.breaks) break_x.push_back(strip.x[b]);
+    std::sort(break_x.begin(), break_x.end());
+
+    // Keep the nearest cached point beyond each end so lines still leave the view
+    const size_t n = cached.Size();
+    size_t first = static_cast<size_t>(std::lower_bound(cached.x.begin(), cached.x.end(), keep_lo) - cached.x.begin());
+    size_t last = static_cast<size_t>(std::upper_bound(cached.x.begin(), cached.x.end(), keep_hi) - cached.x.begin());
+    if (first > 0) --first;
+    if (last < n) ++last;
+
+    size_t i = first, j = 0;
+    out.x.reserve(last - first + strip.Size());
+    out.y.reserve(last - first + strip.Size());
+    while (i < last || j < strip.Size()) {
+        if (j == strip.Size() || (i < last && cached.x[i] < strip.x[j])) {
+            out.x.push_back(cached.x[i]);
+            out.y.push_back(cached.y[i++]);
+            source.push_back(1);
+        } else if (i == last || strip.x[j] < cached.x[i]) {
+            out.x.push_back(strip.x[j]);
+            out.y.push_back(strip.y[j++]);
+            source.push_back(2);
+        } else {
+            out.x.push_back(cached.x[i++]);
+            out.y.push_back(cached.y[i - 1]);
+            ++j;
+            source.push_back(3);
+        }
+    }
+
+    for (size_t k = 0; k + 1 < out.Size(); ++k) {
+        const bool bridge = (source[k] | source[k + 1]) == 3 && source[k] != 3 && source[k + 1] != 3;
+        if (bridge || std::binary_search(break_x.begin(), break_x.end(), out.x[k])) out.breaks.push_back(k);
+    }
+    out.evaluations = cached.evaluations + strip.evaluations;
+    out.x_scale = strip.x_scale;
+    out.y_scale = strip.y_scale;
+    return out;
+}
+
+} // namespace
+
+std::optional<RasterFunctionPlot> RasterFunctionPlot::Create(const std::string& expression, const RasterStyle& style,
+                                                             std::string* error) {
+    auto compiled = CompiledExpression::Compile(expression, {"x"}, error);
+    if (!compiled) return std::nullopt;
+    return RasterFunctionPlot(std::move(*compiled), style);
+}
+
+size_t RasterFunctionPlot::Render(const RasterView& view) {
+    if (!Valid(view)) return 0;
+    const bool same_frame = rendered_ && view.width == view_.width && view.height == view_.height &&
+                            view.y_min == view_.y_min && view.y_max == view_.y_max;
+    const double span = view.x_max - view.x_min, old_span = view_.x_max - view_.x_min;
+    if (same_frame && std::abs(span - old_span) <= 1e-12 * span) {
+        const double shift = (view_.x_min - view.x_min) * XScale(view);
+        const double whole = std::round(shift);
+        if (std::abs(shift - whole) <= 1e-6 && std::abs(whole) + kSeamColumns < static_cast<double>(view.width)) {
+            if (whole == 0.0) {
+                view_ = view;
+                return 0;
+            }
+            return Pan(view, static_cast<long>(whole));
+        }
+    }
+    return RenderAll(view);
+}
+
+void RasterFunctionPlot::Redraw() {
+    if (!rendered_) return;
+    DrawColumns(0, view_.width);
+}
+
+CurveSampling::Options RasterFunctionPlot::SamplingOptions(size_t x_pixels) const {
+    CurveSampling::Options options;
+    options.x_pixels = std::max<size_t>(x_pixels, 1);
+    options.y_pixels = std::max<size_t>(view_.height - 1, 1);
+    options.y_min = view_.y_min;
+    options.y_max = view_.y_max;
+    return options;
+}
+
+size_t RasterFunctionPlot::RenderAll(const RasterView& view) {
+    view_ = view;
+    // Cached points inside the new view are reused; the sampler re-tests them only if the scale grew
+    samples_ = CurveSampling::Sample(expression_, view.x_min, view.x_max, SamplingOptions(view.width - 1),
+                                     rendered_ ? &samples_ : nullptr);
+    evaluations_ += samples_.evaluations;
+    rendered_ = true;
+    canvas_.Resize(view.width, view.height);
+    DrawColumns(0, view.width);
+    return view.width;
+}
+
+size_t RasterFunctionPlot::Pan(const RasterView& view, long shift) {
+    const RasterView old = view_;
+    view_ = view;
+    canvas_.ScrollColumns(shift);
+
+    // The exposed strip runs from the new edge to the old one, which is now `shift` columns in
+    const size_t exposed = static_cast<size_t>(std::labs(shift));
+    const double lo = shift > 0 ? view.x_min : old.x_max;
+    const double hi = shift > 0 ? old.x_min : view.x_max;
+    CurveSampling::Curve strip = CurveSampling::Sample(expression_, lo, hi, SamplingOptions(exposed));
+    evaluations_ += strip.evaluations;
+    // Keep what DrawColumns() can reach from the edge columns
+    const double margin = 2.0 / XScale(view);
+    samples_ = Merge(samples_, strip, view.x_min - margin, view.x_max + margin);
+
+    size_t c0 = 0, c1 = view.width;
+    if (shift > 0) c1 = std::min(view.width, exposed + 1 + kSeamColumns);
+    else c0 = view.width - 1 - exposed - kSeamColumns;
+    DrawColumns(c0, c1);
+    return c1 - c0;
+}
+
+double RasterFunctionPlot::PixelX(double x) const { return (x - view_.x_min) * XScale(view_); }
+
+double RasterFunctionPlot::PixelY(double y) const {
+    return (view_.y_max - y) * static_cast<double>(std::max<size_t>(view_.height - 1, 1)) / (view_.y_max - view_.y_min);
+}
+
+void RasterFunctionPlot::DrawColumns(size_t c0, size_t c1) {
+    canvas_.SetClip(c0, c1);
+    canvas_.Clear(style_.background);
+
+    const double axis_row = std::round(PixelY(0.0)), axis_column = std::round(PixelX(0.0));
+    if (axis_row >= 0.0 && axis_row < static_cast<double>(view_.height)) {
+        const long r = static_cast<long>(axis_row);
+        canvas_.FillRect(static_cast<long>(c0), r, static_cast<long>(c1), r + 1, style_.axes);
+    }
+    if (axis_column >= 0.0 && axis_column < static_cast<double>(view_.width)) {
+        const long c = static_cast<long>(axis_column);
+        canvas_.FillRect(c, 0, c + 1, static_cast<long>(view_.height), style_.axes);
+    }
+
+    // Samples whose segments can touch columns [c0, c1): an end cap reaches half a column
+    const Vector& xs = samples_.x;
+    const double x_lo = view_.x_min + (static_cast<double>(c0) - 1.5) / XScale(view_);
+    const double x_hi = view_.x_min + (static_cast<double>(c1) + 0.5) / XScale(view_);
+    size_t first = static_cast<size_t>(std::lower_bound(xs.begin(), xs.end(), x_lo) - xs.begin());
+    size_t last = static_cast<size_t>(std::upper_bound(xs.begin(), xs.end(), x_hi) - xs.begin());
+    if (first > 0) --first;
+    if (last < xs.size()) ++last;
+
+    if (first < last) {
+        Vector px(last - first), py(last - first);
+        for (size_t i = first; i < last; ++i) {
+            px[i - first] = PixelX(xs[i]);
+            py[i - first] = PixelY(samples_.y[i]);
+        }
+        std::vector<size_t> breaks;
+        for (size_t b : samples_.breaks) {
+            if (b >= first && b < last) breaks.push_back(b - first);
+        }
+        if (style_.fill_opacity > 0.0) {
+            const double baseline = std::clamp(PixelY(0.0), -0.5, view_.height - 0.5);
+            canvas_.FillToBaseline(px.data(), py.data(), px.size(), baseline, style_.fill, style_.fill_opacity, breaks);
+        }
+        canvas_.DrawPolyline(px.data(), py.data(), px.size(), style_.line, breaks);
+    }
+    canvas_.ResetClip();
+}
+
+std::optional<RasterCanvas> RenderHeatmap(const std::string& expression, const RasterView& view,
+                                          Surface::Colormap colormap, std::string* error) {
+    if (!Valid(view)) return std::nullopt;
+    auto compiled = CompiledExpression::Compile(expression, {"x", "y"}, error);
+    if (!compiled) return std::nullopt;
+
+    // Grid points on pixel centres; a one-pixel side still needs two points
+    GridSpec spec{std::max<size_t>(view.width, 2), std::max<size_t>(view.height, 2),
+                  view.x_min, view.x_max, view.y_min, view.y_max};
+    auto grid = Surface::Evaluate(*compiled, spec);
+    if (!grid) return std::nullopt;
+
+    RasterCanvas canvas(view.width, view.height);
+    const std::vector<uint8_t> rgb = Surface::Colorize(*grid, colormap);
+    canvas.DrawImage(rgb.data(), spec.columns, spec.rows);
+    return canvas;
+}
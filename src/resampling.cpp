@@ -0,0 +1,274 @@
+/**
+ * @file resampling.cpp
+ * @brief Philox streams, bootstrap replicates and permutation tests
+ */
+
+#include "resampling.h"
+#include "parallel.h"
+#include "quantile_select.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr size_t kBlock = 1024;                  // Draws per accumulator block (stack buffer)
+// Permutation statistics equal to the observed one up to rounding count as extreme
+constexpr double kTieTolerance = 1e-12;
+
+double FromMoments(const MomentAccumulator& acc, Resampling::Statistic stat) {
+    switch (stat) {
+        case Resampling::Statistic::Mean: return acc.mean;
+        case Resampling::Statistic::Variance: return acc.Variance();
+        case Resampling::Statistic::StdDev: return acc.StandardDeviation();
+        case Resampling::Statistic::Skewness: return acc.Skewness();
+        case Resampling::Statistic::Kurtosis: return acc.Kurtosis();
+    }
+    return kNaN;
+}
+
+double FromCoMoments(const CoMomentAccumulator& acc, Resampling::PairStatistic stat) {
+    switch (stat) {
+        case Resampling::PairStatistic::Correlation: return acc.Correlation();
+        case Resampling::PairStatistic::Covariance: return acc.Covariance();
+        case Resampling::PairStatistic::Slope: return acc.Slope();
+    }
+    return kNaN;
+}
+
+// Moments of n draws with replacement, gathered a block at a time
+MomentAccumulator ResampleMoments(const double* x, size_t n, Resampling::PhiloxStream& rng) {
+    MomentAccumulator acc;
+    double block[kBlock];
+    for (size_t start = 0; start < n; start += kBlock) {
+        size_t m = std::min(kBlock, n - start);
+        for (size_t i = 0; i < m; ++i) block[i] = x[rng.Below(n)];
+        acc.PushRange(block, m);
+    }
+    return acc;
+}
+
+bool ValidOptions(size_t n, const Resampling::BootstrapOptions& options) {
+    return n >= 2 && options.resamples > 0 && options.resamples <= Resampling::kMaxResamples &&
+           options.confidence > 0.0 && options.confidence < 1.0;
+}
+
+// Standard error, bias and percentile interval over the finite replicates
+Resampling::BootstrapResult Summarize(double estimate, Vector replicates, double confidence) {
+    Resampling::BootstrapResult result;
+    result.estimate = estimate;
+    Vector finite;
+    finite.reserve(replicates.size());
+    std::copy_if(replicates.begin(), replicates.end(), std::back_inserter(finite),
+                 [](double r) { return std::isfinite(r); });
+    if (finite.empty()) {
+        result.standard_error = result.bias = result.lower = result.upper = kNaN;
+    } else {
+        MomentAccumulator acc;
+        acc.PushRange(finite.data(), finite.size());
+        result.standard_error = acc.StandardDeviation();
+        result.bias = acc.mean - estimate;
+        const double probs[2] = {(1.0 - confidence) / 2.0, (1.0 + confidence) / 2.0};
+        double bounds[2];
+        Selection::QuantilesInPlace(finite.data(), finite.size(), probs, 2, bounds);
+        result.lower = bounds[0];
+        result.upper = bounds[1];
+    }
+    result.replicates = std::move(replicates);
+    return result;
+}
+
+double GroupStatistic(const std::vector<MomentAccumulator>& groups, Resampling::TestStatistic stat) {
+    switch (stat) {
+        case Resampling::TestStatistic::MeanDifference: return groups[0].mean - groups[1].mean;
+        case Resampling::TestStatistic::WelchT: return Resampling::WelchT(groups[0], groups[1]);
+        case Resampling::TestStatistic::FStatistic: return Resampling::FStatistic(groups.data(), groups.size());
+    }
+    return kNaN;
+}
+
+} // namespace
+
+namespace Resampling {
+
+PhiloxStream::PhiloxStream(uint64_t seed, uint64_t stream)
+    : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+      counter_{0, 0, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)} {}
+
+std::array<uint32_t, 4> PhiloxStream::Block(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key) {
+    constexpr uint32_t kM0 = 0xD2511F53u, kM1 = 0xCD9E8D57u;
+    constexpr uint32_t kW0 = 0x9E3779B9u, kW1 = 0xBB67AE85u;
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = uint64_t{kM0} * counter[0];
+        uint64_t p1 = uint64_t{kM1} * counter[2];
+        counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(p1),
+                   static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(p0)};
+        key[0] += kW0;
+        key[1] += kW1;
+    }
+    return counter;
+}
+
+void PhiloxStream::Refill() {
+    block_ = Block(counter_, key_);
+    if (++counter_[0] == 0) ++counter_[1];
+    used_ = 0;
+}
+
+uint64_t PhiloxStream::BelowWide(uint64_t bound) {
+    uint64_t threshold = (0 - bound) % bound;
+    for (;;) {
+        uint64_t r = Next64();
+        if (r >= threshold) return r % bound;
+    }
+}
+
+double WelchT(const MomentAccumulator& a, const MomentAccumulator& b) {
+    double se2 = a.Variance() / static_cast<double>(a.count) + b.Variance() / static_cast<double>(b.count);
+    return (a.mean - b.mean) / std::sqrt(se2);
+}
+
+double WelchDegreesOfFreedom(const MomentAccumulator& a, const MomentAccumulator& b) {
+    double va = a.Variance() / static_cast<double>(a.count);
+    double vb = b.Variance() / static_cast<double>(b.count);
+    return (va + vb) * (va + vb) /
+           (va * va / static_cast<double>(a.count - 1) + vb * vb / static_cast<double>(b.count - 1));
+}
+
+double FStatistic(const MomentAccumulator* groups, size_t k) {
+    MomentAccumulator total;
+    for (size_t g = 0; g < k; ++g) total.Merge(groups[g]);
+    double between = 0.0, within = 0.0;
+    for (size_t g = 0; g < k; ++g) {
+        double d = groups[g].mean - total.mean;
+        between += static_cast<double>(groups[g].count) * d * d;
+        within += groups[g].m2;
+    }
+    double df_between = static_cast<double>(k - 1);
+    double df_within = static_cast<double>(total.count - k);
+    return (between / df_between) / (within / df_within);
+}
+
+std::optional<BootstrapResult> Bootstrap(const double* x, size_t n, Statistic stat, const BootstrapOptions& options) {
+    if (!ValidOptions(n, options)) return std::nullopt;
+    MomentAccumulator original;
+    original.PushRange(x, n);
+
+    Vector replicates(options.resamples);
+    AXIOM::Parallel::ParallelForWork(options.resamples, n, [&](size_t lo, size_t hi) {
+        for (size_t b = lo; b < hi; ++b) {
+            PhiloxStream rng(options.seed, b);
+            replicates[b] = FromMoments(ResampleMoments(x, n, rng), stat);
+        }
+    });
+    return Summarize(FromMoments(original, stat), std::move(replicates), options.confidence);
+}
+
+std::optional<BootstrapResult> Bootstrap(const double* x, size_t n, const StatisticFn& stat,
+                                         const BootstrapOptions& options) {
+    if (!ValidOptions(n, options) || !stat) return std::nullopt;
+    Vector scratch(x, x + n);
+    double estimate = stat(scratch.data(), n);
+
+    Vector replicates(options.resamples);
+    AXIOM::Parallel::ParallelForWork(options.resamples, n, [&](size_t lo, size_t hi) {
+        Vector sample(n);
+        for (size_t b = lo; b < hi; ++b) {
+            PhiloxStream rng(options.seed, b);
+            for (size_t i = 0; i < n; ++i) sample[i] = x[rng.Below(n)];
+            replicates[b] = stat(sample.data(), n);
+        }
+    });
+    return Summarize(estimate, std::move(replicates), options.confidence);
+}
+
+std::optional<BootstrapResult> BootstrapPaired(const double* x, const double* y, size_t n, PairStatistic stat,
+                                               const BootstrapOptions& options) {
+    if (!ValidOptions(n, options)) return std::nullopt;
+    CoMomentAccumulator original;
+    for (size_t i = 0; i < n; ++i) original.Push(x[i], y[i]);
+
+    Vector replicates(options.resamples);
+    AXIOM::Parallel::ParallelForWork(options.resamples, n, [&](size_t lo, size_t hi) {
+        for (size_t b = lo; b < hi; ++b) {
+            PhiloxStream rng(options.seed, b);
+            CoMomentAccumulator acc;
+            for (size_t i = 0; i < n; ++i) {
+                size_t row = rng.Below(n);
+                acc.Push(x[row], y[row]);
+            }
+            replicates[b] = FromCoMoments(acc, stat);
+        }
+    });
+    return Summarize(FromCoMoments(original, stat), std::move(replicates), options.confidence);
+}
+
+std::optional<PermutationResult> PermutationTest(const std::vector<const Vector*>& groups, TestStatistic stat,
+                                                 const PermutationOptions& options) {
+    const size_t k = groups.size();
+    if (options.permutations == 0 || options.permutations > kMaxResamples || k < 2) return std::nullopt;
+    if (stat != TestStatistic::FStatistic && k != 2) return std::nullopt;
+    const size_t min_size = stat == TestStatistic::FStatistic ? 1 : 2;
+
+    // Pooled values; group g owns positions [offsets[g], offsets[g + 1])
+    std::vector<size_t> offsets{0};
+    for (const Vector* g : groups) {
+        if (!g || g->size() < min_size) return std::nullopt;
+        offsets.push_back(offsets.back() + g->size());
+    }
+    const size_t total = offsets.back();
+    if (total <= k) return std::nullopt;
+    Vector pooled;
+    pooled.reserve(total);
+    for (const Vector* g : groups) pooled.insert(pooled.end(), g->begin(), g->end());
+
+    std::vector<MomentAccumulator> observed_moments(k);
+    for (size_t g = 0; g < k; ++g) observed_moments[g].PushRange(pooled.data() + offsets[g], offsets[g + 1] - offsets[g]);
+    const double observed = GroupStatistic(observed_moments, stat);
+    if (!std::isfinite(observed)) return std::nullopt;
+
+    const bool two_sided = stat != TestStatistic::FStatistic;
+    const double threshold = (two_sided ? std::abs(observed) : observed) * (1.0 - kTieTolerance);
+
+    // Only labels before the last group are drawn; the rest fall to it
+    const size_t shuffled = offsets[k - 1];
+    auto count_extreme = [&](size_t lo, size_t hi) {
+        uint64_t extreme = 0;
+        std::vector<size_t> perm(total), swaps(shuffled);
+        std::iota(perm.begin(), perm.end(), size_t{0});
+        std::vector<MomentAccumulator> moments(k);
+        double block[kBlock];
+        for (size_t b = lo; b < hi; ++b) {
+            PhiloxStream rng(options.seed, b);
+            for (size_t i = 0; i < shuffled; ++i) {
+                swaps[i] = i + rng.Below(total - i);
+                std::swap(perm[i], perm[swaps[i]]);
+            }
+            for (size_t g = 0; g < k; ++g) {
+                moments[g] = MomentAccumulator{};
+                for (size_t start = offsets[g]; start < offsets[g + 1]; start += kBlock) {
+                    size_t m = std::min(kBlock, offsets[g + 1] - start);
+                    for (size_t i = 0; i < m; ++i) block[i] = pooled[perm[start + i]];
+                    moments[g].PushRange(block, m);
+                }
+            }
+            double s = GroupStatistic(moments, stat);
+            extreme += (two_sided ? std::abs(s) : s) >= threshold;
+            // Undo the swaps so the next resample starts from the identity again
+            for (size_t i = shuffled; i-- > 0;) std::swap(perm[i], perm[swaps[i]]);
+        }
+        return extreme;
+    };
+
+    PermutationResult result;
+    result.observed = observed;
+    result.permutations = options.permutations;
+    result.extreme = AXIOM::Parallel::ParallelReduceWork(options.permutations, total, uint64_t{0}, count_extreme,
+                                                         std::plus<uint64_t>{});
+    result.p_value = static_cast<double>(result.extreme + 1) / static_cast<double>(result.permutations + 1);
+    return result;
+}
+
+} // namespace Resampling
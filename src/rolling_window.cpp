@@ -0,0 +1,339 @@
+/**
+ * @file rolling_window.cpp
+ * @brief Segmented batch windows and streaming window accumulators
+ */
+
+#include "rolling_window.h"
+#include "parallel.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace Rolling {
+
+namespace {
+
+// Outputs per independently seeded segment (at least one window long, so
+// the exact re-seed costs no more than the slide it replaces)
+constexpr size_t kSegment = 4096;
+
+/**
+ * Calls segment(lo, hi) for output segments [lo, hi) aligned to multiples
+ * of the segment length, so results do not depend on the thread count.
+ */
+template <typename SegmentFn>
+void ForEachSegment(size_t outputs, size_t w, SegmentFn&& segment) {
+    size_t length = std::max(kSegment, w);
+    AXIOM::Parallel::ParallelFor(0, outputs, length, [&](size_t lo, size_t hi) {
+        for (size_t s = lo; s < hi; s += length) segment(s, std::min(hi, s + length));
+    });
+}
+
+// Exact mean and sum of squared deviations of x[0 .. w)
+std::pair<double, double> WindowMoments(const double* x, size_t w) {
+    double mean = 0.0;
+    for (size_t i = 0; i < w; ++i) mean += x[i];
+    mean /= static_cast<double>(w);
+    double m2 = 0.0;
+    for (size_t i = 0; i < w; ++i) {
+        double d = x[i] - mean;
+        m2 += d * d;
+    }
+    return {mean, m2};
+}
+
+// Mean (or sum) of a window given its non-finite counts and finite part
+double WithNonFinite(const NonFiniteCounts& c, double finite_value) {
+    if (c.nan > 0 || (c.pos_inf > 0 && c.neg_inf > 0)) return std::numeric_limits<double>::quiet_NaN();
+    if (c.pos_inf > 0) return std::numeric_limits<double>::infinity();
+    if (c.neg_inf > 0) return -std::numeric_limits<double>::infinity();
+    return finite_value;
+}
+
+template <typename Better>
+void Extremum(const double* x, size_t n, size_t w, double* out, Better better) {
+    ForEachSegment(n - w + 1, w, [&](size_t lo, size_t hi) {
+        // Indices with strictly worse values than a later element never win
+        std::vector<size_t> queue(hi - lo + w);
+        size_t head = 0, tail = 0;
+        for (size_t i = lo; i < hi + w - 1; ++i) {
+            while (tail > head && !better(x[queue[tail - 1]], x[i])) --tail;
+            queue[tail++] = i;
+            if (i + 1 >= lo + w) {
+                size_t start = i + 1 - w;
+                while (queue[head] < start) ++head;
+                out[start] = x[queue[head]];
+            }
+        }
+    });
+}
+
+} // namespace
+
+void Mean(const double* x, size_t n, size_t w, double* out) {
+    if (w == 0 || w > n) return;
+    const auto& kernels = AXIOM::SIMD::Kernels();
+    const double inv_w = 1.0 / static_cast<double>(w);
+
+    ForEachSegment(n - w + 1, w, [&](size_t lo, size_t hi) {
+        // Prefix sums of x[lo .. hi + w - 1) shifted by x[lo]; each window is
+        // one difference of two prefix entries
+        const size_t length = hi - lo + w - 1;
+        double shift = x[lo];
+        std::vector<double> prefix(length);
+        kernels.prefix_sum(x + lo, prefix.data(), length, shift);
+        if (std::isfinite(prefix.back())) {
+            out[lo] = prefix[w - 1] * inv_w + shift;
+            for (size_t i = lo + 1; i < hi; ++i) {
+                size_t j = i - lo;
+                out[i] = (prefix[j + w - 1] - prefix[j - 1]) * inv_w + shift;
+            }
+            return;
+        }
+
+        // An inf or NaN would poison every later prefix entry, so sum the
+        // finite values alone and count the others per window
+        std::vector<double> finite(x + lo, x + lo + length);
+        std::vector<NonFiniteCounts> counts(length + 1);
+        auto first_finite = std::find_if(finite.begin(), finite.end(), [](double v) { return std::isfinite(v); });
+        shift = first_finite != finite.end() ? *first_finite : 0.0;
+        for (size_t k = 0; k < length; ++k) {
+            counts[k + 1] = counts[k];
+            if (std::isfinite(finite[k])) continue;
+            counts[k + 1].Add(finite[k], 1);
+            finite[k] = shift;
+        }
+        kernels.prefix_sum(finite.data(), prefix.data(), length, shift);
+        for (size_t i = lo; i < hi; ++i) {
+            size_t j = i - lo;
+            double sum = prefix[j + w - 1] - (j > 0 ? prefix[j - 1] : 0.0);
+            NonFiniteCounts window{counts[j + w].nan - counts[j].nan, counts[j + w].pos_inf - counts[j].pos_inf,
+                                   counts[j + w].neg_inf - counts[j].neg_inf};
+            out[i] = WithNonFinite(window, sum * inv_w + shift);
+        }
+    });
+}
+
+void Variance(const double* x, size_t n, size_t w, double* out) {
+    if (w < 2 || w > n) return;
+    const double wd = static_cast<double>(w);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    ForEachSegment(n - w + 1, w, [&](size_t lo, size_t hi) {
+        // Windows holding a non-finite value are NaN; once the last one
+        // leaves, the sliding state is re-seeded exactly instead of carrying
+        // inf - inf forward
+        size_t next_finite = lo;   // First window start with no non-finite value seen so far
+        for (size_t k = lo; k < lo + w; ++k) {
+            if (!std::isfinite(x[k])) next_finite = k + 1;
+        }
+        double mean = 0.0, m2 = 0.0;
+        bool seeded = false;
+        for (size_t i = lo; i < hi; ++i) {
+            if (i > lo && !std::isfinite(x[i + w - 1])) next_finite = i + w;
+            if (i < next_finite) {
+                out[i] = nan;
+                seeded = false;
+                continue;
+            }
+            if (!seeded) {
+                std::tie(mean, m2) = WindowMoments(x + i, w);
+                seeded = true;
+                out[i] = m2 / (wd - 1.0);
+                continue;
+            }
+            // Replace x_old by x_new: Welford remove + add in one step
+            double x_old = x[i - 1];
+            double x_new = x[i + w - 1];
+            double delta = x_new - x_old;
+            double new_mean = mean + delta / wd;
+            m2 += delta * ((x_new - new_mean) + (x_old - mean));
+            mean = new_mean;
+            out[i] = std::max(m2, 0.0) / (wd - 1.0);
+        }
+    });
+}
+
+void StdDev(const double* x, size_t n, size_t w, double* out) {
+    if (w < 2 || w > n) return;
+    Variance(x, n, w, out);
+    for (size_t i = 0; i + w <= n; ++i) out[i] = std::sqrt(out[i]);
+}
+
+void Min(const double* x, size_t n, size_t w, double* out) {
+    if (w == 0 || w > n) return;
+    Extremum(x, n, w, out, [](double a, double b) { return a < b; });
+}
+
+void Max(const double* x, size_t n, size_t w, double* out) {
+    if (w == 0 || w > n) return;
+    Extremum(x, n, w, out, [](double a, double b) { return a > b; });
+}
+
+void Median(const double* x, size_t n, size_t w, double* out) {
+    if (w == 0 || w > n) return;
+    ForEachSegment(n - w + 1, w, [&](size_t lo, size_t hi) {
+        MedianWindow window(w);
+        for (size_t i = lo; i < lo + w - 1; ++i) window.Push(x[i]);
+        for (size_t i = lo; i < hi; ++i) {
+            window.Push(x[i + w - 1]);
+            out[i] = window.Median();
+        }
+    });
+}
+
+void EWMAMean(const double* x, size_t n, double alpha, double* out) {
+    EWMA ewma(alpha);
+    for (size_t i = 0; i < n; ++i) {
+        ewma.Push(x[i]);
+        out[i] = ewma.Mean();
+    }
+}
+
+void EWMAVariance(const double* x, size_t n, double alpha, double* out) {
+    EWMA ewma(alpha);
+    for (size_t i = 0; i < n; ++i) {
+        ewma.Push(x[i]);
+        out[i] = ewma.Variance();
+    }
+}
+
+// ============================================================================
+// Streaming windows
+// ============================================================================
+
+MomentWindow::MomentWindow(size_t w) : ring_(std::max<size_t>(1, w)) {}
+
+void MomentWindow::Push(double x) {
+    if (!std::isfinite(x)) non_finite_.Add(x, 1);
+
+    if (!Full()) {
+        ring_[head_] = x;
+        head_ = (head_ + 1) % ring_.size();
+        ++count_;
+        double delta = x - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (x - mean_);
+        return;
+    }
+
+    double x_old = ring_[head_];
+    ring_[head_] = x;
+    head_ = (head_ + 1) % ring_.size();
+    double wd = static_cast<double>(count_);
+    double delta = x - x_old;
+    double new_mean = mean_ + delta / wd;
+    m2_ += delta * ((x - new_mean) + (x_old - mean_));
+    mean_ = new_mean;
+
+    // Re-seed exactly once the last inf / NaN leaves (the incremental state
+    // is NaN by then), and every max(w, kSegment) replacements to cap drift
+    if (!std::isfinite(x_old)) {
+        non_finite_.Add(x_old, -1);
+        if (!non_finite_.Any()) Resync();
+    } else if (++since_resync_ >= std::max(kSegment, ring_.size())) {
+        Resync();
+    }
+}
+
+void MomentWindow::Resync() {
+    auto [mean, m2] = WindowMoments(ring_.data(), count_);
+    mean_ = mean;
+    m2_ = m2;
+    since_resync_ = 0;
+}
+
+double MomentWindow::Mean() const {
+    return WithNonFinite(non_finite_, mean_);
+}
+
+double MomentWindow::Variance() const {
+    if (non_finite_.Any()) return std::numeric_limits<double>::quiet_NaN();
+    return count_ > 1 ? std::max(m2_, 0.0) / static_cast<double>(count_ - 1) : 0.0;
+}
+
+double MomentWindow::StdDev() const {
+    return std::sqrt(Variance());
+}
+
+void ExtremaWindow::Push(double x) {
+    uint64_t i = index_++;
+    while (!min_.empty() && min_.back().second >= x) min_.pop_back();
+    while (!max_.empty() && max_.back().second <= x) max_.pop_back();
+    min_.emplace_back(i, x);
+    max_.emplace_back(i, x);
+    if (i >= window_) {
+        uint64_t start = i + 1 - window_;
+        while (min_.front().first < start) min_.pop_front();
+        while (max_.front().first < start) max_.pop_front();
+    }
+}
+
+MedianWindow::MedianWindow(size_t w) : ring_(std::max<size_t>(1, w)) {}
+
+void MedianWindow::Push(double x) {
+    if (count_ == ring_.size()) {
+        Erase(ring_[head_]);
+    } else {
+        ++count_;
+    }
+    ring_[head_] = x;
+    head_ = (head_ + 1) % ring_.size();
+    Insert(x);
+}
+
+void MedianWindow::Insert(double x) {
+    if (low_.empty() || x <= *low_.rbegin()) {
+        low_.insert(x);
+    } else {
+        high_.insert(x);
+    }
+    Rebalance();
+}
+
+void MedianWindow::Erase(double x) {
+    if (!low_.empty() && x <= *low_.rbegin()) {
+        low_.erase(low_.find(x));
+    } else {
+        high_.erase(high_.find(x));
+    }
+    Rebalance();
+}
+
+void MedianWindow::Rebalance() {
+    while (low_.size() > high_.size() + 1) {
+        auto top = std::prev(low_.end());
+        high_.insert(*top);
+        low_.erase(top);
+    }
+    while (high_.size() > low_.size()) {
+        low_.insert(*high_.begin());
+        high_.erase(high_.begin());
+    }
+}
+
+double MedianWindow::Median() const {
+    if (low_.size() > high_.size()) return *low_.rbegin();
+    return 0.5 * (*low_.rbegin() + *high_.begin());
+}
+
+void EWMA::Push(double x) {
+    if (!seeded_) {
+        mean_ = x;
+        variance_ = 0.0;
+        seeded_ = true;
+        return;
+    }
+    // West's incremental form of the exponentially weighted variance
+    double diff = x - mean_;
+    double increment = alpha_ * diff;
+    mean_ += increment;
+    variance_ = (1.0 - alpha_) * (variance_ + diff * increment);
+}
+
+double EWMA::StdDev() const {
+    return std::sqrt(variance_);
+}
+
+} // namespace Rolling
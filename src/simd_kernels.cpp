@@ -0,0 +1,1169 @@
+/**
+ * @file simd_kernels.cpp
+ * @brief Scalar, AVX2+FMA and AVX-512F builds of the hot numeric kernels
+ *
+ * The vector variants use target attributes instead of global -m flags,
+ * so this file compiles for baseline x86-64 and the wider code is only
+ * ever executed after CPUID confirms support.
+ */
+
+#include "simd_kernels.h"
+#include "cpu_optimization.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define AXIOM_SIMD_X86 1
+    #include <immintrin.h>
+    #define AXIOM_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #define AXIOM_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#endif
+
+namespace AXIOM {
+namespace SIMD {
+
+namespace {
+
+constexpr double kInvSqrt2Pi = 0.39894228040143267794;
+constexpr double kSqrt2 = 1.41421356237309504880;
+
+// Cody-Waite split of ln 2: n * kLn2Hi is exact for |n| < 2^11
+constexpr double kLn2Hi = 6.93147180369123816490e-01;
+constexpr double kLn2Lo = 1.90821492927058770002e-10;
+constexpr double kLog2e = 1.44269504088896340736;
+
+// 1/k! for k = 13 .. 0: exp(r) on |r| <= ln(2)/2 to below 1e-17
+constexpr double kExpTaylor[] = {
+    1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+    1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0,
+    1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0,
+};
+
+// 1/(2k+1) for k = 11 .. 1: log(m) = 2s (1 + s^2/3 + s^4/5 + ...), s <= 0.1716
+constexpr double kLogSeries[] = {
+    1.0 / 23.0, 1.0 / 21.0, 1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0,
+    1.0 / 11.0, 1.0 / 9.0, 1.0 / 7.0, 1.0 / 5.0, 1.0 / 3.0,
+};
+
+// Chebyshev coefficients of log(erfc(u) / t) + u^2 in ty = 4t - 2, t = 2 / (2 + u)
+constexpr double kErfcCheb[] = {
+    -1.3026537197817094, 6.4196979235649026e-1, 1.9476473204185836e-2,
+    -9.5615147868086316e-3, -9.4659534448203687e-4, 3.6683949785276145e-4,
+    4.2523324806907772e-5, -2.0278578112534243e-5, -1.6242900046470255e-6,
+    1.3036558355805232e-6, 1.5626441722066143e-8, -8.5238095914926543e-8,
+    6.5290544390988515e-9, 5.0593434955514689e-9, -9.9136415649303309e-10,
+    -2.2736512229318359e-10, 9.6467911020155268e-11, 2.3940380830391147e-12,
+    -6.8860275264975534e-12, 8.9448792730907257e-13, 3.1309213993429581e-13,
+    -1.1270822361367252e-13, 3.8109052551892321e-16, 7.106097613609237e-15,
+    -1.5230282014571043e-15, -9.457494571291234e-17, 1.210237189224279e-16,
+    -2.816663087747177e-17,
+};
+constexpr size_t kErfcTerms = sizeof(kErfcCheb) / sizeof(kErfcCheb[0]);
+
+} // namespace
+
+// ============================================================================
+// Scalar kernels (portable reference implementations)
+// ============================================================================
+
+namespace scalar {
+
+double sum(const double* data, size_t n) {
+    // Four accumulators break the add dependency chain without -ffast-math
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += data[i]; s1 += data[i + 1]; s2 += data[i + 2]; s3 += data[i + 3];
+    }
+    for (; i < n; ++i) s0 += data[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+double dot(const double* x, const double* y, size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += x[i] * y[i]; s1 += x[i + 1] * y[i + 1];
+        s2 += x[i + 2] * y[i + 2]; s3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < n; ++i) s0 += x[i] * y[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+double sum_sq_dev(const double* data, size_t n, double center) {
+    double s0 = 0.0, s1 = 0.0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        double d0 = data[i] - center, d1 = data[i + 1] - center;
+        s0 += d0 * d0; s1 += d1 * d1;
+    }
+    for (; i < n; ++i) { double d = data[i] - center; s0 += d * d; }
+    return s0 + s1;
+}
+
+void minmax(const double* data, size_t n, double* min_out, double* max_out) {
+    double mn = std::numeric_limits<double>::infinity();
+    double mx = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    *min_out = mn; *max_out = mx;
+}
+
+// Neumaier step: the low-order part lost by s + x goes into c
+inline void kb_add(double& s, double& c, double x) {
+    double t = s + x;
+    c += std::fabs(s) >= std::fabs(x) ? (s - t) + x : (x - t) + s;
+    s = t;
+}
+
+// Folds per-lane (sum, compensation) pairs into the pair at out[0..1]
+inline void kb_fold(const double* s, const double* c, size_t lanes, double* out) {
+    for (size_t l = 0; l < lanes; ++l) kb_add(out[0], out[1], s[l]);
+    for (size_t l = 0; l < lanes; ++l) kb_add(out[0], out[1], c[l]);
+}
+
+void sum_kb(const double* data, size_t n, double* out) {
+    double s[4] = {}, c[4] = {};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (size_t l = 0; l < 4; ++l) kb_add(s[l], c[l], data[i + l]);
+    }
+    for (; i < n; ++i) kb_add(s[0], c[0], data[i]);
+    out[0] = out[1] = 0.0;
+    kb_fold(s, c, 4, out);
+}
+
+void sum_sq_dev_kb(const double* data, size_t n, double center, double* out) {
+    double s[4] = {}, c[4] = {};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (size_t l = 0; l < 4; ++l) {
+            double d = data[i + l] - center;
+            kb_add(s[l], c[l], d * d);
+        }
+    }
+    for (; i < n; ++i) { double d = data[i] - center; kb_add(s[0], c[0], d * d); }
+    out[0] = out[1] = 0.0;
+    kb_fold(s, c, 4, out);
+}
+
+void central_moments_kb(const double* data, size_t n, double center, double* out) {
+    double s[4] = {}, c[4] = {}, m3[4] = {}, m4[4] = {};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (size_t l = 0; l < 4; ++l) {
+            double d = data[i + l] - center;
+            double d2 = d * d;
+            kb_add(s[l], c[l], d2);
+            m3[l] += d2 * d;
+            m4[l] += d2 * d2;
+        }
+    }
+    for (; i < n; ++i) {
+        double d = data[i] - center;
+        double d2 = d * d;
+        kb_add(s[0], c[0], d2);
+        m3[0] += d2 * d;
+        m4[0] += d2 * d2;
+    }
+    out[0] = out[1] = 0.0;
+    kb_fold(s, c, 4, out);
+    out[2] = (m3[0] + m3[1]) + (m3[2] + m3[3]);
+    out[3] = (m4[0] + m4[1]) + (m4[2] + m4[3]);
+}
+
+void co_dev_kb(const double* x, const double* y, size_t n, double cx, double cy, double* out) {
+    std::fill(out, out + 6, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        double dx = x[i] - cx, dy = y[i] - cy;
+        kb_add(out[0], out[1], dx * dx);
+        kb_add(out[2], out[3], dy * dy);
+        kb_add(out[4], out[5], dx * dy);
+    }
+}
+
+void gemm(const double* A, const double* B, double* C, size_t M, size_t K, size_t N) {
+    std::fill(C, C + M * N, 0.0);
+    // i-k-j order streams rows of B and C contiguously
+    for (size_t i = 0; i < M; ++i) {
+        double* c_row = C + i * N;
+        for (size_t k = 0; k < K; ++k) {
+            double a = A[i * K + k];
+            const double* b_row = B + k * N;
+            for (size_t j = 0; j < N; ++j) c_row[j] += a * b_row[j];
+        }
+    }
+}
+
+void poly_eval(const double* coeffs, size_t degree, const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        double acc = coeffs[degree];
+        for (size_t d = degree; d-- > 0;) acc = acc * x[i] + coeffs[d];
+        y[i] = acc;
+    }
+}
+
+void affine(const double* x, double* y, size_t n, double a, double b) {
+    for (size_t i = 0; i < n; ++i) y[i] = a * x[i] + b;
+}
+
+void prefix_sum(const double* x, double* out, size_t n, double shift) {
+    double running = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        running += x[i] - shift;
+        out[i] = running;
+    }
+}
+
+void exp(const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] = std::exp(x[i]);
+}
+
+void log(const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] = std::log(x[i]);
+}
+
+void normal_pdf(const double* x, double* y, size_t n, double mean, double sd) {
+    const double inv_sd = 1.0 / sd;
+    const double scale = inv_sd * kInvSqrt2Pi;
+    for (size_t i = 0; i < n; ++i) {
+        double z = (x[i] - mean) * inv_sd;
+        y[i] = scale * std::exp(-0.5 * z * z);
+    }
+}
+
+void normal_cdf(const double* x, double* y, size_t n, double mean, double sd) {
+    const double k = 1.0 / (sd * kSqrt2);
+    for (size_t i = 0; i < n; ++i) y[i] = 0.5 * std::erfc((mean - x[i]) * k);
+}
+
+void bin_uniform(const double* x, uint32_t* index, size_t n, double lo, double hi, uint32_t bins) {
+    const double count = static_cast<double>(bins);
+    const double step = (hi - lo) / count;
+    const double scale = count / (hi - lo);
+    // Rounding in t (and in the reported edges) stays within this many bins
+    // of the truth, so only values that close to an edge need the exact check
+    const double window = 8.0 * std::numeric_limits<double>::epsilon() * (std::max(std::fabs(lo), std::fabs(hi)) * scale + count);
+    for (size_t i = 0; i < n; ++i) {
+        double v = x[i];
+        if (v >= lo && v <= hi) {
+            double t = (v - lo) * scale;
+            double k = std::min(static_cast<double>(static_cast<uint64_t>(t)), count - 1.0);
+            double frac = t - k;
+            if (frac < window || frac > 1.0 - window) {
+                // Agree exactly with the edges fma(k, step, lo) reported to callers
+                if (k > 0.0 && v < std::fma(k, step, lo)) k -= 1.0;
+                else if (k + 1.0 < count && v >= std::fma(k + 1.0, step, lo)) k += 1.0;
+            }
+            index[i] = 1 + static_cast<uint32_t>(k);
+        } else {
+            index[i] = v < lo ? 0 : (v > hi ? bins + 1 : bins + 2);
+        }
+    }
+}
+
+void bin_edges(const double* x, uint32_t* index, size_t n, const double* edges, uint32_t bins) {
+    for (size_t i = 0; i < n; ++i) {
+        double v = x[i];
+        if (!(v >= edges[0] && v <= edges[bins])) {
+            index[i] = v < edges[0] ? 0 : (v > edges[bins] ? bins + 1 : bins + 2);
+            continue;
+        }
+        // Last j < bins with edges[j] <= v; the loop length depends only on bins
+        size_t pos = 0;
+        for (size_t len = bins; len > 1;) {
+            size_t half = len / 2;
+            pos += static_cast<size_t>(edges[pos + half] <= v) * half;
+            len -= half;
+        }
+        index[i] = static_cast<uint32_t>(pos) + 1;
+    }
+}
+
+} // namespace scalar
+
+#ifdef AXIOM_SIMD_X86
+
+// ============================================================================
+// AVX2 + FMA kernels (4 x double)
+// ============================================================================
+
+namespace avx2 {
+
+AXIOM_TARGET_AVX2 static inline double hsum(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    __m128d shuf = _mm_unpackhi_pd(lo, lo);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, shuf));
+}
+
+AXIOM_TARGET_AVX2 double sum(const double* data, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm256_add_pd(a0, _mm256_loadu_pd(data + i));
+        a1 = _mm256_add_pd(a1, _mm256_loadu_pd(data + i + 4));
+    }
+    double s = hsum(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i) s += data[i];
+    return s;
+}
+
+AXIOM_TARGET_AVX2 double dot(const double* x, const double* y, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), a0);
+        a1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), a1);
+    }
+    double s = hsum(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i) s += x[i] * y[i];
+    return s;
+}
+
+AXIOM_TARGET_AVX2 double sum_sq_dev(const double* data, size_t n, double center) {
+    __m256d c = _mm256_set1_pd(center);
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(data + i), c);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(data + i + 4), c);
+        a0 = _mm256_fmadd_pd(d0, d0, a0);
+        a1 = _mm256_fmadd_pd(d1, d1, a1);
+    }
+    double s = hsum(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i) { double d = data[i] - center; s += d * d; }
+    return s;
+}
+
+AXIOM_TARGET_AVX2 void minmax(const double* data, size_t n, double* min_out, double* max_out) {
+    __m256d vmin = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d vmax = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(data + i);
+        vmin = _mm256_min_pd(vmin, v);
+        vmax = _mm256_max_pd(vmax, v);
+    }
+    alignas(32) double lo[4], hi[4];
+    _mm256_store_pd(lo, vmin);
+    _mm256_store_pd(hi, vmax);
+    double mn = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+    double mx = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+    for (; i < n; ++i) { mn = std::min(mn, data[i]); mx = std::max(mx, data[i]); }
+    *min_out = mn; *max_out = mx;
+}
+
+// Branch-free Neumaier step per lane: the larger-magnitude operand is the
+// one whose low-order bits survive in t
+AXIOM_TARGET_AVX2 static inline void kb_add(__m256d& s, __m256d& c, __m256d x) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d t = _mm256_add_pd(s, x);
+    __m256d s_larger = _mm256_cmp_pd(_mm256_andnot_pd(sign, s), _mm256_andnot_pd(sign, x), _CMP_GE_OQ);
+    __m256d large = _mm256_blendv_pd(x, s, s_larger);
+    __m256d small = _mm256_blendv_pd(s, x, s_larger);
+    c = _mm256_add_pd(c, _mm256_add_pd(_mm256_sub_pd(large, t), small));
+    s = t;
+}
+
+// Adds the lanes of (s, c) into the pair at out[0..1]
+AXIOM_TARGET_AVX2 static inline void kb_fold(__m256d s, __m256d c, double* out) {
+    alignas(32) double ls[4], lc[4];
+    _mm256_store_pd(ls, s);
+    _mm256_store_pd(lc, c);
+    scalar::kb_fold(ls, lc, 4, out);
+}
+
+// Continues a scalar tail into the pair at out[0..1]
+static inline void kb_merge(double* out, const double* tail) {
+    scalar::kb_add(out[0], out[1], tail[0]);
+    scalar::kb_add(out[0], out[1], tail[1]);
+}
+
+AXIOM_TARGET_AVX2 void sum_kb(const double* data, size_t n, double* out) {
+    __m256d s0 = _mm256_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        kb_add(s0, c0, _mm256_loadu_pd(data + i));
+        kb_add(s1, c1, _mm256_loadu_pd(data + i + 4));
+    }
+    double tail[2];
+    scalar::sum_kb(data + i, n - i, tail);
+    out[0] = out[1] = 0.0;
+    kb_fold(s0, c0, out);
+    kb_fold(s1, c1, out);
+    kb_merge(out, tail);
+}
+
+AXIOM_TARGET_AVX2 void sum_sq_dev_kb(const double* data, size_t n, double center, double* out) {
+    __m256d vc = _mm256_set1_pd(center);
+    __m256d s0 = _mm256_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(data + i), vc);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(data + i + 4), vc);
+        kb_add(s0, c0, _mm256_mul_pd(d0, d0));
+        kb_add(s1, c1, _mm256_mul_pd(d1, d1));
+    }
+    double tail[2];
+    scalar::sum_sq_dev_kb(data + i, n - i, center, tail);
+    out[0] = out[1] = 0.0;
+    kb_fold(s0, c0, out);
+    kb_fold(s1, c1, out);
+    kb_merge(out, tail);
+}
+
+AXIOM_TARGET_AVX2 void central_moments_kb(const double* data, size_t n, double center, double* out) {
+    __m256d vc = _mm256_set1_pd(center);
+    __m256d s0 = _mm256_setzero_pd(), c0 = s0, m3 = s0, m4 = s0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(data + i), vc);
+        __m256d d2 = _mm256_mul_pd(d, d);
+        kb_add(s0, c0, d2);
+        m3 = _mm256_fmadd_pd(d2, d, m3);
+        m4 = _mm256_fmadd_pd(d2, d2, m4);
+    }
+    double tail[4];
+    scalar::central_moments_kb(data + i, n - i, center, tail);
+    out[0] = out[1] = 0.0;
+    kb_fold(s0, c0, out);
+    kb_merge(out, tail);
+    out[2] = hsum(m3) + tail[2];
+    out[3] = hsum(m4) + tail[3];
+}
+
+AXIOM_TARGET_AVX2 void co_dev_kb(const double* x, const double* y, size_t n, double cx, double cy, double* out) {
+    __m256d vx = _mm256_set1_pd(cx), vy = _mm256_set1_pd(cy);
+    __m256d zero = _mm256_setzero_pd();
+    __m256d sxx = zero, cxx = zero, syy = zero, cyy = zero, sxy = zero, cxy = zero;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vx);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vy);
+        kb_add(sxx, cxx, _mm256_mul_pd(dx, dx));
+        kb_add(syy, cyy, _mm256_mul_pd(dy, dy));
+        kb_add(sxy, cxy, _mm256_mul_pd(dx, dy));
+    }
+    double tail[6];
+    scalar::co_dev_kb(x + i, y + i, n - i, cx, cy, tail);
+    std::fill(out, out + 6, 0.0);
+    kb_fold(sxx, cxx, out);
+    kb_fold(syy, cyy, out + 2);
+    kb_fold(sxy, cxy, out + 4);
+    for (size_t k = 0; k < 3; ++k) kb_merge(out + 2 * k, tail + 2 * k);
+}
+
+AXIOM_TARGET_AVX2 void gemm(const double* A, const double* B, double* C, size_t M, size_t K, size_t N) {
+    std::fill(C, C + M * N, 0.0);
+    for (size_t i = 0; i < M; ++i) {
+        double* c_row = C + i * N;
+        for (size_t k = 0; k < K; ++k) {
+            __m256d a = _mm256_set1_pd(A[i * K + k]);
+            const double* b_row = B + k * N;
+            size_t j = 0;
+            for (; j + 4 <= N; j += 4) {
+                __m256d c = _mm256_loadu_pd(c_row + j);
+                _mm256_storeu_pd(c_row + j, _mm256_fmadd_pd(a, _mm256_loadu_pd(b_row + j), c));
+            }
+            for (; j < N; ++j) c_row[j] += A[i * K + k] * b_row[j];
+        }
+    }
+}
+
+AXIOM_TARGET_AVX2 void poly_eval(const double* coeffs, size_t degree, const double* x, double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d acc = _mm256_set1_pd(coeffs[degree]);
+        for (size_t d = degree; d-- > 0;) acc = _mm256_fmadd_pd(acc, vx, _mm256_set1_pd(coeffs[d]));
+        _mm256_storeu_pd(y + i, acc);
+    }
+    scalar::poly_eval(coeffs, degree, x + i, y + i, n - i);
+}
+
+AXIOM_TARGET_AVX2 void affine(const double* x, double* y, size_t n, double a, double b) {
+    __m256d va = _mm256_set1_pd(a), vb = _mm256_set1_pd(b);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), vb));
+    }
+    for (; i < n; ++i) y[i] = a * x[i] + b;
+}
+
+AXIOM_TARGET_AVX2 void prefix_sum(const double* x, double* out, size_t n, double shift) {
+    // In-register scan (log2(4) shifted adds), then add the running carry
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d vshift = _mm256_set1_pd(shift);
+    __m256d carry = zero;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_sub_pd(_mm256_loadu_pd(x + i), vshift);
+        v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1));
+        v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3));
+        v = _mm256_add_pd(v, carry);
+        _mm256_storeu_pd(out + i, v);
+        carry = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    double running = _mm256_cvtsd_f64(carry);
+    for (; i < n; ++i) {
+        running += x[i] - shift;
+        out[i] = running;
+    }
+}
+
+// 2^k for integral k in [-1022, 1023], built directly in the exponent field
+AXIOM_TARGET_AVX2 static inline __m256d pow2i(__m256d k) {
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0 + 1023.0);   // 2^52 + bias
+    __m256i bits = _mm256_castpd_si256(_mm256_add_pd(k, magic));
+    return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+}
+
+// exp(hi + lo): n comes from the sum, and hi - n ln2 is exact (Cody-Waite), so
+// lo keeps the bits a single rounded argument would lose
+AXIOM_TARGET_AVX2 static inline __m256d exp_hl(__m256d hi, __m256d lo) {
+    // Clamp keeps 2^n1 * 2^n2 representable; min/max order lets NaN through
+    hi = _mm256_max_pd(_mm256_set1_pd(-1000.0), _mm256_min_pd(_mm256_set1_pd(1000.0), hi));
+    __m256d n = _mm256_round_pd(_mm256_mul_pd(_mm256_add_pd(hi, lo), _mm256_set1_pd(kLog2e)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(kLn2Hi), hi);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(kLn2Lo), r);
+    r = _mm256_add_pd(r, lo);
+
+    __m256d p = _mm256_set1_pd(kExpTaylor[0]);
+    for (size_t k = 1; k < sizeof(kExpTaylor) / sizeof(kExpTaylor[0]); ++k) {
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(kExpTaylor[k]));
+    }
+
+    __m256d n1 = _mm256_floor_pd(_mm256_mul_pd(n, _mm256_set1_pd(0.5)));
+    __m256d n2 = _mm256_sub_pd(n, n1);
+    return _mm256_mul_pd(_mm256_mul_pd(p, pow2i(n1)), pow2i(n2));
+}
+
+AXIOM_TARGET_AVX2 static inline __m256d log_pd(__m256d x) {
+    // Subnormals are scaled into the normal range first
+    __m256d tiny = _mm256_cmp_pd(x, _mm256_set1_pd(std::numeric_limits<double>::min()), _CMP_LT_OQ);
+    __m256d xs = _mm256_blendv_pd(x, _mm256_mul_pd(x, _mm256_set1_pd(18014398509481984.0)), tiny);   // 2^54
+    __m256d bias = _mm256_blendv_pd(_mm256_set1_pd(1023.0), _mm256_set1_pd(1023.0 + 54.0), tiny);
+
+    // x = 2^e * m with m in [1, 2), then m in [sqrt(1/2), sqrt(2))
+    __m256i bits = _mm256_castpd_si256(xs);
+    const __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+    __m256i exponent = _mm256_srli_epi64(_mm256_slli_epi64(bits, 1), 53);
+    __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(exponent, _mm256_castpd_si256(two52))), two52);
+    e = _mm256_sub_pd(e, bias);
+    __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_castpd_si256(_mm256_set1_pd(1.0))));
+    __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(kSqrt2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+    e = _mm256_add_pd(e, _mm256_and_pd(big, _mm256_set1_pd(1.0)));
+
+    __m256d s = _mm256_div_pd(_mm256_sub_pd(m, _mm256_set1_pd(1.0)), _mm256_add_pd(m, _mm256_set1_pd(1.0)));
+    __m256d z = _mm256_mul_pd(s, s);
+    __m256d q = _mm256_set1_pd(kLogSeries[0]);
+    for (size_t k = 1; k < sizeof(kLogSeries) / sizeof(kLogSeries[0]); ++k) {
+        q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(kLogSeries[k]));
+    }
+    __m256d s2 = _mm256_add_pd(s, s);
+    __m256d lm = _mm256_fmadd_pd(_mm256_mul_pd(s2, z), q, s2);
+    __m256d result = _mm256_fmadd_pd(e, _mm256_set1_pd(kLn2Hi), _mm256_fmadd_pd(e, _mm256_set1_pd(kLn2Lo), lm));
+
+    const double inf = std::numeric_limits<double>::infinity();
+    result = _mm256_blendv_pd(result, _mm256_set1_pd(-inf), _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_EQ_OQ));
+    result = _mm256_blendv_pd(result, _mm256_set1_pd(inf), _mm256_cmp_pd(x, _mm256_set1_pd(inf), _CMP_EQ_OQ));
+    return _mm256_blendv_pd(result, _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN()),
+                            _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_NGE_UQ));
+}
+
+AXIOM_TARGET_AVX2 static inline __m256d erfc_pd(__m256d u) {
+    // erfc(|u|) = t exp(-u^2 + C(ty)); |u| > 30 underflows anyway
+    __m256d a = _mm256_and_pd(u, _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL)));
+    a = _mm256_min_pd(_mm256_set1_pd(30.0), a);
+    __m256d t = _mm256_div_pd(_mm256_set1_pd(2.0), _mm256_add_pd(_mm256_set1_pd(2.0), a));
+    __m256d ty = _mm256_fmsub_pd(_mm256_set1_pd(4.0), t, _mm256_set1_pd(2.0));
+
+    __m256d d = _mm256_setzero_pd(), dd = _mm256_setzero_pd();
+    for (size_t j = kErfcTerms - 1; j > 0; --j) {
+        __m256d tmp = d;
+        d = _mm256_fmadd_pd(ty, d, _mm256_sub_pd(_mm256_set1_pd(kErfcCheb[j]), dd));
+        dd = tmp;
+    }
+    __m256d c = _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_fmadd_pd(ty, d, _mm256_set1_pd(kErfcCheb[0]))), dd);
+
+    __m256d h = _mm256_mul_pd(a, a);
+    __m256d l = _mm256_fmsub_pd(a, a, h);
+    __m256d r = _mm256_mul_pd(t, exp_hl(_mm256_sub_pd(_mm256_setzero_pd(), h), _mm256_sub_pd(c, l)));
+    __m256d negative = _mm256_cmp_pd(u, _mm256_setzero_pd(), _CMP_LT_OQ);
+    return _mm256_blendv_pd(r, _mm256_sub_pd(_mm256_set1_pd(2.0), r), negative);
+}
+
+// Applies op to full vectors, then to the tail through a padded block so
+// every element takes the same code path
+template <typename Op>
+AXIOM_TARGET_AVX2 static inline void map_pd(const double* x, double* y, size_t n, Op op) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(y + i, op(_mm256_loadu_pd(x + i)));
+    if (i < n) {
+        double in[4] = {0.0, 0.0, 0.0, 0.0}, out[4];
+        std::copy(x + i, x + n, in);
+        _mm256_storeu_pd(out, op(_mm256_loadu_pd(in)));
+        std::copy(out, out + (n - i), y + i);
+    }
+}
+
+// Stateless ops are functors rather than lambdas: a captureless lambda's
+// conversion to a function pointer carries no target attribute and trips -Wpsabi
+struct ExpOp {
+    AXIOM_TARGET_AVX2 __m256d operator()(__m256d v) const { return exp_hl(v, _mm256_setzero_pd()); }
+};
+
+struct LogOp {
+    AXIOM_TARGET_AVX2 __m256d operator()(__m256d v) const { return log_pd(v); }
+};
+
+AXIOM_TARGET_AVX2 void exp(const double* x, double* y, size_t n) {
+    map_pd(x, y, n, ExpOp{});
+}
+
+AXIOM_TARGET_AVX2 void log(const double* x, double* y, size_t n) {
+    map_pd(x, y, n, LogOp{});
+}
+
+AXIOM_TARGET_AVX2 void normal_pdf(const double* x, double* y, size_t n, double mean, double sd) {
+    const __m256d mu = _mm256_set1_pd(mean);
+    const __m256d inv_sd = _mm256_set1_pd(1.0 / sd);
+    const __m256d scale = _mm256_set1_pd(kInvSqrt2Pi / sd);
+    const __m256d minus_half = _mm256_set1_pd(-0.5);
+    map_pd(x, y, n, [&](__m256d v) AXIOM_TARGET_AVX2 {
+        // |z| > 40 underflows; the clamp also keeps fmsub(inf, inf, inf) out
+        __m256d z = _mm256_mul_pd(_mm256_sub_pd(v, mu), inv_sd);
+        z = _mm256_min_pd(_mm256_set1_pd(40.0), _mm256_and_pd(z, _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL))));
+        __m256d h = _mm256_mul_pd(z, z);
+        __m256d l = _mm256_fmsub_pd(z, z, h);
+        return _mm256_mul_pd(scale, exp_hl(_mm256_mul_pd(minus_half, h), _mm256_mul_pd(minus_half, l)));
+    });
+}
+
+AXIOM_TARGET_AVX2 void normal_cdf(const double* x, double* y, size_t n, double mean, double sd) {
+    const __m256d mu = _mm256_set1_pd(mean);
+    const __m256d k = _mm256_set1_pd(1.0 / (sd * kSqrt2));
+    const __m256d half = _mm256_set1_pd(0.5);
+    map_pd(x, y, n, [&](__m256d v) AXIOM_TARGET_AVX2 {
+        return _mm256_mul_pd(half, erfc_pd(_mm256_mul_pd(_mm256_sub_pd(mu, v), k)));
+    });
+}
+
+AXIOM_TARGET_AVX2 void bin_uniform(const double* x, uint32_t* index, size_t n, double lo, double hi, uint32_t bins) {
+    const __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+    const __m256d count = _mm256_set1_pd(static_cast<double>(bins));
+    const __m256d step = _mm256_set1_pd((hi - lo) / static_cast<double>(bins));
+    const __m256d scale = _mm256_set1_pd(static_cast<double>(bins) / (hi - lo));
+    const __m256d last = _mm256_set1_pd(static_cast<double>(bins - 1));
+    const __m256d one = _mm256_set1_pd(1.0), zero = _mm256_setzero_pd();
+    const __m256d above = _mm256_set1_pd(static_cast<double>(bins) + 1.0);
+    const __m256d missing = _mm256_set1_pd(static_cast<double>(bins) + 2.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        __m256d t = _mm256_floor_pd(_mm256_mul_pd(_mm256_sub_pd(v, vlo), scale));
+        __m256d k = _mm256_max_pd(_mm256_min_pd(t, last), zero);
+        // Step to the neighbour when rounding put v on the wrong side of a reported edge
+        __m256d left = _mm256_fmadd_pd(k, step, vlo);
+        __m256d next = _mm256_add_pd(k, one);
+        __m256d right = _mm256_fmadd_pd(next, step, vlo);
+        __m256d down = _mm256_and_pd(_mm256_cmp_pd(v, left, _CMP_LT_OQ), _mm256_cmp_pd(k, zero, _CMP_GT_OQ));
+        __m256d up = _mm256_and_pd(_mm256_cmp_pd(v, right, _CMP_GE_OQ), _mm256_cmp_pd(next, count, _CMP_LT_OQ));
+        k = _mm256_sub_pd(k, _mm256_and_pd(down, one));
+        k = _mm256_add_pd(k, _mm256_and_pd(up, one));
+        __m256d code = _mm256_add_pd(k, one);
+        // Outside codes as doubles, then one conversion for all four lanes
+        code = _mm256_blendv_pd(code, zero, _mm256_cmp_pd(v, vlo, _CMP_LT_OQ));
+        code = _mm256_blendv_pd(code, above, _mm256_cmp_pd(v, vhi, _CMP_GT_OQ));
+        code = _mm256_blendv_pd(code, missing, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(index + i), _mm256_cvttpd_epi32(code));
+    }
+    scalar::bin_uniform(x + i, index + i, n - i, lo, hi, bins);
+}
+
+// Small edge sets: count the interior edges <= v with broadcast compares
+// (bins - 1 compares per 4 values beats log2(bins) dependent loads);
+// larger ones use the scalar branch-free search, which outran gathers
+constexpr uint32_t kLinearEdgesAVX2 = 32;
+
+AXIOM_TARGET_AVX2 void bin_edges(const double* x, uint32_t* index, size_t n, const double* edges, uint32_t bins) {
+    if (bins > kLinearEdgesAVX2) {
+        scalar::bin_edges(x, index, n, edges, bins);
+        return;
+    }
+    const __m256d first = _mm256_set1_pd(edges[0]), end = _mm256_set1_pd(edges[bins]);
+    const __m256d above = _mm256_set1_pd(static_cast<double>(bins) + 1.0);
+    const __m256d missing = _mm256_set1_pd(static_cast<double>(bins) + 2.0);
+    const __m256d one = _mm256_set1_pd(1.0), zero = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        __m256d code = one;
+        for (uint32_t j = 1; j < bins; ++j) {
+            code = _mm256_add_pd(code, _mm256_and_pd(_mm256_cmp_pd(_mm256_broadcast_sd(edges + j), v, _CMP_LE_OQ), one));
+        }
+        code = _mm256_blendv_pd(code, zero, _mm256_cmp_pd(v, first, _CMP_LT_OQ));
+        code = _mm256_blendv_pd(code, above, _mm256_cmp_pd(v, end, _CMP_GT_OQ));
+        code = _mm256_blendv_pd(code, missing, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(index + i), _mm256_cvttpd_epi32(code));
+    }
+    scalar::bin_edges(x + i, index + i, n - i, edges, bins);
+}
+
+} // namespace avx2
+
+// ============================================================================
+// AVX-512F kernels (8 x double)
+// ============================================================================
+
+namespace avx512 {
+
+AXIOM_TARGET_AVX512 double sum(const double* data, size_t n) {
+    __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm512_add_pd(a0, _mm512_loadu_pd(data + i));
+        a1 = _mm512_add_pd(a1, _mm512_loadu_pd(data + i + 8));
+    }
+    double s = _mm512_reduce_add_pd(_mm512_add_pd(a0, a1));
+    for (; i < n; ++i) s += data[i];
+    return s;
+}
+
+AXIOM_TARGET_AVX512 double dot(const double* x, const double* y, size_t n) {
+    __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), a0);
+        a1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), a1);
+    }
+    double s = _mm512_reduce_add_pd(_mm512_add_pd(a0, a1));
+    for (; i < n; ++i) s += x[i] * y[i];
+    return s;
+}
+
+AXIOM_TARGET_AVX512 double sum_sq_dev(const double* data, size_t n, double center) {
+    __m512d c = _mm512_set1_pd(center);
+    __m512d a0 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d d = _mm512_sub_pd(_mm512_loadu_pd(data + i), c);
+        a0 = _mm512_fmadd_pd(d, d, a0);
+    }
+    double s = _mm512_reduce_add_pd(a0);
+    for (; i < n; ++i) { double d = data[i] - center; s += d * d; }
+    return s;
+}
+
+AXIOM_TARGET_AVX512 void minmax(const double* data, size_t n, double* min_out, double* max_out) {
+    __m512d vmin = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+    __m512d vmax = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(data + i);
+        vmin = _mm512_min_pd(vmin, v);
+        vmax = _mm512_max_pd(vmax, v);
+    }
+    double mn = _mm512_reduce_min_pd(vmin);
+    double mx = _mm512_reduce_max_pd(vmax);
+    for (; i < n; ++i) { mn = std::min(mn, data[i]); mx = std::max(mx, data[i]); }
+    *min_out = mn; *max_out = mx;
+}
+
+AXIOM_TARGET_AVX512 static inline void kb_add(__m512d& s, __m512d& c, __m512d x) {
+    __m512d t = _mm512_add_pd(s, x);
+    __mmask8 s_larger = _mm512_cmp_pd_mask(_mm512_abs_pd(s), _mm512_abs_pd(x), _CMP_GE_OQ);
+    __m512d large = _mm512_mask_blend_pd(s_larger, x, s);
+    __m512d small = _mm512_mask_blend_pd(s_larger, s, x);
+    c = _mm512_add_pd(c, _mm512_add_pd(_mm512_sub_pd(large, t), small));
+    s = t;
+}
+
+AXIOM_TARGET_AVX512 static inline void kb_fold(__m512d s, __m512d c, double* out) {
+    alignas(64) double ls[8], lc[8];
+    _mm512_store_pd(ls, s);
+    _mm512_store_pd(lc, c);
+    scalar::kb_fold(ls, lc, 8, out);
+}
+
+AXIOM_TARGET_AVX512 void sum_kb(const double* data, size_t n, double* out) {
+    __m512d s0 = _mm512_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        kb_add(s0, c0, _mm512_loadu_pd(data + i));
+        kb_add(s1, c1, _mm512_loadu_pd(data + i + 8));
+    }
+    double tail[2];
+    scalar::sum_kb(data + i, n - i, tail);
+    out[0] = out[1] = 0.0;
+    kb_fold(s0, c0, out);
+    kb_fold(s1, c1, out);
+    avx2::kb_merge(out, tail);
+}
+
+AXIOM_TARGET_AVX512 void sum_sq_dev_kb(const double* data, size_t n, double center, double* out) {
+    __m512d vc = _mm512_set1_pd(center);
+    __m512d s0 = _mm512_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(data + i), vc);
+        __m512d d1 = _mm512_sub_pd(_mm512_loadu_pd(data + i + 8), vc);
+        kb_add(s0, c0, _mm512_mul_pd(d0, d0));
+        kb_add(s1, c1, _mm512_mul_pd(d1, d1));
+    }
+    double tail[2];
+    scalar::sum_sq_dev_kb(data + i, n - i, center, tail);
+    out[0] = out[1] = 0.0;
+    kb_fold(s0, c0, out);
+    kb_fold(s1, c1, out);
+    avx2::kb_merge(out, tail);
+}
+
+AXIOM_TARGET_AVX512 void central_moments_kb(const double* data, size_t n, double center, double* out) {
+    __m512d vc = _mm512_set1_pd(center);
+    __m512d s0 = _mm512_setzero_pd(), c0 = s0, m3 = s0, m4 = s0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d d = _mm512_sub_pd(_mm512_loadu_pd(data + i), vc);
+        __m512d d2 = _mm512_mul_pd(d, d);
+        kb_add(s0, c0, d2);
+        m3 = _mm512_fmadd_pd(d2, d, m3);
+        m4 = _mm512_fmadd_pd(d2, d2, m4);
+    }
+    double tail[4];
+    scalar::central_moments_kb(data + i, n - i, center, tail);
+    out[0] = out[1] = 0.0;
+    kb_fold(s0, c0, out);
+    avx2::kb_merge(out, tail);
+    out[2] = _mm512_reduce_add_pd(m3) + tail[2];
+    out[3] = _mm512_reduce_add_pd(m4) + tail[3];
+}
+
+AXIOM_TARGET_AVX512 void co_dev_kb(const double* x, const double* y, size_t n, double cx, double cy, double* out) {
+    __m512d vx = _mm512_set1_pd(cx), vy = _mm512_set1_pd(cy);
+    __m512d zero = _mm512_setzero_pd();
+    __m512d sxx = zero, cxx = zero, syy = zero, cyy = zero, sxy = zero, cxy = zero;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x + i), vx);
+        __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(y + i), vy);
+        kb_add(sxx, cxx, _mm512_mul_pd(dx, dx));
+        kb_add(syy, cyy, _mm512_mul_pd(dy, dy));
+        kb_add(sxy, cxy, _mm512_mul_pd(dx, dy));
+    }
+    double tail[6];
+    scalar::co_dev_kb(x + i, y + i, n - i, cx, cy, tail);
+    std::fill(out, out + 6, 0.0);
+    kb_fold(sxx, cxx, out);
+    kb_fold(syy, cyy, out + 2);
+    kb_fold(sxy, cxy, out + 4);
+    for (size_t k = 0; k < 3; ++k) avx2::kb_merge(out + 2 * k, tail + 2 * k);
+}
+
+AXIOM_TARGET_AVX512 void gemm(const double* A, const double* B, double* C, size_t M, size_t K, size_t N) {
+    std::fill(C, C + M * N, 0.0);
+    for (size_t i = 0; i < M; ++i) {
+        double* c_row = C + i * N;
+        for (size_t k = 0; k < K; ++k) {
+            __m512d a = _mm512_set1_pd(A[i * K + k]);
+            const double* b_row = B + k * N;
+            size_t j = 0;
+            for (; j + 8 <= N; j += 8) {
+                __m512d c = _mm512_loadu_pd(c_row + j);
+                _mm512_storeu_pd(c_row + j, _mm512_fmadd_pd(a, _mm512_loadu_pd(b_row + j), c));
+            }
+            for (; j < N; ++j) c_row[j] += A[i * K + k] * b_row[j];
+        }
+    }
+}
+
+AXIOM_TARGET_AVX512 void poly_eval(const double* coeffs, size_t degree, const double* x, double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d vx = _mm512_loadu_pd(x + i);
+        __m512d acc = _mm512_set1_pd(coeffs[degree]);
+        for (size_t d = degree; d-- > 0;) acc = _mm512_fmadd_pd(acc, vx, _mm512_set1_pd(coeffs[d]));
+        _mm512_storeu_pd(y + i, acc);
+    }
+    avx2::poly_eval(coeffs, degree, x + i, y + i, n - i);
+}
+
+AXIOM_TARGET_AVX512 void affine(const double* x, double* y, size_t n, double a, double b) {
+    __m512d va = _mm512_set1_pd(a), vb = _mm512_set1_pd(b);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), vb));
+    }
+    for (; i < n; ++i) y[i] = a * x[i] + b;
+}
+
+AXIOM_TARGET_AVX512 void prefix_sum(const double* x, double* out, size_t n, double shift) {
+    const __m512i by1 = _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0);
+    const __m512i by2 = _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0);
+    const __m512i by4 = _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0);
+    const __m512i last = _mm512_set1_epi64(7);
+    const __m512d vshift = _mm512_set1_pd(shift);
+    __m512d carry = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_sub_pd(_mm512_loadu_pd(x + i), vshift);
+        v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xFE, by1, v));
+        v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xFC, by2, v));
+        v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xF0, by4, v));
+        v = _mm512_add_pd(v, carry);
+        _mm512_storeu_pd(out + i, v);
+        carry = _mm512_permutexvar_pd(last, v);
+    }
+    double running = _mm512_cvtsd_f64(carry);
+    for (; i < n; ++i) {
+        running += x[i] - shift;
+        out[i] = running;
+    }
+}
+
+// exp(hi + lo) as in avx2::exp_hl; scalef applies 2^n with correct overflow/underflow
+AXIOM_TARGET_AVX512 static inline __m512d exp_hl(__m512d hi, __m512d lo) {
+    hi = _mm512_max_pd(_mm512_set1_pd(-1000.0), _mm512_min_pd(_mm512_set1_pd(1000.0), hi));
+    __m512d n = _mm512_roundscale_pd(_mm512_mul_pd(_mm512_add_pd(hi, lo), _mm512_set1_pd(kLog2e)), _MM_FROUND_TO_NEAREST_INT);
+    __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(kLn2Hi), hi);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(kLn2Lo), r);
+    r = _mm512_add_pd(r, lo);
+
+    __m512d p = _mm512_set1_pd(kExpTaylor[0]);
+    for (size_t k = 1; k < sizeof(kExpTaylor) / sizeof(kExpTaylor[0]); ++k) {
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(kExpTaylor[k]));
+    }
+    return _mm512_scalef_pd(p, n);
+}
+
+AXIOM_TARGET_AVX512 static inline __m512d log_pd(__m512d x) {
+    // getexp / getmant handle subnormals; m in [1, 2) is then folded to [sqrt(1/2), sqrt(2))
+    __m512d e = _mm512_getexp_pd(x);
+    __m512d m = _mm512_getmant_pd(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+    __mmask8 big = _mm512_cmp_pd_mask(m, _mm512_set1_pd(kSqrt2), _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, big, m, _mm512_set1_pd(0.5));
+    e = _mm512_mask_add_pd(e, big, e, _mm512_set1_pd(1.0));
+
+    __m512d s = _mm512_div_pd(_mm512_sub_pd(m, _mm512_set1_pd(1.0)), _mm512_add_pd(m, _mm512_set1_pd(1.0)));
+    __m512d z = _mm512_mul_pd(s, s);
+    __m512d q = _mm512_set1_pd(kLogSeries[0]);
+    for (size_t k = 1; k < sizeof(kLogSeries) / sizeof(kLogSeries[0]); ++k) {
+        q = _mm512_fmadd_pd(q, z, _mm512_set1_pd(kLogSeries[k]));
+    }
+    __m512d s2 = _mm512_add_pd(s, s);
+    __m512d lm = _mm512_fmadd_pd(_mm512_mul_pd(s2, z), q, s2);
+    __m512d result = _mm512_fmadd_pd(e, _mm512_set1_pd(kLn2Hi), _mm512_fmadd_pd(e, _mm512_set1_pd(kLn2Lo), lm));
+
+    const double inf = std::numeric_limits<double>::infinity();
+    result = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_EQ_OQ), result, _mm512_set1_pd(-inf));
+    result = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, _mm512_set1_pd(inf), _CMP_EQ_OQ), result, _mm512_set1_pd(inf));
+    return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_NGE_UQ), result,
+                                _mm512_set1_pd(std::numeric_limits<double>::quiet_NaN()));
+}
+
+AXIOM_TARGET_AVX512 static inline __m512d erfc_pd(__m512d u) {
+    __m512d a = _mm512_min_pd(_mm512_set1_pd(30.0), _mm512_abs_pd(u));
+    __m512d t = _mm512_div_pd(_mm512_set1_pd(2.0), _mm512_add_pd(_mm512_set1_pd(2.0), a));
+    __m512d ty = _mm512_fmsub_pd(_mm512_set1_pd(4.0), t, _mm512_set1_pd(2.0));
+
+    __m512d d = _mm512_setzero_pd(), dd = _mm512_setzero_pd();
+    for (size_t j = kErfcTerms - 1; j > 0; --j) {
+        __m512d tmp = d;
+        d = _mm512_fmadd_pd(ty, d, _mm512_sub_pd(_mm512_set1_pd(kErfcCheb[j]), dd));
+        dd = tmp;
+    }
+    __m512d c = _mm512_sub_pd(_mm512_mul_pd(_mm512_set1_pd(0.5), _mm512_fmadd_pd(ty, d, _mm512_set1_pd(kErfcCheb[0]))), dd);
+
+    __m512d h = _mm512_mul_pd(a, a);
+    __m512d l = _mm512_fmsub_pd(a, a, h);
+    __m512d r = _mm512_mul_pd(t, exp_hl(_mm512_sub_pd(_mm512_setzero_pd(), h), _mm512_sub_pd(c, l)));
+    __mmask8 negative = _mm512_cmp_pd_mask(u, _mm512_setzero_pd(), _CMP_LT_OQ);
+    return _mm512_mask_sub_pd(r, negative, _mm512_set1_pd(2.0), r);
+}
+
+// Full vectors, then a masked tail (same code path for every element)
+template <typename Op>
+AXIOM_TARGET_AVX512 static inline void map_pd(const double* x, double* y, size_t n, Op op) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(y + i, op(_mm512_loadu_pd(x + i)));
+    if (i < n) {
+        __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(y + i, mask, op(_mm512_maskz_loadu_pd(mask, x + i)));
+    }
+}
+
+// Functors for the same -Wpsabi reason as avx2::ExpOp
+struct ExpOp {
+    AXIOM_TARGET_AVX512 __m512d operator()(__m512d v) const { return exp_hl(v, _mm512_setzero_pd()); }
+};
+
+struct LogOp {
+    AXIOM_TARGET_AVX512 __m512d operator()(__m512d v) const { return log_pd(v); }
+};
+
+AXIOM_TARGET_AVX512 void exp(const double* x, double* y, size_t n) {
+    map_pd(x, y, n, ExpOp{});
+}
+
+AXIOM_TARGET_AVX512 void log(const double* x, double* y, size_t n) {
+    map_pd(x, y, n, LogOp{});
+}
+
+AXIOM_TARGET_AVX512 void normal_pdf(const double* x, double* y, size_t n, double mean, double sd) {
+    const __m512d mu = _mm512_set1_pd(mean);
+    const __m512d inv_sd = _mm512_set1_pd(1.0 / sd);
+    const __m512d scale = _mm512_set1_pd(kInvSqrt2Pi / sd);
+    const __m512d minus_half = _mm512_set1_pd(-0.5);
+    map_pd(x, y, n, [&](__m512d v) AXIOM_TARGET_AVX512 {
+        __m512d z = _mm512_min_pd(_mm512_set1_pd(40.0), _mm512_abs_pd(_mm512_mul_pd(_mm512_sub_pd(v, mu), inv_sd)));
+        __m512d h = _mm512_mul_pd(z, z);
+        __m512d l = _mm512_fmsub_pd(z, z, h);
+        return _mm512_mul_pd(scale, exp_hl(_mm512_mul_pd(minus_half, h), _mm512_mul_pd(minus_half, l)));
+    });
+}
+
+AXIOM_TARGET_AVX512 void normal_cdf(const double* x, double* y, size_t n, double mean, double sd) {
+    const __m512d mu = _mm512_set1_pd(mean);
+    const __m512d k = _mm512_set1_pd(1.0 / (sd * kSqrt2));
+    const __m512d half = _mm512_set1_pd(0.5);
+    map_pd(x, y, n, [&](__m512d v) AXIOM_TARGET_AVX512 {
+        return _mm512_mul_pd(half, erfc_pd(_mm512_mul_pd(_mm512_sub_pd(mu, v), k)));
+    });
+}
+
+AXIOM_TARGET_AVX512 void bin_uniform(const double* x, uint32_t* index, size_t n, double lo, double hi, uint32_t bins) {
+    const __m512d vlo = _mm512_set1_pd(lo), vhi = _mm512_set1_pd(hi);
+    const __m512d count = _mm512_set1_pd(static_cast<double>(bins));
+    const __m512d step = _mm512_set1_pd((hi - lo) / static_cast<double>(bins));
+    const __m512d scale = _mm512_set1_pd(static_cast<double>(bins) / (hi - lo));
+    const __m512d last = _mm512_set1_pd(static_cast<double>(bins - 1));
+    const __m512d one = _mm512_set1_pd(1.0), zero = _mm512_setzero_pd();
+    const __m512d above = _mm512_set1_pd(static_cast<double>(bins) + 1.0);
+    const __m512d missing = _mm512_set1_pd(static_cast<double>(bins) + 2.0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(x + i);
+        __m512d t = _mm512_roundscale_pd(_mm512_mul_pd(_mm512_sub_pd(v, vlo), scale), _MM_FROUND_TO_NEG_INF);
+        __m512d k = _mm512_max_pd(_mm512_min_pd(t, last), zero);
+        __m512d left = _mm512_fmadd_pd(k, step, vlo);
+        __m512d next = _mm512_add_pd(k, one);
+        __m512d right = _mm512_fmadd_pd(next, step, vlo);
+        __mmask8 down = _mm512_cmp_pd_mask(v, left, _CMP_LT_OQ) & _mm512_cmp_pd_mask(k, zero, _CMP_GT_OQ);
+        __mmask8 up = _mm512_cmp_pd_mask(v, right, _CMP_GE_OQ) & _mm512_cmp_pd_mask(next, count, _CMP_LT_OQ);
+        k = _mm512_mask_sub_pd(k, down, k, one);
+        k = _mm512_mask_add_pd(k, up, k, one);
+        __m512d code = _mm512_add_pd(k, one);
+        code = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, vlo, _CMP_LT_OQ), code, zero);
+        code = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, vhi, _CMP_GT_OQ), code, above);
+        code = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, v, _CMP_UNORD_Q), code, missing);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(index + i), _mm512_cvttpd_epu32(code));
+    }
+    avx2::bin_uniform(x + i, index + i, n - i, lo, hi, bins);
+}
+
+constexpr uint32_t kLinearEdgesAVX512 = 64;
+
+AXIOM_TARGET_AVX512 void bin_edges(const double* x, uint32_t* index, size_t n, const double* edges, uint32_t bins) {
+    if (bins > kLinearEdgesAVX512) {
+        scalar::bin_edges(x, index, n, edges, bins);
+        return;
+    }
+    const __m512d first = _mm512_set1_pd(edges[0]), end = _mm512_set1_pd(edges[bins]);
+    const __m512i above = _mm512_set1_epi64(static_cast<long long>(bins) + 1);
+    const __m512i missing = _mm512_set1_epi64(static_cast<long long>(bins) + 2);
+    const __m512i one = _mm512_set1_epi64(1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(x + i);
+        __m512i code = one;
+        for (uint32_t j = 1; j < bins; ++j) {
+            code = _mm512_mask_add_epi64(code, _mm512_cmp_pd_mask(_mm512_set1_pd(edges[j]), v, _CMP_LE_OQ), code, one);
+        }
+        code = _mm512_mask_mov_epi64(code, _mm512_cmp_pd_mask(v, first, _CMP_LT_OQ), _mm512_setzero_si512());
+        code = _mm512_mask_mov_epi64(code, _mm512_cmp_pd_mask(v, end, _CMP_GT_OQ), above);
+        code = _mm512_mask_mov_epi64(code, _mm512_cmp_pd_mask(v, v, _CMP_UNORD_Q), missing);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(index + i), _mm512_cvtepi64_epi32(code));
+    }
+    scalar::bin_edges(x + i, index + i, n - i, edges, bins);
+}
+
+} // namespace avx512
+
+#endif // AXIOM_SIMD_X86
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+static KernelTable BuildKernels(ISALevel level) {
+    KernelTable table{
+        scalar::sum, scalar::dot, scalar::sum_sq_dev, scalar::minmax,
+        scalar::sum_kb, scalar::sum_sq_dev_kb, scalar::central_moments_kb, scalar::co_dev_kb,
+        scalar::gemm, scalar::poly_eval, scalar::affine, scalar::prefix_sum,
+        scalar::exp, scalar::log, scalar::normal_pdf, scalar::normal_cdf,
+        scalar::bin_uniform, scalar::bin_edges,
+        "scalar", "scalar", "scalar", "scalar", "scalar"
+    };
+
+#ifdef AXIOM_SIMD_X86
+    switch (level) {
+        case ISALevel::AVX512:
+            table = {
+                avx512::sum, avx512::dot, avx512::sum_sq_dev, avx512::minmax,
+                avx512::sum_kb, avx512::sum_sq_dev_kb, avx512::central_moments_kb, avx512::co_dev_kb,
+                avx512::gemm, avx512::poly_eval, avx512::affine, avx512::prefix_sum,
+                avx512::exp, avx512::log, avx512::normal_pdf, avx512::normal_cdf,
+                avx512::bin_uniform, avx512::bin_edges,
+                "avx512f", "avx512f", "avx512f", "avx512f", "avx512f"
+            };
+            break;
+        case ISALevel::AVX2:
+            table = {
+                avx2::sum, avx2::dot, avx2::sum_sq_dev, avx2::minmax,
+                avx2::sum_kb, avx2::sum_sq_dev_kb, avx2::central_moments_kb, avx2::co_dev_kb,
+                avx2::gemm, avx2::poly_eval, avx2::affine, avx2::prefix_sum,
+                avx2::exp, avx2::log, avx2::normal_pdf, avx2::normal_cdf,
+                avx2::bin_uniform, avx2::bin_edges,
+                "avx2+fma", "avx2+fma", "avx2+fma", "avx2+fma", "avx2+fma"
+            };
+            break;
+        default:
+            break;
+    }
+#endif
+
+    return table;
+}
+
+const KernelTable& Kernels() {
+    static const KernelTable table = BuildKernels(CPUOptimization::GetISALevel());
+    return table;
+}
+
+const KernelTable* KernelsFor(ISALevel level) {
+#ifdef AXIOM_SIMD_X86
+    const CPUFeatures& f = CPUOptimization::GetFeatures();
+    bool supported = level == ISALevel::Scalar ||
+                     (level == ISALevel::AVX2 && f.avx2 && f.fma && f.os_avx) ||
+                     (level == ISALevel::AVX512 && f.avx512f && f.os_avx512);
+#else
+    bool supported = level == ISALevel::Scalar;
+#endif
+    if (!supported) return nullptr;
+    static const KernelTable tables[] = {
+        BuildKernels(ISALevel::Scalar), BuildKernels(ISALevel::AVX2), BuildKernels(ISALevel::AVX512)
+    };
+    return &tables[static_cast<size_t>(level)];
+}
+
+} // namespace SIMD
+} // namespace AXIOM
@@ -0,0 +1,478 @@
+/**
+ * @file sparse_polynomial.cpp
+ * @brief Sparse polynomial arithmetic (heap multiplication) and the expanding parser
+ */
+
+#include "sparse_polynomial.h"
+#include "compiled_expression.h"
+#include "dynamic_calc_types.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+using Term = SparsePolynomial::Term;
+
+constexpr unsigned kShift(size_t variable) { return 8 * (SparsePolynomial::kMaxVariables - 1 - variable); }
+
+// Per-byte a + b <= 255 for every exponent, so adding packed monomials never carries
+bool ExponentsFit(uint64_t a, uint64_t b) {
+    for (size_t v = 0; v < SparsePolynomial::kMaxVariables; ++v) {
+        if (((a >> (8 * v)) & 0xFF) + ((b >> (8 * v)) & 0xFF) > SparsePolynomial::kMaxExponent) return false;
+    }
+    return true;
+}
+
+constexpr size_t kMinDensePairs = 1 << 14;     // Below this the heap is already fast
+constexpr size_t kMaxDenseSlots = 1 << 22;     // 32 MB of accumulators
+constexpr double kExactLimit = 9007199254740992.0;   // 2^53: doubles hold every integer up to here
+
+/**
+ * Kronecker substitution: with every exponent of the product below its
+ * radix, a monomial maps to one index of a mixed-radix box (first variable
+ * most significant, so descending index is descending lex order) and a
+ * monomial product is an index sum. Term pairs then accumulate into a
+ * dense array without comparisons; the caller checks the box is small.
+ */
+void DenseMultiply(const std::vector<Term>& x, const std::vector<Term>& y, size_t variables,
+                   const std::vector<uint64_t>& radix, size_t slots, std::vector<Term>& out) {
+    std::vector<uint64_t> stride(variables);
+    for (size_t v = variables, s = 1; v-- > 0; s *= radix[v]) stride[v] = s;
+    auto index_of = [&](uint64_t monomial) {
+        uint64_t index = 0;
+        for (size_t v = 0; v < variables; ++v) index += SparsePolynomial::Exponent(monomial, v) * stride[v];
+        return index;
+    };
+    std::vector<uint64_t> iy(y.size());
+    for (size_t j = 0; j < y.size(); ++j) iy[j] = index_of(y[j].monomial);
+
+    std::vector<double> dense(slots, 0.0);
+    for (const Term& a : x) {
+        const uint64_t ia = index_of(a.monomial);
+        for (size_t j = 0; j < y.size(); ++j) {
+            dense[ia + iy[j]] += a.coefficient * y[j].coefficient;
+        }
+    }
+    for (size_t index = slots; index-- > 0;) {
+        if (dense[index] == 0.0) continue;   // Absent or cancelled
+        uint64_t monomial = 0;
+        for (size_t v = 0; v < variables; ++v) {
+            monomial |= ((index / stride[v]) % radix[v]) << (8 * (SparsePolynomial::kMaxVariables - 1 - v));
+        }
+        out.push_back({monomial, dense[index]});
+    }
+}
+
+std::string FormatCoefficient(double value) {
+    char buffer[64];
+    if (value == std::floor(value) && std::abs(value) <= kExactLimit) {
+        std::snprintf(buffer, sizeof(buffer), "%.0f", value);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    }
+    return buffer;
+}
+
+/**
+ * Recursive descent that expands while it parses:
+ *   sum     := product (('+' | '-') product)*
+ *   product := signed (('*' | '/' | implicit) signed)*     (divisors must be constant)
+ *   signed  := ('-' | '+') signed | power
+ *   power   := primary ('^' signed)?                        (constant; integer >= 0 unless the base is constant)
+ *   primary := number | name | '(' sum ')'
+ */
+class PolynomialParser {
+public:
+    explicit PolynomialParser(std::string_view text) : text_(text) {}
+
+    std::optional<SparsePolynomial> Run(std::string& error) {
+        SparsePolynomial result;
+        bool ok = Sum(result) && (SkipSpace(), pos_ == text_.size() || Fail("unexpected '" + std::string(1, text_[pos_]) + "'"));
+        if (!ok) {
+            error = error_;
+            return std::nullopt;
+        }
+        return result;
+    }
+
+private:
+    bool Fail(std::string message) {
+        if (error_.empty()) error_ = std::move(message);
+        return false;
+    }
+
+    void SkipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    }
+
+    char Peek() {
+        SkipSpace();
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    bool Accept(char c) {
+        if (Peek() != c) return false;
+        ++pos_;
+        return true;
+    }
+
+    static bool NameStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+    static bool NameChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+    static bool NumberStart(char c) { return std::isdigit(static_cast<unsigned char>(c)) || c == '.'; }
+
+    bool Store(std::optional<SparsePolynomial> result, SparsePolynomial& out) {
+        if (!result) {
+            return Fail("more than " + std::to_string(SparsePolynomial::kMaxVariables) + " variables, an exponent above " +
+                        std::to_string(SparsePolynomial::kMaxExponent) + " or more than " +
+                        std::to_string(SparsePolynomial::kMaxTerms) + " terms");
+        }
+        out = std::move(*result);
+        return true;
+    }
+
+    bool Sum(SparsePolynomial& out) {
+        if (!Product(out)) return false;
+        for (;;) {
+            const bool add = Accept('+');
+            if (!add && !Accept('-')) return true;
+            SparsePolynomial rhs;
+            if (!Product(rhs)) return false;
+            if (!Store(add ? SparsePolynomial::Add(out, rhs) : SparsePolynomial::Subtract(out, rhs), out)) return false;
+        }
+    }
+
+    bool Product(SparsePolynomial& out) {
+        if (!Signed(out)) return false;
+        for (;;) {
+            char c = Peek();
+            SparsePolynomial rhs;
+            if (c == '/') {
+                ++pos_;
+                double divisor;
+                if (!Signed(rhs)) return false;
+                if (!rhs.IsConstant(&divisor)) return Fail("division by a non-constant");
+                if (divisor == 0.0) return Fail("division by zero");
+                out = out.Scaled(1.0 / divisor);
+            } else if (c == '*' || NumberStart(c) || NameStart(c) || c == '(') {
+                // Explicit or implicit multiplication: 2x, 3(x + 1), (x + 1)(x - 1)
+                if (c == '*') ++pos_;
+                if (!Signed(rhs) || !Store(SparsePolynomial::Multiply(out, rhs), out)) return false;
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool Signed(SparsePolynomial& out) {
+        if (Accept('-')) {
+            if (!Signed(out)) return false;
+            out = out.Scaled(-1.0);
+            return true;
+        }
+        if (Accept('+')) return Signed(out);
+        return Power(out);
+    }
+
+    bool Power(SparsePolynomial& out) {
+        if (!Primary(out)) return false;
+        if (!Accept('^')) return true;
+        SparsePolynomial exponent;
+        double n;
+        if (!Signed(exponent)) return false;
+        if (!exponent.IsConstant(&n)) return Fail("exponent must be constant");
+        double base;
+        if (out.IsConstant(&base)) {
+            // A constant base takes any real exponent: 2^-1, 4^0.5
+            const double value = std::pow(base, n);
+            if (!std::isfinite(value)) return Fail("constant power is not a finite real number");
+            out = SparsePolynomial::Constant(value);
+            return true;
+        }
+        if (n < 0 || n != std::floor(n)) return Fail("exponent must be a non-negative integer");
+        if (n > SparsePolynomial::kMaxExponent) return Store(std::nullopt, out);
+        return Store(SparsePolynomial::Pow(out, static_cast<unsigned>(n)), out);
+    }
+
+    bool Number(SparsePolynomial& out) {
+        const char* begin = text_.data() + pos_;
+        const char* stop = begin + CompiledExpression::NumberLength(text_.substr(pos_));
+        double value;
+        auto [ptr, ec] = std::from_chars(begin, stop, value);
+        if (ec != std::errc() || ptr != stop) return Fail("bad number '" + std::string(begin, stop) + "'");
+        pos_ += static_cast<size_t>(stop - begin);
+        out = SparsePolynomial::Constant(value);
+        return true;
+    }
+
+    bool Primary(SparsePolynomial& out) {
+        char c = Peek();
+        if (c == '(') {
+            ++pos_;
+            if (!Sum(out)) return false;
+            return Accept(')') || Fail("expected ')'");
+        }
+        if (NumberStart(c)) return Number(out);
+        if (!NameStart(c)) return Fail(c ? "unexpected '" + std::string(1, c) + "'" : "unexpected end of expression");
+
+        size_t start = pos_;
+        while (pos_ < text_.size() && NameChar(text_[pos_])) ++pos_;
+        std::string name(text_.substr(start, pos_ - start));
+        if (Peek() == '(') return Fail("'" + name + "(' is not a polynomial operation");
+        if (name == "pi" || name == "PI") {
+            out = SparsePolynomial::Constant(PI_CONST);
+        } else if (name == "e" || name == "E") {
+            out = SparsePolynomial::Constant(2.718281828459045);
+        } else if (name == "phi") {
+            out = SparsePolynomial::Constant(1.618033988749895);
+        } else {
+            out = SparsePolynomial::Variable(name);
+        }
+        return true;
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+    std::string error_;
+};
+
+} // namespace
+
+SparsePolynomial SparsePolynomial::Constant(double value) {
+    SparsePolynomial p;
+    if (value != 0.0) p.terms_.push_back({0, value});
+    return p;
+}
+
+SparsePolynomial SparsePolynomial::Variable(const std::string& name) {
+    SparsePolynomial p;
+    p.variables_.push_back(name);
+    p.terms_.push_back({uint64_t{1} << kShift(0), 1.0});
+    return p;
+}
+
+std::optional<SparsePolynomial> SparsePolynomial::Parse(std::string_view text, std::string* error) {
+    std::string reason;
+    auto result = PolynomialParser(text).Run(reason);
+    if (!result && error) *error = reason;
+    return result;
+}
+
+std::optional<std::vector<std::string>> SparsePolynomial::MergedVariables(const SparsePolynomial& a,
+                                                                          const SparsePolynomial& b) {
+    std::vector<std::string> merged;
+    std::set_union(a.variables_.begin(), a.variables_.end(), b.variables_.begin(), b.variables_.end(),
+                   std::back_inserter(merged));
+    if (merged.size() > kMaxVariables) return std::nullopt;
+    return merged;
+}
+
+SparsePolynomial SparsePolynomial::Over(const std::vector<std::string>& variables) const {
+    std::vector<unsigned> shift(variables_.size());
+    for (size_t v = 0; v < variables_.size(); ++v) {
+        auto it = std::lower_bound(variables.begin(), variables.end(), variables_[v]);
+        shift[v] = kShift(static_cast<size_t>(it - variables.begin()));
+    }
+    SparsePolynomial p;
+    p.variables_ = variables;
+    p.terms_.reserve(terms_.size());
+    for (const Term& t : terms_) {
+        uint64_t monomial = 0;
+        for (size_t v = 0; v < variables_.size(); ++v) monomial |= uint64_t{Exponent(t.monomial, v)} << shift[v];
+        p.terms_.push_back({monomial, t.coefficient});
+    }
+    // Inserting variables keeps the relative order of existing ones, so the lex order holds
+    return p;
+}
+
+std::optional<SparsePolynomial> SparsePolynomial::Add(const SparsePolynomial& a, const SparsePolynomial& b) {
+    if (a.variables_ != b.variables_) {
+        auto merged = MergedVariables(a, b);
+        if (!merged) return std::nullopt;
+        return Add(a.Over(*merged), b.Over(*merged));
+    }
+    SparsePolynomial sum;
+    sum.variables_ = a.variables_;
+    sum.terms_.reserve(a.terms_.size() + b.terms_.size());
+    size_t i = 0, j = 0;
+    while (i < a.terms_.size() || j < b.terms_.size()) {
+        if (j == b.terms_.size() || (i < a.terms_.size() && a.terms_[i].monomial > b.terms_[j].monomial)) {
+            sum.terms_.push_back(a.terms_[i++]);
+        } else if (i == a.terms_.size() || b.terms_[j].monomial > a.terms_[i].monomial) {
+            sum.terms_.push_back(b.terms_[j++]);
+        } else {
+            const double c = a.terms_[i].coefficient + b.terms_[j].coefficient;
+            if (c != 0.0) sum.terms_.push_back({a.terms_[i].monomial, c});
+            ++i;
+            ++j;
+        }
+    }
+    return sum;
+}
+
+std::optional<SparsePolynomial> SparsePolynomial::Subtract(const SparsePolynomial& a, const SparsePolynomial& b) {
+    return Add(a, b.Scaled(-1.0));
+}
+
+std::optional<SparsePolynomial> SparsePolynomial::Multiply(const SparsePolynomial& a, const SparsePolynomial& b) {
+    if (a.variables_ != b.variables_) {
+        auto merged = MergedVariables(a, b);
+        if (!merged) return std::nullopt;
+        return Multiply(a.Over(*merged), b.Over(*merged));
+    }
+    const uint64_t bounds_a = a.ExponentBounds();
+    const uint64_t bounds_b = b.ExponentBounds();
+    if (!ExponentsFit(bounds_a, bounds_b)) return std::nullopt;
+
+    // Johnson's heap: one cursor per term of the shorter operand, popped in descending monomial order
+    const auto& x = a.terms_.size() <= b.terms_.size() ? a.terms_ : b.terms_;
+    const auto& y = a.terms_.size() <= b.terms_.size() ? b.terms_ : a.terms_;
+    SparsePolynomial product;
+    product.variables_ = a.variables_;
+    if (x.empty()) return product;
+
+    // Dense products whose exponent box is small go through Kronecker substitution
+    if (x.size() * y.size() >= kMinDensePairs) {
+        std::vector<uint64_t> radix(a.variables_.size());
+        size_t slots = 1;
+        for (size_t v = 0; v < radix.size() && slots <= kMaxDenseSlots; ++v) {
+            radix[v] = Exponent(bounds_a, v) + Exponent(bounds_b, v) + 1;
+            slots *= radix[v];
+        }
+        if (slots <= kMaxDenseSlots && slots <= 2 * x.size() * y.size()) {
+            DenseMultiply(x, y, radix.size(), radix, slots, product.terms_);
+            if (product.terms_.size() > kMaxTerms) return std::nullopt;
+            return product;
+        }
+    }
+
+    struct Cursor {
+        uint64_t monomial;
+        uint32_t i, j;
+        bool operator<(const Cursor& other) const { return monomial < other.monomial; }
+    };
+    std::vector<Cursor> heap;
+    heap.reserve(x.size());
+    for (uint32_t i = 0; i < x.size(); ++i) heap.push_back({x[i].monomial + y[0].monomial, i, 0});
+    std::make_heap(heap.begin(), heap.end());
+
+    auto& out = product.terms_;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end());
+        Cursor& top = heap.back();
+        const double c = x[top.i].coefficient * y[top.j].coefficient;
+        if (!out.empty() && out.back().monomial == top.monomial) {
+            out.back().coefficient += c;
+        } else {
+            if (!out.empty() && out.back().coefficient == 0.0) out.pop_back();
+            // Checked as terms are emitted, so a runaway expansion stops here
+            if (out.size() == kMaxTerms) return std::nullopt;
+            out.push_back({top.monomial, c});
+        }
+        if (++top.j < y.size()) {
+            top.monomial = x[top.i].monomial + y[top.j].monomial;
+            std::push_heap(heap.begin(), heap.end());
+        } else {
+            heap.pop_back();
+        }
+    }
+    if (out.back().coefficient == 0.0) out.pop_back();
+    return product;
+}
+
+std::optional<SparsePolynomial> SparsePolynomial::Pow(const SparsePolynomial& base, unsigned exponent) {
+    const uint64_t bounds = base.ExponentBounds();
+    for (size_t v = 0; v < kMaxVariables; ++v) {
+        if (uint64_t{(bounds >> (8 * v)) & 0xFF} * exponent > kMaxExponent) return std::nullopt;
+    }
+    SparsePolynomial result = Constant(1.0);
+    result.variables_ = base.variables_;
+    for (unsigned e = 0; e < exponent; ++e) {
+        auto next = Multiply(result, base);
+        if (!next) return std::nullopt;
+        result = std::move(*next);
+    }
+    return result;
+}
+
+SparsePolynomial SparsePolynomial::Scaled(double factor) const {
+    SparsePolynomial p;
+    p.variables_ = variables_;
+    p.terms_.reserve(terms_.size());
+    for (const Term& t : terms_) {
+        const double c = t.coefficient * factor;
+        if (c != 0.0) p.terms_.push_back({t.monomial, c});
+    }
+    return p;
+}
+
+bool SparsePolynomial::IsConstant(double* value) const {
+    if (terms_.size() > 1 || (terms_.size() == 1 && terms_[0].monomial != 0)) return false;
+    if (value) *value = terms_.empty() ? 0.0 : terms_[0].coefficient;
+    return true;
+}
+
+bool SparsePolynomial::IsExact() const {
+    return std::all_of(terms_.begin(), terms_.end(), [](const Term& t) { return std::abs(t.coefficient) <= kExactLimit; });
+}
+
+unsigned SparsePolynomial::TotalDegree() const {
+    unsigned degree = 0;
+    for (const Term& t : terms_) {
+        unsigned d = 0;
+        for (size_t v = 0; v < variables_.size(); ++v) d += Exponent(t.monomial, v);
+        degree = std::max(degree, d);
+    }
+    return degree;
+}
+
+uint64_t SparsePolynomial::ExponentBounds() const {
+    uint64_t bounds = 0;
+    for (size_t v = 0; v < variables_.size(); ++v) {
+        unsigned highest = 0;
+        for (const Term& t : terms_) highest = std::max(highest, Exponent(t.monomial, v));
+        bounds |= uint64_t{highest} << kShift(v);
+    }
+    return bounds;
+}
+
+double SparsePolynomial::Evaluate(const double* values) const {
+    double sum = 0.0;
+    for (const Term& t : terms_) {
+        double term = t.coefficient;
+        for (size_t v = 0; v < variables_.size(); ++v) {
+            if (unsigned e = Exponent(t.monomial, v)) term *= std::pow(values[v], static_cast<int>(e));
+        }
+        sum += term;
+    }
+    return sum;
+}
+
+std::string SparsePolynomial::ToString() const {
+    if (terms_.empty()) return "0";
+    std::string out;
+    for (const Term& t : terms_) {
+        const double magnitude = std::abs(t.coefficient);
+        if (out.empty()) {
+            if (t.coefficient < 0) out += '-';
+        } else {
+            out += t.coefficient < 0 ? " - " : " + ";
+        }
+        bool first = true;
+        if (magnitude != 1.0 || t.monomial == 0) {
+            out += FormatCoefficient(magnitude);
+            first = false;
+        }
+        for (size_t v = 0; v < variables_.size(); ++v) {
+            const unsigned e = Exponent(t.monomial, v);
+            if (e == 0) continue;
+            if (!first) out += '*';
+            out += variables_[v];
+            if (e > 1) out += "^" + std::to_string(e);
+            first = false;
+        }
+    }
+    return out;
+}
@@ -1,74 +1,159 @@
 #include "statistics_engine.h"
+#include "binning.h"
+#include "compensated_sum.h"
+#include "frequency_table.h"
+#include "parallel.h"
+#include "quantile_select.h"
+#include "rolling_window.h"
 #include <cmath>
-#include <unordered_map>
+#include <limits>
+
+MomentAccumulator StatisticsEngine::Accumulate(const double* data, size_t n) {
+    return AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, MomentAccumulator{},
+        [data](size_t lo, size_t hi) {
+            MomentAccumulator acc;
+            acc.PushRange(data + lo, hi - lo);
+            return acc;
+        },
+        [](MomentAccumulator a, const MomentAccumulator& b) { a.Merge(b); return a; });
+}
+
+CoMomentAccumulator StatisticsEngine::AccumulatePairs(const Vector& x, const Vector& y) {
+    size_t n = std::min(x.size(), y.size());
+    return AXIOM::Parallel::ParallelReduce(size_t{0}, n, 0, CoMomentAccumulator{},
+        [&x, &y](size_t lo, size_t hi) {
+            CoMomentAccumulator acc;
+            acc.PushRange(x.data() + lo, y.data() + lo, hi - lo);
+            return acc;
+        },
+        [](CoMomentAccumulator a, const CoMomentAccumulator& b) { a.Merge(b); return a; });
+}
+
+EngineResult StatisticsEngine::Describe(const Vector& data) {
+    if (data.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+
+    auto acc = Accumulate(data);
+    if (!acc.IsFinite()) return {{}, {CalcErr::DomainError}};
+
+    auto d = acc.Describe();
+    return EngineSuccessResult(Vector{static_cast<double>(d.count), d.mean, d.variance, d.std_dev,
+                                      d.skewness, d.kurtosis, d.min, d.max});
+}
 
 EngineResult StatisticsEngine::Mean(const Vector& data) {
     if (data.empty()) return {{}, {CalcErr::ArgumentMismatch}};
     
-    double sum = 0.0;
-    for (double val : data) {
-        if (!std::isfinite(val)) return {{}, {CalcErr::DomainError}};
-        sum += val;
-    }
-    return {EngineSuccessResult(sum / data.size()), {}};
+    double sum = Reduction::Sum(data.data(), data.size());
+    if (!std::isfinite(sum)) return {{}, {CalcErr::DomainError}};
+    return EngineSuccessResult(sum / static_cast<double>(data.size()));
 }
 
-EngineResult StatisticsEngine::Median(Vector data) {
-    if (data.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+EngineResult StatisticsEngine::Median(const Vector& data) {
+    auto q = Quantiles(data, Vector{0.5});
+    if (!q.HasResult()) return q;
+    return EngineSuccessResult(std::get<Vector>(*q.result)[0]);
+}
+
+EngineResult StatisticsEngine::QuantilesInPlace(std::span<double> buffer, const Vector& probabilities) {
+    if (buffer.empty() || probabilities.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+    for (double p : probabilities) {
+        if (!(p >= 0.0 && p <= 1.0)) return {{}, {CalcErr::ArgumentMismatch}};
+    }
+    if (std::any_of(buffer.begin(), buffer.end(), [](double v) { return std::isnan(v); })) {
+        return {{}, {CalcErr::DomainError}};
+    }
     
-    std::sort(data.begin(), data.end());
-    size_t n = data.size();
+    Vector out(probabilities.size());
+    Selection::QuantilesInPlace(buffer.data(), buffer.size(), probabilities.data(), probabilities.size(), out.data());
+    return EngineSuccessResult(out);
+}
+
+EngineResult StatisticsEngine::Quantiles(const Vector& data, const Vector& probabilities) {
+    if (data.size() < Selection::kParallelSelectThreshold || AXIOM::ThreadPool::Global().Size() <= 1) {
+        Vector scratch = data;
+        return QuantilesInPlace(scratch, probabilities);
+    }
     
-    if (n % 2 == 0) {
-        return {EngineSuccessResult((data[n/2-1] + data[n/2]) / 2.0), {}};
-    } else {
-        return {EngineSuccessResult(data[n/2]), {}};
+    // Large inputs: parallel bracketed selection reads the data without copying it
+    if (data.empty() || probabilities.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+    for (double p : probabilities) {
+        if (!(p >= 0.0 && p <= 1.0)) return {{}, {CalcErr::ArgumentMismatch}};
     }
+    bool has_nan = AXIOM::Parallel::ParallelReduce(size_t{0}, data.size(), 0, false,
+        [&data](size_t lo, size_t hi) {
+            return std::any_of(data.begin() + lo, data.begin() + hi, [](double v) { return std::isnan(v); });
+        },
+        [](bool a, bool b) { return a || b; });
+    if (has_nan) return {{}, {CalcErr::DomainError}};
+    
+    Vector out(probabilities.size());
+    Selection::ParallelQuantiles(data.data(), data.size(), probabilities.data(), probabilities.size(), out.data());
+    return EngineSuccessResult(out);
 }
 
 EngineResult StatisticsEngine::Mode(const Vector& data) {
     if (data.empty()) return {{}, {CalcErr::ArgumentMismatch}};
     
-    std::unordered_map<double, int> frequency;
-    for (double val : data) {
-        frequency[val]++;
-    }
+    Vector modes = Frequency::Count(data.data(), data.size()).Modes();
+    if (modes.empty()) return {{}, {CalcErr::DomainError}};
+    if (modes.size() == 1) return EngineSuccessResult(modes[0]);
+    return EngineSuccessResult(modes);
+}
+
+EngineResult StatisticsEngine::ValueCounts(const Vector& data) {
+    if (data.empty()) return {{}, {CalcErr::ArgumentMismatch}};
     
-    double mode_val = data[0];
-    int max_count = 0;
-    for (const auto& [val, count] : frequency) {
-        if (count > max_count) {
-            max_count = count;
-            mode_val = val;
-        }
+    auto table = Frequency::Count(data.data(), data.size());
+    Matrix rows;
+    rows.reserve(table.Size());
+    for (size_t i : table.ByCount()) rows.push_back({table.values[i], static_cast<double>(table.counts[i])});
+    return EngineSuccessResult(rows);
+}
+
+EngineResult StatisticsEngine::CrossTabulate(const Vector& x, const Vector& y) {
+    if (x.empty() || x.size() != y.size()) return {{}, {CalcErr::ArgumentMismatch}};
+    
+    auto table = Frequency::CrossTabulate(x.data(), y.data(), x.size());
+    if (!table || table->Rows() == 0) return {{}, {CalcErr::DomainError}};
+    Matrix counts(table->Rows(), Vector(table->Columns()));
+    for (size_t r = 0; r < table->Rows(); ++r) {
+        for (size_t c = 0; c < table->Columns(); ++c) counts[r][c] = static_cast<double>(table->At(r, c));
     }
-    
-    return {EngineSuccessResult(mode_val), {}};
+    return EngineSuccessResult(counts);
 }
 
 EngineResult StatisticsEngine::Variance(const Vector& data) {
     if (data.size() < 2) return {{}, {CalcErr::ArgumentMismatch}};
     
-    auto mean_result = Mean(data);
-    if (!mean_result.result.has_value()) return mean_result;
-    
-    double mean_val = std::get<double>(*mean_result.result);
-    double sum_sq_diff = 0.0;
+    auto acc = Accumulate(data);
+    if (!acc.IsFinite()) return {{}, {CalcErr::DomainError}};
+    return EngineSuccessResult(acc.Variance());
+}
+
+EngineResult StatisticsEngine::StandardDeviation(const Vector& data) {
+    if (data.size() < 2) return {{}, {CalcErr::ArgumentMismatch}};
     
-    for (double val : data) {
-        double diff = val - mean_val;
-        sum_sq_diff += diff * diff;
-    }
+    auto acc = Accumulate(data);
+    if (!acc.IsFinite()) return {{}, {CalcErr::DomainError}};
+    return EngineSuccessResult(acc.StandardDeviation());
+}
+
+EngineResult StatisticsEngine::Skewness(const Vector& data) {
+    if (data.size() < 3) return {{}, {CalcErr::ArgumentMismatch}};
     
-    return {EngineSuccessResult(sum_sq_diff / (data.size() - 1)), {}};
+    auto acc = Accumulate(data);
+    if (!acc.IsFinite()) return {{}, {CalcErr::DomainError}};
+    if (acc.m2 == 0.0) return {{}, {CalcErr::DivideByZero}};
+    return EngineSuccessResult(acc.Skewness());
 }
 
-EngineResult StatisticsEngine::StandardDeviation(const Vector& data) {
-    auto var_result = Variance(data);
-    if (!var_result.result.has_value()) return var_result;
+EngineResult StatisticsEngine::Kurtosis(const Vector& data) {
+    if (data.size() < 4) return {{}, {CalcErr::ArgumentMismatch}};
     
-    double variance = std::get<double>(*var_result.result);
-    return {EngineSuccessResult(std::sqrt(variance)), {}};
+    auto acc = Accumulate(data);
+    if (!acc.IsFinite()) return {{}, {CalcErr::DomainError}};
+    if (acc.m2 == 0.0) return {{}, {CalcErr::DivideByZero}};
+    return EngineSuccessResult(acc.Kurtosis());
 }
 
 EngineResult StatisticsEngine::Correlation(const Vector& x, const Vector& y) {
@@ -76,29 +161,13 @@ EngineResult StatisticsEngine::Correlation(const Vector& x, const Vector& y) {
         return {{}, {CalcErr::ArgumentMismatch}};
     }
     
-    auto x_mean_result = Mean(x);
-    auto y_mean_result = Mean(y);
-    if (!x_mean_result.result.has_value() || !y_mean_result.result.has_value()) {
+    auto acc = AccumulatePairs(x, y);
+    if (!std::isfinite(acc.cxy) || !std::isfinite(acc.m2x) || !std::isfinite(acc.m2y)) {
         return {{}, {CalcErr::DomainError}};
     }
+    if (acc.m2x == 0.0 || acc.m2y == 0.0) return {{}, {CalcErr::DivideByZero}};
     
-    double x_mean = std::get<double>(*x_mean_result.result);
-    double y_mean = std::get<double>(*y_mean_result.result);
-    
-    double numerator = 0.0, sum_x_sq = 0.0, sum_y_sq = 0.0;
-    
-    for (size_t i = 0; i < x.size(); ++i) {
-        double x_diff = x[i] - x_mean;
-        double y_diff = y[i] - y_mean;
-        numerator += x_diff * y_diff;
-        sum_x_sq += x_diff * x_diff;
-        sum_y_sq += y_diff * y_diff;
-    }
-    
-    double denominator = std::sqrt(sum_x_sq * sum_y_sq);
-    if (denominator == 0.0) return {{}, {CalcErr::DivideByZero}};
-    
-    return {EngineSuccessResult(numerator / denominator), {}};
+    return EngineSuccessResult(acc.Correlation());
 }
 
 EngineResult StatisticsEngine::LinearRegression(const Vector& x, const Vector& y) {
@@ -106,71 +175,298 @@ EngineResult StatisticsEngine::LinearRegression(const Vector& x, const Vector& y
         return {{}, {CalcErr::ArgumentMismatch}};
     }
     
-    auto x_mean_result = Mean(x);
-    auto y_mean_result = Mean(y);
-    if (!x_mean_result.result.has_value() || !y_mean_result.result.has_value()) {
+    auto acc = AccumulatePairs(x, y);
+    if (!std::isfinite(acc.cxy) || !std::isfinite(acc.m2x)) {
         return {{}, {CalcErr::DomainError}};
     }
-    
-    double x_mean = std::get<double>(*x_mean_result.result);
-    double y_mean = std::get<double>(*y_mean_result.result);
-    
-    double numerator = 0.0, denominator = 0.0;
-    
-    for (size_t i = 0; i < x.size(); ++i) {
-        double x_diff = x[i] - x_mean;
-        numerator += x_diff * (y[i] - y_mean);
-        denominator += x_diff * x_diff;
-    }
-    
-    if (denominator == 0.0) return {{}, {CalcErr::DivideByZero}};
-    
-    double slope = numerator / denominator;
-    double intercept = y_mean - slope * x_mean;
+    if (acc.m2x == 0.0) return {{}, {CalcErr::DivideByZero}};
     
     // Return [slope, intercept]
-    return {EngineSuccessResult(Vector{slope, intercept}), {}};
+    return EngineSuccessResult(Vector{acc.Slope(), acc.Intercept()});
 }
 
-EngineResult StatisticsEngine::Percentile(Vector data, double p) {
+EngineResult StatisticsEngine::RSquared(const Vector& x, const Vector& y) {
+    auto r = Correlation(x, y);
+    if (!r.HasResult()) return r;
+    
+    double value = *r.GetDouble();
+    return EngineSuccessResult(value * value);
+}
+
+EngineResult StatisticsEngine::Percentile(const Vector& data, double p) {
     if (data.empty() || p < 0 || p > 100) {
         return {{}, {CalcErr::ArgumentMismatch}};
     }
     
-    std::sort(data.begin(), data.end());
-    
-    if (p == 0) return {EngineSuccessResult(data[0]), {}};
-    if (p == 100) return {EngineSuccessResult(data.back()), {}};
-    
-    double index = (p / 100.0) * (data.size() - 1);
-    size_t lower = static_cast<size_t>(index);
-    size_t upper = lower + 1;
+    auto q = Quantiles(data, Vector{p / 100.0});
+    if (!q.HasResult()) return q;
+    return EngineSuccessResult(std::get<Vector>(*q.result)[0]);
+}
+
+EngineResult StatisticsEngine::Quartiles(const Vector& data) {
+    // [Q1, Q2, Q3] from a single multi-select pass
+    return Quantiles(data, Vector{0.25, 0.5, 0.75});
+}
+
+EngineResult StatisticsEngine::InterquartileRange(const Vector& data) {
+    auto q = Quantiles(data, Vector{0.25, 0.75});
+    if (!q.HasResult()) return q;
+    const auto& values = std::get<Vector>(*q.result);
+    return EngineSuccessResult(values[1] - values[0]);
+}
+
+namespace {
+
+EngineResult CountsResult(const std::optional<Histogram>& hist) {
+    if (!hist) return {{}, {CalcErr::DomainError}};
+    return EngineSuccessResult(Vector(hist->counts.begin(), hist->counts.end()));
+}
+
+} // namespace
+
+EngineResult StatisticsEngine::HistogramCounts(const Vector& data, int bins) {
+    if (data.empty() || bins <= 0) return {{}, {CalcErr::ArgumentMismatch}};
+    return CountsResult(Binning::Uniform(data.data(), data.size(), static_cast<size_t>(bins)));
+}
+
+EngineResult StatisticsEngine::HistogramCounts(const Vector& data, const Vector& edges) {
+    if (data.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+    return CountsResult(Binning::Edges(data.data(), data.size(), edges));
+}
+
+namespace {
+
+using BatchFn = void (*)(const Distributions::Distribution&, const double*, double*, size_t);
+
+EngineResult Evaluate(const Distributions::Distribution& dist, const Vector& input, BatchFn fn) {
+    if (!dist.Valid()) return {{}, {CalcErr::DomainError}};
+    Vector result(input.size());
+    fn(dist, input.data(), result.data(), input.size());
+    return EngineSuccessResult(result);
+}
+
+EngineResult EvaluateOne(const Distributions::Distribution& dist, double x, BatchFn fn) {
+    auto r = Evaluate(dist, Vector{x}, fn);
+    if (!r.HasResult()) return r;
+    return EngineSuccessResult(std::get<Vector>(*r.result)[0]);
+}
+
+} // namespace
+
+EngineResult StatisticsEngine::NormalPDF(double x, double mean, double stddev) {
+    return EvaluateOne(Distributions::Distribution::Normal(mean, stddev), x, Distributions::PDF);
+}
+
+EngineResult StatisticsEngine::NormalCDF(double x, double mean, double stddev) {
+    return EvaluateOne(Distributions::Distribution::Normal(mean, stddev), x, Distributions::CDF);
+}
+
+EngineResult StatisticsEngine::TDistributionPDF(double x, double degrees_freedom) {
+    return EvaluateOne(Distributions::Distribution::StudentT(degrees_freedom), x, Distributions::PDF);
+}
+
+EngineResult StatisticsEngine::ChiSquaredPDF(double x, double degrees_freedom) {
+    return EvaluateOne(Distributions::Distribution::ChiSquared(degrees_freedom), x, Distributions::PDF);
+}
+
+EngineResult StatisticsEngine::DistributionPDF(const Distributions::Distribution& dist, const Vector& x) {
+    return Evaluate(dist, x, Distributions::PDF);
+}
+
+EngineResult StatisticsEngine::DistributionCDF(const Distributions::Distribution& dist, const Vector& x) {
+    return Evaluate(dist, x, Distributions::CDF);
+}
+
+EngineResult StatisticsEngine::DistributionQuantile(const Distributions::Distribution& dist, const Vector& p) {
+    return Evaluate(dist, p, Distributions::Quantile);
+}
+
+namespace {
+
+bool AllFinite(const Vector& data) {
+    return std::all_of(data.begin(), data.end(), [](double v) { return std::isfinite(v); });
+}
+
+EngineResult IntervalResult(const std::optional<Resampling::BootstrapResult>& r) {
+    if (!r) return {{}, {CalcErr::ArgumentMismatch}};
+    if (!std::isfinite(r->lower) || !std::isfinite(r->upper)) return {{}, {CalcErr::DomainError}};
+    return EngineSuccessResult(Vector{r->estimate, r->lower, r->upper, r->standard_error});
+}
+
+} // namespace
+
+EngineResult StatisticsEngine::TTest(const Vector& sample1, const Vector& sample2) {
+    if (sample1.size() < 2 || sample2.size() < 2) return {{}, {CalcErr::ArgumentMismatch}};
+    auto a = Accumulate(sample1), b = Accumulate(sample2);
+    if (!a.IsFinite() || !b.IsFinite()) return {{}, {CalcErr::DomainError}};
+
+    double t = Resampling::WelchT(a, b);
+    double df = Resampling::WelchDegreesOfFreedom(a, b);
+    if (!std::isfinite(t) || !std::isfinite(df)) return {{}, {CalcErr::DomainError}};
+    // Two-sided tail of Student's t: I_{df / (df + t^2)}(df / 2, 1 / 2)
+    double p = Distributions::BetaI(df / 2.0, 0.5, df / (df + t * t));
+    return EngineSuccessResult(Vector{t, df, p});
+}
+
+EngineResult StatisticsEngine::ChiSquaredTest(const Matrix& observed, const Matrix& expected) {
+    const size_t rows = observed.size();
+    const size_t columns = rows ? observed[0].size() : 0;
+    if (rows == 0 || columns == 0) return {{}, {CalcErr::ArgumentMismatch}};
+    for (const auto& row : observed) {
+        if (row.size() != columns) return {{}, {CalcErr::ArgumentMismatch}};
+        for (double o : row) {
+            if (!(o >= 0.0) || !std::isfinite(o)) return {{}, {CalcErr::DomainError}};
+        }
+    }
     
-    if (upper >= data.size()) {
-        return {EngineSuccessResult(data.back()), {}};
+    const bool independence = expected.empty();
+    if (!independence && (expected.size() != rows ||
+                          std::any_of(expected.begin(), expected.end(), [&](const Vector& r) { return r.size() != columns; }))) {
+        return {{}, {CalcErr::ArgumentMismatch}};
+    }
+    if (independence && (rows < 2 || columns < 2)) return {{}, {CalcErr::ArgumentMismatch}};
+    
+    // Margins for the independence expectation E_rc = R_r C_c / N
+    Vector row_sums(rows, 0.0), column_sums(columns, 0.0);
+    double total = 0.0;
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < columns; ++c) {
+            row_sums[r] += observed[r][c];
+            column_sums[c] += observed[r][c];
+        }
+        total += row_sums[r];
     }
     
-    double weight = index - lower;
-    double result = data[lower] * (1.0 - weight) + data[upper] * weight;
+    double statistic = 0.0;
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < columns; ++c) {
+            double e = independence ? row_sums[r] * column_sums[c] / total : expected[r][c];
+            if (!(e > 0.0) || !std::isfinite(e)) return {{}, {CalcErr::DomainError}};
+            double d = observed[r][c] - e;
+            statistic += d * d / e;
+        }
+    }
     
-    return {EngineSuccessResult(result), {}};
+    double df = independence ? static_cast<double>((rows - 1) * (columns - 1))
+                             : static_cast<double>(rows * columns - 1);
+    if (df < 1.0) return {{}, {CalcErr::ArgumentMismatch}};
+    return EngineSuccessResult(Vector{statistic, df, Distributions::GammaQ(df / 2.0, statistic / 2.0)});
 }
 
-EngineResult StatisticsEngine::MovingAverage(const Vector& data, int window_size) {
-    if (data.empty() || window_size <= 0 || window_size > static_cast<int>(data.size())) {
+EngineResult StatisticsEngine::ChiSquaredTest(const Vector& x, const Vector& y) {
+    auto table = CrossTabulate(x, y);
+    if (!table.HasResult()) return table;
+    return ChiSquaredTest(std::get<Matrix>(*table.result), Matrix{});
+}
+
+EngineResult StatisticsEngine::ANOVAOneWay(const std::vector<Vector>& groups) {
+    if (groups.size() < 2) return {{}, {CalcErr::ArgumentMismatch}};
+    std::vector<MomentAccumulator> moments;
+    uint64_t total = 0;
+    for (const auto& g : groups) {
+        if (g.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+        moments.push_back(Accumulate(g));
+        if (!moments.back().IsFinite()) return {{}, {CalcErr::DomainError}};
+        total += g.size();
+    }
+    if (total <= groups.size()) return {{}, {CalcErr::ArgumentMismatch}};
+
+    double f = Resampling::FStatistic(moments.data(), moments.size());
+    double df1 = static_cast<double>(groups.size() - 1);
+    double df2 = static_cast<double>(total - groups.size());
+    if (!std::isfinite(f)) return {{}, {CalcErr::DomainError}};
+    // Upper tail of F(df1, df2): I_{df2 / (df2 + df1 F)}(df2 / 2, df1 / 2)
+    double p = Distributions::BetaI(df2 / 2.0, df1 / 2.0, df2 / (df2 + df1 * f));
+    return EngineSuccessResult(Vector{f, df1, df2, p});
+}
+
+EngineResult StatisticsEngine::BootstrapCI(const Vector& data, Resampling::Statistic stat,
+                                           const Resampling::BootstrapOptions& options) {
+    if (!AllFinite(data)) return {{}, {CalcErr::DomainError}};
+    return IntervalResult(Resampling::Bootstrap(data.data(), data.size(), stat, options));
+}
+
+EngineResult StatisticsEngine::BootstrapCI(const Vector& data, const Resampling::StatisticFn& stat,
+                                           const Resampling::BootstrapOptions& options) {
+    if (!AllFinite(data)) return {{}, {CalcErr::DomainError}};
+    return IntervalResult(Resampling::Bootstrap(data.data(), data.size(), stat, options));
+}
+
+EngineResult StatisticsEngine::BootstrapCI(const Vector& x, const Vector& y, Resampling::PairStatistic stat,
+                                           const Resampling::BootstrapOptions& options) {
+    if (x.size() != y.size()) return {{}, {CalcErr::ArgumentMismatch}};
+    if (!AllFinite(x) || !AllFinite(y)) return {{}, {CalcErr::DomainError}};
+    return IntervalResult(Resampling::BootstrapPaired(x.data(), y.data(), x.size(), stat, options));
+}
+
+EngineResult StatisticsEngine::PermutationTest(const std::vector<Vector>& groups, Resampling::TestStatistic stat,
+                                               const Resampling::PermutationOptions& options) {
+    std::vector<const Vector*> refs;
+    for (const auto& g : groups) {
+        if (!AllFinite(g)) return {{}, {CalcErr::DomainError}};
+        refs.push_back(&g);
+    }
+    auto r = Resampling::PermutationTest(refs, stat, options);
+    if (!r) return {{}, {CalcErr::ArgumentMismatch}};
+    return EngineSuccessResult(Vector{r->observed, r->p_value});
+}
+
+namespace {
+
+using WindowFn = void (*)(const double*, size_t, size_t, double*);
+using SmoothingFn = void (*)(const double*, size_t, double, double*);
+
+EngineResult RollingSeries(const Vector& data, int window_size, int min_window, WindowFn fn) {
+    if (data.empty() || window_size < min_window || window_size > static_cast<int>(data.size())) {
         return {{}, {CalcErr::ArgumentMismatch}};
     }
-    
-    Vector result;
-    result.reserve(data.size() - window_size + 1);
-    
-    for (size_t i = 0; i <= data.size() - window_size; ++i) {
-        double sum = 0.0;
-        for (int j = 0; j < window_size; ++j) {
-            sum += data[i + j];
-        }
-        result.push_back(sum / window_size);
+    if (std::any_of(data.begin(), data.end(), [](double v) { return std::isnan(v); })) {
+        return {{}, {CalcErr::DomainError}};
     }
-    
-    return {EngineSuccessResult(result), {}};
+
+    Vector result(data.size() - window_size + 1);
+    fn(data.data(), data.size(), static_cast<size_t>(window_size), result.data());
+    return EngineSuccessResult(result);
+}
+
+EngineResult SmoothedSeries(const Vector& data, double alpha, SmoothingFn fn) {
+    if (data.empty() || !(alpha > 0.0 && alpha <= 1.0)) return {{}, {CalcErr::ArgumentMismatch}};
+
+    Vector result(data.size());
+    fn(data.data(), data.size(), alpha, result.data());
+    return EngineSuccessResult(result);
+}
+
+} // namespace
+
+EngineResult StatisticsEngine::MovingAverage(const Vector& data, int window_size) {
+    return RollingSeries(data, window_size, 1, Rolling::Mean);
+}
+
+EngineResult StatisticsEngine::RollingVariance(const Vector& data, int window_size) {
+    return RollingSeries(data, window_size, 2, Rolling::Variance);
+}
+
+EngineResult StatisticsEngine::RollingStdDev(const Vector& data, int window_size) {
+    return RollingSeries(data, window_size, 2, Rolling::StdDev);
+}
+
+EngineResult StatisticsEngine::RollingMin(const Vector& data, int window_size) {
+    return RollingSeries(data, window_size, 1, Rolling::Min);
+}
+
+EngineResult StatisticsEngine::RollingMax(const Vector& data, int window_size) {
+    return RollingSeries(data, window_size, 1, Rolling::Max);
+}
+
+EngineResult StatisticsEngine::RollingMedian(const Vector& data, int window_size) {
+    return RollingSeries(data, window_size, 1, Rolling::Median);
+}
+
+EngineResult StatisticsEngine::ExponentialSmoothing(const Vector& data, double alpha) {
+    return SmoothedSeries(data, alpha, Rolling::EWMAMean);
+}
+
+EngineResult StatisticsEngine::EWMAVariance(const Vector& data, double alpha) {
+    return SmoothedSeries(data, alpha, Rolling::EWMAVariance);
 }
\ No newline at end of file
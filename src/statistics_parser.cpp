@@ -0,0 +1,577 @@
+/**
+ * @file statistics_parser.cpp
+ * @brief Statistics mode command dispatch over DataLoader tables
+ */
+
+#include "statistics_parser.h"
+#include "binning.h"
+#include "compensated_sum.h"
+#include "linear_model.h"
+#include "quantile_select.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// Whitespace / comma separated; [..] lists and "quoted paths" stay whole
+std::vector<std::string> Tokenize(const std::string& input) {
+    std::vector<std::string> tokens;
+    std::string current;
+    int depth = 0;
+    bool quoted = false;
+    auto flush = [&] {
+        if (!current.empty()) tokens.push_back(std::move(current));
+        current.clear();
+    };
+    for (char c : input) {
+        if (quoted) {
+            if (c == '"') {
+                quoted = false;
+                flush();
+            } else {
+                current += c;
+            }
+        } else if (c == '"' && depth == 0) {
+            flush();
+            quoted = true;
+        } else if (c == '[') {
+            ++depth;
+            current += c;
+        } else if (c == ']') {
+            depth = std::max(0, depth - 1);
+            current += c;
+        } else if (depth == 0 && (std::isspace(static_cast<unsigned char>(c)) || c == ',')) {
+            flush();
+        } else {
+            current += c;
+        }
+    }
+    flush();
+    return tokens;
+}
+
+std::optional<double> ParseNumber(const std::string& text) {
+    const char* first = text.data();
+    const char* last = first + text.size();
+    if (first != last && *first == '+') ++first;
+    double value;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (first == last || ec != std::errc() || ptr != last) return std::nullopt;
+    return value;
+}
+
+// A whole number in [1, max]; checked before any narrowing cast, which is
+// undefined for NaN or out-of-range doubles
+std::optional<size_t> ParseCount(const std::string& text, size_t max) {
+    auto value = ParseNumber(text);
+    if (!value || !(*value >= 1.0 && *value <= static_cast<double>(max)) || *value != std::floor(*value)) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(*value);
+}
+
+std::optional<Vector> ParseList(const std::string& token) {
+    Vector values;
+    std::string inner = token.substr(1, token.size() - 2);
+    std::replace(inner.begin(), inner.end(), ',', ' ');
+    std::istringstream in(inner);
+    std::string item;
+    while (in >> item) {
+        auto value = ParseNumber(item);
+        if (!value) return std::nullopt;
+        values.push_back(*value);
+    }
+    return values;
+}
+
+std::string ToLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+std::string TrimCopy(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t");
+    if (start == std::string::npos) return "";
+    return s.substr(start, s.find_last_not_of(" \t") - start + 1);
+}
+
+std::string JoinNames(const DataTable& table) {
+    std::string out;
+    for (size_t c = 0; c < table.names.size(); ++c) {
+        if (c) out += ", ";
+        out += table.names[c];
+    }
+    return out;
+}
+
+} // namespace
+
+EngineResult StatisticsParser::ParseAndExecute(const std::string& input) {
+    size_t tilde = input.find('~');
+    if (tilde != std::string::npos) {
+        size_t op = ToLower(input).find("regress");
+        if (op == std::string::npos || op > tilde) return {{}, {CalcErr::ParseError}};
+        return Regress(input.substr(op + 7));
+    }
+
+    auto tokens = Tokenize(input);
+    if (!tokens.empty() && ToLower(tokens.front()) == "stats") tokens.erase(tokens.begin());
+    if (tokens.empty()) return {{}, {CalcErr::ParseError}};
+
+    std::string op = ToLower(tokens.front());
+    std::vector<std::string> args(tokens.begin() + 1, tokens.end());
+
+    if (op == "load") return Load(args);
+    if (op == "columns" || op == "tables") return ListColumns(op == "tables" ? std::vector<std::string>{"*"} : args);
+    if (op == "hist") return BuildHistogram(args);
+    if (op == "hist2") return BuildHistogram2D(args);
+    if (op == "pdf" || op == "pmf" || op == "cdf" || op == "invcdf") return EvaluateDistribution(op, args);
+    if (op == "bootstrap") return Bootstrap(args);
+    if (op == "ttest" || op == "anova" || op == "permtest") return CompareGroups(op, args);
+    return Execute(op, args);
+}
+
+const DataTable* StatisticsParser::GetTable(const std::string& name) const {
+    auto it = tables_.find(name);
+    return it != tables_.end() ? &it->second : nullptr;
+}
+
+EngineResult StatisticsParser::Load(const std::vector<std::string>& args) {
+    if (args.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+    std::string name = std::filesystem::path(args[0]).stem().string();
+    if (args.size() == 3 && ToLower(args[1]) == "as") {
+        name = args[2];
+    } else if (args.size() != 1) {
+        return {{}, {CalcErr::ArgumentMismatch}};
+    }
+
+    std::string error;
+    auto table = DataLoader::Load(args[0], error);
+    if (!table) return {{}, {CalcErr::DomainError}};
+
+    std::ostringstream summary;
+    summary << name << ": " << table->rows << " rows, " << table->names.size() << " columns ("
+            << JoinNames(*table) << ")" << (table->from_cache ? " [cached]" : "");
+    tables_[name] = std::move(*table);
+    current_table_ = name;
+    return EngineSuccessResult(summary.str());
+}
+
+EngineResult StatisticsParser::ListColumns(const std::vector<std::string>& args) const {
+    if (!args.empty() && args[0] == "*") {
+        std::string out;
+        for (const auto& [name, table] : tables_) {
+            if (!out.empty()) out += "\n";
+            out += name + ": " + std::to_string(table.rows) + " rows";
+        }
+        return EngineSuccessResult(out);
+    }
+    const DataTable* table = GetTable(args.empty() ? current_table_ : args[0]);
+    if (!table) return {{}, {CalcErr::ArgumentMismatch}};
+    return EngineSuccessResult(JoinNames(*table));
+}
+
+const Vector* StatisticsParser::FindColumn(const std::string& ref) const {
+    if (const DataTable* current = GetTable(current_table_)) {
+        if (const Vector* column = current->Column(ref)) return column;
+    }
+    size_t dot = ref.find('.');
+    if (dot != std::string::npos) {
+        if (const DataTable* table = GetTable(ref.substr(0, dot))) {
+            if (const Vector* column = table->Column(ref.substr(dot + 1))) return column;
+        }
+    }
+    for (const auto& [name, table] : tables_) {
+        if (const Vector* column = table.Column(ref)) return column;
+    }
+    return nullptr;
+}
+
+std::optional<Vector> StatisticsParser::ResolveVector(const std::string& ref) const {
+    if (ref.size() >= 2 && ref.front() == '[' && ref.back() == ']') return ParseList(ref);
+    const Vector* column = FindColumn(ref);
+    if (!column) return std::nullopt;
+    Vector values;
+    values.reserve(column->size());
+    std::copy_if(column->begin(), column->end(), std::back_inserter(values),
+                 [](double v) { return !std::isnan(v); });
+    return values;
+}
+
+bool StatisticsParser::ResolvePair(const std::string& a, const std::string& b, Vector& x, Vector& y) const {
+    auto literal = [](const std::string& ref) { return !ref.empty() && ref.front() == '['; };
+    if (literal(a) || literal(b)) {
+        auto vx = ResolveVector(a);
+        auto vy = ResolveVector(b);
+        if (!vx || !vy) return false;
+        x = std::move(*vx);
+        y = std::move(*vy);
+        return true;
+    }
+    const Vector* cx = FindColumn(a);
+    const Vector* cy = FindColumn(b);
+    if (!cx || !cy || cx->size() != cy->size()) return false;
+    x.clear();
+    y.clear();
+    for (size_t i = 0; i < cx->size(); ++i) {
+        if (std::isnan((*cx)[i]) || std::isnan((*cy)[i])) continue;
+        x.push_back((*cx)[i]);
+        y.push_back((*cy)[i]);
+    }
+    return true;
+}
+
+EngineResult StatisticsParser::Execute(const std::string& op, const std::vector<std::string>& args) {
+    using Unary = EngineResult (StatisticsEngine::*)(const Vector&);
+    using Windowed = EngineResult (StatisticsEngine::*)(const Vector&, int);
+    using Binary = EngineResult (StatisticsEngine::*)(const Vector&, const Vector&);
+
+    static const std::map<std::string, Unary> unary = {
+        {"mean", &StatisticsEngine::Mean},
+        {"median", &StatisticsEngine::Median},
+        {"mode", &StatisticsEngine::Mode},
+        {"var", &StatisticsEngine::Variance},
+        {"variance", &StatisticsEngine::Variance},
+        {"std", &StatisticsEngine::StandardDeviation},
+        {"stddev", &StatisticsEngine::StandardDeviation},
+        {"skew", &StatisticsEngine::Skewness},
+        {"skewness", &StatisticsEngine::Skewness},
+        {"kurt", &StatisticsEngine::Kurtosis},
+        {"kurtosis", &StatisticsEngine::Kurtosis},
+        {"describe", &StatisticsEngine::Describe},
+        {"quartiles", &StatisticsEngine::Quartiles},
+        {"iqr", &StatisticsEngine::InterquartileRange},
+        {"value_counts", &StatisticsEngine::ValueCounts},
+    };
+    static const std::map<std::string, Windowed> windowed = {
+        {"movavg", &StatisticsEngine::MovingAverage},
+        {"rollvar", &StatisticsEngine::RollingVariance},
+        {"rollstd", &StatisticsEngine::RollingStdDev},
+        {"rollmin", &StatisticsEngine::RollingMin},
+        {"rollmax", &StatisticsEngine::RollingMax},
+        {"rollmedian", &StatisticsEngine::RollingMedian},
+    };
+    static const std::map<std::string, Binary> binary = {
+        {"corr", &StatisticsEngine::Correlation},
+        {"regress", &StatisticsEngine::LinearRegression},
+        {"r2", &StatisticsEngine::RSquared},
+        {"crosstab", &StatisticsEngine::CrossTabulate},
+        {"chi2test", &StatisticsEngine::ChiSquaredTest},
+    };
+
+    if (auto it = unary.find(op); it != unary.end()) {
+        if (args.size() != 1) return {{}, {CalcErr::ArgumentMismatch}};
+        auto data = ResolveVector(args[0]);
+        if (!data) return {{}, {CalcErr::ArgumentMismatch}};
+        return (engine_->*it->second)(*data);
+    }
+
+    if (auto it = binary.find(op); it != binary.end()) {
+        Vector x, y;
+        if (args.size() != 2 || !ResolvePair(args[0], args[1], x, y)) return {{}, {CalcErr::ArgumentMismatch}};
+        return (engine_->*it->second)(x, y);
+    }
+
+    if (op == "min" || op == "max" || op == "sum" || op == "count") {
+        if (args.size() != 1) return {{}, {CalcErr::ArgumentMismatch}};
+        auto data = ResolveVector(args[0]);
+        if (!data) return {{}, {CalcErr::ArgumentMismatch}};
+        if (op == "count") return EngineSuccessResult(static_cast<double>(data->size()));
+        if (op == "sum") return EngineSuccessResult(Reduction::Sum(data->data(), data->size()));
+        if (data->empty()) return {{}, {CalcErr::ArgumentMismatch}};
+        auto [lo, hi] = std::minmax_element(data->begin(), data->end());
+        return EngineSuccessResult(op == "min" ? *lo : *hi);
+    }
+
+    // OP ARG NUMBER...
+    if (args.size() < 2) return {{}, {CalcErr::ArgumentMismatch}};
+    auto data = ResolveVector(args[0]);
+    if (!data) return {{}, {CalcErr::ArgumentMismatch}};
+    Vector numbers;
+    for (size_t i = 1; i < args.size(); ++i) {
+        auto value = ParseNumber(args[i]);
+        if (!value) return {{}, {CalcErr::ParseError}};
+        numbers.push_back(*value);
+    }
+
+    if (op == "percentile" && numbers.size() == 1) return engine_->Percentile(*data, numbers[0]);
+    if (op == "quantile" || op == "quantiles") return engine_->Quantiles(*data, numbers);
+    if (op == "ewma" && numbers.size() == 1) return engine_->ExponentialSmoothing(*data, numbers[0]);
+    if (op == "ewmvar" && numbers.size() == 1) return engine_->EWMAVariance(*data, numbers[0]);
+    if (auto it = windowed.find(op); it != windowed.end() && numbers.size() == 1) {
+        // Checked before the narrowing cast: NaN or out-of-range doubles make it undefined
+        double window = numbers[0];
+        if (!(window >= 1.0 && window <= static_cast<double>(std::min<size_t>(data->size(), INT_MAX))) ||
+            window != std::floor(window)) {
+            return {{}, {CalcErr::ArgumentMismatch}};
+        }
+        return (engine_->*it->second)(*data, static_cast<int>(window));
+    }
+    return {{}, {CalcErr::OperationNotFound}};
+}
+
+EngineResult StatisticsParser::BuildHistogram(const std::vector<std::string>& args) const {
+    constexpr size_t kDefaultBins = 10;
+    if (args.empty() || args.size() > 2) return {{}, {CalcErr::ArgumentMismatch}};
+    auto data = ResolveVector(args[0]);
+    if (!data) return {{}, {CalcErr::ArgumentMismatch}};
+
+    std::optional<Histogram> hist;
+    if (args.size() == 2 && args[1].front() == '[') {
+        auto edges = ParseList(args[1]);
+        if (!edges) return {{}, {CalcErr::ParseError}};
+        hist = Binning::Edges(data->data(), data->size(), *edges);
+    } else {
+        size_t bins = kDefaultBins;
+        if (args.size() == 2) {
+            auto count = ParseCount(args[1], Binning::kMaxBins);
+            if (!count) return {{}, {CalcErr::ArgumentMismatch}};
+            bins = *count;
+        }
+        hist = Binning::Uniform(data->data(), data->size(), bins);
+    }
+    if (!hist) return {{}, {CalcErr::DomainError}};
+
+    std::ostringstream out;
+    out << std::setprecision(6);
+    for (size_t i = 0; i < hist->Bins(); ++i) {
+        std::ostringstream label;
+        label << std::setprecision(6) << "[" << hist->edges[i] << ", " << hist->edges[i + 1]
+              << (i + 1 == hist->Bins() ? "]" : ")");
+        out << std::left << std::setw(28) << label.str() << std::right << std::setw(12) << hist->counts[i] << "\n";
+    }
+    out << "n = " << data->size();
+    if (hist->below + hist->above > 0) out << ", " << hist->below << " below, " << hist->above << " above the edges";
+    return EngineSuccessResult(out.str());
+}
+
+EngineResult StatisticsParser::BuildHistogram2D(const std::vector<std::string>& args) const {
+    constexpr size_t kDefaultBins = 10;
+    if (args.size() < 2 || args.size() > 4) return {{}, {CalcErr::ArgumentMismatch}};
+    Vector x, y;
+    if (!ResolvePair(args[0], args[1], x, y)) return {{}, {CalcErr::ArgumentMismatch}};
+
+    size_t bins[2] = {kDefaultBins, kDefaultBins};
+    for (size_t i = 2; i < args.size(); ++i) {
+        auto count = ParseCount(args[i], Binning::kMaxBins);
+        if (!count) return {{}, {CalcErr::ArgumentMismatch}};
+        bins[i - 2] = *count;
+    }
+    if (args.size() == 3) bins[1] = bins[0];
+
+    // Each axis spans its data, widened around a constant as in the 1-D case
+    auto span = [](const Vector& v) {
+        auto range = Binning::FiniteRange(v.data(), v.size()).value_or(std::pair<double, double>{0.0, 1.0});
+        if (range.first == range.second) range = {range.first - 0.5, range.second + 0.5};
+        return range;
+    };
+    auto [x_lo, x_hi] = span(x);
+    auto [y_lo, y_hi] = span(y);
+    auto hist = Binning::Uniform2D(x.data(), y.data(), x.size(), bins[0], x_lo, x_hi, bins[1], y_lo, y_hi);
+    if (!hist) return {{}, {CalcErr::DomainError}};
+
+    Matrix counts(hist->XBins(), Vector(hist->YBins()));
+    for (size_t ix = 0; ix < hist->XBins(); ++ix) {
+        for (size_t iy = 0; iy < hist->YBins(); ++iy) counts[ix][iy] = static_cast<double>(hist->At(ix, iy));
+    }
+    return EngineSuccessResult(counts);
+}
+
+EngineResult StatisticsParser::EvaluateDistribution(const std::string& op, const std::vector<std::string>& args) const {
+    using Distributions::Distribution;
+    struct Family {
+        Distribution::Kind kind;
+        size_t parameters;
+    };
+    static const std::map<std::string, Family> families = {
+        {"normal", {Distribution::Kind::Normal, 2}},
+        {"t", {Distribution::Kind::StudentT, 1}},
+        {"chi2", {Distribution::Kind::ChiSquared, 1}},
+        {"gamma", {Distribution::Kind::Gamma, 2}},
+        {"beta", {Distribution::Kind::Beta, 2}},
+        {"binomial", {Distribution::Kind::Binomial, 2}},
+    };
+
+    if (args.empty()) return {{}, {CalcErr::ArgumentMismatch}};
+    auto family = families.find(ToLower(args[0]));
+    if (family == families.end()) return {{}, {CalcErr::OperationNotFound}};
+    if (args.size() != family->second.parameters + 2) return {{}, {CalcErr::ArgumentMismatch}};
+
+    Distribution dist;
+    dist.kind = family->second.kind;
+    double* parameters[] = {&dist.a, &dist.b};
+    for (size_t i = 0; i < family->second.parameters; ++i) {
+        auto value = ParseNumber(args[i + 1]);
+        if (!value) return {{}, {CalcErr::ParseError}};
+        *parameters[i] = *value;
+    }
+
+    // A number gives a number; a list or column gives one value per element
+    const std::string& target = args.back();
+    auto scalar = ParseNumber(target);
+    auto points = scalar ? std::optional<Vector>(Vector{*scalar}) : ResolveVector(target);
+    if (!points) return {{}, {CalcErr::ArgumentMismatch}};
+
+    EngineResult r = op == "cdf"    ? engine_->DistributionCDF(dist, *points)
+                   : op == "invcdf" ? engine_->DistributionQuantile(dist, *points)
+                                    : engine_->DistributionPDF(dist, *points);
+    if (!scalar || !r.HasResult()) return r;
+    return EngineSuccessResult(std::get<Vector>(*r.result)[0]);
+}
+
+EngineResult StatisticsParser::Bootstrap(const std::vector<std::string>& args) const {
+    static const std::map<std::string, Resampling::Statistic> moments = {
+        {"mean", Resampling::Statistic::Mean},
+        {"var", Resampling::Statistic::Variance},
+        {"std", Resampling::Statistic::StdDev},
+        {"skew", Resampling::Statistic::Skewness},
+        {"kurt", Resampling::Statistic::Kurtosis},
+    };
+    static const std::map<std::string, Resampling::PairStatistic> pairs = {
+        {"corr", Resampling::PairStatistic::Correlation},
+        {"cov", Resampling::PairStatistic::Covariance},
+        {"slope", Resampling::PairStatistic::Slope},
+    };
+
+    if (args.size() < 2) return {{}, {CalcErr::ArgumentMismatch}};
+    std::string stat = ToLower(args[0]);
+    auto pair = pairs.find(stat);
+    size_t columns = pair != pairs.end() ? 2 : 1;
+    if (args.size() < 1 + columns || args.size() > 3 + columns) return {{}, {CalcErr::ArgumentMismatch}};
+
+    // Trailing resample count and confidence level
+    Resampling::BootstrapOptions options;
+    for (size_t i = 1 + columns; i < args.size(); ++i) {
+        auto value = ParseNumber(args[i]);
+        if (!value) return {{}, {CalcErr::ParseError}};
+        if (i == 1 + columns) {
+            auto count = ParseCount(args[i], Resampling::kMaxResamples);
+            if (!count) return {{}, {CalcErr::ArgumentMismatch}};
+            options.resamples = *count;
+        } else {
+            options.confidence = *value;
+        }
+    }
+
+    if (pair != pairs.end()) {
+        Vector x, y;
+        if (!ResolvePair(args[1], args[2], x, y)) return {{}, {CalcErr::ArgumentMismatch}};
+        return engine_->BootstrapCI(x, y, pair->second, options);
+    }
+    auto data = ResolveVector(args[1]);
+    if (!data) return {{}, {CalcErr::ArgumentMismatch}};
+    if (auto it = moments.find(stat); it != moments.end()) return engine_->BootstrapCI(*data, it->second, options);
+    if (stat == "median") {
+        auto median = [](double* sample, size_t n) {
+            const double half = 0.5;
+            double out;
+            Selection::QuantilesInPlace(sample, n, &half, 1, &out);
+            return out;
+        };
+        return engine_->BootstrapCI(*data, median, options);
+    }
+    return {{}, {CalcErr::OperationNotFound}};
+}
+
+EngineResult StatisticsParser::CompareGroups(const std::string& op, const std::vector<std::string>& args) const {
+    std::vector<std::string> refs = args;
+    Resampling::PermutationOptions options;
+    if (op == "permtest" && !refs.empty()) {
+        if (ParseNumber(refs.back())) {
+            auto count = ParseCount(refs.back(), Resampling::kMaxResamples);
+            if (!count) return {{}, {CalcErr::ArgumentMismatch}};
+            options.permutations = *count;
+            refs.pop_back();
+        }
+    }
+    if (refs.size() < 2 || (op == "ttest" && refs.size() != 2)) return {{}, {CalcErr::ArgumentMismatch}};
+
+    // Independent samples: each keeps all of its own non-missing values
+    std::vector<Vector> groups;
+    for (const auto& ref : refs) {
+        auto data = ResolveVector(ref);
+        if (!data) return {{}, {CalcErr::ArgumentMismatch}};
+        groups.push_back(std::move(*data));
+    }
+
+    if (op == "ttest") return engine_->TTest(groups[0], groups[1]);
+    if (op == "anova") return engine_->ANOVAOneWay(groups);
+    auto stat = groups.size() == 2 ? Resampling::TestStatistic::WelchT : Resampling::TestStatistic::FStatistic;
+    return engine_->PermutationTest(groups, stat, options);
+}
+
+EngineResult StatisticsParser::Regress(const std::string& formula) const {
+    // "(y ~ x1 + x2 - 1)" or "y ~ x1 + x2"
+    std::string body = TrimCopy(formula);
+    if (body.size() >= 2 && body.front() == '(' && body.back() == ')') body = body.substr(1, body.size() - 2);
+    size_t tilde = body.find('~');
+    std::string response = TrimCopy(body.substr(0, tilde));
+    if (response.empty()) return {{}, {CalcErr::ParseError}};
+
+    std::vector<std::string> terms;
+    bool intercept = true;
+    std::string rhs = body.substr(tilde + 1);
+    size_t pos = 0;
+    char sign = '+';
+    while (pos <= rhs.size()) {
+        size_t next = rhs.find_first_of("+-", pos);
+        std::string term = TrimCopy(rhs.substr(pos, next == std::string::npos ? std::string::npos : next - pos));
+        if (term == "0" || (term == "1" && sign == '-')) {
+            intercept = false;
+        } else if (sign == '-' || (term.empty() && next != std::string::npos)) {
+            return {{}, {CalcErr::ParseError}};
+        } else if (term != "1" && !term.empty()) {
+            terms.push_back(term);
+        }
+        if (next == std::string::npos) break;
+        sign = rhs[next];
+        pos = next + 1;
+    }
+    if (terms.empty() && !intercept) return {{}, {CalcErr::ParseError}};
+
+    // Rows where any referenced value is missing are dropped
+    std::vector<const Vector*> sources;
+    for (const auto& name : terms) sources.push_back(FindColumn(name));
+    sources.push_back(FindColumn(response));
+    for (const Vector* source : sources) {
+        if (!source || source->size() != sources.front()->size()) return {{}, {CalcErr::ArgumentMismatch}};
+    }
+
+    std::vector<Vector> columns(terms.size());
+    Vector y;
+    for (size_t i = 0; i < sources.front()->size(); ++i) {
+        bool complete = std::none_of(sources.begin(), sources.end(), [i](const Vector* v) { return std::isnan((*v)[i]); });
+        if (!complete) continue;
+        for (size_t t = 0; t < terms.size(); ++t) columns[t].push_back((*sources[t])[i]);
+        y.push_back((*sources.back())[i]);
+    }
+
+    std::vector<const Vector*> predictors;
+    for (const auto& column : columns) predictors.push_back(&column);
+    auto fit = LinearModel::Fit(predictors, y, intercept);
+    if (!fit) return {{}, {CalcErr::DomainError}};
+
+    std::vector<std::string> labels;
+    if (intercept) labels.push_back("(intercept)");
+    labels.insert(labels.end(), terms.begin(), terms.end());
+    size_t width = 12;
+    for (const auto& label : labels) width = std::max(width, label.size() + 2);
+
+    std::ostringstream out;
+    out << std::left << std::setw(static_cast<int>(width)) << "term" << std::right
+        << std::setw(16) << "estimate" << std::setw(16) << "std.error" << "\n";
+    out << std::setprecision(6);
+    for (size_t j = 0; j < labels.size(); ++j) {
+        out << std::left << std::setw(static_cast<int>(width)) << labels[j] << std::right
+            << std::setw(16) << fit->coefficients[j] << std::setw(16) << fit->standard_errors[j] << "\n";
+    }
+    out << "R^2 = " << fit->r_squared << ", adjusted R^2 = " << fit->adjusted_r_squared
+        << ", residual SE = " << fit->residual_std_error << " on "
+        << (fit->observations - std::min<uint64_t>(fit->observations, fit->rank)) << " df, n = " << fit->observations;
+    return EngineSuccessResult(out.str());
+}
@@ -0,0 +1,143 @@
+/**
+ * @file streaming_statistics.cpp
+ * @brief Named sketch-backed streams with compact merge blobs
+ */
+
+#include "streaming_statistics.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr uint8_t kStreamMagic = 'S';
+constexpr uint8_t kStreamVersion = 1;
+
+// Blob layout: magic, version, moments (count + 6 doubles), then the
+// t-digest and KLL blobs, each prefixed by a u32 byte length
+template <typename T>
+void Append(std::vector<uint8_t>& out, T value) {
+    size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+template <typename T>
+bool Consume(const uint8_t*& data, size_t& size, T& value) {
+    if (size < sizeof(T)) return false;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    size -= sizeof(T);
+    return true;
+}
+
+} // namespace
+
+StreamingStatistics::StreamingStatistics(StreamingConfig config) : config_(config) {}
+
+StreamingStatistics::Stream& StreamingStatistics::GetOrCreate(const std::string& stream) {
+    auto it = streams_.find(stream);
+    if (it == streams_.end()) it = streams_.emplace(stream, Stream(config_)).first;
+    return it->second;
+}
+
+void StreamingStatistics::Push(const std::string& stream, double value) {
+    Push(stream, &value, 1);
+}
+
+void StreamingStatistics::Push(const std::string& stream, const double* values, size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stream& s = GetOrCreate(stream);
+    for (size_t i = 0; i < n; ++i) {
+        double v = values[i];
+        if (std::isnan(v)) continue;
+        s.moments.Push(v);
+        s.tdigest.Add(v);
+        s.kll.Update(v);
+    }
+}
+
+std::optional<double> StreamingStatistics::Quantile(const std::string& stream, double q, SketchKind kind) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream);
+    if (it == streams_.end() || it->second.moments.count == 0 || !(q >= 0.0 && q <= 1.0)) return std::nullopt;
+    return kind == SketchKind::KLL ? it->second.kll.Quantile(q) : it->second.tdigest.Quantile(q);
+}
+
+std::optional<double> StreamingStatistics::CDF(const std::string& stream, double x, SketchKind kind) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream);
+    if (it == streams_.end() || it->second.moments.count == 0) return std::nullopt;
+    return kind == SketchKind::KLL ? it->second.kll.Rank(x) : it->second.tdigest.CDF(x);
+}
+
+std::optional<DescriptiveStats> StreamingStatistics::Describe(const std::string& stream) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream);
+    if (it == streams_.end()) return std::nullopt;
+    return it->second.moments.Describe();
+}
+
+std::vector<uint8_t> StreamingStatistics::Serialize(const std::string& stream) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream);
+    if (it == streams_.end()) return {};
+    const Stream& s = it->second;
+
+    std::vector<uint8_t> out;
+    Append(out, kStreamMagic);
+    Append(out, kStreamVersion);
+    Append(out, s.moments.count);
+    for (double v : {s.moments.mean, s.moments.m2, s.moments.m3, s.moments.m4, s.moments.min, s.moments.max}) {
+        Append(out, v);
+    }
+    for (const auto& blob : {s.tdigest.Serialize(), s.kll.Serialize()}) {
+        Append(out, static_cast<uint32_t>(blob.size()));
+        out.insert(out.end(), blob.begin(), blob.end());
+    }
+    return out;
+}
+
+bool StreamingStatistics::MergeSerialized(const std::string& stream, const uint8_t* data, size_t size) {
+    uint8_t magic = 0, version = 0;
+    MomentAccumulator moments;
+    if (!Consume(data, size, magic) || magic != kStreamMagic ||
+        !Consume(data, size, version) || version != kStreamVersion ||
+        !Consume(data, size, moments.count) ||
+        !Consume(data, size, moments.mean) || !Consume(data, size, moments.m2) ||
+        !Consume(data, size, moments.m3) || !Consume(data, size, moments.m4) ||
+        !Consume(data, size, moments.min) || !Consume(data, size, moments.max)) {
+        return false;
+    }
+    moments.total = CompensatedSum{moments.mean * static_cast<double>(moments.count), 0.0};
+
+    uint32_t digest_size = 0;
+    if (!Consume(data, size, digest_size) || digest_size > size) return false;
+    auto digest = TDigest::Deserialize(data, digest_size);
+    data += digest_size;
+    size -= digest_size;
+
+    uint32_t kll_size = 0;
+    if (!Consume(data, size, kll_size) || kll_size != size) return false;
+    auto kll = KLLSketch::Deserialize(data, kll_size);
+    if (!digest || !kll) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stream& s = GetOrCreate(stream);
+    s.moments.Merge(moments);
+    s.tdigest.Merge(*digest);
+    s.kll.Merge(*kll);
+    return true;
+}
+
+bool StreamingStatistics::Reset(const std::string& stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return streams_.erase(stream) > 0;
+}
+
+std::vector<std::string> StreamingStatistics::Streams() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(streams_.size());
+    for (const auto& entry : streams_) names.push_back(entry.first);
+    return names;
+}
@@ -1,4 +1,6 @@
 #include "string_helpers.h"
+#include <cmath>
+#include <cstdio>
 #include <sstream>
 
 namespace Utils {
@@ -35,4 +37,83 @@ std::string ReplaceAll(const std::string& str, const std::string& from, const st
     return result;
 }
 
-}
\ No newline at end of file
+std::string FormatNumber(double val) {
+    // Handle special cases
+    if (std::isinf(val)) return std::signbit(val) ? "-inf" : "inf";
+    if (std::isnan(val)) return "nan";
+    
+    // For integers or numbers that can be represented exactly
+    if (val == std::floor(val) && std::abs(val) < 1e15) {
+        return std::to_string(static_cast<long long>(val));
+    }
+    
+    // For normal floating point numbers
+    char buffer[64];
+    double abs_val = std::abs(val);
+    
+    if (abs_val >= 1e6 || (abs_val > 0 && abs_val < 1e-6)) {
+        // Use scientific notation for very large or very small numbers
+        snprintf(buffer, sizeof(buffer), "%.6e", val);
+    } else {
+        // Use high precision for normal numbers - let's try 15 digits
+        snprintf(buffer, sizeof(buffer), "%.15g", val);
+    }
+    
+    return std::string(buffer);
+}
+
+namespace {
+constexpr char kBase64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+std::string Base64Encode(const uint8_t* data, size_t size) {
+    std::string out;
+    out.reserve((size + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < size; i += 3) {
+        uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        out += kBase64Alphabet[(v >> 18) & 63];
+        out += kBase64Alphabet[(v >> 12) & 63];
+        out += kBase64Alphabet[(v >> 6) & 63];
+        out += kBase64Alphabet[v & 63];
+    }
+    if (i < size) {
+        uint32_t v = uint32_t(data[i]) << 16;
+        if (i + 1 < size) v |= uint32_t(data[i + 1]) << 8;
+        out += kBase64Alphabet[(v >> 18) & 63];
+        out += kBase64Alphabet[(v >> 12) & 63];
+        out += (i + 1 < size) ? kBase64Alphabet[(v >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+std::optional<std::vector<uint8_t>> Base64Decode(std::string_view text) {
+    auto value_of = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+') return 62;
+        if (c == '/') return 63;
+        return -1;
+    };
+
+    while (!text.empty() && text.back() == '=') text.remove_suffix(1);
+    std::vector<uint8_t> out;
+    out.reserve(text.size() * 3 / 4);
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : text) {
+        int v = value_of(c);
+        if (v < 0) return std::nullopt;
+        buffer = (buffer << 6) | static_cast<uint32_t>(v);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>((buffer >> bits) & 0xFF));
+        }
+    }
+    return out;
+}
+
+}
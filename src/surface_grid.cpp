@@ -0,0 +1,213 @@
+/**
+ * @file surface_grid.cpp
+ * @brief Tiled grid evaluation, colormap lookup and marching squares
+ */
+
+#include "surface_grid.h"
+#include "dynamic_calc_types.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr size_t kTileColumns = 128;
+constexpr size_t kTileRows = 32;
+constexpr size_t kMaxPoints = size_t{1} << 28;
+
+using Color = std::array<uint8_t, 3>;
+using Lut = std::array<Color, 256>;
+
+struct Anchor {
+    double t;
+    Color color;
+};
+
+template <size_t N>
+Lut Interpolate(const std::array<Anchor, N>& anchors) {
+    Lut lut{};
+    for (size_t i = 0; i < lut.size(); ++i) {
+        double t = static_cast<double>(i) / 255.0;
+        size_t k = 1;
+        while (k + 1 < N && anchors[k].t < t) ++k;
+        const Anchor& a = anchors[k - 1];
+        const Anchor& b = anchors[k];
+        double w = (t - a.t) / (b.t - a.t);
+        for (size_t ch = 0; ch < 3; ++ch) {
+            lut[i][ch] = static_cast<uint8_t>(std::lround(a.color[ch] + w * (b.color[ch] - a.color[ch])));
+        }
+    }
+    return lut;
+}
+
+const Lut& Table(Surface::Colormap colormap) {
+    // matplotlib's viridis at ninths, and Moreland's cool-warm end and middle points
+    static const Lut viridis = Interpolate(std::array<Anchor, 9>{{
+        {0.0, {68, 1, 84}}, {0.125, {71, 44, 122}}, {0.25, {59, 81, 139}},
+        {0.375, {44, 113, 142}}, {0.5, {33, 144, 141}}, {0.625, {39, 173, 129}},
+        {0.75, {92, 200, 99}}, {0.875, {170, 220, 50}}, {1.0, {253, 231, 37}},
+    }});
+    static const Lut grayscale = Interpolate(std::array<Anchor, 2>{{{0.0, {0, 0, 0}}, {1.0, {255, 255, 255}}}});
+    static const Lut coolwarm = Interpolate(std::array<Anchor, 3>{{
+        {0.0, {59, 76, 192}}, {0.5, {221, 221, 221}}, {1.0, {180, 4, 38}},
+    }});
+    switch (colormap) {
+        case Surface::Colormap::Grayscale: return grayscale;
+        case Surface::Colormap::Coolwarm: return coolwarm;
+        case Surface::Colormap::Viridis: break;
+    }
+    return viridis;
+}
+
+// Point where the level crosses the edge from grid point (c0, r0) to (c1, r1)
+struct Crossing {
+    double x, y;
+};
+
+Crossing Cross(const SurfaceGrid& grid, size_t c0, size_t r0, float v0, size_t c1, size_t r1, float v1, double level) {
+    double t = (level - v0) / (static_cast<double>(v1) - v0);
+    return {grid.X(c0) + t * (grid.X(c1) - grid.X(c0)), grid.Y(r0) + t * (grid.Y(r1) - grid.Y(r0))};
+}
+
+void ContourCell(const SurfaceGrid& grid, size_t c, size_t r, double level, std::vector<ContourSegment>& out) {
+    // Clockwise from the top left: a (c, r), b (c + 1, r), d (c + 1, r + 1), e (c, r + 1)
+    const float a = grid.At(c, r), b = grid.At(c + 1, r), d = grid.At(c + 1, r + 1), e = grid.At(c, r + 1);
+    if (std::isnan(a) || std::isnan(b) || std::isnan(d) || std::isnan(e)) return;
+    const bool ha = a >= level, hb = b >= level, hd = d >= level, he = e >= level;
+
+    // Crossed edges in clockwise order: top, right, bottom, left
+    Crossing cut[4];
+    size_t count = 0;
+    if (ha != hb) cut[count++] = Cross(grid, c, r, a, c + 1, r, b, level);
+    if (hb != hd) cut[count++] = Cross(grid, c + 1, r, b, c + 1, r + 1, d, level);
+    if (hd != he) cut[count++] = Cross(grid, c + 1, r + 1, d, c, r + 1, e, level);
+    if (he != ha) cut[count++] = Cross(grid, c, r + 1, e, c, r, a, level);
+
+    auto emit = [&](const Crossing& p, const Crossing& q) { out.push_back({p.x, p.y, q.x, q.y}); };
+    if (count == 2) {
+        emit(cut[0], cut[1]);
+    } else if (count == 4) {
+        // Saddle: if the centre is on a's side, a and d are joined through it and the
+        // lines cut off b and e; otherwise they cut off a and d
+        const bool centre = 0.25 * (static_cast<double>(a) + b + d + e) >= level;
+        if (centre == ha) {
+            emit(cut[0], cut[1]);
+            emit(cut[2], cut[3]);
+        } else {
+            emit(cut[3], cut[0]);
+            emit(cut[1], cut[2]);
+        }
+    }
+}
+
+} // namespace
+
+namespace Surface {
+
+std::optional<SurfaceGrid> Evaluate(const CompiledExpression& f, const GridSpec& spec) {
+    if (f.VariableCount() != 2 || spec.columns < 2 || spec.rows < 2) return std::nullopt;
+    if (spec.columns > kMaxPoints / spec.rows) return std::nullopt;
+    if (!(spec.x_min < spec.x_max) || !(spec.y_min < spec.y_max) ||
+        !std::isfinite(spec.x_max - spec.x_min) || !std::isfinite(spec.y_max - spec.y_min)) {
+        return std::nullopt;
+    }
+
+    SurfaceGrid grid;
+    grid.spec = spec;
+    grid.values.resize(spec.columns * spec.rows);
+    const size_t tiles_across = (spec.columns + kTileColumns - 1) / kTileColumns;
+    const size_t tiles_down = (spec.rows + kTileRows - 1) / kTileRows;
+
+    AXIOM::Parallel::ParallelForWork(tiles_across * tiles_down, kTileColumns * kTileRows, [&](size_t lo, size_t hi) {
+        Vector xs(kTileColumns * kTileRows), ys(xs.size()), zs(xs.size());
+        for (size_t tile = lo; tile < hi; ++tile) {
+            const size_t c0 = (tile % tiles_across) * kTileColumns, r0 = (tile / tiles_across) * kTileRows;
+            const size_t width = std::min(kTileColumns, spec.columns - c0);
+            const size_t height = std::min(kTileRows, spec.rows - r0);
+            size_t k = 0;
+            for (size_t r = r0; r < r0 + height; ++r) {
+                const double y = grid.Y(r);
+                for (size_t c = c0; c < c0 + width; ++c, ++k) {
+                    xs[k] = grid.X(c);
+                    ys[k] = y;
+                }
+            }
+            const double* inputs[] = {xs.data(), ys.data()};
+            f.Evaluate(inputs, zs.data(), k);
+
+            k = 0;
+            for (size_t r = r0; r < r0 + height; ++r) {
+                float* row = grid.values.data() + r * spec.columns + c0;
+                for (size_t c = 0; c < width; ++c) row[c] = static_cast<float>(zs[k++]);
+            }
+        }
+    });
+    return grid;
+}
+
+std::optional<std::pair<float, float>> FiniteRange(const SurfaceGrid& grid) {
+    using Range = std::pair<float, float>;
+    const float inf = std::numeric_limits<float>::infinity();
+    Range range = AXIOM::Parallel::ParallelReduce(size_t{0}, grid.values.size(), 0, Range{inf, -inf},
+        [&](size_t lo, size_t hi) {
+            Range part{inf, -inf};
+            for (size_t i = lo; i < hi; ++i) {
+                const float v = grid.values[i];
+                if (!std::isfinite(v)) continue;
+                part.first = std::min(part.first, v);
+                part.second = std::max(part.second, v);
+            }
+            return part;
+        },
+        [](Range acc, const Range& part) {
+            return Range{std::min(acc.first, part.first), std::max(acc.second, part.second)};
+        });
+    if (range.first > range.second) return std::nullopt;
+    return range;
+}
+
+std::vector<uint8_t> Colorize(const SurfaceGrid& grid, Colormap colormap, double lo, double hi) {
+    const Lut& lut = Table(colormap);
+    const size_t n = grid.values.size();
+    std::vector<uint8_t> rgb(3 * n);
+    const double scale = hi > lo ? 255.0 / (hi - lo) : 0.0;
+    AXIOM::Parallel::ParallelFor(0, n, 0, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float v = grid.values[i];
+            Color color{0, 0, 0};
+            if (!std::isnan(v)) {
+                double t = (v - lo) * scale;   // NaN for an infinite v over a zero-width range
+                color = lut[t > 0.0 ? static_cast<size_t>(std::min(t, 255.0) + 0.5) : 0];
+            }
+            std::copy(color.begin(), color.end(), rgb.begin() + 3 * i);
+        }
+    });
+    return rgb;
+}
+
+std::vector<uint8_t> Colorize(const SurfaceGrid& grid, Colormap colormap) {
+    auto range = FiniteRange(grid);
+    if (!range) return Colorize(grid, colormap, 0.0, 1.0);
+    return Colorize(grid, colormap, range->first, range->second);
+}
+
+std::vector<ContourSegment> Contour(const SurfaceGrid& grid, double level) {
+    const size_t cell_rows = grid.Rows() - 1, cell_columns = grid.Columns() - 1;
+    std::vector<std::vector<ContourSegment>> bands(cell_rows);
+    AXIOM::Parallel::ParallelForWork(cell_rows, cell_columns, [&](size_t lo, size_t hi) {
+        for (size_t r = lo; r < hi; ++r) {
+            for (size_t c = 0; c < cell_columns; ++c) ContourCell(grid, c, r, level, bands[r]);
+        }
+    });
+
+    std::vector<ContourSegment> segments;
+    size_t total = 0;
+    for (const auto& band : bands) total += band.size();
+    segments.reserve(total);
+    for (const auto& band : bands) segments.insert(segments.end(), band.begin(), band.end());
+    return segments;
+}
+
+} // namespace Surface
@@ -1,43 +1,48 @@
 #include "symbolic_engine.h"
+#include "sparse_polynomial.h"
 
 // Placeholder implementations for symbolic operations
 // These would need a full computer algebra system for complete functionality
 
 EngineResult SymbolicEngine::Expand(const std::string& expression) {
-    // For now, return the expression as-is with a note
-    return {EngineSuccessResult("expand(" + expression + ") - symbolic expansion not yet implemented"), {}};
+    // Polynomials expand natively; anything else (functions, division by a variable) is a ParseError
+    auto polynomial = SparsePolynomial::Parse(expression);
+    if (!polynomial) {
+        return {{}, {EngineErrorResult(CalcErr::ParseError)}};
+    }
+    return EngineSuccessResult(polynomial->ToString());
 }
 
 EngineResult SymbolicEngine::Factor(const std::string& expression) {
-    return {EngineSuccessResult("factor(" + expression + ") - symbolic factoring not yet implemented"), {}};
+    return EngineSuccessResult("factor(" + expression + ") - symbolic factoring not yet implemented");
 }
 
 EngineResult SymbolicEngine::Simplify(const std::string& expression) {
-    return {EngineSuccessResult("simplify(" + expression + ") - symbolic simplification not yet implemented"), {}};
+    return EngineSuccessResult("simplify(" + expression + ") - symbolic simplification not yet implemented");
 }
 
 EngineResult SymbolicEngine::Substitute(const std::string& expr, const std::string& var, const std::string& value) {
-    return {EngineSuccessResult("substitute(" + expr + ", " + var + "=" + value + ") - substitution not yet implemented"), {}};
+    return EngineSuccessResult("substitute(" + expr + ", " + var + "=" + value + ") - substitution not yet implemented");
 }
 
 EngineResult SymbolicEngine::Integrate(const std::string& expression, const std::string& variable) {
-    return {EngineSuccessResult("integrate(" + expression + ", " + variable + ") - symbolic integration not yet implemented"), {}};
+    return EngineSuccessResult("integrate(" + expression + ", " + variable + ") - symbolic integration not yet implemented");
 }
 
 EngineResult SymbolicEngine::DefiniteIntegral(const std::string& expr, const std::string& var, double a, double b) {
-    return {EngineSuccessResult("integrate(" + expr + ", " + var + ", " + std::to_string(a) + ", " + std::to_string(b) + ") - definite integration not yet implemented"), {}};
+    return EngineSuccessResult("integrate(" + expr + ", " + var + ", " + std::to_string(a) + ", " + std::to_string(b) + ") - definite integration not yet implemented");
 }
 
 EngineResult SymbolicEngine::PartialDerivative(const std::string& expr, const std::string& var) {
-    return {EngineSuccessResult("d/d" + var + "(" + expr + ") - partial derivatives not yet implemented"), {}};
+    return EngineSuccessResult("d/d" + var + "(" + expr + ") - partial derivatives not yet implemented");
 }
 
 EngineResult SymbolicEngine::TaylorSeries(const std::string& expr, const std::string& var, double point, int order) {
-    return {EngineSuccessResult("taylor(" + expr + ", " + var + "=" + std::to_string(point) + ", order=" + std::to_string(order) + ") - Taylor series not yet implemented"), {}};
+    return EngineSuccessResult("taylor(" + expr + ", " + var + "=" + std::to_string(point) + ", order=" + std::to_string(order) + ") - Taylor series not yet implemented");
 }
 
 EngineResult SymbolicEngine::SolveEquation(const std::string& equation, const std::string& variable) {
-    return {EngineSuccessResult("solve(" + equation + ", " + variable + ") - symbolic equation solving not yet implemented"), {}};
+    return EngineSuccessResult("solve(" + equation + ", " + variable + ") - symbolic equation solving not yet implemented");
 }
 
 EngineResult SymbolicEngine::SolveSystem(const std::vector<std::string>& equations, const std::vector<std::string>& variables) {
@@ -53,13 +58,13 @@ EngineResult SymbolicEngine::SolveSystem(const std::vector<std::string>& equatio
         if (i < variables.size() - 1) var_str += ", ";
     }
     
-    return {EngineSuccessResult("solve_system([" + eq_str + "], [" + var_str + "]) - symbolic system solving not yet implemented"), {}};
+    return EngineSuccessResult("solve_system([" + eq_str + "], [" + var_str + "]) - symbolic system solving not yet implemented");
 }
 
 EngineResult SymbolicEngine::FindLimits(const std::string& expr, const std::string& var, double approach_point) {
-    return {EngineSuccessResult("limit(" + expr + ", " + var + " -> " + std::to_string(approach_point) + ") - limits not yet implemented"), {}};
+    return EngineSuccessResult("limit(" + expr + ", " + var + " -> " + std::to_string(approach_point) + ") - limits not yet implemented");
 }
 
 EngineResult SymbolicEngine::FindRoots(const std::string& expr, const std::string& var, double range_min, double range_max) {
-    return {EngineSuccessResult("roots(" + expr + ", " + var + " in [" + std::to_string(range_min) + ", " + std::to_string(range_max) + "]) - root finding not yet implemented"), {}};
+    return EngineSuccessResult("roots(" + expr + ", " + var + " in [" + std::to_string(range_min) + ", " + std::to_string(range_max) + "]) - root finding not yet implemented");
 }
\ No newline at end of file
@@ -0,0 +1,529 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Work-stealing scheduler implementation
+ */
+
+#include "thread_pool.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+namespace AXIOM {
+
+// ============================================================================
+// WorkStealingDeque
+// ============================================================================
+
+WorkStealingDeque::WorkStealingDeque(int64_t initial_capacity) {
+    int64_t capacity = 1;
+    while (capacity < initial_capacity) capacity <<= 1;
+    buffers_.push_back(std::make_unique<Buffer>(capacity));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+    // Tasks left behind at shutdown are owned by the deque
+    while (PoolTask* task = Pop()) delete task;
+}
+
+WorkStealingDeque::Buffer* WorkStealingDeque::Grow(Buffer* old, int64_t bottom, int64_t top) {
+    auto grown = std::make_unique<Buffer>(old->capacity * 2);
+    for (int64_t i = top; i < bottom; ++i) grown->Put(i, old->Get(i));
+    Buffer* raw = grown.get();
+    buffers_.push_back(std::move(grown));
+    buffer_.store(raw, std::memory_order_release);
+    return raw;
+}
+
+void WorkStealingDeque::Push(PoolTask* task) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Buffer* buf = buffer_.load(std::memory_order_relaxed);
+    if (b - t > buf->capacity - 1) {
+        buf = Grow(buf, b, t);
+    }
+    buf->Put(b, task);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+PoolTask* WorkStealingDeque::Pop() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buf = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    PoolTask* task = buf->Get(b);
+    if (t == b) {
+        // Last element: race against thieves for it
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+PoolTask* WorkStealingDeque::Steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+
+    if (t >= b) return nullptr;
+
+    Buffer* buf = buffer_.load(std::memory_order_acquire);
+    PoolTask* task = buf->Get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;   // Lost the race; caller retries elsewhere
+    }
+    return task;
+}
+
+bool WorkStealingDeque::Empty() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return t >= b;
+}
+
+// ============================================================================
+// ThreadPool
+// ============================================================================
+
+namespace {
+
+thread_local ThreadPool* tls_pool = nullptr;
+thread_local int tls_worker_index = -1;
+
+uint64_t NextRandom(uint64_t& state) {
+    // xorshift64*: cheap victim selection
+    state ^= state >> 12; state ^= state << 25; state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+#ifdef __linux__
+bool ReadIntFile(const std::string& path, int& value) {
+    std::ifstream in(path);
+    return static_cast<bool>(in >> value);
+}
+#endif
+
+} // namespace
+
+// ============================================================================
+// Thread placement
+// ============================================================================
+
+bool ParseCPUList(const std::string& spec, std::vector<int>& cpus) {
+    cpus.clear();
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+        if (item.empty()) continue;
+        size_t dash = item.find('-');
+        try {
+            size_t used = 0;
+            int lo = std::stoi(item.substr(0, dash), &used);
+            if (used != (dash == std::string::npos ? item.size() : dash)) return false;
+            int hi = lo;
+            if (dash != std::string::npos) {
+                std::string tail = item.substr(dash + 1);
+                hi = std::stoi(tail, &used);
+                if (used != tail.size()) return false;
+            }
+            if (lo < 0 || hi < lo) return false;
+            for (int cpu = lo; cpu <= hi; ++cpu) cpus.push_back(cpu);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return !cpus.empty();
+}
+
+std::string ApplyThreadPlacement(const ThreadPlacement& placement, size_t index) {
+    std::ostringstream ss;
+#ifdef __linux__
+    pthread_t self = pthread_self();
+
+    if (!placement.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (placement.pin_each) {
+            CPU_SET(placement.cpus[index % placement.cpus.size()], &set);
+        } else {
+            for (int cpu : placement.cpus) CPU_SET(cpu, &set);
+        }
+        int rc = pthread_setaffinity_np(self, sizeof(set), &set);
+        ss << "cpus {";
+        bool first = true;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &set)) continue;
+            ss << (first ? "" : ",") << cpu;
+            first = false;
+        }
+        ss << "}";
+        if (rc != 0) ss << " (affinity refused: " << std::strerror(rc) << ")";
+    } else {
+        ss << "cpus inherited";
+    }
+
+    if (placement.fifo_priority > 0) {
+        sched_param param{};
+        param.sched_priority = placement.fifo_priority;
+        int rc = pthread_setschedparam(self, SCHED_FIFO, &param);
+        ss << ", SCHED_FIFO:" << placement.fifo_priority;
+        if (rc != 0) ss << " (refused: " << std::strerror(rc) << ")";
+    } else if (placement.nice != 0) {
+        // Linux applies nice per task, so target this thread's tid
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        int rc = setpriority(PRIO_PROCESS, static_cast<id_t>(tid), placement.nice);
+        ss << ", nice " << placement.nice;
+        if (rc != 0) ss << " (refused: " << std::strerror(errno) << ")";
+    }
+#else
+    (void)placement;
+    (void)index;
+    ss << "placement unsupported on this platform";
+#endif
+    return ss.str();
+}
+
+std::vector<int> ThreadPool::TopologyOrderedCPUs() {
+    std::vector<int> ordered;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        // (package, core) -> logical CPUs on that physical core
+        std::map<std::pair<int, int>, std::vector<int>> cores;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed)) continue;
+            std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            int package = 0, core = cpu;
+            ReadIntFile(base + "physical_package_id", package);
+            ReadIntFile(base + "core_id", core);
+            cores[{package, core}].push_back(cpu);
+        }
+        // Round-robin over physical cores so SMT siblings are used last
+        for (size_t rank = 0;; ++rank) {
+            bool any = false;
+            for (const auto& [key, cpus] : cores) {
+                if (rank < cpus.size()) { ordered.push_back(cpus[rank]); any = true; }
+            }
+            if (!any) break;
+        }
+    }
+#endif
+    if (ordered.empty()) {
+        unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < hw; ++i) ordered.push_back(static_cast<int>(i));
+    }
+    return ordered;
+}
+
+ThreadPool::ThreadPool(const ThreadPoolConfig& config) : config_(config) {
+    std::vector<int> cpus = config_.placement.cpus.empty() ? TopologyOrderedCPUs() : config_.placement.cpus;
+    size_t count = config_.num_threads > 0 ? config_.num_threads : cpus.size();
+    count = std::max<size_t>(1, count);
+
+    workers_.reserve(count);
+    worker_cpus_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->rng_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+        workers_.push_back(std::move(worker));
+        worker_cpus_.push_back(cpus[i % cpus.size()]);
+    }
+
+    worker_layout_.resize(count);
+
+    // Start threads only after every deque exists so thieves see a stable set
+    for (size_t i = 0; i < count; ++i) {
+        workers_[i]->thread = std::thread(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    Stop();
+}
+
+void ThreadPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        if (stopping_.exchange(true)) return;
+        ++wake_epoch_;
+    }
+    park_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    // A Submit that raced the stop may have queued after the workers left
+    while (PoolTask* task = PopInjected()) Execute(task);
+}
+
+void ThreadPool::Submit(std::function<void()> fn) {
+    auto* task = new PoolTask{std::move(fn)};
+    outstanding_.fetch_add(1, std::memory_order_acq_rel);
+
+    if (stopping_.load(std::memory_order_acquire)) {
+        // A replaced global pool: no workers left, so run here
+        Execute(task);
+        return;
+    }
+
+    if (tls_pool == this && tls_worker_index >= 0) {
+        workers_[tls_worker_index]->deque.Push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injection_mutex_);
+        injection_queue_.push_back(task);
+        injected_count_.fetch_add(1, std::memory_order_release);
+    }
+
+    NotifyOne();
+}
+
+void ThreadPool::NotifyOne() {
+    // seq_cst pairs with the sleeper increment in WorkerLoop
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            ++wake_epoch_;
+        }
+        park_cv_.notify_one();
+    }
+}
+
+PoolTask* ThreadPool::PopInjected() {
+    if (injected_count_.load(std::memory_order_acquire) == 0) return nullptr;
+    std::lock_guard<std::mutex> lock(injection_mutex_);
+    if (injection_queue_.empty()) return nullptr;
+    PoolTask* task = injection_queue_.front();
+    injection_queue_.pop_front();
+    injected_count_.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+PoolTask* ThreadPool::FindTask(size_t self_index, uint64_t& rng_state) {
+    if (self_index < workers_.size()) {
+        if (PoolTask* task = workers_[self_index]->deque.Pop()) return task;
+    }
+    if (PoolTask* task = PopInjected()) return task;
+
+    size_t n = workers_.size();
+    size_t start = static_cast<size_t>(NextRandom(rng_state) % n);
+    for (size_t k = 0; k < n; ++k) {
+        size_t victim = (start + k) % n;
+        if (victim == self_index) continue;
+        if (PoolTask* task = workers_[victim]->deque.Steal()) return task;
+    }
+    return nullptr;
+}
+
+void ThreadPool::Execute(PoolTask* task) {
+    std::unique_ptr<PoolTask> owned(task);
+    owned->fn();   // TaskGroup wraps user code, so nothing escapes here
+    outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool ThreadPool::TryRunOneTask() {
+    size_t self = (tls_pool == this && tls_worker_index >= 0)
+        ? static_cast<size_t>(tls_worker_index) : workers_.size();
+    thread_local uint64_t helper_rng = 0x2545F4914F6CDD1DULL;
+    PoolTask* task = FindTask(self, self < workers_.size() ? workers_[self]->rng_state : helper_rng);
+    if (!task) return false;
+    Execute(task);
+    return true;
+}
+
+int ThreadPool::CurrentWorkerIndex() const {
+    return tls_pool == this ? tls_worker_index : -1;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+    tls_pool = this;
+    tls_worker_index = static_cast<int>(index);
+    Worker& self = *workers_[index];
+
+    // Placement is applied from inside the thread so nice/tid-based calls work
+    ThreadPlacement placement = config_.placement;
+    if (placement.pin_each && placement.cpus.empty()) placement.cpus = worker_cpus_;
+    bool customized = !placement.cpus.empty() || placement.fifo_priority > 0 || placement.nice != 0;
+    std::string layout = customized ? ApplyThreadPlacement(placement, index) : "cpus inherited";
+    {
+        std::lock_guard<std::mutex> lock(layout_mutex_);
+        worker_layout_[index] = std::move(layout);
+    }
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (PoolTask* task = FindTask(index, self.rng_state)) {
+            Execute(task);
+            continue;
+        }
+
+        // Parking policy: spin on steals, then yield, then sleep
+        PoolTask* found = nullptr;
+        auto spin_deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(config_.spin_us);
+        while (!found && std::chrono::steady_clock::now() < spin_deadline) {
+            found = FindTask(index, self.rng_state);
+        }
+        for (int i = 0; i < config_.yield_iterations && !found; ++i) {
+            std::this_thread::yield();
+            found = FindTask(index, self.rng_state);
+        }
+        if (found) {
+            Execute(found);
+            continue;
+        }
+
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        uint64_t epoch;
+        {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            epoch = wake_epoch_;
+        }
+        // Re-check after announcing: a Submit that raced us either sees the
+        // sleeper and bumps the epoch, or its task is visible here.
+        found = FindTask(index, self.rng_state);
+        if (!found) {
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            park_cv_.wait(lock, [&] { return wake_epoch_ != epoch || stopping_.load(); });
+        }
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+        if (found) Execute(found);
+    }
+
+    tls_pool = nullptr;
+    tls_worker_index = -1;
+}
+
+std::string ThreadPool::Describe() const {
+    std::ostringstream ss;
+    ss << workers_.size() << " workers, spin " << config_.spin_us << "us";
+    std::lock_guard<std::mutex> lock(layout_mutex_);
+    for (size_t i = 0; i < worker_layout_.size(); ++i) {
+        ss << "\n  worker[" << i << "] "
+           << (worker_layout_[i].empty() ? "starting" : worker_layout_[i]);
+    }
+    return ss.str();
+}
+
+// ============================================================================
+// Global pool
+// ============================================================================
+
+namespace {
+
+std::mutex g_pool_mutex;
+std::unique_ptr<ThreadPool> g_pool;
+std::vector<std::unique_ptr<ThreadPool>> g_retired_pools;   // Stopped, kept for stale references
+ThreadPoolConfig g_pool_config = [] {
+    ThreadPoolConfig config;
+    if (const char* env = std::getenv("AXIOM_THREADS")) {
+        config.num_threads = static_cast<size_t>(std::strtoul(env, nullptr, 10));
+    }
+    return config;
+}();
+
+} // namespace
+
+ThreadPool& ThreadPool::Global() {
+    std::lock_guard<std::mutex> lock(g_pool_mutex);
+    if (!g_pool) g_pool = std::make_unique<ThreadPool>(g_pool_config);
+    return *g_pool;
+}
+
+bool ThreadPool::ConfigureGlobal(const ThreadPoolConfig& config) {
+    std::unique_ptr<ThreadPool> replaced;
+    {
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        if (g_pool && (g_pool->Outstanding() > 0 || tls_pool == g_pool.get())) return false;
+        g_pool_config = config;
+        replaced = std::move(g_pool);
+    }
+    if (replaced) {
+        replaced->Stop();
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        g_retired_pools.push_back(std::move(replaced));
+    }
+    return true;
+}
+
+bool ThreadPool::SetGlobalThreadCount(size_t num_threads) {
+    ThreadPoolConfig config;
+    {
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        config = g_pool_config;
+    }
+    config.num_threads = num_threads;
+    return ConfigureGlobal(config);
+}
+
+size_t ThreadPool::GlobalThreadCount() {
+    {
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        if (g_pool) return g_pool->Size();
+        if (g_pool_config.num_threads > 0) return g_pool_config.num_threads;
+    }
+    return std::max<size_t>(1, TopologyOrderedCPUs().size());
+}
+
+// ============================================================================
+// TaskGroup
+// ============================================================================
+
+TaskGroup::~TaskGroup() {
+    // Never leave children referencing a dead group
+    while (pending_.load(std::memory_order_acquire) > 0) {
+        if (!pool_.TryRunOneTask()) std::this_thread::yield();
+    }
+}
+
+void TaskGroup::Run(std::function<void()> fn) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.Submit([this, fn = std::move(fn)] {
+        try {
+            fn();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+        pending_.fetch_sub(1, std::memory_order_release);
+    });
+}
+
+void TaskGroup::Wait() {
+    while (pending_.load(std::memory_order_acquire) > 0) {
+        if (!pool_.TryRunOneTask()) std::this_thread::yield();
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        std::swap(error, error_);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace AXIOM
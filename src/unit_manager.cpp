@@ -1,7 +1,206 @@
 #include "unit_manager.h"
+#include "simd_kernels.h"
 #include <unordered_map>
+#include <algorithm>
+#include <cctype>
 #include <cmath>
 
+namespace {
+
+constexpr size_t kMaxCachedConversions = 4096;   // Cleared beyond this; keys come from user input
+
+uint64_t HashSymbol(std::string_view symbol) {
+    uint64_t h = 14695981039346656037ull;   // FNV-1a
+    for (char c : symbol) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// splitmix64 finalizer over the hash moved by the bucket's displacement
+uint64_t SlotHash(uint64_t h, uint64_t displacement) {
+    uint64_t z = h + (displacement + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+uint64_t PowerOfTwoAtLeast(uint64_t n) {
+    uint64_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+UnitType TypeOf(const Dimension& dimension) {
+    static constexpr UnitType kTypes[] = {
+        UnitType::Length, UnitType::Time, UnitType::Mass, UnitType::Temperature, UnitType::Current,
+        UnitType::Area, UnitType::Volume, UnitType::Velocity, UnitType::Acceleration,
+        UnitType::Force, UnitType::Energy, UnitType::Power, UnitType::Pressure,
+    };
+    for (UnitType type : kTypes) {
+        if (UnitManager::DimensionOf(type) == dimension) return type;
+    }
+    return UnitType::Dimensionless;
+}
+
+/**
+ * Recursive descent over a unit expression:
+ *   product := power (('*' | '/') power)*
+ *   power   := factor ('^' integer)?
+ *   factor  := symbol | '1' | '(' product ')'
+ * A unit with an offset (C, F) is accepted only on its own.
+ */
+class UnitExpressionParser {
+public:
+    UnitExpressionParser(std::string_view text, const UnitSymbolTable& symbols) : text_(text), symbols_(symbols) {}
+
+    std::optional<CompoundUnit> Run() {
+        CompoundUnit unit;
+        if (!Product(unit) || (SkipSpace(), pos_ != text_.size())) return std::nullopt;
+        if (offset_unit_) {
+            if (terms_ != 1) return std::nullopt;
+            unit.offset = offset_unit_->offset;
+        }
+        return unit;
+    }
+
+private:
+    void SkipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    }
+
+    bool Accept(char c) {
+        SkipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool Product(CompoundUnit& out) {
+        if (!Power(out)) return false;
+        for (;;) {
+            const bool divide = Accept('/');
+            if (!divide && !Accept('*')) return true;
+            CompoundUnit next;
+            if (!Power(next)) return false;
+            auto dimension = Dimension::CheckedProduct(out.dimension, next.dimension, divide);
+            if (!dimension) return false;
+            out.dimension = *dimension;
+            out.scale = divide ? out.scale / next.scale : out.scale * next.scale;
+        }
+    }
+
+    bool Power(CompoundUnit& out) {
+        if (!Factor(out)) return false;
+        if (!Accept('^')) return true;
+        SkipSpace();
+        const bool negative = pos_ < text_.size() && text_[pos_] == '-';
+        if (negative) ++pos_;
+        int power = 0;
+        size_t digits = 0;
+        for (; pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_])) && digits < 3; ++pos_, ++digits) {
+            power = power * 10 + (text_[pos_] - '0');
+        }
+        if (digits == 0) return false;
+        if (negative) power = -power;
+        auto dimension = out.dimension.CheckedPow(power);
+        if (!dimension) return false;
+        out.dimension = *dimension;
+        out.scale = std::pow(out.scale, power);
+        ++terms_;   // A powered C or F is not a temperature
+        return true;
+    }
+
+    bool Factor(CompoundUnit& out) {
+        if (Accept('(')) return Product(out) && Accept(')');
+        SkipSpace();
+        if (pos_ < text_.size() && text_[pos_] == '1') {
+            ++pos_;
+            out = CompoundUnit();
+            ++terms_;   // So "1/C" counts as a compound
+            return true;
+        }
+        const size_t start = pos_;
+        while (pos_ < text_.size() && (std::isalpha(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) ++pos_;
+        const Unit* unit = symbols_.Find(text_.substr(start, pos_ - start));
+        if (!unit) return false;
+        out.dimension = unit->dimension;
+        out.scale = unit->scale_factor;
+        if (unit->offset != 0.0) offset_unit_ = unit;
+        ++terms_;
+        return true;
+    }
+
+    std::string_view text_;
+    const UnitSymbolTable& symbols_;
+    size_t pos_ = 0;
+    size_t terms_ = 0;   // Factors and powers; an offset applies only when this is 1
+    const Unit* offset_unit_ = nullptr;
+};
+
+} // namespace
+
+void UnitSymbolTable::Build(const std::unordered_map<std::string, Unit>& units) {
+    const uint64_t n = units.size();
+    const uint64_t bucket_count = PowerOfTwoAtLeast(std::max<uint64_t>(1, n / 2));
+    bucket_mask_ = bucket_count - 1;
+    std::vector<std::vector<std::pair<uint64_t, const Unit*>>> buckets(bucket_count);
+    for (const auto& [symbol, unit] : units) {
+        const uint64_t h = HashSymbol(symbol);
+        buckets[h & bucket_mask_].emplace_back(h, &unit);
+    }
+    // Largest buckets first, while most slots are free
+    std::vector<size_t> order(bucket_count);
+    for (size_t b = 0; b < bucket_count; ++b) order[b] = b;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    // Load factor <= 1/2; a bucket that finds no displacement doubles the table
+    for (uint64_t slot_count = PowerOfTwoAtLeast(2 * n + 1);; slot_count *= 2) {
+        slot_mask_ = slot_count - 1;
+        slots_.assign(slot_count, nullptr);
+        displacements_.assign(bucket_count, 0);
+        std::vector<uint64_t> placed;
+        bool complete = true;
+        for (size_t b : order) {
+            const auto& keys = buckets[b];
+            if (keys.empty()) break;
+            bool found = false;
+            for (uint32_t d = 0; d <= UINT16_MAX && !found; ++d) {
+                placed.clear();
+                found = true;
+                for (const auto& [h, unit] : keys) {
+                    const uint64_t slot = SlotHash(h, d) & slot_mask_;
+                    if (slots_[slot] || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                        found = false;
+                        break;
+                    }
+                    placed.push_back(slot);
+                }
+                if (found) {
+                    displacements_[b] = static_cast<uint16_t>(d);
+                    for (size_t i = 0; i < keys.size(); ++i) slots_[placed[i]] = keys[i].second;
+                }
+            }
+            if (!found) {
+                complete = false;
+                break;
+            }
+        }
+        if (complete) return;
+    }
+}
+
+const Unit* UnitSymbolTable::Find(std::string_view symbol) const {
+    if (slots_.empty()) return nullptr;
+    const uint64_t h = HashSymbol(symbol);
+    const Unit* unit = slots_[SlotHash(h, displacements_[h & bucket_mask_]) & slot_mask_];
+    return unit && unit->symbol == symbol ? unit : nullptr;
+}
+
 UnitManager::UnitManager() {
     // Length units
     RegisterUnit("m", UnitType::Length, 1.0, "meter");
@@ -28,43 +227,130 @@ UnitManager::UnitManager() {
     RegisterUnit("week", UnitType::Time, 604800.0, "week");
     RegisterUnit("year", UnitType::Time, 31557600.0, "year");
     
-    // Temperature units (special handling needed)
+    // Temperature units: C and F are affine (offset of their zero in kelvin)
     RegisterUnit("K", UnitType::Temperature, 1.0, "kelvin");
-    RegisterUnit("C", UnitType::Temperature, 1.0, "celsius");
-    RegisterUnit("F", UnitType::Temperature, 1.0, "fahrenheit");
+    RegisterUnit("C", Dimensions::Temperature, 1.0, "celsius", 273.15);
+    RegisterUnit("F", Dimensions::Temperature, 5.0/9.0, "fahrenheit", 459.67 * 5.0/9.0);
     
     // Angle units
     RegisterUnit("rad", UnitType::Angle, 1.0, "radian");
     RegisterUnit("deg", UnitType::Angle, PI_CONST/180.0, "degree");
     RegisterUnit("grad", UnitType::Angle, PI_CONST/200.0, "gradian");
+
+    // Other SI base units and common derived units
+    RegisterUnit("A", UnitType::Current, 1.0, "ampere");
+    RegisterUnit("mol", Dimensions::Amount, 1.0, "mole");
+    RegisterUnit("cd", Dimensions::Luminosity, 1.0, "candela");
+    RegisterUnit("Hz", Dimensions::Frequency, 1.0, "hertz");
+    RegisterUnit("L", UnitType::Volume, 0.001, "liter");
+    RegisterUnit("mL", UnitType::Volume, 1e-6, "milliliter");
+    RegisterUnit("N", UnitType::Force, 1.0, "newton");
+    RegisterUnit("kN", UnitType::Force, 1000.0, "kilonewton");
+    RegisterUnit("J", UnitType::Energy, 1.0, "joule");
+    RegisterUnit("kJ", UnitType::Energy, 1000.0, "kilojoule");
+    RegisterUnit("kWh", UnitType::Energy, 3.6e6, "kilowatt hour");
+    RegisterUnit("W", UnitType::Power, 1.0, "watt");
+    RegisterUnit("kW", UnitType::Power, 1000.0, "kilowatt");
+    RegisterUnit("Pa", UnitType::Pressure, 1.0, "pascal");
+    RegisterUnit("kPa", UnitType::Pressure, 1000.0, "kilopascal");
+    RegisterUnit("bar", UnitType::Pressure, 1e5, "bar");
+    RegisterUnit("atm", UnitType::Pressure, 101325.0, "atmosphere");
+    RegisterUnit("V", Dimensions::Voltage, 1.0, "volt");
+
+    symbols_.Build(units_);
+    symbols_ready_ = true;
+}
+
+Dimension UnitManager::DimensionOf(UnitType type) {
+    switch (type) {
+        case UnitType::Length: return Dimensions::Length;
+        case UnitType::Time: return Dimensions::Time;
+        case UnitType::Mass: return Dimensions::Mass;
+        case UnitType::Temperature: return Dimensions::Temperature;
+        case UnitType::Current: return Dimensions::Current;
+        case UnitType::Area: return Dimensions::Area;
+        case UnitType::Volume: return Dimensions::Volume;
+        case UnitType::Velocity: return Dimensions::Velocity;
+        case UnitType::Acceleration: return Dimensions::Acceleration;
+        case UnitType::Force: return Dimensions::Force;
+        case UnitType::Energy: return Dimensions::Energy;
+        case UnitType::Power: return Dimensions::Power;
+        case UnitType::Pressure: return Dimensions::Pressure;
+        case UnitType::Angle:   // Radians are a ratio of lengths
+        case UnitType::Dimensionless: break;
+    }
+    return Dimensions::Dimensionless;
 }
 
 void UnitManager::RegisterUnit(const std::string& symbol, UnitType type, double scale, const std::string& name) {
-    units_[symbol] = {type, scale, symbol, name};
+    units_[symbol] = {type, scale, symbol, name, DimensionOf(type)};
+    if (symbols_ready_) symbols_.Build(units_);
+    std::lock_guard<std::mutex> lock(conversions_mutex_);
+    conversions_.clear();
 }
 
-EngineResult UnitManager::ConvertUnit(double value, const std::string& from_unit, const std::string& to_unit) {
-    auto from_it = units_.find(from_unit);
-    auto to_it = units_.find(to_unit);
-    
-    if (from_it == units_.end() || to_it == units_.end()) {
-        return {{}, {CalcErr::OperationNotFound}};
+void UnitManager::RegisterUnit(const std::string& symbol, const Dimension& dimension, double scale,
+                               const std::string& name, double offset) {
+    units_[symbol] = {TypeOf(dimension), scale, symbol, name, dimension, offset};
+    if (symbols_ready_) symbols_.Build(units_);
+    std::lock_guard<std::mutex> lock(conversions_mutex_);
+    conversions_.clear();
+}
+
+std::optional<CompoundUnit> UnitManager::ParseUnit(std::string_view text) const {
+    return UnitExpressionParser(text, symbols_).Run();
+}
+
+std::optional<UnitConversion> UnitManager::GetConversion(const std::string& from_unit, const std::string& to_unit,
+                                                         CalcErr* error) {
+    std::string key = from_unit;
+    key += '\0';
+    key += to_unit;
+    {
+        std::lock_guard<std::mutex> lock(conversions_mutex_);
+        auto it = conversions_.find(key);
+        if (it != conversions_.end()) return it->second;
     }
-    
-    if (from_it->second.type != to_it->second.type) {
-        return {{}, {CalcErr::ArgumentMismatch}};
+
+    auto from = ParseUnit(from_unit);
+    auto to = ParseUnit(to_unit);
+    if (!from || !to) {
+        if (error) *error = CalcErr::OperationNotFound;
+        return std::nullopt;
     }
-    
-    // Special handling for temperature
-    if (from_it->second.type == UnitType::Temperature) {
-        return ConvertTemperature(value, from_unit, to_unit);
+    if (from->dimension != to->dimension) {
+        if (error) *error = CalcErr::ArgumentMismatch;
+        return std::nullopt;
     }
-    
-    // Standard linear conversion: convert to base unit, then to target unit
-    double base_value = value * from_it->second.scale_factor;
-    double result = base_value / to_it->second.scale_factor;
-    
-    return {EngineSuccessResult(result), {}};
+
+    // SI value = value * scale + offset on both sides
+    UnitConversion conversion;
+    conversion.factor = from->scale / to->scale;
+    conversion.offset = (from->offset - to->offset) / to->scale;
+    std::lock_guard<std::mutex> lock(conversions_mutex_);
+    if (conversions_.size() >= kMaxCachedConversions) conversions_.clear();
+    conversions_.emplace(std::move(key), conversion);
+    return conversion;
+}
+
+EngineResult UnitManager::ConvertUnit(double value, const std::string& from_unit, const std::string& to_unit) {
+    CalcErr error = CalcErr::None;
+    auto conversion = GetConversion(from_unit, to_unit, &error);
+    if (!conversion) {
+        return {{}, {error}};
+    }
+    return EngineSuccessResult(conversion->Apply(value));
+}
+
+EngineResult UnitManager::ConvertUnit(const Vector& values, const std::string& from_unit, const std::string& to_unit) {
+    CalcErr error = CalcErr::None;
+    auto conversion = GetConversion(from_unit, to_unit, &error);
+    if (!conversion) {
+        return {{}, {error}};
+    }
+    Vector converted(values.size());
+    AXIOM::SIMD::Kernels().affine(values.data(), converted.data(), values.size(), conversion->factor, conversion->offset);
+    return EngineSuccessResult(converted);
 }
 
 EngineResult UnitManager::ConvertTemperature(double value, const std::string& from_unit, const std::string& to_unit) {
@@ -92,13 +378,13 @@ EngineResult UnitManager::ConvertTemperature(double value, const std::string& fr
         return {{}, {CalcErr::OperationNotFound}};
     }
     
-    return {EngineSuccessResult(result), {}};
+    return EngineSuccessResult(result);
 }
 
 bool UnitManager::AreCompatible(const std::string& unit1, const std::string& unit2) {
-    auto u1 = units_.find(unit1);
-    auto u2 = units_.find(unit2);
-    return (u1 != units_.end() && u2 != units_.end() && u1->second.type == u2->second.type);
+    auto u1 = ParseUnit(unit1);
+    auto u2 = ParseUnit(unit2);
+    return u1 && u2 && u1->dimension == u2->dimension;
 }
 
 std::string UnitManager::GetCanonicalUnit(UnitType type) {
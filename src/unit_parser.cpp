@@ -1,32 +1,153 @@
 #include "unit_parser.h"
+#include "compiled_expression.h"
 #include "string_helpers.h"
-#include <regex>
-#include <sstream>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+bool IsSpace(char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+
+std::string_view Trim(std::string_view text) {
+    while (!text.empty() && IsSpace(text.front())) text.remove_prefix(1);
+    while (!text.empty() && IsSpace(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+// One number at pos (sign and exponent allowed); advances pos past it
+bool ScanNumber(std::string_view text, size_t& pos, double& value) {
+    const char* first = text.data() + pos;
+    const char* last = text.data() + text.size();
+    if (first != last && *first == '+') ++first;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc()) return false;
+    pos = static_cast<size_t>(ptr - text.data());
+    return true;
+}
+
+// "[1, -2.5e3 4]": comma and/or whitespace separated
+bool ScanList(std::string_view text, size_t& pos, Vector& values) {
+    ++pos;   // '['
+    for (;;) {
+        while (pos < text.size() && (IsSpace(text[pos]) || text[pos] == ',')) ++pos;
+        if (pos == text.size()) return false;
+        if (text[pos] == ']') {
+            ++pos;
+            return true;
+        }
+        double value;
+        if (!ScanNumber(text, pos, value)) return false;
+        values.push_back(value);
+    }
+}
+
+bool IsNameStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+bool IsNameChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+
+// Offset of the word "to" with whitespace on both sides
+size_t FindToKeyword(std::string_view text) {
+    for (size_t i = 1; i + 2 < text.size(); ++i) {
+        if (text[i] == 't' && text[i + 1] == 'o' && IsSpace(text[i - 1]) && IsSpace(text[i + 2])) return i;
+    }
+    return std::string_view::npos;
+}
+
+} // namespace
 
 EngineResult UnitParser::ParseAndExecute(const std::string& input) {
-    if (IsUnitConversion(input)) {
-        return ParseConversion(input);
+    auto request = Scan(input);
+    if (!request) {
+        return {{}, {CalcErr::ParseError}};
+    }
+    if (request->is_list) {
+        return unit_manager_->ConvertUnit(request->values, request->from_unit, request->to_unit);
+    }
+    return unit_manager_->ConvertUnit(request->values.front(), request->from_unit, request->to_unit);
+}
+
+std::optional<UnitConversionRequest> UnitParser::Scan(const std::string& input) {
+    std::string_view text = Trim(input);
+    constexpr std::string_view kConvert = "convert";
+    if (text.substr(0, kConvert.size()) == kConvert && text.size() > kConvert.size() && IsSpace(text[kConvert.size()])) {
+        text = Trim(text.substr(kConvert.size()));
+    }
+
+    UnitConversionRequest request;
+    size_t pos = 0;
+    if (!text.empty() && text.front() == '[') {
+        request.is_list = true;
+        if (!ScanList(text, pos, request.values)) return std::nullopt;
+    } else {
+        double value;
+        if (!ScanNumber(text, pos, value)) return std::nullopt;
+        request.values.push_back(value);
     }
-    return {{}, {CalcErr::ParseError}};
+
+    // "5 m to ft" and "5m to ft": the units are everything either side of "to"
+    std::string_view rest = text.substr(pos);
+    const size_t to = FindToKeyword(rest);
+    if (to == std::string_view::npos) return std::nullopt;
+    const std::string_view from_unit = Trim(rest.substr(0, to));
+    const std::string_view to_unit = Trim(rest.substr(to + 2));
+    if (from_unit.empty() || to_unit.empty()) return std::nullopt;
+    request.from_unit = from_unit;
+    request.to_unit = to_unit;
+    return request;
 }
 
-bool UnitParser::IsUnitConversion(const std::string& input) {
-    // Look for patterns like "5 meters to feet" or "convert 10 kg to lb"
-    std::regex pattern(R"((convert\s+)?(\d+(?:\.\d+)?)\s+(\w+)\s+to\s+(\w+))");
-    return std::regex_search(input, pattern);
+bool UnitParser::HasUnitLiteral(std::string_view input, const UnitManager& units,
+                                const std::map<std::string, double>& context) {
+    for (size_t pos = 0; pos < input.size();) {
+        // Digits inside a name ("x2") are not a literal
+        if (IsNameChar(input[pos]) && !std::isdigit(static_cast<unsigned char>(input[pos]))) {
+            while (pos < input.size() && IsNameChar(input[pos])) ++pos;
+            continue;
+        }
+        const size_t length = CompiledExpression::NumberLength(input.substr(pos));
+        if (length == 0) {
+            ++pos;
+            continue;
+        }
+        pos += length;
+        size_t start = pos;
+        while (start < input.size() && IsSpace(input[start])) ++start;
+        if (start == input.size() || !IsNameStart(input[start])) continue;
+        size_t end = start;
+        while (end < input.size() && IsNameChar(input[end])) ++end;
+        size_t next = end;
+        while (next < input.size() && IsSpace(input[next])) ++next;
+        const std::string_view name = input.substr(start, end - start);
+        if ((next == input.size() || input[next] != '(') && !context.count(std::string(name)) && units.FindUnit(name)) {
+            return true;
+        }
+        pos = end;
+    }
+    return false;
 }
 
-EngineResult UnitParser::ParseConversion(const std::string& input) {
-    std::regex pattern(R"((convert\s+)?(\d+(?:\.\d+)?)\s+(\w+)\s+to\s+(\w+))");
-    std::smatch matches;
-    
-    if (std::regex_search(input, matches, pattern)) {
-        double value = std::stod(matches[2].str());
-        std::string from_unit = matches[3].str();
-        std::string to_unit = matches[4].str();
-        
-        return unit_manager_->ConvertUnit(value, from_unit, to_unit);
+std::optional<EngineResult> UnitParser::EvaluateQuantity(const std::string& input,
+                                                         const std::map<std::string, double>& context,
+                                                         const UnitManager& units) {
+    if (!HasUnitLiteral(input, units, context)) return std::nullopt;
+
+    // Units are checked and folded to SI by the compile, so a dimension error is
+    // reported before anything is evaluated and evaluation is on plain doubles
+    std::vector<std::string> names;
+    std::vector<double> values;
+    for (const auto& [name, value] : context) {
+        names.push_back(name);
+        values.push_back(value);
     }
-    
-    return {{}, {CalcErr::ParseError}};
-}
\ No newline at end of file
+    bool dimension_error = false;
+    auto compiled = CompiledExpression::Compile(input, names, units, nullptr, &dimension_error);
+    if (dimension_error) return EngineResult{{}, {EngineErrorResult(CalcErr::ArgumentMismatch)}};
+    if (!compiled || !compiled->HasUnits()) return std::nullopt;
+
+    double value = compiled->EvaluateAt(values.data());
+    if (std::isnan(value)) return EngineResult{{}, {EngineErrorResult(CalcErr::DomainError)}};
+    const Dimension& dimension = compiled->ResultDimension();
+    if (dimension.IsDimensionless()) return EngineSuccessResult(value);
+    return EngineSuccessResult(Utils::FormatNumber(value) + " " + dimension.ToString());
+}
@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <cstring>
 #include <cassert>
 #include <iomanip>
 #include <functional>
@@ -9,6 +10,41 @@
 // Proje dosyalarını dahil ediyoruz
 #include "dynamic_calc.h"
 #include "string_helpers.h"
+#include "parallel.h"
+#include "quantile_select.h"
+#include "streaming_statistics.h"
+#include "rolling_window.h"
+#include "compensated_sum.h"
+#include "data_loader.h"
+#include "linear_model.h"
+#include "statistics_parser.h"
+#include "distributions.h"
+#include "binning.h"
+#include "frequency_table.h"
+#include "resampling.h"
+#include "plot_engine.h"
+#include "compiled_expression.h"
+#include "curve_sampling.h"
+#include "surface_grid.h"
+#include "level_of_detail.h"
+#include "raster_plot.h"
+#include "plot_tile_cache.h"
+#include "quantity.h"
+#include "unit_manager.h"
+#include "unit_parser.h"
+#include "sparse_polynomial.h"
+#include "symbolic_engine.h"
+#include "simd_kernels.h"
+#include "linear_system_parser.h"
+#include "daemon_engine.h"
+#include "../core/dispatch/selective_dispatcher.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <numeric>
+#include <random>
 
 using namespace AXIOM;
 
@@ -580,6 +616,2003 @@ void Test_ComplexOperations() {
     std::cout << "[   OK  ] Test_ComplexOperations" << std::endl;
 }
 
+void Test_DispatchBatch() {
+    std::cout << "[RUNNING] Test_DispatchBatch..." << std::endl;
+
+    SelectiveDispatcher dispatcher;
+    ASSERT_EQ(true, dispatcher.ClassifyOperation("2 + 3") == OperationComplexity::Simple);
+    ASSERT_EQ(true, dispatcher.ClassifyOperation("sin(30)") == OperationComplexity::Medium);
+    ASSERT_EQ(true, dispatcher.ClassifyOperation("derivative(x^2, x)") == OperationComplexity::Extreme);
+
+    // Results come back in input order; one shape is classified once, repeats evaluate once
+    std::vector<std::string> batch = {"2 + 3", "10 + 1.5", "2 + 3", "sqrt(16)", "1 / 4", "2 + 3"};
+    std::vector<EngineResult> results = dispatcher.DispatchBatch(batch);
+    ASSERT_EQ(batch.size(), results.size());
+    ASSERT_NEAR(5.0, results[0].GetDouble().value_or(NAN), 1e-12);
+    ASSERT_NEAR(11.5, results[1].GetDouble().value_or(NAN), 1e-12);
+    ASSERT_NEAR(5.0, results[2].GetDouble().value_or(NAN), 1e-12);
+    ASSERT_NEAR(4.0, results[3].GetDouble().value_or(NAN), 1e-12);
+    ASSERT_NEAR(0.25, results[4].GetDouble().value_or(NAN), 1e-12);
+    ASSERT_NEAR(5.0, results[5].GetDouble().value_or(NAN), 1e-12);
+
+    BatchDispatchMetrics metrics = dispatcher.GetLastBatchMetrics();
+    ASSERT_EQ(6u, metrics.operation_count);
+    ASSERT_EQ(4u, metrics.distinct_expressions);
+    // "2 + 3" was classified above; "10 + 1.5" shares its shape
+    ASSERT_EQ(2u, metrics.classifications);
+    ASSERT_EQ(4u, metrics.classification_cache_hits);
+    ASSERT_EQ(6u, metrics.engine_group_sizes[ComputeEngine::Native]);
+
+    // A batch result matches the single dispatch of the same expression
+    ASSERT_NEAR(dispatcher.DispatchOperation("sqrt(16)").GetDouble().value_or(NAN), results[3].GetDouble().value_or(NAN), 1e-12);
+    ASSERT_EQ(0u, dispatcher.DispatchBatch(std::vector<std::string>{}).size());
+
+    std::cout << "[   OK  ] Test_DispatchBatch" << std::endl;
+}
+
+void Test_ThreadPool() {
+    std::cout << "[RUNNING] Test_ThreadPool..." << std::endl;
+
+    // parallel_for touches every index exactly once
+    std::vector<int> hits(100000, 0);
+    Parallel::ParallelFor(0, hits.size(), 1000, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) hits[i]++;
+    });
+    ASSERT_EQ(static_cast<long>(hits.size()), static_cast<long>(std::accumulate(hits.begin(), hits.end(), 0L)));
+
+    // Weighted ranges cover a few heavy items exactly once as well
+    std::vector<int> heavy(300, 0);
+    Parallel::ParallelForWork(heavy.size(), 1000, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) heavy[i]++;
+    });
+    ASSERT_EQ(true, std::all_of(heavy.begin(), heavy.end(), [](int h) { return h == 1; }));
+    Parallel::ParallelForWork(0, 1000, [&](size_t, size_t) { heavy[0]++; });
+    ASSERT_EQ(1, heavy[0]);
+    auto heavy_sum = Parallel::ParallelReduceWork(heavy.size(), 1000, size_t{0}, [](size_t lo, size_t hi) {
+        size_t sum = 0;
+        for (size_t i = lo; i < hi; ++i) sum += i;
+        return sum;
+    }, std::plus<size_t>{});
+    ASSERT_EQ(static_cast<size_t>(299 * 300 / 2), heavy_sum);
+
+    // parallel_reduce is deterministic across runs
+    std::vector<double> values(200000);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = 1.0 / (1.0 + i);
+    auto reduce = [&] {
+        return Parallel::ParallelReduce(0, values.size(), 0, 0.0,
+            [&](size_t lo, size_t hi) { double s = 0; for (size_t i = lo; i < hi; ++i) s += values[i]; return s; },
+            [](double a, double b) { return a + b; });
+    };
+    double first = reduce();
+    ASSERT_EQ(first, reduce());
+    ASSERT_NEAR(first, std::accumulate(values.begin(), values.end(), 0.0), 1e-9);
+
+    // parallel_sort matches std::sort
+    std::vector<int> data(100000);
+    std::mt19937 rng(42);
+    for (auto& v : data) v = static_cast<int>(rng() % 1000000);
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    Parallel::ParallelSort(data.begin(), data.end());
+    ASSERT_EQ(true, data == expected);
+
+    // Nested task groups complete without deadlock
+    std::atomic<int> leaves{0};
+    TaskGroup outer;
+    for (int i = 0; i < 8; ++i) {
+        outer.Run([&leaves] {
+            TaskGroup inner;
+            for (int j = 0; j < 8; ++j) inner.Run([&leaves] { leaves++; });
+            inner.Wait();
+        });
+    }
+    outer.Wait();
+    ASSERT_EQ(64, leaves.load());
+
+    // Exceptions propagate to the waiter
+    bool caught = false;
+    try {
+        TaskGroup group;
+        group.Run([] { throw std::runtime_error("task failure"); });
+        group.Wait();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    ASSERT_EQ(true, caught);
+    ASSERT_EQ(true, DynamicCalc::GetThreadCount() >= 1);
+
+    // The global pool is not replaced under running work, and a replaced pool stays usable
+    ThreadPool& previous = ThreadPool::Global();
+    std::atomic<bool> started{false}, release{false};
+    {
+        TaskGroup busy;
+        busy.Run([&] {
+            started = true;
+            while (!release) std::this_thread::yield();
+        });
+        while (!started) std::this_thread::yield();
+        ASSERT_EQ(false, ThreadPool::SetGlobalThreadCount(2));
+        ASSERT_EQ(true, &previous == &ThreadPool::Global());
+        release = true;
+        busy.Wait();
+    }
+    ASSERT_EQ(true, ThreadPool::SetGlobalThreadCount(2));
+    ASSERT_EQ(2u, ThreadPool::Global().Size());
+    std::atomic<int> stale_runs{0};
+    TaskGroup stale(previous);
+    for (int i = 0; i < 4; ++i) stale.Run([&stale_runs] { stale_runs++; });
+    stale.Wait();
+    ASSERT_EQ(4, stale_runs.load());
+    ASSERT_EQ(true, ThreadPool::SetGlobalThreadCount(0));
+
+    std::cout << "[   OK  ] Test_ThreadPool" << std::endl;
+}
+
+void Test_Daemon() {
+    std::cout << "[RUNNING] Test_Daemon..." << std::endl;
+
+    // Thread layout: flags override the config file, invalid layouts are rejected
+    auto config_path = std::filesystem::temp_directory_path() / "axiom_test_daemon.conf";
+    {
+        std::ofstream out(config_path);
+        out << "# test layout\ncompute.threads = 3\ncompute.sched = fifo:10\npool.spin_us = 20\n";
+    }
+    DaemonConfig config;
+    std::string error;
+    ASSERT_EQ(true, config.ApplyArgs({"--daemon-config=" + config_path.string(),
+                                      "--compute-threads=2", "--compute-cpus=0", "--compute-pin=true",
+                                      "--compute-spin-us=100", "--pipe=ignored"}, error));
+    std::filesystem::remove(config_path);
+    ASSERT_EQ(2u, config.compute.threads);
+    ASSERT_EQ(10, config.compute.placement.fifo_priority);
+    ASSERT_EQ(true, config.compute.placement.pin_each);
+    ASSERT_EQ(1u, config.compute.placement.cpus.size());
+    ASSERT_EQ(100, config.compute.spin_us);
+    ASSERT_EQ(20, config.pool.spin_us);
+    ASSERT_EQ(true, config.Describe().find("(pinned)") != std::string::npos);
+
+    DaemonConfig rejected;
+    ASSERT_EQ(false, rejected.Set("io.threads", "2", error));
+    ASSERT_EQ(false, rejected.Set("compute.threads", "0", error));
+    ASSERT_EQ(false, rejected.Set("compute.sched", "fifo:100", error));
+    ASSERT_EQ(false, rejected.Set("compute.cpus", "3-1", error));
+    ASSERT_EQ(false, rejected.Set("gpu.threads", "1", error));
+
+    // A pool layout that cannot be applied (the pool is busy) fails start() rather than being ignored
+    {
+        std::atomic<bool> release{false};
+        ThreadPool::Global().Submit([&release] {
+            while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        DaemonConfig busy;
+        ASSERT_EQ(true, busy.Set("pool.threads", "2", error));
+        DaemonEngine refused("axiom_test_daemon_busy", busy);
+        ASSERT_EQ(false, refused.start());
+        ASSERT_EQ(true, refused.get_status() == DaemonEngine::DaemonStatus::ERROR);
+        release.store(true);
+        while (ThreadPool::Global().Outstanding() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Each compute worker applies its placement and reports it in the layout
+    DaemonConfig layout;
+    ASSERT_EQ(true, layout.Set("compute.threads", "2", error));
+    ASSERT_EQ(true, layout.Set("compute.cpus", "0", error));
+    ASSERT_EQ(true, layout.Set("compute.pin", "true", error));
+    DaemonEngine daemon("axiom_test_daemon", layout);
+    ASSERT_EQ(true, daemon.start());
+    auto wait_for = [](const std::function<bool()>& done) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return done();
+    };
+    ASSERT_EQ(true, wait_for([&] {
+        std::string report = daemon.get_status_report();
+        return report.find("compute[0] cpus {0}") != std::string::npos &&
+               report.find("compute[1] cpus {0}") != std::string::npos;
+    }));
+
+    // Synchronous requests go through the session engine and the stream sketches
+    DaemonEngine::Request request;
+    request.session_id = daemon.create_session();
+    request.command = "2+3*4";
+    request.mode = "algebraic";
+    auto response = daemon.process_request(request);
+    ASSERT_EQ(true, response.success);
+    ASSERT_EQ(std::string("14"), response.result);
+    request.mode = "quantum";
+    ASSERT_EQ(false, daemon.process_request(request).success);
+
+    // Stream mode (or a raw "stream " prefix) feeds the daemon-wide sketches
+    auto stream = [&](const std::string& command, const std::string& mode) {
+        DaemonEngine::Request r;
+        r.session_id = request.session_id;
+        r.command = command;
+        r.mode = mode;
+        return daemon.process_request(r);
+    };
+    ASSERT_EQ(std::string("4"), stream("add sizes 1 2 3 4", "stream").result);
+    ASSERT_EQ(std::string("1"), stream("stream add sizes 5", "").result);
+    ASSERT_EQ(std::string("3"), stream("quantile sizes 0.5 kll", "stream").result);
+    std::string exported = stream("export sizes", "stream").result;
+    ASSERT_EQ(std::string("merged"), stream("merge copy " + exported, "stream").result);
+    ASSERT_EQ(5.0, static_cast<double>(daemon.get_streams().Describe("copy")->count));
+    ASSERT_EQ(false, stream("quantile missing 0.5", "stream").success);
+    ASSERT_EQ(false, stream("merge copy not-base64", "stream").success);
+
+    // Queued requests record enqueue-to-completion latency; p99 sits between p50 and max
+    const size_t queued = 200;
+    for (size_t i = 0; i < queued; ++i) {
+        ASSERT_EQ(true, daemon.send_command(request.session_id, "add latency " + std::to_string(i), "stream"));
+    }
+    ASSERT_EQ(true, wait_for([&] { return daemon.get_latency_summary().samples == queued; }));
+    auto latency = daemon.get_latency_summary();
+    ASSERT_EQ(true, latency.p50_us > 0.0);
+    ASSERT_EQ(true, latency.p50_us <= latency.p99_us);
+    ASSERT_EQ(true, latency.p99_us <= latency.max_us);
+    ASSERT_EQ(static_cast<double>(queued), daemon.get_streams().Describe("latency")->count);
+    daemon.reset_latency_samples();
+    ASSERT_EQ(0u, daemon.get_latency_summary().samples);
+
+    daemon.stop();
+    ASSERT_EQ(false, daemon.is_running());
+
+    std::cout << "[   OK  ] Test_Daemon" << std::endl;
+}
+
+void Test_SimdKernels() {
+    std::cout << "[RUNNING] Test_SimdKernels..." << std::endl;
+
+    // Integer inputs keep every kernel exact, so each ISA must match the known answer
+    const size_t M = 3, K = 5, N = 11, n = 19;
+    Vector A(M * K), B(K * N), expected_c(M * N, 0.0);
+    for (size_t i = 0; i < A.size(); ++i) A[i] = static_cast<double>(static_cast<int>(i % 7) - 3);
+    for (size_t i = 0; i < B.size(); ++i) B[i] = static_cast<double>(static_cast<int>(i % 5) - 2);
+    for (size_t i = 0; i < M; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+            for (size_t k = 0; k < K; ++k) expected_c[i * N + j] += A[i * K + k] * B[k * N + j];
+        }
+    }
+    const Vector coeffs = {4.0, -3.0, 0.0, 2.0};   // 4 - 3x + 2x^3
+    Vector x(n), expected_y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<double>(static_cast<int>(i) - 9);
+        expected_y[i] = 4.0 - 3.0 * x[i] + 2.0 * x[i] * x[i] * x[i];
+    }
+
+    size_t levels = 0;
+    for (ISALevel level : {ISALevel::Scalar, ISALevel::AVX2, ISALevel::AVX512}) {
+        const AXIOM::SIMD::KernelTable* kernels = AXIOM::SIMD::KernelsFor(level);
+        if (!kernels) continue;
+        ++levels;
+        Vector C(M * N, -1.0), y(n);
+        kernels->gemm(A.data(), B.data(), C.data(), M, K, N);
+        ASSERT_EQ(true, C == expected_c);
+        kernels->poly_eval(coeffs.data(), coeffs.size() - 1, x.data(), y.data(), n);
+        ASSERT_EQ(true, y == expected_y);
+        ASSERT_EQ(std::accumulate(x.begin(), x.end(), 0.0), kernels->sum(x.data(), n));
+        ASSERT_EQ(std::inner_product(x.begin(), x.end(), expected_y.begin(), 0.0), kernels->dot(x.data(), expected_y.data(), n));
+        double moments[4];
+        kernels->central_moments_kb(x.data(), n, 1.0, moments);   // x - 1 spans -10..8
+        ASSERT_EQ(589.0, moments[0] + moments[1]);
+        ASSERT_EQ(-1729.0, moments[2]);
+        ASSERT_EQ(34105.0, moments[3]);
+    }
+    ASSERT_EQ(true, levels >= 1);
+
+    // Sums of monomials compile to one poly_eval pass; other programs keep the stack path
+    auto cubic = CompiledExpression::Compile("2x^3 - 3x + 4", {"x"});
+    ASSERT_EQ(true, cubic->IsPolynomial());
+    ASSERT_EQ(false, CompiledExpression::Compile("2x(x + 1)(x - 1)", {"x"})->IsPolynomial());
+    ASSERT_EQ(false, CompiledExpression::Compile("x^2 + sin(x)", {"x"})->IsPolynomial());
+    Vector y(n);
+    cubic->Evaluate(x.data(), y.data(), n);
+    ASSERT_EQ(true, y == expected_y);
+    ASSERT_EQ(expected_y[3], cubic->EvaluateAt(&x[3]));
+
+    // LinearSystemParser multiplies through gemm on every QR iteration
+    LinearSystemParser linear;
+    Vector eigenvalues = GetVector(linear.ParseAndExecute("eigen [2, 1; 1, 2]"));
+    ASSERT_EQ(2u, eigenvalues.size());
+    ASSERT_NEAR(3.0, std::max(eigenvalues[0], eigenvalues[1]), 1e-9);
+    ASSERT_NEAR(1.0, std::min(eigenvalues[0], eigenvalues[1]), 1e-9);
+
+    std::cout << "[   OK  ] Test_SimdKernels" << std::endl;
+}
+
+void Test_MomentAccumulator() {
+    std::cout << "[RUNNING] Test_MomentAccumulator..." << std::endl;
+
+    StatisticsEngine stats;
+    Vector x = {2.0, 4, 4, 4, 5, 5, 7, 9, 12, 1.5};
+
+    // Reference values: scipy.stats skew/kurtosis with bias=False
+    auto d = StatisticsEngine::Accumulate(x).Describe();
+    ASSERT_EQ(10, static_cast<int>(d.count));
+    ASSERT_NEAR(5.35, d.mean, 1e-12);
+    ASSERT_NEAR(10.225, d.variance, 1e-12);
+    ASSERT_NEAR(1.0410286440022467, d.skewness, 1e-12);
+    ASSERT_NEAR(0.8715901757550248, d.kurtosis, 1e-12);
+    ASSERT_NEAR(1.5, d.min, 1e-15);
+    ASSERT_NEAR(12.0, d.max, 1e-15);
+
+    ASSERT_NEAR(1.0410286440022467, stats.Skewness(x).GetDouble().value(), 1e-12);
+    ASSERT_NEAR(std::sqrt(10.225), stats.StandardDeviation(x).GetDouble().value(), 1e-12);
+
+    // Merging any split equals a single pass
+    MomentAccumulator left, right, streamed;
+    for (size_t i = 0; i < x.size(); ++i) {
+        (i < 3 ? left : right).Push(x[i]);
+        streamed.Push(x[i]);
+    }
+    left.Merge(right);
+    ASSERT_NEAR(streamed.m4, left.m4, 1e-9);
+    ASSERT_NEAR(d.kurtosis, left.Kurtosis(), 1e-12);
+
+    // Large, offset input exercises the parallel chunked path
+    Vector big(1000000);
+    for (size_t i = 0; i < big.size(); ++i) big[i] = 1e6 + static_cast<double>(i % 1000);
+    auto big_stats = StatisticsEngine::Accumulate(big).Describe();
+    ASSERT_NEAR(1e6 + 499.5, big_stats.mean, 1e-6);
+    ASSERT_NEAR(83333.25 * 1000000.0 / 999999.0, big_stats.variance, 1e-4);
+
+    Vector y;
+    for (double v : x) y.push_back(v * v);
+    ASSERT_NEAR(0.970987964588854, stats.Correlation(x, y).GetDouble().value(), 1e-12);
+    ASSERT_EQ(true, stats.Describe(Vector{}).HasErrors());
+
+    std::cout << "[   OK  ] Test_MomentAccumulator" << std::endl;
+}
+
+void Test_QuantileSelection() {
+    std::cout << "[RUNNING] Test_QuantileSelection..." << std::endl;
+
+    StatisticsEngine stats;
+    Vector data = {7, 1, 9, 3, 5, 3, 8, 2, 6, 4};   // sorted: 1 2 3 3 4 5 6 7 8 9
+
+    ASSERT_NEAR(4.5, stats.Median(data).GetDouble().value(), 1e-12);
+    ASSERT_NEAR(3.0, stats.Percentile(data, 25).GetDouble().value(), 1e-12);   // h = 2.25 -> 3 + 0.25 * 0
+    ASSERT_NEAR(6.75, stats.Percentile(data, 75).GetDouble().value(), 1e-12);  // h = 6.75 -> 6 + 0.75 * 1
+    ASSERT_NEAR(3.75, stats.InterquartileRange(data).GetDouble().value(), 1e-12);
+
+    auto quartiles = stats.Quartiles(data);
+    ASSERT_EQ(true, quartiles.HasResult());
+    ASSERT_NEAR(4.5, std::get<Vector>(*quartiles.result)[1], 1e-12);
+
+    // In-place multi-select on a caller buffer matches a full sort
+    std::mt19937 rng(7);
+    Vector buffer(10001);
+    for (auto& v : buffer) v = static_cast<double>(rng() % 1000);
+    Vector sorted = buffer;
+    std::sort(sorted.begin(), sorted.end());
+    auto q = StatisticsEngine::QuantilesInPlace(buffer, Vector{0.0, 0.1, 0.5, 0.9, 1.0});
+    const auto& values = std::get<Vector>(*q.result);
+    ASSERT_NEAR(sorted[0], values[0], 1e-12);
+    ASSERT_NEAR(sorted[1000], values[1], 1e-12);
+    ASSERT_NEAR(sorted[5000], values[2], 1e-12);
+    ASSERT_NEAR(sorted[9000], values[3], 1e-12);
+    ASSERT_NEAR(sorted[10000], values[4], 1e-12);
+
+    // Parallel bracketed selection leaves the input untouched
+    Vector large(200000);
+    for (auto& v : large) v = static_cast<double>(rng() % 100000) / 7.0;
+    Vector copy = large;
+    double probs[] = {0.25, 0.5, 0.75};
+    double out[3];
+    Selection::ParallelQuantiles(large.data(), large.size(), probs, 3, out);
+    ASSERT_EQ(true, large == copy);
+    std::sort(copy.begin(), copy.end());
+    double h = 0.75 * (copy.size() - 1);
+    size_t lo = static_cast<size_t>(h);
+    ASSERT_NEAR(copy[lo] + (h - lo) * (copy[lo + 1] - copy[lo]), out[2], 1e-9);
+
+    // Heavy ties collapse brackets onto one value; counted bounds still land every rank
+    Vector tied(200000);
+    for (size_t i = 0; i < tied.size(); ++i) tied[i] = (i % 10 < 8) ? 5.0 : static_cast<double>(rng() % 1000) / 100.0;
+    double tied_probs[] = {0.01, 0.05, 0.5, 0.95, 0.99};
+    double tied_out[5];
+    Selection::ParallelQuantiles(tied.data(), tied.size(), tied_probs, 5, tied_out);
+    std::sort(tied.begin(), tied.end());
+    for (size_t p = 0; p < 5; ++p) {
+        double th = tied_probs[p] * (tied.size() - 1);
+        size_t tlo = static_cast<size_t>(th);
+        ASSERT_NEAR(tied[tlo] + (th - tlo) * (tied[tlo + 1] - tied[tlo]), tied_out[p], 1e-9);
+    }
+
+    ASSERT_EQ(true, stats.Percentile(data, 101).HasErrors());
+
+    std::cout << "[   OK  ] Test_QuantileSelection" << std::endl;
+}
+
+void Test_QuantileSketches() {
+    std::cout << "[RUNNING] Test_QuantileSketches..." << std::endl;
+
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    Vector data(200000);
+    for (auto& v : data) v = normal(rng);
+    Vector sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    auto rank_of = [&sorted](double v) {
+        return static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), v) - sorted.begin()) /
+               static_cast<double>(sorted.size());
+    };
+
+    // Two half-stream sketches merged through their serialized form
+    TDigest digest_a, digest_b;
+    KLLSketch kll_a, kll_b;
+    size_t half = data.size() / 2;
+    digest_a.AddRange(data.data(), half);
+    digest_b.AddRange(data.data() + half, data.size() - half);
+    kll_a.UpdateRange(data.data(), half);
+    kll_b.UpdateRange(data.data() + half, data.size() - half);
+
+    auto digest_blob = digest_b.Serialize();
+    auto kll_blob = kll_b.Serialize();
+    auto digest_copy = TDigest::Deserialize(digest_blob.data(), digest_blob.size());
+    auto kll_copy = KLLSketch::Deserialize(kll_blob.data(), kll_blob.size());
+    ASSERT_EQ(true, digest_copy.has_value() && kll_copy.has_value());
+    digest_a.Merge(*digest_copy);
+    kll_a.Merge(*kll_copy);
+
+    ASSERT_NEAR(static_cast<double>(data.size()), digest_a.Count(), 1e-9);
+    ASSERT_EQ(static_cast<uint64_t>(data.size()), kll_a.Count());
+    ASSERT_EQ(true, digest_a.CentroidCount() < 1000);
+    ASSERT_EQ(true, kll_a.RetainedItems() < 2000);
+
+    for (double q : {0.001, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999}) {
+        double tail = std::min(q, 1.0 - q);
+        ASSERT_NEAR(q, rank_of(digest_a.Quantile(q)), std::max(0.005, 0.5 * tail));
+        ASSERT_NEAR(q, rank_of(kll_a.Quantile(q)), 1.65 / 200);
+    }
+    ASSERT_NEAR(sorted.front(), digest_a.Quantile(0.0), 1e-12);
+    ASSERT_NEAR(sorted.back(), kll_a.Quantile(1.0), 1e-12);
+    ASSERT_NEAR(0.5, digest_a.CDF(0.0), 0.01);
+    ASSERT_NEAR(0.5, kll_a.Rank(0.0), 1.65 / 200);
+
+    // Truncated or foreign blobs are rejected
+    ASSERT_EQ(false, TDigest::Deserialize(digest_blob.data(), digest_blob.size() - 1).has_value());
+    ASSERT_EQ(false, KLLSketch::Deserialize(digest_blob.data(), digest_blob.size()).has_value());
+
+    // Corrupt headers are rejected before anything is allocated from them
+    auto patched = [](std::vector<uint8_t> blob, size_t offset, auto value) {
+        std::memcpy(blob.data() + offset, &value, sizeof(value));
+        return blob;
+    };
+    for (double compression : {double(INFINITY), double(NAN), 1e300, 0.0}) {
+        auto bad = patched(digest_blob, 2, compression);
+        ASSERT_EQ(false, TDigest::Deserialize(bad.data(), bad.size()).has_value());
+    }
+    auto huge_count = patched(digest_blob, 26, uint32_t{0xFFFFFFFF});
+    ASSERT_EQ(false, TDigest::Deserialize(huge_count.data(), huge_count.size()).has_value());
+    auto huge_k = patched(kll_blob, 2, uint32_t{0xFFFFFFFF});
+    ASSERT_EQ(false, KLLSketch::Deserialize(huge_k.data(), huge_k.size()).has_value());
+    uint64_t kll_n = 0;
+    std::memcpy(&kll_n, kll_blob.data() + 6, sizeof(kll_n));
+    auto wrong_n = patched(kll_blob, 6, kll_n + 1);
+    ASSERT_EQ(false, KLLSketch::Deserialize(wrong_n.data(), wrong_n.size()).has_value());
+
+    // Named streams: exact moments, sketch quantiles, base64 round trip
+    StreamingStatistics worker, host;
+    worker.Push("latency", data.data(), half);
+    host.Push("latency", data.data() + half, data.size() - half);
+    auto blob = worker.Serialize("latency");
+    auto decoded = Utils::Base64Decode(Utils::Base64Encode(blob.data(), blob.size()));
+    ASSERT_EQ(true, decoded.has_value() && *decoded == blob);
+    ASSERT_EQ(true, host.MergeSerialized("latency", decoded->data(), decoded->size()));
+
+    auto described = host.Describe("latency");
+    ASSERT_EQ(true, described.has_value());
+    ASSERT_EQ(static_cast<uint64_t>(data.size()), described->count);
+    double mean = std::accumulate(data.begin(), data.end(), 0.0) / static_cast<double>(data.size());
+    ASSERT_NEAR(mean, described->mean, 1e-12);
+    ASSERT_NEAR(0.5, rank_of(host.Quantile("latency", 0.5, SketchKind::KLL).value()), 1.65 / 200);
+    ASSERT_EQ(false, host.Quantile("missing", 0.5).has_value());
+    ASSERT_EQ(false, host.MergeSerialized("latency", blob.data(), blob.size() / 2));
+
+    std::cout << "[   OK  ] Test_QuantileSketches" << std::endl;
+}
+
+void Test_RollingWindows() {
+    std::cout << "[RUNNING] Test_RollingWindows..." << std::endl;
+
+    StatisticsEngine stats;
+    Vector data = {4, 8, 6, -1, -2, -3, -1, 3, 4, 5};
+
+    auto ma = stats.MovingAverage(data, 3);
+    ASSERT_EQ(true, ma.HasResult());
+    const auto& means = std::get<Vector>(*ma.result);
+    ASSERT_EQ(static_cast<size_t>(8), means.size());
+    ASSERT_NEAR(6.0, means[0], 1e-12);
+    ASSERT_NEAR(1.0, means[2], 1e-12);
+    ASSERT_NEAR(4.0, means[7], 1e-12);
+
+    ASSERT_NEAR(4.0, std::get<Vector>(*stats.RollingVariance(data, 3).result)[0], 1e-12);   // {4, 8, 6}
+    ASSERT_NEAR(-3.0, std::get<Vector>(*stats.RollingMin(data, 4).result)[2], 1e-12);     // {6, -1, -2, -3}
+    ASSERT_NEAR(8.0, std::get<Vector>(*stats.RollingMax(data, 4).result)[0], 1e-12);
+    ASSERT_NEAR(-1.5, std::get<Vector>(*stats.RollingMedian(data, 4).result)[3], 1e-12);  // {-1, -2, -3, -1}
+
+    auto smoothed = stats.ExponentialSmoothing(Vector{2, 4, 8}, 0.5);
+    ASSERT_NEAR(5.5, std::get<Vector>(*smoothed.result)[2], 1e-12);   // 2 -> 3 -> 5.5
+
+    // Long windows over a large offset agree with direct recomputation
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> normal(1e6, 2.0);
+    Vector series(20000);
+    for (auto& v : series) v = normal(rng);
+    const size_t w = 250;
+    auto variance = stats.RollingVariance(series, static_cast<int>(w));
+    auto median = stats.RollingMedian(series, static_cast<int>(w));
+    Rolling::MomentWindow moments(w);
+    Rolling::ExtremaWindow extrema(w);
+    for (size_t i = 0; i < series.size(); ++i) {
+        moments.Push(series[i]);
+        extrema.Push(series[i]);
+    }
+    for (size_t start : {size_t{0}, size_t{4095}, size_t{4096}, series.size() - w}) {
+        Vector window(series.begin() + start, series.begin() + start + w);
+        double expected_var = stats.Variance(window).GetDouble().value();
+        ASSERT_NEAR(expected_var, std::get<Vector>(*variance.result)[start], 1e-6);
+        ASSERT_NEAR(stats.Median(window).GetDouble().value(), std::get<Vector>(*median.result)[start], 1e-9);
+        if (start == series.size() - w) {
+            ASSERT_NEAR(expected_var, moments.Variance(), 1e-6);
+            ASSERT_NEAR(*std::min_element(window.begin(), window.end()), extrema.Min(), 1e-12);
+        }
+    }
+
+    // An inf only affects the windows that contain it
+    const double inf = std::numeric_limits<double>::infinity();
+    Vector spiked = {1, 2, 3, inf, 5, 6, 7, 8, -inf, 10, 11, 12};
+    const Vector spiked_mean = std::get<Vector>(*stats.MovingAverage(spiked, 3).result);
+    const Vector spiked_var = std::get<Vector>(*stats.RollingVariance(spiked, 3).result);
+    ASSERT_NEAR(2.0, spiked_mean[0], 1e-12);
+    ASSERT_EQ(inf, spiked_mean[1]);
+    ASSERT_EQ(inf, spiked_mean[3]);
+    ASSERT_NEAR(6.0, spiked_mean[4], 1e-12);
+    ASSERT_EQ(-inf, spiked_mean[8]);
+    ASSERT_NEAR(11.0, spiked_mean[9], 1e-12);
+    ASSERT_EQ(true, std::isnan(spiked_var[3]));
+    ASSERT_NEAR(1.0, spiked_var[4], 1e-12);   // {5, 6, 7}
+    ASSERT_NEAR(1.0, spiked_var[9], 1e-12);   // {10, 11, 12}
+    Vector both = {1, inf, -inf, 4, 5};
+    ASSERT_EQ(true, std::isnan(std::get<Vector>(*stats.MovingAverage(both, 3).result)[0]));
+    ASSERT_NEAR(4.5, std::get<Vector>(*stats.MovingAverage(both, 2).result)[3], 1e-12);
+    Rolling::MomentWindow streaming(3);
+    for (double v : spiked) {
+        streaming.Push(v);
+    }
+    ASSERT_NEAR(11.0, streaming.Mean(), 1e-12);
+    ASSERT_NEAR(1.0, streaming.Variance(), 1e-12);
+    streaming.Push(inf);
+    ASSERT_EQ(inf, streaming.Mean());
+    ASSERT_EQ(true, std::isnan(streaming.Variance()));
+
+    ASSERT_EQ(true, stats.MovingAverage(data, 0).HasErrors());
+    ASSERT_EQ(true, stats.RollingVariance(data, 1).HasErrors());
+    ASSERT_EQ(true, stats.RollingMedian(Vector{1.0, std::nan("")}, 1).HasErrors());
+    ASSERT_EQ(true, stats.ExponentialSmoothing(data, 1.5).HasErrors());
+
+    std::cout << "[   OK  ] Test_RollingWindows" << std::endl;
+}
+
+void Test_CompensatedSums() {
+    std::cout << "[RUNNING] Test_CompensatedSums..." << std::endl;
+
+    // Large cancelling pairs around small terms: naive summation drifts
+    std::mt19937_64 rng(9);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    Vector data;
+    data.reserve(300003);
+    for (int i = 0; i < 100001; ++i) {
+        double big = 1e16 * (1.0 + unit(rng));
+        data.push_back(big);
+        data.push_back(1.0);
+        data.push_back(-big);
+    }
+    ASSERT_NEAR(100001.0, Reduction::Sum(data.data(), data.size()), 1e-9);
+
+    StatisticsEngine stats;
+    ASSERT_NEAR(100001.0 / 300003.0, stats.Mean(data).GetDouble().value(), 1e-15);
+    // The single-pass accumulator compensates per block too
+    auto described = stats.Describe(data);
+    ASSERT_NEAR(100001.0 / 300003.0, std::get<Vector>(*described.result)[1], 1e-15);
+
+    // Same bits for repeated calls (fixed combination order)
+    double first = Reduction::Sum(data.data(), data.size());
+    ASSERT_EQ(true, first == Reduction::Sum(data.data(), data.size()));
+
+    // Variance and regression on a large offset keep full precision
+    Vector x(100000), y(100000);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = 1e9 + static_cast<double>(i % 2);
+        y[i] = 3.0 * x[i] + 7.0;
+    }
+    double n = static_cast<double>(x.size());
+    ASSERT_NEAR(0.25 * n / (n - 1.0), stats.Variance(x).GetDouble().value(), 1e-12);
+    auto fit = stats.LinearRegression(x, y);
+    ASSERT_EQ(true, fit.HasResult());
+    ASSERT_NEAR(3.0, std::get<Vector>(*fit.result)[0], 1e-12);
+    ASSERT_NEAR(1.0, stats.Correlation(x, y).GetDouble().value(), 1e-12);
+
+    auto dev = Reduction::SumCrossDeviations(x.data(), y.data(), x.size(), 1e9 + 0.5, 3e9 + 8.5);
+    ASSERT_NEAR(0.25 * n, dev.xx, 1e-9);
+    ASSERT_NEAR(0.75 * n, dev.xy, 1e-9);
+
+    ASSERT_EQ(true, stats.Mean(Vector{1.0, std::nan("")}).HasErrors());
+
+    std::cout << "[   OK  ] Test_CompensatedSums" << std::endl;
+}
+
+void Test_DataLoader() {
+    std::cout << "[RUNNING] Test_DataLoader..." << std::endl;
+
+    // Quoted header, CRLF, a missing cell, a text cell and a blank line
+    std::string text = "id,\"price, usd\",qty\r\n1,10.5,3\r\n2,,4\n\n3,12.5,n/a\n4,+13e0,5";
+    std::string error;
+    auto parsed = DataLoader::ParseText(text.data(), text.size(), error);
+    ASSERT_EQ(true, parsed.has_value());
+    ASSERT_EQ(size_t{4}, parsed->rows);
+    ASSERT_EQ(std::string("price, usd"), parsed->names[1]);
+    ASSERT_EQ(true, std::isnan(parsed->Column("price, usd")->at(1)));
+    ASSERT_EQ(true, std::isnan(parsed->Column("qty")->at(2)));
+    ASSERT_NEAR(13.0, parsed->Column("price, usd")->at(3), 1e-12);
+
+    // All-numeric first line is data; tab delimiter detected
+    std::string tsv = "1\t2\n3\t4\n";
+    auto headerless = DataLoader::ParseText(tsv.data(), tsv.size(), error);
+    ASSERT_EQ(size_t{2}, headerless->rows);
+    ASSERT_EQ(std::string("c1"), headerless->names[1]);
+
+    // Missing cells in the first line do not make it a header
+    std::string sparse = "1,,nan\n2,3,4\n";
+    auto sparse_parsed = DataLoader::ParseText(sparse.data(), sparse.size(), error);
+    ASSERT_EQ(size_t{2}, sparse_parsed->rows);
+    ASSERT_EQ(true, std::isnan(sparse_parsed->columns[1][0]) && std::isnan(sparse_parsed->columns[2][0]));
+
+    // Doubled quotes in a quoted header unescape
+    std::string escaped = "\"say \"\"hi\"\"\",b\n1,2\n";
+    auto escaped_parsed = DataLoader::ParseText(escaped.data(), escaped.size(), error);
+    ASSERT_EQ(std::string("say \"hi\""), escaped_parsed->names[0]);
+
+    // Large file: parsed in chunks, then served from the columnar cache
+    auto dir = std::filesystem::temp_directory_path() / "axiom_data_loader_test";
+    std::filesystem::create_directories(dir);
+    std::string path = (dir / "series.csv").string();
+    std::filesystem::remove(DataLoader::CachePath(path));
+    const size_t rows = 200000;
+    {
+        std::ofstream out(path);
+        out << "x,y\n";
+        for (size_t i = 0; i < rows; ++i) out << i << "," << (2.0 * i + 1.0) << "\n";
+    }
+    auto loaded = DataLoader::Load(path, error);
+    ASSERT_EQ(true, loaded.has_value() && !loaded->from_cache);
+    ASSERT_EQ(rows, loaded->rows);
+    bool ordered = true;
+    for (size_t i = 0; i < rows; ++i) ordered = ordered && loaded->columns[0][i] == static_cast<double>(i);
+    ASSERT_EQ(true, ordered);
+
+    auto cached = DataLoader::Load(path, error);
+    ASSERT_EQ(true, cached.has_value() && cached->from_cache);
+    ASSERT_EQ(true, cached->columns == loaded->columns && cached->names == loaded->names);
+
+    // A failed rename (the target is a directory) leaves no temp file behind
+    std::string blocked = (dir / "blocked.axcol").string();
+    std::filesystem::create_directories(std::filesystem::path(blocked) / "occupied");
+    ASSERT_EQ(false, DataLoader::WriteColumnar(*loaded, blocked));
+    ASSERT_EQ(false, std::filesystem::exists(blocked + ".tmp"));
+
+    StatisticsEngine engine;
+    StatisticsParser parser(&engine);
+    auto summary = parser.ParseAndExecute("stats load \"" + path + "\" as s");
+    ASSERT_EQ(true, summary.HasResult());
+    ASSERT_NEAR((rows - 1) / 2.0, parser.ParseAndExecute("mean x").GetDouble().value(), 1e-9);
+    ASSERT_NEAR(1.0, parser.ParseAndExecute("corr s.x s.y").GetDouble().value(), 1e-12);
+    ASSERT_NEAR(2.5, parser.ParseAndExecute("median [1, 2, 3, 4]").GetDouble().value(), 1e-12);
+    ASSERT_EQ(true, parser.ParseAndExecute("mean nosuch").HasErrors());
+    ASSERT_EQ(true, parser.ParseAndExecute("frobnicate x").HasErrors());
+    ASSERT_EQ(true, parser.ParseAndExecute("movavg [1, 2, 3] nan").HasErrors());
+    ASSERT_EQ(true, parser.ParseAndExecute("movavg [1, 2, 3] 1e300").HasErrors());
+    ASSERT_EQ(true, parser.ParseAndExecute("movavg [1, 2, 3] 1.5").HasErrors());
+    ASSERT_EQ(true, parser.ParseAndExecute("movavg [1, 2, 3] 2").HasResult());
+    ASSERT_EQ(true, parser.ParseAndExecute("load /nonexistent/file.csv").HasErrors());
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[   OK  ] Test_DataLoader" << std::endl;
+}
+
+void Test_MultipleRegression() {
+    std::cout << "[RUNNING] Test_MultipleRegression..." << std::endl;
+
+    std::mt19937_64 rng(17);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const size_t n = 20000;
+    Vector x1(n), x2(n), x3(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x1[i] = normal(rng);
+        x2[i] = 100.0 + 5.0 * normal(rng);
+        x3[i] = x1[i] - 2.0 * x2[i];
+        y[i] = 1.0 + 2.0 * x1[i] - 3.0 * x2[i] + 0.1 * normal(rng);
+    }
+
+    auto fit = LinearModel::Fit({&x1, &x2}, y);
+    ASSERT_EQ(true, fit.has_value());
+    ASSERT_EQ(size_t{3}, fit->rank);
+    ASSERT_NEAR(1.0, fit->coefficients[0], 0.05);
+    ASSERT_NEAR(2.0, fit->coefficients[1], 0.005);
+    ASSERT_NEAR(-3.0, fit->coefficients[2], 0.005);
+    ASSERT_NEAR(0.1, fit->residual_std_error, 0.005);
+    ASSERT_EQ(true, fit->r_squared > 0.999 && fit->r_squared < 1.0);
+
+    // Single predictor matches the closed form se(slope) = s / sqrt(Sxx)
+    auto simple = LinearModel::Fit({&x1}, y);
+    double mean = std::accumulate(x1.begin(), x1.end(), 0.0) / n;
+    double sxx = 0.0;
+    for (double v : x1) sxx += (v - mean) * (v - mean);
+    ASSERT_NEAR(simple->residual_std_error / std::sqrt(sxx), simple->standard_errors[1], 1e-12);
+    StatisticsEngine stats;
+    ASSERT_NEAR(std::get<Vector>(*stats.LinearRegression(x1, y).result)[0], simple->coefficients[1], 1e-9);
+
+    // An exactly collinear column is aliased without changing the fit
+    auto aliased = LinearModel::Fit({&x1, &x2, &x3}, y);
+    ASSERT_EQ(size_t{3}, aliased->rank);
+    ASSERT_EQ(1, static_cast<int>(std::count_if(aliased->coefficients.begin(), aliased->coefficients.end(),
+                                                [](double c) { return std::isnan(c); })));
+    ASSERT_NEAR(fit->residual_sum_squares, aliased->residual_sum_squares, 1e-6);
+
+    // Online Givens updates (split and merged) reproduce the batch fit
+    OnlineRegression head(2), tail(2);
+    for (size_t i = 0; i < n; ++i) {
+        double row[2] = {x1[i], x2[i]};
+        (i < n / 3 ? head : tail).Add(row, y[i]);
+    }
+    head.Merge(tail);
+    auto online = head.Fit();
+    ASSERT_EQ(uint64_t{n}, online->observations);
+    for (size_t j = 0; j < 3; ++j) {
+        ASSERT_NEAR(fit->coefficients[j], online->coefficients[j], 1e-9);
+        ASSERT_NEAR(fit->standard_errors[j], online->standard_errors[j], 1e-9);
+    }
+    ASSERT_NEAR(fit->r_squared, online->r_squared, 1e-12);
+
+    // Formula syntax over loaded columns
+    auto dir = std::filesystem::temp_directory_path() / "axiom_regression_test";
+    std::filesystem::create_directories(dir);
+    std::string path = (dir / "model.csv").string();
+    {
+        std::ofstream out(path);
+        out << "a,b,target\n";
+        for (int i = 0; i < 50; ++i) out << i << "," << (i * i) % 7 << "," << (4.0 + 0.5 * i - 2.0 * ((i * i) % 7)) << "\n";
+    }
+    StatisticsParser parser(&stats);
+    parser.ParseAndExecute("load \"" + path + "\"");
+    auto report = parser.ParseAndExecute("regress(target ~ a + b)");
+    ASSERT_EQ(true, report.HasResult());
+    ASSERT_EQ(true, std::get<std::string>(*report.result).find("R^2 = 1") != std::string::npos);
+    ASSERT_EQ(true, parser.ParseAndExecute("regress(target ~ a - 1)").HasResult());
+    ASSERT_EQ(true, parser.ParseAndExecute("regress(target ~ nosuch)").HasErrors());
+    std::filesystem::remove_all(dir);
+
+    std::cout << "[   OK  ] Test_MultipleRegression" << std::endl;
+}
+
+void Test_Distributions() {
+    std::cout << "[RUNNING] Test_Distributions..." << std::endl;
+    using Distributions::Distribution;
+    using Kind = Distribution::Kind;
+
+    // Reference values from 40-digit mpmath
+    struct Reference {
+        Kind kind;
+        double a, b, x, pdf, cdf;
+    };
+    const Reference references[] = {
+        {Kind::Normal, 0, 1, -37, 2.1200065515246056e-298, 5.7255712225245768e-300},
+        {Kind::Normal, 0, 1, -8, 5.0522710835368923e-15, 6.2209605742717841e-16},
+        {Kind::Normal, 3, 0.5, 4.5, 0.0088636968238760144, 0.99865010196836991},
+        {Kind::StudentT, 1, 0, -50, 0.0001272730452554141, 0.0063653491009727967},
+        {Kind::StudentT, 4.5, 0, 1.7, 0.096501269112785559, 0.92182304393205111},
+        {Kind::StudentT, 30, 0, -2.5, 0.021057019220621632, 0.0090578245340333471},
+        {Kind::ChiSquared, 1, 0, 0.01, 3.9695254747701176, 0.079655674554057964},
+        {Kind::ChiSquared, 10, 0, 25, 0.0018954738220614985, 0.99465449451286594},
+        {Kind::Gamma, 0.5, 2, 0.001, 12.609356355490783, 0.025227120630039612},
+        {Kind::Gamma, 7.5, 0.3, 2.2, 0.4902064278427484, 0.52431647818084964},
+        {Kind::Beta, 0.5, 0.5, 0.999, 10.07087911994709, 0.9798649583666225},
+        {Kind::Beta, 2, 5, 0.3, 2.1609000000000001, 0.57982499999999998},
+        {Kind::Beta, 30, 12, 0.9, 0.044644417450004614, 0.99951027691021487},
+        {Kind::Binomial, 20, 0.3, 6, 0.19163898275344258, 0.60800981220092401},
+        {Kind::Binomial, 20, 0.3, 20, 3.4867844009999974e-11, 1.0},
+    };
+    auto relative = [](double got, double want) { return std::abs(got - want) / std::abs(want); };
+    for (const auto& ref : references) {
+        Distribution dist{ref.kind, ref.a, ref.b};
+        ASSERT_EQ(true, dist.Valid());
+        ASSERT_NEAR(0.0, relative(Distributions::PDF(dist, ref.x), ref.pdf), 1e-12);
+        ASSERT_NEAR(0.0, relative(Distributions::CDF(dist, ref.x), ref.cdf), 1e-12);
+        if (ref.cdf < 0.999) {
+            ASSERT_NEAR(0.0, relative(Distributions::Quantile(dist, ref.cdf), ref.x), 1e-10);
+        }
+    }
+    ASSERT_NEAR(1.959963984540054, Distributions::NormalQuantile(0.975), 1e-14);
+    ASSERT_EQ(true, std::isinf(Distributions::Quantile(Distribution::Gamma(2.0, 1.0), 1.0)));
+    ASSERT_EQ(true, std::isnan(Distributions::Quantile(Distribution::Normal(), 1.5)));
+    ASSERT_EQ(0.0, Distributions::PDF(Distribution::Beta(2.0, 3.0), 1.5));
+    ASSERT_EQ(0.0, Distributions::PDF(Distribution::Binomial(10.0, 0.5), 2.5));
+    ASSERT_EQ(false, Distribution::StudentT(0.0).Valid());
+
+    // Vectorized exp / log stay within a few ulp of libm, and batch densities
+    // match the scalar path, on every ISA the host supports
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> exponent(-700.0, 700.0);
+    const size_t n = 4099;
+    Vector x(n), y(n), back(n), grid(n);
+    for (double& v : x) v = exponent(rng);
+    for (size_t i = 0; i < n; ++i) grid[i] = 0.01 + 0.005 * static_cast<double>(i);
+    const Distribution families[] = {Distribution::Normal(1.0, 2.0), Distribution::StudentT(4.5),
+                                     Distribution::ChiSquared(3.0), Distribution::Gamma(3.3, 1.7),
+                                     Distribution::Beta(2.0, 5.0), Distribution::Binomial(20.0, 0.3)};
+    size_t levels = 0;
+    for (ISALevel level : {ISALevel::Scalar, ISALevel::AVX2, ISALevel::AVX512}) {
+        const AXIOM::SIMD::KernelTable* kernels = AXIOM::SIMD::KernelsFor(level);
+        if (!kernels) continue;
+        ++levels;
+        kernels->exp(x.data(), y.data(), n);
+        kernels->log(y.data(), back.data(), n);
+        double worst_exp = 0.0, worst_log = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            worst_exp = std::max(worst_exp, relative(y[i], std::exp(x[i])));
+            worst_log = std::max(worst_log, relative(back[i], std::log(y[i])));
+        }
+        ASSERT_NEAR(0.0, worst_exp, 4e-16);
+        ASSERT_NEAR(0.0, worst_log, 4e-16);
+
+        for (const auto& dist : families) {
+            Vector densities(n), cdf(n);
+            Distributions::PDF(dist, grid.data(), densities.data(), n, *kernels);
+            Distributions::CDF(dist, grid.data(), cdf.data(), n, *kernels);
+            double worst_pdf = 0.0, worst_cdf = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                double pdf = Distributions::PDF(dist, grid[i]);
+                if (pdf > 0.0) worst_pdf = std::max(worst_pdf, relative(densities[i], pdf));
+                else worst_pdf = std::max(worst_pdf, std::abs(densities[i]));
+                worst_cdf = std::max(worst_cdf, std::abs(cdf[i] - Distributions::CDF(dist, grid[i])));
+            }
+            ASSERT_NEAR(0.0, worst_pdf, 1e-13);
+            ASSERT_NEAR(0.0, worst_cdf, 1e-14);
+        }
+    }
+    ASSERT_EQ(true, levels >= 1);
+
+    // Quantiles invert CDFs through the engine
+    Distribution gamma = Distribution::Gamma(3.3, 1.7);
+    for (size_t i = 0; i < n; ++i) x[i] = grid[i];
+    StatisticsEngine stats;
+    auto densities = std::get<Vector>(*stats.DistributionPDF(gamma, x).result);
+    auto cdf = std::get<Vector>(*stats.DistributionCDF(gamma, x).result);
+    auto inverted = std::get<Vector>(*stats.DistributionQuantile(gamma, cdf).result);
+    double worst_pdf = 0.0, worst_inverse = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        worst_pdf = std::max(worst_pdf, relative(densities[i], Distributions::PDF(gamma, x[i])));
+        if (cdf[i] < 0.999999) worst_inverse = std::max(worst_inverse, relative(inverted[i], x[i]));
+    }
+    ASSERT_NEAR(0.0, worst_pdf, 1e-15);
+    ASSERT_NEAR(0.0, worst_inverse, 1e-10);
+    ASSERT_EQ(true, stats.DistributionPDF(Distribution::Beta(-1.0, 2.0), x).HasErrors());
+
+    ASSERT_NEAR(0.3989422804014327, stats.NormalPDF(0.0).GetDouble().value(), 1e-15);
+    ASSERT_NEAR(0.99865010196836991, stats.NormalCDF(4.5, 3.0, 0.5).GetDouble().value(), 1e-14);
+    ASSERT_NEAR(0.096501269112785559, stats.TDistributionPDF(1.7, 4.5).GetDouble().value(), 1e-14);
+    ASSERT_NEAR(0.0018954738220614985, stats.ChiSquaredPDF(25.0, 10.0).GetDouble().value(), 1e-16);
+    ASSERT_EQ(true, stats.NormalPDF(0.0, 0.0, -1.0).HasErrors());
+
+    StatisticsParser parser(&stats);
+    ASSERT_NEAR(0.92182304393205111, parser.ParseAndExecute("cdf t 4.5 1.7").GetDouble().value(), 1e-14);
+    ASSERT_NEAR(1.7, parser.ParseAndExecute("invcdf t 4.5 0.92182304393205111").GetDouble().value(), 1e-12);
+    auto pmf = parser.ParseAndExecute("pmf binomial 20 0.3 [6, 20]");
+    ASSERT_NEAR(0.19163898275344258, std::get<Vector>(*pmf.result)[0], 1e-13);
+    ASSERT_EQ(true, parser.ParseAndExecute("pdf weibull 1 2 3").HasErrors());
+    ASSERT_EQ(true, parser.ParseAndExecute("pdf normal 0 1").HasErrors());
+
+    std::cout << "[   OK  ] Test_Distributions" << std::endl;
+}
+
+void Test_Binning() {
+    std::cout << "[RUNNING] Test_Binning..." << std::endl;
+
+    // Brute-force reference: last edge <= v, upper limit inclusive
+    auto reference = [](const Vector& data, const Vector& edges) {
+        std::vector<uint64_t> counts(edges.size() - 1, 0);
+        for (double v : data) {
+            if (!(v >= edges.front() && v <= edges.back())) continue;
+            size_t j = static_cast<size_t>(std::upper_bound(edges.begin(), edges.end(), v) - edges.begin()) - 1;
+            ++counts[std::min(j, counts.size() - 1)];
+        }
+        return counts;
+    };
+
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> uniform(-1.5, 11.5);
+    const size_t n = 100003;   // Several chunks, each with private counts
+    Vector data(n);
+    for (double& v : data) v = uniform(rng);
+    auto hist = Binning::Uniform(data.data(), n, 37, -0.3, 10.8);
+    ASSERT_EQ(true, hist.has_value());
+    // Values sitting exactly on the reported edges land in the bin they open
+    for (size_t i = 0; i < 3000; ++i) data[i] = hist->edges[i % hist->edges.size()];
+    data[3000] = std::nan("");
+    data[3001] = std::numeric_limits<double>::infinity();
+    hist = Binning::Uniform(data.data(), n, 37, -0.3, 10.8);
+    ASSERT_EQ(true, reference(data, hist->edges) == hist->counts);
+    uint64_t below = std::count_if(data.begin(), data.end(), [](double v) { return v < -0.3; });
+    uint64_t above = std::count_if(data.begin(), data.end(), [](double v) { return v > 10.8; });
+    ASSERT_EQ(below, hist->below);
+    ASSERT_EQ(above, hist->above);
+    ASSERT_EQ(uint64_t{1}, hist->missing);
+
+    // Arbitrary edges, including an empty bin and both search strategies
+    Vector edges = {-1.0, 0.0, 0.5, 0.5, 2.0, 3.3, 7.0, 7.01, 11.0};
+    auto custom = Binning::Edges(data.data(), n, edges);
+    ASSERT_EQ(true, reference(data, edges) == custom->counts);
+    ASSERT_EQ(uint64_t{0}, custom->counts[2]);
+    Vector many_edges(301);
+    for (size_t i = 0; i < many_edges.size(); ++i) many_edges[i] = -1.0 + 0.04 * static_cast<double>(i) + 1e-3 * std::sin(static_cast<double>(i));
+    ASSERT_EQ(true, reference(data, many_edges) == Binning::Edges(data.data(), n, many_edges)->counts);
+    ASSERT_EQ(false, Binning::Edges(data.data(), n, Vector{2.0, 1.0}).has_value());
+    ASSERT_EQ(false, Binning::Uniform(data.data(), n, 0).has_value());
+
+    // 2-D counts agree with binning each axis separately
+    const Vector& ys = data;
+    Vector xs(n);
+    for (size_t i = 0; i < n; ++i) xs[i] = uniform(rng);
+    auto grid = Binning::Uniform2D(xs.data(), ys.data(), n, 6, 0.0, 10.0, 4, 0.0, 10.0);
+    ASSERT_EQ(true, grid.has_value());
+    uint64_t total = grid->outside + grid->missing;
+    for (uint64_t c : grid->counts) total += c;
+    ASSERT_EQ(uint64_t{n}, total);
+    ASSERT_EQ(uint64_t{1}, grid->missing);
+    Vector column;
+    for (size_t i = 0; i < n; ++i) {
+        if (xs[i] >= grid->x_edges[2] && xs[i] < grid->x_edges[3]) column.push_back(ys[i]);
+    }
+    auto slice = Binning::Uniform(column.data(), column.size(), 4, 0.0, 10.0);
+    for (size_t iy = 0; iy < 4; ++iy) ASSERT_EQ(slice->counts[iy], grid->At(2, iy));
+
+    // Plotting, the engine and statistics mode share the counts
+    StatisticsEngine stats;
+    Vector small = {1.0, 2.0, 2.0, 3.0, 3.0, 3.0, 4.0};
+    auto counts = std::get<Vector>(*stats.HistogramCounts(small, 3).result);
+    ASSERT_EQ(true, (counts == Vector{1.0, 2.0, 4.0}));
+    PlotEngine plots;
+    std::string chart = plots.Histogram(small, 3);
+    ASSERT_EQ(true, chart.find("[3.00-4.00] ") != std::string::npos && chart.find("(4)") != std::string::npos);
+    StatisticsParser parser(&stats);
+    auto text = parser.ParseAndExecute("hist [1, 2, 2, 3, 3, 3, 4] [0, 2, 5]");
+    ASSERT_EQ(true, text.HasResult());
+    ASSERT_EQ(true, std::get<std::string>(*text.result).find("n = 7") != std::string::npos);
+    auto matrix = parser.ParseAndExecute("hist2 [1, 2, 3, 4] [4, 3, 2, 1] 2");
+    ASSERT_EQ(true, matrix.HasResult());
+    const auto& cells = std::get<Matrix>(*matrix.result);
+    ASSERT_EQ(2.0, cells[0][1]);
+    ASSERT_EQ(0.0, cells[0][0]);
+    // Bin counts must be whole numbers within Binning::kMaxBins
+    for (const char* bad : {"hist [1, 2, 3] inf", "hist [1, 2, 3] nan", "hist [1, 2, 3] 2.5", "hist [1, 2, 3] 1e30",
+                            "hist2 [1, 2] [3, 4] 1e30", "hist2 [1, 2] [3, 4] 2 inf"}) {
+        ASSERT_EQ(false, parser.ParseAndExecute(bad).HasResult());
+    }
+
+    std::cout << "[   OK  ] Test_Binning" << std::endl;
+}
+
+void Test_Resampling() {
+    std::cout << "[RUNNING] Test_Resampling..." << std::endl;
+
+    // Philox4x32-10 known-answer vectors (Random123)
+    auto kat = Resampling::PhiloxStream::Block({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0});
+    ASSERT_EQ(true, (kat == std::array<uint32_t, 4>{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+    Resampling::PhiloxStream stream(7, 3);
+    uint64_t draws[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 40000; ++i) ++draws[stream.Below(4)];
+    for (uint64_t d : draws) ASSERT_NEAR(10000.0, static_cast<double>(d), 400.0);
+
+    // Parametric tests against high-precision references
+    StatisticsEngine stats;
+    Vector a = {5.1, 4.9, 5.6, 5.8, 6.0, 5.2, 5.5};
+    Vector b = {6.3, 6.1, 5.9, 6.8, 7.0, 6.4};
+    Vector c = {5.0, 5.4, 5.3, 4.8, 5.1};
+    auto t = std::get<Vector>(*stats.TTest(a, b).result);
+    ASSERT_NEAR(-4.3012616289113445, t[0], 1e-12);
+    ASSERT_NEAR(10.486874126369687, t[1], 1e-11);
+    ASSERT_NEAR(0.001397508539502055, t[2], 1e-14);
+    auto f = std::get<Vector>(*stats.ANOVAOneWay({a, b, c}).result);
+    ASSERT_NEAR(19.24402266819662, f[0], 1e-11);
+    ASSERT_NEAR(15.0, f[2], 1e-15);
+    ASSERT_NEAR(7.2236881289297373e-5, f[3], 1e-16);
+    ASSERT_EQ(true, stats.TTest(a, Vector{1.0}).HasErrors());
+
+    // Permutation p-values agree with the parametric ones in magnitude
+    auto perm = std::get<Vector>(*stats.PermutationTest({a, b}, Resampling::TestStatistic::WelchT).result);
+    ASSERT_NEAR(t[0], perm[0], 1e-12);
+    ASSERT_EQ(true, perm[1] < 0.01);
+    auto perm3 = std::get<Vector>(*stats.PermutationTest({a, b, c}, Resampling::TestStatistic::FStatistic).result);
+    ASSERT_EQ(true, perm3[1] < 0.01);
+    auto null = std::get<Vector>(*stats.PermutationTest({a, Vector{5.5, 5.0, 5.9, 5.2, 5.4}},
+                                                        Resampling::TestStatistic::MeanDifference).result);
+    ASSERT_EQ(true, null[1] > 0.2);
+
+    // Bootstrap: interval around the estimate, standard error near sd / sqrt(n)
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> normal(10.0, 2.0);
+    Vector sample(400);
+    for (double& v : sample) v = normal(rng);
+    auto ci = std::get<Vector>(*stats.BootstrapCI(sample, Resampling::Statistic::Mean).result);
+    double sd = StatisticsEngine::Accumulate(sample).StandardDeviation();
+    ASSERT_EQ(true, ci[1] < ci[0] && ci[0] < ci[2]);
+    ASSERT_NEAR(sd / 20.0, ci[3], 0.1 * sd / 20.0);
+
+    // Replicates depend only on the seed, not on the thread count
+    Resampling::BootstrapOptions options;
+    options.resamples = 300;
+    auto serial = Resampling::Bootstrap(sample.data(), sample.size(), Resampling::Statistic::StdDev, options);
+    auto median = [](double* x, size_t n) {
+        std::nth_element(x, x + n / 2, x + n);
+        return x[n / 2];
+    };
+    auto serial_median = Resampling::Bootstrap(sample.data(), sample.size(), median, options);
+    AXIOM::ThreadPool::SetGlobalThreadCount(4);
+    auto pooled = Resampling::Bootstrap(sample.data(), sample.size(), Resampling::Statistic::StdDev, options);
+    auto pooled_median = Resampling::Bootstrap(sample.data(), sample.size(), median, options);
+    AXIOM::ThreadPool::SetGlobalThreadCount(0);
+    ASSERT_EQ(true, serial->replicates == pooled->replicates);
+    ASSERT_EQ(true, serial_median->replicates == pooled_median->replicates);
+    options.seed = 99;
+    auto reseeded = Resampling::Bootstrap(sample.data(), sample.size(), Resampling::Statistic::StdDev, options);
+    ASSERT_EQ(false, serial->replicates == reseeded->replicates);
+
+    // Paired rows: perfectly correlated data has a degenerate interval at 1
+    Vector x = {1, 2, 3, 4, 5, 6, 7, 8};
+    Vector y = {3, 5, 7, 9, 11, 13, 15, 17};
+    auto slope = std::get<Vector>(*stats.BootstrapCI(x, y, Resampling::PairStatistic::Slope).result);
+    ASSERT_NEAR(2.0, slope[1], 1e-12);
+    ASSERT_NEAR(2.0, slope[2], 1e-12);
+
+    // Statistics mode
+    StatisticsParser parser(&stats);
+    auto ttest = parser.ParseAndExecute("ttest [5.1, 4.9, 5.6, 5.8, 6.0, 5.2, 5.5] [6.3, 6.1, 5.9, 6.8, 7.0, 6.4]");
+    ASSERT_NEAR(0.001397508539502055, std::get<Vector>(*ttest.result)[2], 1e-14);
+    auto boot = parser.ParseAndExecute("bootstrap median [1, 2, 3, 4, 5, 6, 7, 8, 9] 500 0.9");
+    ASSERT_EQ(true, boot.HasResult());
+    ASSERT_NEAR(5.0, std::get<Vector>(*boot.result)[0], 1e-15);
+    auto permtest = parser.ParseAndExecute("permtest [5.1, 4.9, 5.6, 5.8, 6.0, 5.2, 5.5] [6.3, 6.1, 5.9, 6.8, 7.0, 6.4] 999");
+    ASSERT_EQ(true, std::get<Vector>(*permtest.result)[1] < 0.02);
+    ASSERT_EQ(true, parser.ParseAndExecute("bootstrap mode [1, 2, 3]").HasErrors());
+    // Counts must be whole numbers within Resampling::kMaxResamples
+    for (const char* bad : {"bootstrap mean [1, 2, 3] inf", "bootstrap mean [1, 2, 3] 1e30", "bootstrap mean [1, 2, 3] 2.5",
+                            "permtest [1, 2, 3] [4, 5, 6] nan", "permtest [1, 2, 3] [4, 5, 6] 1e19"}) {
+        ASSERT_EQ(true, parser.ParseAndExecute(bad).HasErrors());
+    }
+
+    // Extreme counts are reduced in a fixed order, so they match across pool sizes
+    Resampling::PermutationOptions perm_options;
+    perm_options.permutations = 5000;
+    auto serial_perm = Resampling::PermutationTest({&sample, &x}, Resampling::TestStatistic::WelchT, perm_options);
+    AXIOM::ThreadPool::SetGlobalThreadCount(4);
+    auto pooled_perm = Resampling::PermutationTest({&sample, &x}, Resampling::TestStatistic::WelchT, perm_options);
+    AXIOM::ThreadPool::SetGlobalThreadCount(0);
+    ASSERT_EQ(true, serial_perm && pooled_perm && serial_perm->extreme == pooled_perm->extreme);
+
+    std::cout << "[   OK  ] Test_Resampling" << std::endl;
+}
+
+void Test_FrequencyTable() {
+    std::cout << "[RUNNING] Test_FrequencyTable..." << std::endl;
+
+    // Both methods agree with std::map on low- and high-cardinality data
+    std::mt19937_64 rng(3);
+    const size_t n = 60001;
+    Vector low(n), high(n);
+    for (size_t i = 0; i < n; ++i) {
+        low[i] = static_cast<double>(rng() % 17) * 0.25 - 1.0;
+        high[i] = static_cast<double>(rng() % 1000000) * 1e-3;
+    }
+    low[5] = -0.0;
+    low[6] = std::nan("");
+    auto reference = [](const Vector& data) {
+        std::map<double, uint64_t> counts;
+        for (double v : data) {
+            if (!std::isnan(v)) ++counts[v];
+        }
+        return counts;
+    };
+    for (const Vector* data : {&low, &high}) {
+        auto expected = reference(*data);
+        for (auto method : {Frequency::Method::Hash, Frequency::Method::Sort}) {
+            auto table = Frequency::Count(data->data(), n, method);
+            ASSERT_EQ(expected.size(), table.Size());
+            size_t i = 0;
+            bool same = true;
+            for (const auto& [value, count] : expected) {
+                same = same && table.values[i] == value && table.counts[i] == count;
+                ++i;
+            }
+            ASSERT_EQ(true, same);
+        }
+    }
+    ASSERT_EQ(true, Frequency::ChooseMethod(low.data(), n) == Frequency::Method::Hash);
+    ASSERT_EQ(true, Frequency::ChooseMethod(high.data(), n) == Frequency::Method::Sort);
+    ASSERT_EQ(uint64_t{1}, Frequency::Count(low.data(), n).missing);
+    ASSERT_EQ(false, std::signbit(Frequency::Count(low.data(), n).values[4]));
+
+    // Every mode, ascending, whatever the input order
+    StatisticsEngine stats;
+    ASSERT_EQ(3.0, stats.Mode({1, 3, 3, 2}).GetDouble().value());
+    auto modes = stats.Mode({7, 2, 9, 2, 7, 5});
+    ASSERT_EQ(true, (std::get<Vector>(*modes.result) == Vector{2.0, 7.0}));
+    auto counts = std::get<Matrix>(*stats.ValueCounts({4, 1, 4, 3, 1, 4, 2}).result);
+    ASSERT_EQ(true, (counts == Matrix{{4, 3}, {1, 2}, {2, 1}, {3, 1}}));
+
+    // Contingency table and Pearson chi-squared against high-precision references
+    Vector x, y;
+    const double cells[2][3] = {{10, 20, 30}, {20, 15, 5}};
+    for (int r = 0; r < 2; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            for (int k = 0; k < cells[r][c]; ++k) {
+                x.push_back(r + 1.0);
+                y.push_back(c * 10.0);
+            }
+        }
+    }
+    std::shuffle(x.begin(), x.end(), std::mt19937(1));
+    std::shuffle(y.begin(), y.end(), std::mt19937(1));
+    auto table = std::get<Matrix>(*stats.CrossTabulate(x, y).result);
+    ASSERT_EQ(true, (table == Matrix{{10, 20, 30}, {20, 15, 5}}));
+    auto independence = std::get<Vector>(*stats.ChiSquaredTest(x, y).result);
+    ASSERT_NEAR(18.650793650793651, independence[0], 1e-12);
+    ASSERT_EQ(2.0, independence[1]);
+    ASSERT_NEAR(8.9131582465932296e-5, independence[2], 1e-17);
+    auto fit = std::get<Vector>(*stats.ChiSquaredTest(Matrix{{8, 9, 19, 5, 8, 11}}, Matrix{{10, 10, 10, 10, 10, 10}}).result);
+    ASSERT_NEAR(11.6, fit[0], 1e-12);
+    ASSERT_NEAR(0.040699388504049994, fit[2], 1e-15);
+    ASSERT_NEAR(5.3414715652448774e-25, Distributions::GammaQ(2.0, 60.0), 1e-37);
+    ASSERT_EQ(true, stats.ChiSquaredTest(Matrix{{1, 2}}, Matrix{{1, 0}}).HasErrors());
+
+    StatisticsParser parser(&stats);
+    auto top = parser.ParseAndExecute("value_counts [2, 2, 5, 5, 5]");
+    ASSERT_EQ(5.0, std::get<Matrix>(*top.result)[0][0]);
+    ASSERT_EQ(true, parser.ParseAndExecute("chi2test [1, 1, 2, 2] [1, 2, 1, 2]").HasResult());
+
+    std::cout << "[   OK  ] Test_FrequencyTable" << std::endl;
+}
+
+void Test_CompiledExpression() {
+    std::cout << "[RUNNING] Test_CompiledExpression..." << std::endl;
+
+    // Constants fold away; degrees, implicit multiplication and "sin x" follow the parser
+    auto folded = CompiledExpression::Compile("2^10 + sqrt(16) * pi", {"x"});
+    ASSERT_EQ(true, folded->IsConstant());
+    double zero = 0.0;
+    ASSERT_NEAR(1024.0 + 4.0 * PI_CONST, folded->EvaluateAt(&zero), 1e-12);
+    double thirty = 30.0;
+    ASSERT_NEAR(0.5, CompiledExpression::Compile("sin(x)", {"x"})->EvaluateAt(&thirty), 1e-15);
+    ASSERT_NEAR(0.25, CompiledExpression::Compile("sin x^2", {"x"})->EvaluateAt(&thirty), 1e-15);
+    double three = 3.0;
+    ASSERT_NEAR(48.0, CompiledExpression::Compile("2x(x + 1)(x - 1)", {"x"})->EvaluateAt(&three), 1e-12);
+    ASSERT_NEAR(30.0, CompiledExpression::Compile("asin(0.5)", {})->EvaluateAt(nullptr), 1e-12);
+    ASSERT_NEAR(7.0, CompiledExpression::Compile("max(1, x, 7) + gcd(12, 18) - mod(13, 5) * 2", {"x"})->EvaluateAt(&three), 1e-12);
+
+    // Errors at compile time, NaN for points outside the domain
+    std::string error;
+    ASSERT_EQ(false, CompiledExpression::Compile("x + y", {"x"}, &error).has_value());
+    ASSERT_EQ(false, error.empty());
+    ASSERT_EQ(false, CompiledExpression::Compile("(x + 1", {"x"}).has_value());
+    double minus_one = -1.0;
+    ASSERT_EQ(true, std::isnan(CompiledExpression::Compile("ln(x)", {"x"})->EvaluateAt(&minus_one)));
+    ASSERT_EQ(true, std::isnan(CompiledExpression::Compile("1 / (x + 1)", {"x"})->EvaluateAt(&minus_one)));
+
+    // The batch path (blocks, SIMD exp / ln, the pool) matches point evaluation
+    auto curve = CompiledExpression::Compile("exp(-x^2 / 8) * ln(abs(x) + 1) + x^3 - x^1.5 / 4", {"x"});
+    const size_t n = 100003;
+    Vector xs(n), ys(n);
+    for (size_t i = 0; i < n; ++i) xs[i] = -10.0 + 20.0 * static_cast<double>(i) / static_cast<double>(n - 1);
+    curve->Evaluate(xs.data(), ys.data(), n);
+    for (size_t i = 0; i < n; i += 997) {
+        double expected = curve->EvaluateAt(&xs[i]);
+        if (std::isnan(expected)) {
+            ASSERT_EQ(true, std::isnan(ys[i]));
+        } else {
+            ASSERT_NEAR(expected, ys[i], 1e-12 * (1.0 + std::abs(expected)));
+        }
+    }
+
+    // Cancelled terms leave zero leading coefficients; powers must see the real degree
+    const double two = 2.0;
+    ASSERT_NEAR(8.0, CompiledExpression::Compile("(0*x + 2)^3", {"x"})->EvaluateAt(&two), 1e-12);
+    ASSERT_NEAR(9.0, CompiledExpression::Compile("(x - x + 3)^2", {"x"})->EvaluateAt(&two), 1e-12);
+    ASSERT_NEAR(1.0, CompiledExpression::Compile("((x^2 + 1) - x^2)^2", {"x"})->EvaluateAt(&two), 1e-12);
+    Vector cancelled_x = {-1.5, 0.0, 4.0}, cancelled_y(3);
+    CompiledExpression::Compile("(x - x + 3)^2 + x", {"x"})->Evaluate(cancelled_x.data(), cancelled_y.data(), 3);
+    ASSERT_EQ(true, cancelled_y == Vector({7.5, 9.0, 13.0}));
+
+    // PlotFunction, PlotParametric and PolarPlot share the compiled path
+    PlotEngine plots;
+    PlotConfig config;
+    config.width = 41;
+    config.height = 21;
+    config.y_min = -10;
+    config.y_max = 10;
+    std::string parabola = plots.PlotFunction("x^2 - 5", config);
+    ASSERT_EQ(static_cast<size_t>(config.height), static_cast<size_t>(std::count(parabola.begin(), parabola.end(), '\n')));
+    ASSERT_EQ(true, std::count(parabola.begin(), parabola.end(), '*') >= 10);
+    std::string circle = plots.PlotParametric("5cos(t)", "5sin(t)", 0, 360, config);
+    std::string polar = plots.PolarPlot("5", config);
+    ASSERT_EQ(true, std::count(circle.begin(), circle.end(), '*') >= 20);
+    ASSERT_EQ(circle, polar);
+    ASSERT_EQ(std::string("Error: Invalid expression\n"), plots.PlotFunction("x +", config));
+
+    std::cout << "[   OK  ] Test_CompiledExpression" << std::endl;
+}
+
+void Test_CurveSampling() {
+    std::cout << "[RUNNING] Test_CurveSampling..." << std::endl;
+
+    CurveSampling::Options options;
+    options.x_pixels = 1000;
+    options.y_pixels = 500;
+    auto sample = [&](const char* expression, double lo, double hi, double y_min, double y_max) {
+        options.y_min = y_min;
+        options.y_max = y_max;
+        return CurveSampling::Sample(*CompiledExpression::Compile(expression, {"x"}), lo, hi, options);
+    };
+
+    // Smooth curves stay within the tolerance of their chords, with one pass of midpoints
+    auto wave = sample("sin(x)", -720, 720, -1.5, 1.5);
+    ASSERT_EQ(true, wave.breaks.empty());
+    ASSERT_EQ(true, wave.evaluations <= 600);
+    double worst = 0.0;
+    for (size_t i = 0, j = 0; i <= 20000; ++i) {
+        double x = -720.0 + 1440.0 * static_cast<double>(i) / 20000.0;
+        while (j + 2 < wave.x.size() && wave.x[j + 1] < x) ++j;
+        double t = (x - wave.x[j]) / (wave.x[j + 1] - wave.x[j]);
+        double chord = wave.y[j] + t * (wave.y[j + 1] - wave.y[j]);
+        worst = std::max(worst, std::abs(chord - std::sin(x * D2R)) * 500.0 / 3.0);
+    }
+    ASSERT_EQ(true, worst < 0.5);
+    ASSERT_EQ(true, std::is_sorted(wave.x.begin(), wave.x.end()));
+
+    // Asymptotes and jumps become breaks located far below pixel resolution
+    auto tangent = sample("tan(x)", -180, 180, -5, 5);
+    ASSERT_EQ(size_t{2}, tangent.breaks.size());
+    ASSERT_NEAR(-90.0, tangent.x[tangent.breaks[0]], 1e-3);
+    ASSERT_NEAR(90.0, tangent.x[tangent.breaks[1] + 1], 1e-3);
+    ASSERT_EQ(size_t{1}, sample("abs(x)/x", -10, 10, -2, 2).breaks.size());
+    ASSERT_EQ(size_t{1}, sample("1/x", -10, 10, -5, 5).breaks.size());
+    // Steep but continuous, and a kink: no breaks
+    ASSERT_EQ(true, sample("1000x", -1, 1, -5, 5).breaks.empty());
+    ASSERT_EQ(true, sample("abs(x - 0.3)", -10, 10, -1, 10).breaks.empty());
+
+    // A spike one pixel wide is found; the domain edge of sqrt is traced to the origin
+    auto spike = sample("5exp(-((x - 1.2345)/0.02)^2)", -10, 10, -1, 6);
+    ASSERT_NEAR(5.0, *std::max_element(spike.y.begin(), spike.y.end()), 0.01);
+    ASSERT_EQ(true, spike.evaluations < 1000);
+    auto root = sample("sqrt(x)", -10, 10, -1, 4);
+    ASSERT_EQ(true, root.x.front() >= 0.0 && root.x.front() < 1e-4);
+    ASSERT_EQ(true, root.breaks.empty());
+
+    // The ASCII plot joins samples but not across the asymptote
+    PlotEngine plots;
+    PlotConfig config;
+    config.x_min = -180;
+    config.x_max = 180;
+    std::string plot = plots.PlotFunction("tan(x)", config);
+    // Asymptotes at -90 and 90 fall in columns 19-20 and 59-60; rows away from the edges stay empty there
+    std::vector<std::string> rows;
+    std::istringstream lines(plot);
+    for (std::string row; std::getline(lines, row);) rows.push_back(row);
+    ASSERT_EQ(static_cast<size_t>(config.height), rows.size());
+    bool joined_across = false;
+    for (size_t r = 4; r < 16; ++r) {
+        for (size_t c : {19, 20, 59, 60}) joined_across |= rows[r][c] == '*';
+    }
+    ASSERT_EQ(false, joined_across);
+    ASSERT_EQ(true, rows.front().find('*') != std::string::npos);
+
+    std::cout << "[   OK  ] Test_CurveSampling" << std::endl;
+}
+
+void Test_SurfaceGrid() {
+    std::cout << "[RUNNING] Test_SurfaceGrid..." << std::endl;
+
+    // Row 0 is y_max; tiles of any shape cover the grid exactly once
+    auto plane = CompiledExpression::Compile("x + 2y", {"x", "y"});
+    GridSpec spec;
+    spec.columns = 300;
+    spec.rows = 70;
+    spec.x_min = -3;
+    spec.x_max = 3;
+    spec.y_min = 0;
+    spec.y_max = 1;
+    auto grid = Surface::Evaluate(*plane, spec);
+    ASSERT_EQ(spec.columns * spec.rows, grid->values.size());
+    ASSERT_NEAR(-1.0, grid->At(0, 0), 1e-6);
+    ASSERT_NEAR(3.0, grid->At(299, 69), 1e-6);
+    bool all_match = true;
+    for (size_t r = 0; r < grid->Rows(); ++r) {
+        for (size_t c = 0; c < grid->Columns(); ++c) {
+            all_match &= std::abs(grid->At(c, r) - (grid->X(c) + 2.0 * grid->Y(r))) < 1e-5;
+        }
+    }
+    ASSERT_EQ(true, all_match);
+    ASSERT_EQ(false, Surface::Evaluate(*CompiledExpression::Compile("x", {"x"}), spec).has_value());
+    spec.rows = 1;
+    ASSERT_EQ(false, Surface::Evaluate(*plane, spec).has_value());
+
+    // Undefined points stay NaN, are left out of the range and are drawn black
+    GridSpec small;
+    small.columns = 3;
+    small.rows = 2;
+    small.x_min = -1;
+    small.x_max = 1;
+    small.y_min = 0;
+    small.y_max = 1;
+    auto root = Surface::Evaluate(*CompiledExpression::Compile("sqrt(x) + y", {"x", "y"}), small);
+    ASSERT_EQ(true, std::isnan(root->At(0, 0)));
+    auto range = Surface::FiniteRange(*root);
+    ASSERT_NEAR(0.0, range->first, 1e-7);
+    ASSERT_NEAR(2.0, range->second, 1e-7);
+    auto gray = Surface::Colorize(*root, Surface::Colormap::Grayscale);
+    ASSERT_EQ(0, gray[0] + gray[1] + gray[2]);
+    ASSERT_EQ(255, static_cast<int>(gray[3 * 2]));        // (2, 0): sqrt(1) + 1 = 2
+    ASSERT_EQ(0, static_cast<int>(gray[3 * 4]));          // (1, 1): sqrt(0) + 0 = 0
+    auto viridis = Surface::Colorize(*root, Surface::Colormap::Viridis, 0.0, 2.0);
+    ASSERT_EQ(68, static_cast<int>(viridis[3 * 4]));
+    ASSERT_EQ(37, static_cast<int>(viridis[3 * 2 + 2]));
+
+    // Marching squares traces a circle, and saddles give two separate pieces
+    GridSpec square;
+    square.columns = 201;
+    square.rows = 201;
+    auto bowl = Surface::Evaluate(*CompiledExpression::Compile("x^2 + y^2", {"x", "y"}), square);
+    auto circle = Surface::Contour(*bowl, 25.0);
+    double length = 0.0, worst = 0.0;
+    for (const auto& seg : circle) {
+        length += std::hypot(seg.x1 - seg.x0, seg.y1 - seg.y0);
+        worst = std::max(worst, std::abs(std::hypot(seg.x0, seg.y0) - 5.0));
+    }
+    ASSERT_NEAR(10.0 * PI_CONST, length, 0.01 * 10.0 * PI_CONST);
+    ASSERT_EQ(true, worst < 0.01);
+    GridSpec cell;
+    cell.columns = 2;
+    cell.rows = 2;
+    cell.x_min = cell.y_min = 0;
+    cell.x_max = cell.y_max = 1;
+    auto saddle = Surface::Evaluate(*CompiledExpression::Compile("abs(x + y - 1)", {"x", "y"}), cell);
+    ASSERT_EQ(size_t{2}, Surface::Contour(*saddle, 0.5).size());
+
+    PlotEngine plots;
+    PlotConfig config;
+    config.width = 40;
+    config.height = 12;
+    std::string heatmap = plots.PlotSurface("x^2 + y^2", config);
+    ASSERT_EQ(static_cast<size_t>(config.height + 1), static_cast<size_t>(std::count(heatmap.begin(), heatmap.end(), '\n')));
+    ASSERT_EQ('@', heatmap[0]);
+
+    std::cout << "[   OK  ] Test_SurfaceGrid" << std::endl;
+}
+
+void Test_LevelOfDetail() {
+    std::cout << "[RUNNING] Test_LevelOfDetail..." << std::endl;
+
+    // A random walk with gaps; the pyramid's extremes match a direct scan for any range
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> step;
+    const size_t n = 100003;
+    Vector x(n), y(n);
+    double level = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<double>(i) * 0.01;
+        level += step(rng);
+        y[i] = i % 977 == 5 ? std::nan("") : level;
+    }
+    auto pyramid = LevelOfDetail::Pyramid::Build(x, y);
+    ASSERT_EQ(n, pyramid->Size());
+    bool extremes_match = true;
+    for (int k = 0; k < 200; ++k) {
+        size_t a = rng() % n, b = rng() % n;
+        if (a > b) std::swap(a, b);
+        auto e = pyramid->RangeExtremes(a, b + 1);
+        double lo = *std::min_element(y.begin() + a, y.begin() + b + 1, [](double p, double q) { return std::isnan(q) || p < q; });
+        extremes_match &= e.min == lo && y[e.argmin] == e.min && y[e.argmax] == e.max && e.argmin >= a && e.argmax <= b;
+    }
+    ASSERT_EQ(true, extremes_match);
+
+    // Zooms answered by the pyramid equal the one-pass envelope and keep the extremes
+    for (double lo : {0.0, 123.4, 999.0}) {
+        double hi = lo + (lo == 0.0 ? 1000.03 : 7.5);
+        auto direct = LevelOfDetail::Envelope(x.data(), y.data(), n, lo, hi, 300);
+        auto fast = pyramid->Envelope(lo, hi, 300);
+        ASSERT_EQ(true, direct.x == fast.x);
+        ASSERT_EQ(direct.Size(), fast.Size());
+        ASSERT_EQ(true, direct.Size() <= 4 * 300 + 2);
+    }
+    auto whole = pyramid->Envelope(0.0, 1000.03, 300);
+    auto finite_max = [](const Vector& v) {
+        double m = -std::numeric_limits<double>::infinity();
+        for (double d : v) {
+            if (!std::isnan(d)) m = std::max(m, d);
+        }
+        return m;
+    };
+    ASSERT_EQ(finite_max(y), finite_max(whole.y));
+
+    // LTTB keeps the ends and a lone spike
+    Vector flat_x(1000), flat_y(1000, 0.0);
+    std::iota(flat_x.begin(), flat_x.end(), 0.0);
+    flat_y[637] = 50.0;
+    auto picked = LevelOfDetail::LargestTriangleThreeBuckets(flat_x.data(), flat_y.data(), 1000, 40);
+    ASSERT_EQ(size_t{40}, picked.size());
+    ASSERT_EQ(size_t{0}, picked.front());
+    ASSERT_EQ(size_t{999}, picked.back());
+    ASSERT_EQ(true, std::find(picked.begin(), picked.end(), size_t{637}) != picked.end());
+    auto reduced = pyramid->Downsample(0.0, 1000.03, 200);
+    ASSERT_EQ(size_t{200}, reduced.Size());
+    ASSERT_EQ(true, std::is_sorted(reduced.x.begin(), reduced.x.end()));
+
+    // Unsorted input is sorted on build; plots of a series and of its pyramid agree
+    auto shuffled = LevelOfDetail::Pyramid::Build({3.0, 1.0, 2.0}, {30.0, 10.0, 20.0});
+    ASSERT_EQ(10.0, shuffled->Y()[0]);
+    ASSERT_EQ(false, LevelOfDetail::Pyramid::Build({1.0, std::nan("")}, {1.0, 2.0}).has_value());
+    PlotEngine plots;
+    PlotConfig config;
+    config.x_min = 0;
+    config.x_max = 1000;
+    config.y_min = -400;
+    config.y_max = 400;
+    std::string line = plots.PlotData(x, y, config);
+    ASSERT_EQ(line, plots.PlotSeries(*pyramid, config));
+    ASSERT_EQ(true, std::count(line.begin(), line.end(), '*') > config.width);
+    std::string scatter = plots.PlotData({1.0, -1.0, 0.5}, {1.0, -1.0, 0.0}, config);
+    ASSERT_EQ(static_cast<size_t>(config.height), static_cast<size_t>(std::count(scatter.begin(), scatter.end(), '\n')));
+
+    std::cout << "[   OK  ] Test_LevelOfDetail" << std::endl;
+}
+
+void Test_RasterPlot() {
+    std::cout << "[RUNNING] Test_RasterPlot..." << std::endl;
+
+    // Wu lines: a line between rows splits its coverage, a diagonal spreads one pixel per column
+    const Rgb white{255, 255, 255}, black{0, 0, 0};
+    RasterCanvas canvas(16, 8);
+    canvas.Clear(white);
+    canvas.DrawLine(1.0, 2.5, 14.0, 2.5, black);
+    ASSERT_EQ(128, static_cast<int>(canvas.At(7, 2).r));
+    ASSERT_EQ(128, static_cast<int>(canvas.At(7, 3).r));
+    ASSERT_EQ(255, static_cast<int>(canvas.At(7, 4).r));
+    canvas.Clear(white);
+    canvas.DrawLine(0.0, 0.0, 15.0, 6.3, black);
+    bool one_pixel_per_column = true;
+    for (size_t c = 1; c < 15; ++c) {
+        int ink = 0;
+        for (size_t r = 0; r < 8; ++r) ink += 255 - canvas.At(c, r).r;
+        one_pixel_per_column &= std::abs(ink - 255) <= 2;
+    }
+    ASSERT_EQ(true, one_pixel_per_column);
+    // A segment to 1e16 is clipped first, and the clip columns bound all drawing
+    canvas.Clear(white);
+    canvas.SetClip(4, 8);
+    canvas.DrawLine(6.0, 4.0, 6.0, 1e16, black);
+    canvas.DrawLine(0.0, 1.0, 15.0, 1.0, black);
+    ASSERT_EQ(0, static_cast<int>(canvas.At(6, 7).r));
+    ASSERT_EQ(0, static_cast<int>(canvas.At(5, 1).r));
+    ASSERT_EQ(255, static_cast<int>(canvas.At(2, 1).r));
+    canvas.ResetClip();
+
+    // Encoders: the checksums' check values, Netpbm sizes and a PNG whose stored deflate decodes to the pixels
+    const std::string check = "123456789";
+    ASSERT_EQ(0xCBF43926u, RasterImage::Crc32(reinterpret_cast<const uint8_t*>(check.data()), check.size()));
+    const std::string wiki = "Wikipedia";
+    ASSERT_EQ(0x11E60398u, RasterImage::Adler32(reinterpret_cast<const uint8_t*>(wiki.data()), wiki.size()));
+    RasterCanvas image(300, 120);   // Over 65535 bytes of scanlines: several stored blocks
+    for (size_t y = 0; y < 120; ++y) {
+        for (size_t x = 0; x < 300; ++x) image.Blend(x, y, Rgb{static_cast<uint8_t>(x), static_cast<uint8_t>(y), 77}, 1.0);
+    }
+    ASSERT_EQ(std::string("P6\n300 120\n255\n").size() + 3 * 300 * 120, RasterImage::Encode(image, RasterImage::Format::PPM).size());
+    auto pgm = RasterImage::Encode(image, RasterImage::Format::PGM);
+    ASSERT_EQ(std::string("P5\n300 120\n255\n").size() + 300 * 120, pgm.size());
+    ASSERT_EQ(static_cast<int>((299 * 10 + 587 * 0 + 114 * 77 + 500) / 1000), static_cast<int>(pgm[pgm.size() - 300 * 120 + 10]));
+
+    auto png = RasterImage::Encode(image, RasterImage::Format::PNG);
+    auto be32 = [&](size_t at) {
+        return (uint32_t{png[at]} << 24) | (uint32_t{png[at + 1]} << 16) | (uint32_t{png[at + 2]} << 8) | png[at + 3];
+    };
+    ASSERT_EQ(0x89, static_cast<int>(png[0]));
+    ASSERT_EQ(std::string("PNG"), std::string(png.begin() + 1, png.begin() + 4));
+    ASSERT_EQ(13u, be32(8));
+    ASSERT_EQ(300u, be32(16));
+    ASSERT_EQ(120u, be32(20));
+    ASSERT_EQ(be32(29), RasterImage::Crc32(png.data() + 12, 17));
+    const size_t idat = 33, idat_size = be32(idat);
+    ASSERT_EQ(std::string("IDAT"), std::string(png.begin() + idat + 4, png.begin() + idat + 8));
+    ASSERT_EQ(be32(idat + 8 + idat_size), RasterImage::Crc32(png.data() + idat + 4, idat_size + 4));
+    std::vector<uint8_t> inflated;
+    size_t at = idat + 10, blocks = 0;
+    bool final_block = false;
+    while (!final_block) {
+        final_block = png[at] & 1;
+        const size_t len = png[at + 1] | (png[at + 2] << 8);
+        ASSERT_EQ(0xFFFFu, len ^ (png[at + 3] | (png[at + 4] << 8)));
+        inflated.insert(inflated.end(), png.begin() + at + 5, png.begin() + at + 5 + len);
+        at += 5 + len;
+        ++blocks;
+    }
+    ASSERT_EQ(true, blocks > 1);
+    ASSERT_EQ(be32(at), RasterImage::Adler32(inflated.data(), inflated.size()));
+    ASSERT_EQ(120 * (1 + 3 * 300), inflated.size());
+    bool rows_match = true;
+    for (size_t y = 0; y < 120; ++y) {
+        rows_match &= inflated[y * 901] == 0 &&
+                      std::equal(inflated.begin() + y * 901 + 1, inflated.begin() + (y + 1) * 901,
+                                 image.Pixels().begin() + y * 900);
+    }
+    ASSERT_EQ(true, rows_match);
+    ASSERT_EQ(std::string("IEND"), std::string(png.end() - 8, png.end() - 4));
+
+    // A whole-pixel pan redraws the exposed strip only and matches a full redraw of the same samples
+    RasterStyle style;
+    style.fill_opacity = 0.3;
+    auto plot = RasterFunctionPlot::Create("sin(x * 20) * 3 + 1 / (x - 30)", style);
+    RasterView view;
+    view.x_min = -20;
+    view.x_max = 20;
+    view.width = 401;
+    view.height = 200;
+    ASSERT_EQ(401u, plot->Render(view));
+    ASSERT_EQ(0u, plot->Render(view));
+    const size_t first_render = plot->Evaluations();
+    size_t panned_columns = 0, first_pan = 0;
+    for (int step = 0; step < 8; ++step) {
+        view.x_min += 1.7;   // 17 columns at 10 per unit
+        view.x_max += 1.7;
+        panned_columns += plot->Render(view);
+        if (step == 0) first_pan = plot->Evaluations() - first_render;
+    }
+    view.x_min -= 0.5;
+    view.x_max -= 0.5;
+    panned_columns += plot->Render(view);
+    ASSERT_EQ(8u * (17 + 3) + (5 + 3), panned_columns);
+    ASSERT_EQ(true, first_pan > 0 && first_pan < first_render / 10);
+    const std::vector<uint8_t> incremental = plot->Canvas().Pixels();
+    plot->Redraw();
+    int largest_difference = 0;
+    for (size_t i = 0; i < incremental.size(); ++i) {
+        largest_difference = std::max(largest_difference, std::abs(incremental[i] - plot->Canvas().Pixels()[i]));
+    }
+    ASSERT_EQ(0, largest_difference);
+    // The pole at x = 30 is a break, not a vertical line
+    ASSERT_EQ(false, plot->Samples().breaks.empty());
+
+    // A zoom out reuses the cached samples: fewer evaluations than a fresh plot of the same view
+    view.x_min = -40;
+    view.x_max = 60;
+    const size_t before_zoom = plot->Evaluations();
+    plot->Render(view);
+    auto fresh = RasterFunctionPlot::Create("sin(x * 20) * 3 + 1 / (x - 30)", style);
+    fresh->Render(view);
+    ASSERT_EQ(true, plot->Evaluations() - before_zoom < fresh->Evaluations());
+    ASSERT_EQ(false, RasterFunctionPlot::Create("sin(").has_value());
+
+    // Heatmap: x + y is lowest bottom left and highest top right
+    RasterView square;
+    square.width = 64;
+    square.height = 48;
+    auto heat = RenderHeatmap("x + y", square, Surface::Colormap::Grayscale);
+    ASSERT_EQ(0, static_cast<int>(heat->At(0, 47).r));
+    ASSERT_EQ(255, static_cast<int>(heat->At(63, 0).r));
+    ASSERT_EQ(false, RenderHeatmap("x +", square).has_value());
+
+    std::cout << "[   OK  ] Test_RasterPlot" << std::endl;
+}
+
+void Test_PlotTileCache() {
+    std::cout << "[RUNNING] Test_PlotTileCache..." << std::endl;
+
+    auto square = CompiledExpression::Compile("x^2", {"x"});
+    ASSERT_EQ(CompiledExpression::Compile("6x", {"x"})->Fingerprint(), CompiledExpression::Compile("2*3*x", {"x"})->Fingerprint());
+    ASSERT_EQ(false, square->Fingerprint() == CompiledExpression::Compile("x^3", {"x"})->Fingerprint());
+    ASSERT_EQ(5, PlotTileCache::LevelFor(0.05));
+    ASSERT_EQ(-3, PlotTileCache::LevelFor(8.0));
+
+    // Level 5 samples every 1/32: [-10, 10] is indices -320..320, tiles -2..1
+    PlotTileCache cache(64);
+    Vector xs, ys;
+    ASSERT_EQ(true, cache.SampleCurve(*square, -10, 10, 0.05, xs, ys));
+    ASSERT_EQ(size_t{641}, xs.size());
+    ASSERT_EQ(-10.0, xs.front());
+    ASSERT_EQ(10.0, xs.back());
+    bool exact = true;
+    for (size_t i = 0; i < xs.size(); ++i) exact &= xs[i] == -10.0 + static_cast<double>(i) / 32.0 && ys[i] == xs[i] * xs[i];
+    ASSERT_EQ(true, exact);
+    ASSERT_EQ(size_t{4}, cache.Metrics().misses);
+    ASSERT_EQ(size_t{0}, cache.Metrics().hits);
+
+    // The same view again is all hits. After the prefetch, so are a pan into the next
+    // tile (tile 2) and a zoom out to the coarser tiles over the view (level 4, tiles -1..0)
+    cache.SampleCurve(*square, -10, 10, 0.05, xs, ys);
+    ASSERT_EQ(size_t{4}, cache.Metrics().hits);
+    cache.WaitForPrefetch();
+    ASSERT_EQ(size_t{4}, cache.Metrics().prefetched);
+    cache.SampleCurve(*square, -4, 16, 0.05, xs, ys);
+    cache.SampleCurve(*square, -16, 15.9, 0.1, xs, ys);
+    auto metrics = cache.Metrics();
+    ASSERT_EQ(size_t{4}, metrics.misses);
+    ASSERT_EQ(size_t{3}, metrics.prefetch_hits);
+    ASSERT_EQ(10.0 / 14.0, metrics.HitRate());
+    ASSERT_EQ(-16.0, xs.front());
+    ASSERT_EQ(256.0, ys.front());
+
+    // A small cache evicts least recently used tiles; ranges the grid cannot index are refused
+    PlotTileCache tiny(2);
+    tiny.SampleCurve(*square, -10, 10, 0.05, xs, ys);
+    tiny.WaitForPrefetch();
+    ASSERT_EQ(true, tiny.Metrics().evictions >= 2);
+    ASSERT_EQ(size_t{2}, tiny.Metrics().resident);
+    ASSERT_EQ(false, tiny.SampleCurve(*square, -1e300, 1e300, 1.0, xs, ys));
+    ASSERT_EQ(false, tiny.SampleCurve(*square, 1, 0, 1.0, xs, ys));
+
+    // Surfaces take the nearest grid point of per-axis levels at most one step apart
+    auto saddle = CompiledExpression::Compile("x^2 - y^2", {"x", "y"});
+    GridSpec spec;
+    spec.columns = 61;
+    spec.rows = 23;
+    spec.x_min = -3.3;
+    spec.x_max = 2.7;
+    spec.y_min = -1;
+    spec.y_max = 4.5;
+    SurfaceGrid tiled;
+    ASSERT_EQ(true, cache.SampleSurface(*saddle, spec, tiled));
+    auto direct = Surface::Evaluate(*saddle, spec);
+    double worst = 0.0;
+    for (size_t i = 0; i < tiled.values.size(); ++i) worst = std::max(worst, std::abs(double(tiled.values[i]) - direct->values[i]));
+    ASSERT_EQ(true, worst < 0.1 * 2 * 4.5);   // Half a step (<= 0.1) times the largest slope
+    ASSERT_EQ(false, cache.SampleSurface(*square, spec, tiled));
+
+    // A wide, flat view samples each axis at its own level: x every 4, y every 2^-10,
+    // so 8 tiles instead of a million columns at the y spacing. Each cell's value
+    // comes from a point within half a grid step of it on each axis.
+    spec.columns = 200;
+    spec.rows = 10;
+    spec.x_min = 0;
+    spec.x_max = 1000;
+    spec.y_min = 0;
+    spec.y_max = 0.01;
+    auto along_x = CompiledExpression::Compile("x", {"x", "y"});
+    auto along_y = CompiledExpression::Compile("y", {"x", "y"});
+    PlotTileCache flat(64);
+    ASSERT_EQ(true, flat.SampleSurface(*along_x, spec, tiled));
+    ASSERT_EQ(size_t{8}, flat.Metrics().misses);
+    double worst_x = 0.0;
+    for (size_t r = 0; r < spec.rows; ++r) {
+        for (size_t c = 0; c < spec.columns; ++c) worst_x = std::max(worst_x, std::abs(tiled.At(c, r) - tiled.X(c)));
+    }
+    ASSERT_EQ(true, worst_x <= 0.5 * 1000.0 / 199.0);
+    ASSERT_EQ(true, flat.SampleSurface(*along_y, spec, tiled));
+    double worst_y = 0.0;
+    for (size_t r = 0; r < spec.rows; ++r) {
+        for (size_t c = 0; c < spec.columns; ++c) worst_y = std::max(worst_y, std::abs(tiled.At(c, r) - tiled.Y(r)));
+    }
+    ASSERT_EQ(true, worst_y <= 0.5 * 0.01 / 9.0);
+
+    // PlotEngine keeps the cache across calls: a repeated plot evaluates no tiles
+    PlotEngine plots;
+    PlotConfig config;
+    const std::string first = plots.PlotFunction("sin(x * 30)", config);
+    const size_t misses = plots.GetCacheMetrics().misses;
+    ASSERT_EQ(first, plots.PlotFunction("sin(x * 30)", config));
+    ASSERT_EQ(misses, plots.GetCacheMetrics().misses);
+    ASSERT_EQ(true, plots.GetCacheMetrics().hits >= misses);
+    config.x_min += 25;   // Into the tile past the view, which was prefetched
+    config.x_max += 25;
+    plots.TileCache().WaitForPrefetch();
+    plots.PlotFunction("sin(x * 30)", config);
+    ASSERT_EQ(misses, plots.GetCacheMetrics().misses);
+    plots.ResetCacheMetrics();
+    ASSERT_EQ(0.0, plots.GetCacheMetrics().HitRate());
+
+    std::cout << "[   OK  ] Test_PlotTileCache" << std::endl;
+}
+
+void Test_UnitDimensions() {
+    std::cout << "[RUNNING] Test_UnitDimensions..." << std::endl;
+
+    // Dimensions are checked by the compiler: Length + Time does not compile
+    static_assert(Dimensions::Force == Dimensions::Mass * Dimensions::Length / Dimensions::Time.Pow(2));
+    static_assert(Quantities::Velocity::kDimension == Dimensions::Velocity);
+    constexpr auto speed = 100.0 * Units::km / (2.0 * Units::h);
+    static_assert(std::is_same_v<decltype(speed), const Quantities::Velocity>);
+    ASSERT_NEAR(31.0686, speed.In(Units::mi / Units::h), 1e-4);
+    const Quantities::Force weight = 70.0 * Units::kg * (9.81 * Units::m / (1.0 * Units::s * (1.0 * Units::s)));
+    ASSERT_NEAR(686.7, weight.In(Units::N), 1e-9);
+    const double ratio = (3.0 * Units::km) / (1.0 * Units::mi);   // Dimensionless converts to double
+    ASSERT_NEAR(1.86411, ratio, 1e-5);
+    ASSERT_EQ(std::string("kg*m/s^2"), Dimensions::Force.ToString());
+    ASSERT_EQ(std::string("1"), Dimensions::Dimensionless.ToString());
+
+    UnitManager units;
+    auto force = units.ParseUnit("kg*m/s^2");
+    ASSERT_EQ(true, force.has_value() && force->dimension == Dimensions::Force);
+    ASSERT_EQ(true, units.ParseUnit("kg / (m * s^2)")->dimension == Dimensions::Pressure);
+    ASSERT_EQ(true, units.ParseUnit("1/s")->dimension == Dimensions::Frequency);
+    ASSERT_EQ(false, units.ParseUnit("m/").has_value());
+    ASSERT_EQ(false, units.ParseUnit("C*m").has_value());   // Offset scales cannot be compounded
+    ASSERT_EQ(false, units.ParseUnit("parsec").has_value());
+
+    ASSERT_NEAR(10.0, units.ConvertUnit(36.0, "km/h", "m/s").GetDouble().value(), 1e-12);
+    ASSERT_NEAR(5.0, units.ConvertUnit(5.0, "N", "kg*m/s^2").GetDouble().value(), 1e-12);
+    ASSERT_NEAR(212.0, units.ConvertUnit(100.0, "C", "F").GetDouble().value(), 1e-9);
+    ASSERT_NEAR(0.0, units.ConvertUnit(-459.67, "F", "K").GetDouble().value(), 1e-9);
+    ASSERT_NEAR(1e6, units.ConvertUnit(1.0, "km^2", "m^2").GetDouble().value(), 1e-6);
+    ASSERT_EQ(true, units.ConvertUnit(1.0, "m", "s").error.has_value());
+    ASSERT_EQ(true, units.AreCompatible("J", "N*m"));
+    ASSERT_EQ(false, units.AreCompatible("J", "W"));
+
+    // Exponents are int8_t: anything that would wrap is rejected, not aliased
+    ASSERT_EQ(true, units.ParseUnit("m^127").has_value() && units.ParseUnit("m^-128").has_value());
+    ASSERT_EQ(false, units.ParseUnit("m^200").has_value());
+    ASSERT_EQ(false, units.ParseUnit("m^100*m^100").has_value());
+    ASSERT_EQ(false, units.AreCompatible("m^200", "m^-56"));
+    ASSERT_EQ(false, Dimensions::Length.CheckedPow(128).has_value());
+    ASSERT_EQ(true, Dimensions::Length.CheckedPow(-128).has_value());
+    bool threw = false;
+    try {
+        (void)(Dimension::Of(Dimension::kLength, 100) * Dimension::Of(Dimension::kLength, 100));
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    ASSERT_EQ(true, threw);
+
+    CalcErr error = CalcErr::None;
+    ASSERT_EQ(false, units.GetConversion("m", "s", &error).has_value());
+    ASSERT_EQ(true, error == CalcErr::ArgumentMismatch);
+    ASSERT_EQ(false, units.GetConversion("m", "furlong", &error).has_value());
+    ASSERT_EQ(true, error == CalcErr::OperationNotFound);
+    auto mph = units.GetConversion("mi/h", "m/s");
+    ASSERT_NEAR(0.44704, mph->factor, 1e-12);
+    ASSERT_EQ(0.0, mph->offset);
+    // A reciprocal is a compound too: it must not pick up the Celsius offset
+    for (const char* reciprocal : {"1/C", "1/F", "(1)/C"}) {
+        error = CalcErr::None;
+        ASSERT_EQ(false, units.GetConversion(reciprocal, "1/K", &error).has_value());
+        ASSERT_EQ(true, error == CalcErr::OperationNotFound);
+    }
+    ASSERT_EQ(true, units.GetConversion("(C)", "K").has_value());
+
+    std::cout << "[   OK  ] Test_UnitDimensions" << std::endl;
+}
+
+void Test_UnitParser() {
+    std::cout << "[RUNNING] Test_UnitParser..." << std::endl;
+
+    // The scan accepts signs, exponents, compound units and [..] lists
+    auto request = UnitParser::Scan("  convert -4.5e3 km/h to m/s ");
+    ASSERT_EQ(true, request.has_value());
+    ASSERT_EQ(-4500.0, request->values.front());
+    ASSERT_EQ(std::string("km/h"), request->from_unit);
+    ASSERT_EQ(std::string("m/s"), request->to_unit);
+    request = UnitParser::Scan("[1, 2.5 -3e-1] kg*m/s^2 to N");
+    ASSERT_EQ(true, request.has_value() && request->is_list);
+    ASSERT_EQ(size_t{3}, request->values.size());
+    ASSERT_EQ(-0.3, request->values[2]);
+    ASSERT_EQ(std::string("kg*m/s^2"), request->from_unit);
+    ASSERT_EQ(true, UnitParser::Scan("5m to ft").has_value());
+    ASSERT_EQ(false, UnitParser::Scan("convert m to ft").has_value());
+    ASSERT_EQ(false, UnitParser::Scan("5 m ft").has_value());
+    ASSERT_EQ(false, UnitParser::Scan("[1, 2 m to ft").has_value());
+    ASSERT_EQ(false, UnitParser::Scan("x + toast").has_value());
+
+    UnitManager units;
+    UnitParser parser(&units);
+    ASSERT_NEAR(-3.28084, parser.ParseAndExecute("-1 m to ft").GetDouble().value(), 1e-5);
+    ASSERT_NEAR(1.5, parser.ParseAndExecute("convert 1.5e3 g to kg").GetDouble().value(), 1e-12);
+    ASSERT_EQ(true, parser.ParseAndExecute("1 m to kg").error.has_value());
+    ASSERT_EQ(true, parser.ParseAndExecute("one m to ft").error.has_value());
+
+    // Lists go through the SIMD affine kernel with the cached factor and offset
+    Vector celsius(1003);
+    for (size_t i = 0; i < celsius.size(); ++i) celsius[i] = static_cast<double>(i) - 40.0;
+    auto converted = units.ConvertUnit(celsius, "C", "F");
+    const Vector& fahrenheit = std::get<Vector>(*converted.result);
+    ASSERT_EQ(celsius.size(), fahrenheit.size());
+    double worst = 0.0;
+    for (size_t i = 0; i < celsius.size(); ++i) worst = std::max(worst, std::abs(fahrenheit[i] - (celsius[i] * 1.8 + 32.0)));
+    ASSERT_EQ(true, worst < 1e-9);
+    auto feet = std::get<Vector>(*parser.ParseAndExecute("convert [0, 0.3048, -3.048] m to ft").result);
+    ASSERT_NEAR(1.0, feet[1], 1e-12);
+    ASSERT_NEAR(-10.0, feet[2], 1e-12);
+
+    // Perfect hash lookups: every symbol, and later registrations
+    ASSERT_EQ(std::string("kelvin"), units.FindUnit("K")->name);
+    ASSERT_EQ(true, units.FindUnit("kWh") != nullptr);
+    ASSERT_EQ(true, units.FindUnit("k") == nullptr);
+    ASSERT_EQ(true, units.FindUnit("") == nullptr);
+    units.RegisterUnit("nmi", UnitType::Length, 1852.0, "nautical mile");
+    ASSERT_NEAR(1852.0, units.ConvertUnit(1.0, "nmi", "m").GetDouble().value(), 1e-9);
+    bool all_found = true;
+    for (const std::string& symbol : units.GetUnitsOfType(UnitType::Length)) all_found &= units.FindUnit(symbol) != nullptr;
+    ASSERT_EQ(true, all_found);
+
+    std::cout << "[   OK  ] Test_UnitParser" << std::endl;
+}
+
+void Test_UnitExpressions() {
+    std::cout << "[RUNNING] Test_UnitExpressions..." << std::endl;
+
+    UnitManager units;
+    auto velocity = CompiledExpression::Compile("9.81 m/s^2 * 3 s", {}, units);
+    ASSERT_EQ(true, velocity.has_value() && velocity->HasUnits());
+    ASSERT_EQ(true, velocity->IsConstant());   // Scales fold away with the arithmetic
+    ASSERT_NEAR(29.43, velocity->EvaluateAt(nullptr), 1e-12);
+    ASSERT_EQ(std::string("m/s"), velocity->ResultDimension().ToString());
+
+    // Literals fold to SI; variables stay dimensionless multipliers
+    auto distance = CompiledExpression::Compile("t * 1 h * 100 km/h + 2 mi", {"t"}, units);
+    ASSERT_EQ(true, distance.has_value() && distance->ResultDimension() == Dimensions::Length);
+    const double hours = 2.0;
+    ASSERT_NEAR(203218.688, distance->EvaluateAt(&hours), 1e-6);
+    auto energy = CompiledExpression::Compile("0.5 * 2 kg * (3 m / 1 s)^2", {}, units);
+    ASSERT_EQ(true, energy->ResultDimension() == Dimensions::Energy);
+    ASSERT_NEAR(9.0, energy->EvaluateAt(nullptr), 1e-12);
+    auto side = CompiledExpression::Compile("sqrt(x * 4 m^2)", {"x"}, units);
+    ASSERT_EQ(true, side.has_value() && side->ResultDimension() == Dimensions::Length);
+    const double nine = 9.0;
+    ASSERT_NEAR(6.0, side->EvaluateAt(&nine), 1e-12);
+    ASSERT_NEAR(1.86411, CompiledExpression::Compile("3 km / 1 mi", {}, units)->EvaluateAt(nullptr), 1e-5);
+    ASSERT_EQ(true, CompiledExpression::Compile("3 km / 1 mi", {}, units)->ResultDimension().IsDimensionless());
+
+    // A unit ends at a name that is a variable, a function call or not a unit
+    auto minutes = CompiledExpression::Compile("2 min + min(1 h, 2 h) * s", {"s"}, units);
+    ASSERT_EQ(true, minutes.has_value() && minutes->ResultDimension() == Dimensions::Time);
+    const double three = 3.0;
+    ASSERT_NEAR(10920.0, minutes->EvaluateAt(&three), 1e-9);
+    ASSERT_EQ(false, CompiledExpression::Compile("2 min + 1 s", {"s"}, units).has_value());   // s is a variable here
+
+    // Dimension errors are compile errors
+    std::string reason;
+    bool dimension_error = false;
+    ASSERT_EQ(false, CompiledExpression::Compile("3 m + 2 s", {}, units, &reason, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(std::string("cannot combine m with s"), reason);
+    ASSERT_EQ(false, CompiledExpression::Compile("sin(2 m)", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(false, CompiledExpression::Compile("(2 m)^x", {"x"}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(false, CompiledExpression::Compile("20 C + 1 K", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(false, CompiledExpression::Compile("1 m^100 * 1 m^100 / 1 m^-56", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(false, CompiledExpression::Compile("(1 m^100)^2", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(false, CompiledExpression::Compile("1 m^90 / 1 m^-90", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(false, CompiledExpression::Compile("3 m +", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(false, dimension_error);
+
+    // A lone angle literal is in degrees, the unit trigonometry takes; compound angles are refused
+    ASSERT_NEAR(1.0, CompiledExpression::Compile("sin(90 deg)", {}, units)->EvaluateAt(nullptr), 1e-15);
+    ASSERT_NEAR(-1.0, CompiledExpression::Compile("cos(3.141592653589793 rad)", {}, units)->EvaluateAt(nullptr), 1e-15);
+    ASSERT_NEAR(90.0, CompiledExpression::Compile("100 grad", {}, units)->EvaluateAt(nullptr), 1e-12);
+    ASSERT_EQ(false, CompiledExpression::Compile("2 rad/s", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+    ASSERT_EQ(false, CompiledExpression::Compile("1 deg^2", {}, units, nullptr, &dimension_error).has_value());
+    ASSERT_EQ(true, dimension_error);
+
+    // The ALGEBRAIC path: a scan for "number then unit" gates the compile
+    ASSERT_EQ(true, UnitParser::HasUnitLiteral("9.81 m/s^2 * 3 s", units));
+    ASSERT_EQ(true, UnitParser::HasUnitLiteral("2km", units));
+    ASSERT_EQ(false, UnitParser::HasUnitLiteral("2x + sin(30) * 1e5", units));
+    ASSERT_EQ(false, UnitParser::HasUnitLiteral("x2 m + 3 min(1, 2)", units));   // x2 is a name, min( a call
+    ASSERT_EQ(false, UnitParser::HasUnitLiteral("2 s", units, {{"s", 1.0}}));
+    ASSERT_EQ(false, UnitParser::EvaluateQuantity("3 + 4 * x", {{"x", 2.0}}, units).has_value());
+    auto quantity = UnitParser::EvaluateQuantity("9.81 m/s^2 * 3 s", {}, units);
+    ASSERT_EQ(true, quantity.has_value() && quantity->HasResult());
+    ASSERT_EQ(std::string("29.43 m/s"), std::get<std::string>(*quantity->result));
+    ASSERT_NEAR(1.0, UnitParser::EvaluateQuantity("sin(90 deg)", {}, units)->GetDouble().value_or(NAN), 1e-15);
+    ASSERT_NEAR(6.0, UnitParser::EvaluateQuantity("t * 2 km / 1 km", {{"t", 3.0}}, units)->GetDouble().value_or(NAN), 1e-12);
+    ASSERT_EQ(true, UnitParser::EvaluateQuantity("3 m + 2 s", {}, units)->HasErrors());
+
+    // Without a UnitManager the same names are variables or errors, as before
+    ASSERT_EQ(false, CompiledExpression::Compile("3 m", {}).has_value());
+    ASSERT_EQ(false, CompiledExpression::Compile("2x", {"x"}, units)->HasUnits());
+
+    std::cout << "[   OK  ] Test_UnitExpressions" << std::endl;
+}
+
+void Test_SparsePolynomial() {
+    std::cout << "[RUNNING] Test_SparsePolynomial..." << std::endl;
+
+    auto square = SparsePolynomial::Parse("(x + y)^2");
+    ASSERT_EQ(std::string("x^2 + 2*x*y + y^2"), square->ToString());
+    ASSERT_EQ(std::string("x^3 - 1"), SparsePolynomial::Parse("(x - 1)(x^2 + x + 1)")->ToString());
+    ASSERT_EQ(std::string("0"), SparsePolynomial::Parse("(a + b)(a - b) - a^2 + b^2")->ToString());
+    ASSERT_EQ(std::string("-0.5*x*z + 8"), SparsePolynomial::Parse("2^3 - x z / 2")->ToString());
+    ASSERT_EQ(std::string("x^2 - 2*x + 1"), SparsePolynomial::Parse("-(1 - x)^2 * -1")->ToString());
+
+    // Lex order over sorted variables; values evaluate in that order
+    auto mixed = SparsePolynomial::Parse("3y^2 + 2x*y - 5");
+    ASSERT_EQ(std::string("2*x*y + 3*y^2 - 5"), mixed->ToString());
+    const double xy[] = {2.0, -1.0};
+    ASSERT_EQ(-6.0, mixed->Evaluate(xy));
+    ASSERT_EQ(2u, mixed->TotalDegree());
+
+    // (x + y + z)^20: C(22, 2) = 231 terms, coefficients are multinomials (exact in double)
+    auto big = SparsePolynomial::Parse("(x + y + z)^20");
+    ASSERT_EQ(size_t{231}, big->TermCount());
+    ASSERT_EQ(20u, big->TotalDegree());
+    double coefficient_sum = 0.0, middle = 0.0;
+    for (const auto& term : big->Terms()) {
+        coefficient_sum += term.coefficient;
+        if (SparsePolynomial::Exponent(term.monomial, 0) == 7 && SparsePolynomial::Exponent(term.monomial, 1) == 7) middle = term.coefficient;
+    }
+    ASSERT_EQ(std::pow(3.0, 20), coefficient_sum);
+    ASSERT_EQ(133024320.0, middle);   // 20! / (7! 7! 6!)
+    const double point[] = {0.5, -1.25, 2.0};
+    ASSERT_NEAR(std::pow(1.25, 20), big->Evaluate(point), 1e-9 * std::pow(1.25, 20));
+
+    // A dense product checked against evaluation
+    auto p = SparsePolynomial::Parse("(1 + x + y^2 + 3z)^6");
+    auto q = SparsePolynomial::Parse("(2 - x + w)^5");
+    auto pq = SparsePolynomial::Multiply(*p, *q);
+    ASSERT_EQ(true, pq.has_value());
+    ASSERT_EQ(size_t{4}, pq->Variables().size());
+    const double wxyz[] = {0.3, -0.7, 1.1, 0.2};
+    const double pxyz[] = {-0.7, 1.1, 0.2};
+    const double qwx[] = {0.3, -0.7};
+    ASSERT_NEAR(p->Evaluate(pxyz) * q->Evaluate(qwx), pq->Evaluate(wxyz), 1e-9);
+
+    // Large dense products accumulate by Kronecker index; the result matches the heap path term for term
+    auto tenth = SparsePolynomial::Parse("(1 + x + y + z)^10");
+    auto squared = SparsePolynomial::Multiply(*tenth, *tenth);
+    auto twentieth = SparsePolynomial::Parse("(1 + x + y + z)^20");
+    ASSERT_EQ(size_t{1771}, squared->TermCount());
+    bool same = squared->TermCount() == twentieth->TermCount();
+    for (size_t i = 0; same && i < squared->TermCount(); ++i) {
+        same = squared->Terms()[i].monomial == twentieth->Terms()[i].monomial &&
+               squared->Terms()[i].coefficient == twentieth->Terms()[i].coefficient;
+    }
+    ASSERT_EQ(true, same);
+
+    // Not polynomials, or out of the packed range
+    std::string error;
+    ASSERT_EQ(false, SparsePolynomial::Parse("sin(x)", &error).has_value());
+    ASSERT_EQ(std::string("'sin(' is not a polynomial operation"), error);
+    ASSERT_EQ(false, SparsePolynomial::Parse("1 / x").has_value());
+    ASSERT_EQ(false, SparsePolynomial::Parse("x^-1").has_value());
+    ASSERT_EQ(false, SparsePolynomial::Parse("x^256").has_value());
+    ASSERT_EQ(true, SparsePolynomial::Parse("x^255").has_value());
+    ASSERT_EQ(false, SparsePolynomial::Parse("a+b+c+d+e1+f+g+h+i").has_value());
+    ASSERT_EQ(std::string("1024"), SparsePolynomial::Parse("2^10")->ToString());
+    ASSERT_EQ(std::string("0.5*x + 2"), SparsePolynomial::Parse("2^-1 x + 4^0.5")->ToString());
+    ASSERT_EQ(false, SparsePolynomial::Parse("0^-1 + x").has_value());
+    ASSERT_EQ(false, SparsePolynomial::Parse("x^0.5").has_value());
+    ASSERT_EQ(std::string("2*x + 1234567890123456"), SparsePolynomial::Parse("1234567890123456 + 2x")->ToString());
+
+    // Coefficients past 2^53 round, and say so: C(60, 30) ~ 1.18e17
+    auto binomial = SparsePolynomial::Parse("(1 + x)^60");
+    ASSERT_EQ(false, binomial->IsExact());
+    ASSERT_EQ(true, SparsePolynomial::Parse("(1 + x)^50")->IsExact());   // C(50, 25) ~ 1.26e14
+    ASSERT_EQ(true, binomial->ToString().find("e+17*x^30") != std::string::npos);
+
+    SymbolicEngine symbolic;
+    auto expanded = symbolic.Expand("(x + 1)^2");
+    ASSERT_EQ(std::string("x^2 + 2*x + 1"), std::get<std::string>(*expanded.result));
+    ASSERT_EQ(true, symbolic.Expand("(x + 1").error.has_value());
+    // Expansions past kMaxTerms are refused rather than built: ^24 alone has 2.6M terms
+    std::string error_text;
+    ASSERT_EQ(false, SparsePolynomial::Parse("(a+b+c+d+f+g+h+k)^60", &error_text).has_value());
+    ASSERT_EQ(true, error_text.find("terms") != std::string::npos);
+    ASSERT_EQ(true, symbolic.Expand("(a+b+c+d+f+g+h+k)^255").error.has_value());
+
+    std::cout << "[   OK  ] Test_SparsePolynomial" << std::endl;
+}
+
 int main() {
     std::cout << "======================================\n";
     std::cout << "   AXIOM BULLETPROOF TEST SUITE    \n";
@@ -601,6 +2634,31 @@ int main() {
     RUN_TEST(Test_NonLinearSolver);
     RUN_TEST(Test_LinearSystemParsing);
     RUN_TEST(Test_MatrixOperations);
+    RUN_TEST(Test_DispatchBatch);
+    RUN_TEST(Test_ThreadPool);
+    RUN_TEST(Test_Daemon);
+    RUN_TEST(Test_SimdKernels);
+    RUN_TEST(Test_MomentAccumulator);
+    RUN_TEST(Test_QuantileSelection);
+    RUN_TEST(Test_QuantileSketches);
+    RUN_TEST(Test_RollingWindows);
+    RUN_TEST(Test_CompensatedSums);
+    RUN_TEST(Test_DataLoader);
+    RUN_TEST(Test_MultipleRegression);
+    RUN_TEST(Test_Distributions);
+    RUN_TEST(Test_Binning);
+    RUN_TEST(Test_Resampling);
+    RUN_TEST(Test_FrequencyTable);
+    RUN_TEST(Test_CompiledExpression);
+    RUN_TEST(Test_CurveSampling);
+    RUN_TEST(Test_SurfaceGrid);
+    RUN_TEST(Test_LevelOfDetail);
+    RUN_TEST(Test_RasterPlot);
+    RUN_TEST(Test_PlotTileCache);
+    RUN_TEST(Test_UnitDimensions);
+    RUN_TEST(Test_UnitParser);
+    RUN_TEST(Test_UnitExpressions);
+    RUN_TEST(Test_SparsePolynomial);
 
     std::cout << "======================================\n";
     std::cout << "Tests Passed: " << g_tests_passed << "\n";